@@ -0,0 +1,430 @@
+// DMXEngineWrapper.mm - Objective-C++ implementation bridging the C++ DMX engine to Swift
+
+#import "include/DMXEngineWrapper.h"
+#import "dmx_capture.h"
+#import "dmx_ingest.h"
+#import "fixture_decoder.h"
+#import "universe_store.h"
+#include <memory>
+#include <vector>
+
+static inline bool validUniverse(NSInteger universe) {
+    return universe >= 0 && universe < (NSInteger)RocKontrol::UniverseStore::kUniverseRange;
+}
+
+#pragma mark - GDSACNSource
+
+@implementation GDSACNSource
+@end
+
+#pragma mark - GDReceiveShard
+
+@implementation GDReceiveShard
+@end
+
+#pragma mark - GDUniverseStats
+
+@implementation GDUniverseStats
+@end
+
+static NSArray<NSNumber *> *histogramArray(const std::array<uint64_t, RocKontrol::kTimingBuckets>& counts) {
+    NSMutableArray<NSNumber *> *result = [NSMutableArray arrayWithCapacity:counts.size()];
+    for (uint64_t count : counts) [result addObject:@(count)];
+    return result;
+}
+
+#pragma mark - GDDMXEngine
+
+@implementation GDDMXEngine {
+    std::unique_ptr<RocKontrol::UniverseStore> _store;
+    std::unique_ptr<RocKontrol::DMXIngest> _ingest;
+    std::unique_ptr<RocKontrol::UniverseSnapshot> _frame;
+    std::unique_ptr<RocKontrol::FixtureDecodeWorker> _decoder;
+    std::vector<RocKontrol::FixturePatch> _patch;
+    std::unique_ptr<RocKontrol::DMXCaptureWriter> _capture;
+    std::unique_ptr<RocKontrol::DMXReplayer> _replayer;
+    BOOL _resumeAfterReplay;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _store = std::make_unique<RocKontrol::UniverseStore>();
+        _ingest = std::make_unique<RocKontrol::DMXIngest>(*_store);
+        _frame = std::make_unique<RocKontrol::UniverseSnapshot>();
+        _decoder = std::make_unique<RocKontrol::FixtureDecodeWorker>(*_store);
+        _capture = std::make_unique<RocKontrol::DMXCaptureWriter>();
+        _replayer = std::make_unique<RocKontrol::DMXReplayer>(*_ingest);
+        _artNetUniverseOffset = RocKontrol::DMXIngestConfig().art_net_universe_offset;
+        _sacnUniverseOffset = RocKontrol::DMXIngestConfig().sacn_universe_offset;
+
+        RocKontrol::FixtureDecodeWorker* decoder = _decoder.get();
+        _ingest->setUpdateHandler([decoder] { decoder->notify(); });
+        _decoder->start();
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_replayer) {
+        _replayer->close();
+    }
+    if (_ingest) {
+        _ingest->stop();
+        _ingest->setCapture(nullptr);
+    }
+    if (_capture) {
+        _capture->close();
+    }
+    if (_decoder) {
+        _decoder->stop();
+    }
+}
+
+- (BOOL)startWithProtocols:(GDDMXProtocols)protocols
+               interfaceIP:(NSString *)interfaceIP
+                  loopback:(BOOL)loopback
+             startUniverse:(NSInteger)startUniverse
+             universeCount:(NSInteger)universeCount {
+    return [self startWithProtocols:protocols
+                       interfaceIPs:@[interfaceIP]
+                           loopback:loopback
+                      startUniverse:startUniverse
+                      universeCount:universeCount
+                     receiveThreads:1];
+}
+
+- (BOOL)startWithProtocols:(GDDMXProtocols)protocols
+              interfaceIPs:(NSArray<NSString *> *)interfaceIPs
+                  loopback:(BOOL)loopback
+             startUniverse:(NSInteger)startUniverse
+             universeCount:(NSInteger)universeCount
+            receiveThreads:(NSInteger)receiveThreads {
+    if (!_ingest) return NO;
+    [self stopReplay];
+    _resumeAfterReplay = NO;
+    _ingest->stop();
+
+    RocKontrol::DMXIngestConfig config;
+    config.art_net = (protocols & GDDMXProtocolArtNet) != 0;
+    config.sacn = (protocols & GDDMXProtocolSACN) != 0;
+    config.interfaces.clear();
+    for (NSString *ip in interfaceIPs) {
+        config.interfaces.push_back(ip.length ? [ip UTF8String] : "0.0.0.0");
+    }
+    if (config.interfaces.empty()) config.interfaces.push_back("0.0.0.0");
+    config.loopback = loopback;
+    config.shards = (uint32_t)MIN(MAX(receiveThreads, 1), (NSInteger)RocKontrol::DMXIngest::kMaxShards);
+    config.start_universe = (uint16_t)MIN(MAX(startUniverse, 1), 63999);
+    config.universe_count = (uint16_t)MIN(MAX(universeCount, 1), 63999);
+    config.art_net_universe_offset = (int32_t)MIN(MAX(_artNetUniverseOffset, -65535), 65535);
+    config.sacn_universe_offset = (int32_t)MIN(MAX(_sacnUniverseOffset, -65535), 65535);
+
+    if (!_ingest->configure(config)) return NO;
+    return _ingest->start();
+}
+
+- (void)stop {
+    if (_ingest) _ingest->stop();
+}
+
+- (BOOL)isRunning {
+    return _ingest ? _ingest->isRunning() : NO;
+}
+
+- (BOOL)copyUniverse:(NSInteger)universe into:(uint8_t *)buffer {
+    if (!_store || !validUniverse(universe)) {
+        memset(buffer, 0, RocKontrol::kDMXSlots);
+        return NO;
+    }
+    return _store->read((uint16_t)universe, buffer);
+}
+
+- (BOOL)hasReceivedDataForUniverse:(NSInteger)universe {
+    return (_store && validUniverse(universe)) ? _store->hasData((uint16_t)universe) : NO;
+}
+
+- (void)captureFrame {
+    if (!_store || !_frame) return;
+    _store->snapshot(*_frame);
+    if (_ingest) _ingest->stats().recordFrame(*_frame);
+}
+
+- (const uint8_t *)frameUniverse:(NSInteger)universe {
+    static const uint8_t zeros[RocKontrol::kDMXSlots] = {};
+    if (!_frame || !validUniverse(universe)) return zeros;
+    return _frame->universe((uint16_t)universe);
+}
+
+- (BOOL)frameHasUniverse:(NSInteger)universe {
+    return (_frame && validUniverse(universe)) ? _frame->hasData((uint16_t)universe) : NO;
+}
+
+- (BOOL)frameUniverse:(NSInteger)universe changedFrom:(NSInteger)start count:(NSInteger)count {
+    if (!_frame || !validUniverse(universe) || start < 0 || count <= 0) return NO;
+    return _frame->changed((uint16_t)universe, (uint32_t)start, (uint32_t)count);
+}
+
+- (uint64_t)setFixturePatchWithModes:(const uint8_t *)modes
+                           universes:(const uint16_t *)universes
+                           addresses:(const uint16_t *)addresses
+                               count:(NSInteger)count {
+    if (!_decoder) return 0;
+
+    _patch.resize(count > 0 ? (size_t)count : 0);
+    for (size_t i = 0; i < _patch.size(); i++) {
+        _patch[i].mode = (RocKontrol::FixtureMode)modes[i];
+        _patch[i].universe = universes[i];
+        _patch[i].address = addresses[i];
+    }
+    return _decoder->setPatch(_patch.data(), (uint32_t)_patch.size());
+}
+
+- (GDFixtureFrame)acquireFixtureFrame {
+    GDFixtureFrame result = {};
+    if (!_decoder) return result;
+
+    const RocKontrol::FixtureFrame& frame = _decoder->acquire();
+    result.count = frame.count;
+    result.stride = frame.capacity;
+    result.fields = frame.fields.data();
+    result.bytes = frame.bytes.data();
+    result.stamps = frame.stamps.data();
+    result.sequence = frame.sequence;
+    result.decodedCount = frame.decoded;
+    result.patchVersion = frame.patch_version;
+    result.decodeNanoseconds = frame.decode_ns;
+    return result;
+}
+
+- (uint64_t)fixtureFramesDecoded {
+    return _decoder ? _decoder->framesDecoded() : 0;
+}
+
+- (uint64_t)fixtureFramesUnchanged {
+    return _decoder ? _decoder->framesUnchanged() : 0;
+}
+
+- (NSInteger)fixturesDecodedLastFrame {
+    return _decoder ? _decoder->lastFixturesDecoded() : 0;
+}
+
+- (uint64_t)packetCount {
+    return _ingest ? _ingest->dmxPackets() : 0;
+}
+
+- (uint64_t)invalidPacketCount {
+    return _ingest ? _ingest->invalidPackets() : 0;
+}
+
+- (uint64_t)unmappedPacketCount {
+    return _ingest ? _ingest->unmappedPackets() : 0;
+}
+
+- (uint64_t)duplicatePacketCount {
+    return _ingest ? _ingest->duplicatePackets() : 0;
+}
+
+- (NSArray<GDReceiveShard *> *)receiveShards {
+    if (!_ingest) return @[];
+
+    uint64_t now = RocKontrol::dmxClockNs();
+    NSMutableArray<GDReceiveShard *> *result = [NSMutableArray array];
+    for (const RocKontrol::DMXShardStats& info : _ingest->shards()) {
+        GDReceiveShard *shard = [[GDReceiveShard alloc] init];
+        shard.index = info.index;
+        shard.firstUniverse = info.first_universe;
+        shard.lastUniverse = info.last_universe;
+        shard.readsArtNet = info.art_net;
+        shard.socketCount = info.sockets;
+        shard.packetCount = info.packets;
+        shard.batchCount = info.batches;
+        shard.secondsSinceLastPacket = info.last_packet_ns && now > info.last_packet_ns
+            ? (double)(now - info.last_packet_ns) / 1e9 : 0.0;
+        [result addObject:shard];
+    }
+    return result;
+}
+
+- (uint64_t)receiveBatchCount {
+    return _ingest ? _ingest->receiveBatches() : 0;
+}
+
+- (NSDate *)lastPacketTime {
+    uint64_t last = _ingest ? _ingest->lastPacketNs() : 0;
+    if (last == 0) return [NSDate distantPast];
+
+    // Ingest timestamps are monotonic - convert via the age of the packet
+    uint64_t now = RocKontrol::dmxClockNs();
+    double age = now > last ? (double)(now - last) / 1e9 : 0.0;
+    return [NSDate dateWithTimeIntervalSinceNow:-age];
+}
+
+- (BOOL)startCaptureToPath:(NSString *)path {
+    if (!_ingest || !_capture) return NO;
+    _ingest->setCapture(nullptr);
+    if (!_capture->open([path fileSystemRepresentation])) return NO;
+    _ingest->setCapture(_capture.get());
+    return YES;
+}
+
+- (void)stopCapture {
+    if (!_ingest || !_capture) return;
+    _ingest->setCapture(nullptr);
+    _capture->close();
+}
+
+- (BOOL)isCapturing {
+    return _capture ? _capture->isOpen() : NO;
+}
+
+- (uint64_t)capturePacketCount {
+    return _capture ? _capture->packets() : 0;
+}
+
+- (uint64_t)captureByteCount {
+    return _capture ? _capture->bytes() : 0;
+}
+
+- (uint64_t)captureWriteErrorCount {
+    return _capture ? _capture->writeErrors() : 0;
+}
+
+- (BOOL)startReplayFromPath:(NSString *)path speed:(double)speed loop:(BOOL)loop {
+    if (!_ingest || !_replayer) return NO;
+    [self stopReplay];
+    if (!_replayer->open([path fileSystemRepresentation])) return NO;
+
+    // The replay thread is the only ingest caller while it runs
+    _resumeAfterReplay = _ingest->isRunning();
+    _ingest->stop();
+    if (_replayer->start(speed, loop)) return YES;
+
+    [self stopReplay];
+    return NO;
+}
+
+- (void)stopReplay {
+    if (!_ingest || !_replayer) return;
+    _replayer->stop();
+    // Replayed packets carry timestamps up to the capture's length ahead of the
+    // clock at speed 0 or > 1; live input must not be judged against them
+    _ingest->resetSenders();
+    if (_resumeAfterReplay) {
+        _resumeAfterReplay = NO;
+        _ingest->start();
+    }
+}
+
+- (BOOL)isReplaying {
+    return _replayer ? _replayer->isRunning() : NO;
+}
+
+- (uint64_t)replayRecordCount {
+    return _replayer ? _replayer->recordCount() : 0;
+}
+
+- (double)replayDuration {
+    return _replayer ? (double)_replayer->durationNs() / 1e9 : 0.0;
+}
+
+- (uint64_t)replayPacketCount {
+    return _replayer ? _replayer->packetsReplayed() : 0;
+}
+
+- (uint64_t)replayLoopCount {
+    return _replayer ? _replayer->loops() : 0;
+}
+
+- (double)replayPacketsPerSecond {
+    uint64_t elapsed = _replayer ? _replayer->elapsedNs() : 0;
+    return elapsed ? (double)_replayer->packetsReplayed() * 1e9 / (double)elapsed : 0.0;
+}
+
+- (NSArray<GDUniverseStats *> *)universeStats {
+    if (!_ingest) return @[];
+
+    uint64_t now = RocKontrol::dmxClockNs();
+    NSMutableArray<GDUniverseStats *> *result = [NSMutableArray array];
+    for (const RocKontrol::DMXUniverseStats& info : _ingest->stats().universes()) {
+        GDUniverseStats *stats = [[GDUniverseStats alloc] init];
+        stats.universe = info.universe;
+        stats.protocol = info.wire == RocKontrol::DMXWire::ArtNet ? GDDMXProtocolArtNet : GDDMXProtocolSACN;
+        stats.packetCount = info.packets;
+        stats.packetsPerSecond = info.rate_hz;
+        stats.interval = (double)info.interval_ns / 1e9;
+        stats.jitter = (double)info.jitter_ns / 1e9;
+        stats.jitterHistogram = histogramArray(info.jitter_histogram);
+        stats.sequenceGapCount = info.sequence_gaps;
+        stats.secondsSinceLastPacket = now > info.last_packet_ns ? (double)(now - info.last_packet_ns) / 1e9 : 0.0;
+        stats.frameCount = info.frames;
+        stats.latency = (double)info.latency_last_ns / 1e9;
+        stats.latencyMean = (double)info.latency_mean_ns / 1e9;
+        stats.latencyMax = (double)info.latency_max_ns / 1e9;
+        stats.latencyHistogram = histogramArray(info.latency_histogram);
+        [result addObject:stats];
+    }
+    return result;
+}
+
++ (NSArray<NSNumber *> *)timingHistogramLimits {
+    NSMutableArray<NSNumber *> *result = [NSMutableArray arrayWithCapacity:RocKontrol::kTimingBuckets];
+    for (uint32_t i = 0; i < RocKontrol::kTimingBuckets; i++) {
+        uint64_t limit = RocKontrol::timingBucketLimitNs(i);
+        [result addObject:@((double)limit / 1e9)];
+    }
+    return result;
+}
+
+- (NSArray<GDSACNSource *> *)sacnSources {
+    if (!_ingest) return @[];
+
+    uint64_t now = RocKontrol::dmxClockNs();
+    NSMutableArray<GDSACNSource *> *result = [NSMutableArray array];
+    for (const RocKontrol::SACNSourceInfo& info : _ingest->sacnMerger().sources()) {
+        GDSACNSource *source = [[GDSACNSource alloc] init];
+        source.cid = [[[NSUUID alloc] initWithUUIDBytes:info.cid.data()] UUIDString];
+        source.name = [NSString stringWithUTF8String:info.name.c_str()] ?: @"";
+        source.universe = info.universe;
+        source.priority = info.priority;
+        source.winning = info.winning;
+        source.packetCount = info.packets;
+        source.sequenceErrorCount = info.sequence_errors;
+        source.duplicateCount = info.duplicates;
+        source.sequenceGapCount = info.sequence_gaps;
+        source.secondsSinceLastPacket = now > info.last_seen_ns ? (double)(now - info.last_seen_ns) / 1e9 : 0.0;
+        source.packetsPerSecond = info.rate_hz;
+        source.jitter = (double)info.jitter_ns / 1e9;
+        [result addObject:source];
+    }
+    return result;
+}
+
+- (NSInteger)sacnActiveSourceCount {
+    return _ingest ? _ingest->sacnMerger().activeSources() : 0;
+}
+
+- (uint64_t)sacnSequenceErrorCount {
+    return _ingest ? _ingest->sacnMerger().sequenceErrors() : 0;
+}
+
+- (uint64_t)sacnSourcesTimedOut {
+    return _ingest ? _ingest->sacnMerger().sourcesTimedOut() : 0;
+}
+
+- (uint64_t)syncLatchedFrameCount {
+    return _ingest ? _ingest->syncLatch().latchedFrames() : 0;
+}
+
+- (uint64_t)syncLatchedUniverseCount {
+    return _ingest ? _ingest->syncLatch().latchedUniverses() : 0;
+}
+
+- (uint64_t)unsyncedUniverseCount {
+    return _ingest ? _ingest->syncLatch().unsyncedWrites() : 0;
+}
+
+- (uint64_t)syncTimeoutCount {
+    return _ingest ? _ingest->syncLatch().syncTimeouts() : 0;
+}
+
+@end
@@ -0,0 +1,266 @@
+// dmx_capture.cpp - Art-Net / sACN packet capture and replay
+// Portable C++ over POSIX files and mmap (macOS and Linux)
+
+#include "dmx_capture.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace RocKontrol {
+
+namespace {
+
+constexpr size_t kWriteBufferBytes = 1 << 20;
+constexpr uint32_t kMaxSpeedNotifyInterval = 32;    // Packets between decode wakeups at max speed
+constexpr uint64_t kMaxSleepNs = 50000000;          // Long recorded gaps sleep in steps so stop() stays prompt
+
+inline size_t paddedLength(size_t length) {
+    return (length + 7) & ~(size_t)7;
+}
+
+} // namespace
+
+// DMXCaptureWriter
+
+DMXCaptureWriter::~DMXCaptureWriter() {
+    close();
+}
+
+bool DMXCaptureWriter::open(const std::string& path) {
+    close();
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    file_ = fopen(path.c_str(), "wb");
+    if (!file_) {
+        fprintf(stderr, "DMXEngine: Could not open capture file %s\n", path.c_str());
+        return false;
+    }
+    setvbuf(file_, nullptr, _IOFBF, kWriteBufferBytes);
+
+    DMXCaptureHeader header = {};
+    memcpy(header.magic, kCaptureMagic, sizeof(header.magic));
+    header.version = kCaptureVersion;
+    header.header_size = sizeof(DMXCaptureHeader);
+    header.start_unix_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    if (fwrite(&header, sizeof(header), 1, file_) != 1) {
+        fprintf(stderr, "DMXEngine: Could not write capture file %s\n", path.c_str());
+        fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+
+    first_ns_ = 0;
+    packets_.store(0, std::memory_order_relaxed);
+    write_errors_.store(0, std::memory_order_relaxed);
+    bytes_.store(sizeof(header), std::memory_order_relaxed);
+    recording_.store(true);
+    return true;
+}
+
+void DMXCaptureWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    recording_.store(false);
+    if (file_) {
+        // Whatever was still buffered is written here
+        if (fclose(file_) != 0) {
+            write_errors_.fetch_add(1, std::memory_order_relaxed);
+            fprintf(stderr, "DMXEngine: Capture file did not flush on close: %s\n", strerror(errno));
+        }
+        file_ = nullptr;
+    }
+}
+
+void DMXCaptureWriter::record(DMXWire wire, const uint8_t* data, size_t length, uint64_t timestampNs,
+                              uint32_t sourceAddress) {
+    if (!recording_.load(std::memory_order_relaxed) || length == 0 || length > 0xFFFF) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) return;
+    if (first_ns_ == 0) first_ns_ = timestampNs;
+
+    DMXCaptureRecord record = {};
+    record.time_ns = timestampNs >= first_ns_ ? timestampNs - first_ns_ : 0;
+    record.length = (uint16_t)length;
+    record.wire = (uint8_t)wire;
+    record.source_address = sourceAddress;
+
+    static const uint8_t kPad[8] = {};
+    size_t pad = paddedLength(length) - length;
+    bool written = fwrite(&record, sizeof(record), 1, file_) == 1 && fwrite(data, 1, length, file_) == length &&
+                   (!pad || fwrite(kPad, 1, pad, file_) == pad);
+    if (!written) {
+        // Report the first failure, count every one
+        if (write_errors_.fetch_add(1, std::memory_order_relaxed) == 0) {
+            fprintf(stderr, "DMXEngine: Capture write failed: %s\n", strerror(errno));
+        }
+        return;
+    }
+
+    packets_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(sizeof(record) + length + pad, std::memory_order_relaxed);
+}
+
+// DMXReplayer
+
+DMXReplayer::DMXReplayer(DMXIngest& ingest) : ingest_(ingest) {}
+
+DMXReplayer::~DMXReplayer() {
+    close();
+}
+
+bool DMXReplayer::open(const std::string& path) {
+    close();
+
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        fprintf(stderr, "DMXEngine: Could not open capture file %s\n", path.c_str());
+        return false;
+    }
+
+    struct stat st = {};
+    if (fstat(fd_, &st) != 0 || (size_t)st.st_size < sizeof(DMXCaptureHeader)) {
+        fprintf(stderr, "DMXEngine: %s is not a capture file\n", path.c_str());
+        close();
+        return false;
+    }
+
+    map_size_ = (size_t)st.st_size;
+    void* map = mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "DMXEngine: Could not map capture file %s\n", path.c_str());
+        map_size_ = 0;
+        close();
+        return false;
+    }
+    map_ = static_cast<const uint8_t*>(map);
+
+    DMXCaptureHeader header;
+    memcpy(&header, map_, sizeof(header));
+    if (memcmp(header.magic, kCaptureMagic, sizeof(header.magic)) != 0 || header.version != kCaptureVersion ||
+        header.header_size < sizeof(header) || header.header_size > map_size_) {
+        fprintf(stderr, "DMXEngine: %s is not a version %u capture file\n", path.c_str(), kCaptureVersion);
+        close();
+        return false;
+    }
+
+    // Walk once: count records and make sure the last one is complete
+    size_t offset = header.header_size;
+    while (offset + sizeof(DMXCaptureRecord) <= map_size_) {
+        DMXCaptureRecord record;
+        memcpy(&record, map_ + offset, sizeof(record));
+        if (offset + sizeof(record) + record.length > map_size_) break;
+        record_count_++;
+        duration_ns_ = record.time_ns;
+        offset += sizeof(record) + paddedLength(record.length);
+    }
+    // A torn last record (recording still running or killed) is left out
+    data_end_ = std::min(offset, map_size_);
+    return true;
+}
+
+void DMXReplayer::close() {
+    stop();
+    if (map_) {
+        munmap(const_cast<uint8_t*>(map_), map_size_);
+        map_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    map_size_ = 0;
+    data_end_ = 0;
+    record_count_ = 0;
+    duration_ns_ = 0;
+}
+
+bool DMXReplayer::start(double speed, bool loop) {
+    stop();
+    if (!map_ || record_count_ == 0 || speed < 0) return false;
+
+    should_stop_.store(false);
+    packets_.store(0, std::memory_order_relaxed);
+    loops_.store(0, std::memory_order_relaxed);
+    started_ns_.store(dmxClockNs(), std::memory_order_relaxed);
+    finished_ns_.store(0, std::memory_order_relaxed);
+    running_.store(true);
+    thread_ = std::thread(&DMXReplayer::replayLoop, this, speed, loop);
+    return true;
+}
+
+void DMXReplayer::stop() {
+    should_stop_.store(true);
+    if (thread_.joinable()) thread_.join();
+    running_.store(false);
+}
+
+uint64_t DMXReplayer::elapsedNs() const {
+    uint64_t started = started_ns_.load(std::memory_order_relaxed);
+    if (started == 0) return 0;
+    uint64_t finished = finished_ns_.load(std::memory_order_relaxed);
+    return (finished ? finished : dmxClockNs()) - started;
+}
+
+void DMXReplayer::replayLoop(double speed, bool loop) {
+    const size_t start = reinterpret_cast<const DMXCaptureHeader*>(map_)->header_size;
+    uint64_t clock = dmxClockNs();  // Replay time of the current pass's first record
+
+    do {
+        uint64_t pending = 0;
+        uint64_t lastTime = 0;
+
+        for (size_t offset = start; offset + sizeof(DMXCaptureRecord) <= data_end_;) {
+            if (should_stop_.load(std::memory_order_relaxed)) break;
+
+            DMXCaptureRecord record;
+            memcpy(&record, map_ + offset, sizeof(record));
+            const uint8_t* payload = map_ + offset + sizeof(record);
+            offset += sizeof(record) + paddedLength(record.length);
+            lastTime = record.time_ns;
+
+            uint64_t due = clock + (speed > 0 ? (uint64_t)((double)record.time_ns / speed) : record.time_ns);
+            if (speed > 0) {
+                // Wake the decoder for what went in before sleeping
+                uint64_t now = dmxClockNs();
+                if (due > now && pending) {
+                    ingest_.notifyUpdate();
+                    pending = 0;
+                }
+                while (due > now && !should_stop_.load(std::memory_order_relaxed)) {
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(std::min(due - now, kMaxSleepNs)));
+                    now = dmxClockNs();
+                }
+                if (should_stop_.load(std::memory_order_relaxed)) break;
+            }
+
+            ingest_.ingest(record.wire == (uint8_t)DMXWire::SACN ? DMXWire::SACN : DMXWire::ArtNet,
+                           payload, record.length, due, record.source_address);
+            packets_.fetch_add(1, std::memory_order_relaxed);
+
+            if (++pending >= kMaxSpeedNotifyInterval) {
+                ingest_.notifyUpdate();
+                pending = 0;
+            }
+        }
+
+        if (pending) ingest_.notifyUpdate();
+        if (should_stop_.load(std::memory_order_relaxed)) break;
+
+        // Next pass continues the timeline (one nominal packet gap after the last
+        // record). Its senders start their sequence numbers over.
+        clock += (speed > 0 ? (uint64_t)((double)lastTime / speed) : lastTime) + 1000000;
+        loops_.fetch_add(1, std::memory_order_relaxed);
+        if (loop) ingest_.resetSenders();
+    } while (loop);
+
+    finished_ns_.store(dmxClockNs(), std::memory_order_relaxed);
+    running_.store(false);
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,130 @@
+// dmx_capture.h - Art-Net / sACN packet capture and replay
+// DMXCaptureWriter appends every datagram the receive thread reads to a
+// capture file; DMXReplayer memory-maps one and feeds it back through
+// DMXIngest::ingest() at recorded speed, N times faster, or as fast as the
+// ingest path takes it (load generation / profiling with real show data).
+//
+// File layout (little-endian, every record 8-byte aligned so the mapped file
+// is read in place):
+//   DMXCaptureHeader                       32 bytes
+//   { DMXCaptureRecord, payload, pad }     repeated to end of file
+
+#pragma once
+
+#include "dmx_ingest.h"
+#include "dmx_protocol.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace RocKontrol {
+
+constexpr char kCaptureMagic[8] = {'R', 'K', 'D', 'M', 'X', 'C', 'A', 'P'};
+constexpr uint32_t kCaptureVersion = 1;
+
+struct DMXCaptureHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;           // sizeof(DMXCaptureHeader) - records start here
+    uint64_t start_unix_ns;         // Wall clock when recording started
+    uint64_t reserved;
+};
+
+struct DMXCaptureRecord {
+    uint64_t time_ns;               // Since the first record
+    uint16_t length;                // Payload bytes (payload padded to 8)
+    uint8_t wire;                   // DMXWire
+    uint8_t reserved;
+    uint32_t source_address;        // Sender IPv4, host order (0 = unknown, as in older captures)
+};
+
+static_assert(sizeof(DMXCaptureHeader) == 32, "capture header layout");
+static_assert(sizeof(DMXCaptureRecord) == 16, "capture record layout");
+
+class DMXCaptureWriter {
+public:
+    DMXCaptureWriter() = default;
+    ~DMXCaptureWriter();
+
+    DMXCaptureWriter(const DMXCaptureWriter&) = delete;
+    DMXCaptureWriter& operator=(const DMXCaptureWriter&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return recording_.load(); }
+
+    // Append one datagram (receive thread). No-op when closed.
+    void record(DMXWire wire, const uint8_t* data, size_t length, uint64_t timestampNs, uint32_t sourceAddress = 0);
+
+    uint64_t packets() const { return packets_.load(std::memory_order_relaxed); }
+    uint64_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+    // Records that did not reach the file (disk full, I/O error), including a
+    // failed flush on close(). Not counted in packets() / bytes().
+    uint64_t writeErrors() const { return write_errors_.load(std::memory_order_relaxed); }
+
+private:
+    std::mutex mutex_;
+    FILE* file_ = nullptr;
+    uint64_t first_ns_ = 0;
+    std::atomic<bool> recording_{false};
+    std::atomic<uint64_t> packets_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> write_errors_{0};
+};
+
+class DMXReplayer {
+public:
+    explicit DMXReplayer(DMXIngest& ingest);
+    ~DMXReplayer();
+
+    DMXReplayer(const DMXReplayer&) = delete;
+    DMXReplayer& operator=(const DMXReplayer&) = delete;
+
+    // Map a capture file and check every record fits (stops any replay first)
+    bool open(const std::string& path);
+    void close();
+
+    // speed: 1 = as recorded, N = N times faster, 0 = as fast as possible.
+    // Packets are stamped with the replay clock at recorded spacing / speed, so
+    // source and sync timeouts behave as they did live at any speed. Each loop
+    // pass starts with DMXIngest::resetSenders(), so the restarted sequence
+    // numbers are not taken for late or duplicate packets.
+    bool start(double speed, bool loop);
+    void stop();
+    bool isRunning() const { return running_.load(); }
+
+    // Capture file
+    uint64_t recordCount() const { return record_count_; }
+    uint64_t durationNs() const { return duration_ns_; }
+
+    // Statistics for the current / last run
+    uint64_t packetsReplayed() const { return packets_.load(std::memory_order_relaxed); }
+    uint64_t loops() const { return loops_.load(std::memory_order_relaxed); }
+    uint64_t elapsedNs() const;
+
+private:
+    void replayLoop(double speed, bool loop);
+
+    DMXIngest& ingest_;
+
+    int fd_ = -1;
+    const uint8_t* map_ = nullptr;
+    size_t map_size_ = 0;
+    size_t data_end_ = 0;           // End of the last complete record
+    uint64_t record_count_ = 0;
+    uint64_t duration_ns_ = 0;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> should_stop_{false};
+    std::atomic<uint64_t> packets_{0};
+    std::atomic<uint64_t> loops_{0};
+    std::atomic<uint64_t> started_ns_{0};
+    std::atomic<uint64_t> finished_ns_{0};
+};
+
+} // namespace RocKontrol
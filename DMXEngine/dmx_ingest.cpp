@@ -0,0 +1,418 @@
+// dmx_ingest.cpp - Art-Net / sACN receive loop
+// Portable C++ over BSD sockets (macOS and Linux)
+
+#include "dmx_ingest.h"
+#include "dmx_capture.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace RocKontrol {
+
+namespace {
+constexpr int kPollTimeoutMs = 100;     // stop() latency
+constexpr uint64_t kExpireIntervalNs = 100000000ull;
+}
+
+// One batch worth of datagram buffers; recvmmsg headers on Linux
+struct DMXIngest::ReceiveBatch {
+    explicit ReceiveBatch(uint32_t count) : data(count * kMaxDMXDatagram), lengths(count), from(count) {
+#ifdef __linux__
+        iov.resize(count);
+        msgs.resize(count);
+        for (uint32_t i = 0; i < count; i++) {
+            iov[i].iov_base = buffer(i);
+            iov[i].iov_len = kMaxDMXDatagram;
+            msgs[i] = {};
+            msgs[i].msg_hdr.msg_name = &from[i];
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+#endif
+    }
+
+    uint8_t* buffer(uint32_t i) { return data.data() + (size_t)i * kMaxDMXDatagram; }
+    uint32_t size() const { return (uint32_t)lengths.size(); }
+    uint32_t source(uint32_t i) const { return ntohl(from[i].sin_addr.s_addr); }
+
+    std::vector<uint8_t> data;
+    std::vector<size_t> lengths;
+    std::vector<sockaddr_in> from;          // Sender of each datagram
+#ifdef __linux__
+    std::vector<iovec> iov;
+    std::vector<mmsghdr> msgs;
+#endif
+};
+
+DMXIngest::DMXIngest(UniverseStore& store) : latch_(store), merger_(latch_) {}
+
+DMXIngest::~DMXIngest() {
+    stop();
+}
+
+bool DMXIngest::configure(const DMXIngestConfig& config) {
+    if (running_.load()) return false;
+    config_ = config;
+    config_.batch_size = std::max<uint32_t>(1, config_.batch_size);
+    return true;
+}
+
+bool DMXIngest::start() {
+    if (running_.load()) return true;
+
+    std::vector<std::string> interfaces = config_.interfaces;
+    if (interfaces.empty()) interfaces.push_back("0.0.0.0");
+
+    // Unicast cannot be split by group - loopback reads everything on one shard
+    uint32_t groupCount = std::max<uint16_t>(1, config_.universe_count);
+    uint32_t shardCount = config_.loopback ? 1 : std::min({std::max<uint32_t>(1, config_.shards), kMaxShards, groupCount});
+
+    // sACN groups are named by sACN universe - undo the store mapping
+    int32_t firstGroup = std::max(1, (int32_t)config_.start_universe - config_.sacn_universe_offset);
+    int32_t lastGroup = std::min(63999, (int32_t)config_.start_universe - config_.sacn_universe_offset + (int32_t)groupCount - 1);
+
+    for (uint32_t i = 0; i < shardCount; i++) {
+        auto shard = std::make_unique<Shard>();
+        shard->index = i;
+
+        if (config_.art_net && i == 0) {
+            // Art-Net is broadcast - every shard's socket would get a copy, so one shard reads it
+            for (const std::string& interface : interfaces) {
+                int fd = bindSocket(kArtNetPort, false, interface);
+                if (fd < 0) {
+                    fprintf(stderr, "DMXEngine: Failed to bind Art-Net port %u on %s\n", kArtNetPort, interface.c_str());
+                    continue;
+                }
+                shard->sockets.push_back({fd, DMXWire::ArtNet});
+                shard->art_net = true;
+                fprintf(stderr, "DMXEngine: Art-Net listening on port %u, interface %s\n", kArtNetPort, interface.c_str());
+                if (interface.empty() || interface == "0.0.0.0") break;
+            }
+        }
+
+        if (config_.sacn && config_.loopback) {
+            // Loopback senders unicast to us
+            for (const std::string& interface : interfaces) {
+                int fd = bindSocket(kSACNPort, false, interface);
+                if (fd < 0) {
+                    fprintf(stderr, "DMXEngine: Failed to bind sACN port %u on %s\n", kSACNPort, interface.c_str());
+                    continue;
+                }
+                shard->sockets.push_back({fd, DMXWire::SACN});
+                fprintf(stderr, "DMXEngine: sACN listening on port %u (unicast), interface %s\n", kSACNPort, interface.c_str());
+                if (interface.empty() || interface == "0.0.0.0") break;
+            }
+        } else if (config_.sacn && firstGroup <= lastGroup) {
+            // Multicast: one socket per shard joining its range of groups on every interface
+            uint32_t span = (uint32_t)(lastGroup - firstGroup + 1);
+            int32_t first = firstGroup + (int32_t)(span * i / shardCount);
+            int32_t last = firstGroup + (int32_t)(span * (i + 1) / shardCount) - 1;
+
+            int fd = first <= last ? bindSocket(kSACNPort, true, interfaces[0]) : -1;
+            if (fd >= 0) {
+                for (int32_t universe = first; universe <= last; universe++) {
+                    joinGroup(fd, (uint16_t)universe);
+                }
+                shard->sockets.push_back({fd, DMXWire::SACN});
+                shard->first_group = (uint16_t)first;
+                shard->last_group = (uint16_t)last;
+                fprintf(stderr, "DMXEngine: sACN shard %u listening on port %u (multicast U%d-U%d), %zu interface(s)\n",
+                        i, kSACNPort, first, last, interfaces.size());
+            } else if (first <= last) {
+                fprintf(stderr, "DMXEngine: Failed to bind sACN port %u\n", kSACNPort);
+            }
+        }
+
+        if (!shard->sockets.empty()) shards_.push_back(std::move(shard));
+    }
+
+    if (shards_.empty()) return false;
+
+    should_stop_.store(false);
+    running_.store(true);
+    for (auto& shard : shards_) {
+        shard->batch = std::make_unique<ReceiveBatch>(config_.batch_size);
+        shard->thread = std::thread(&DMXIngest::receiveLoop, this, std::ref(*shard));
+    }
+    return true;
+}
+
+void DMXIngest::stop() {
+    if (!running_.load()) return;
+
+    should_stop_.store(true);
+    for (auto& shard : shards_) {
+        if (shard->thread.joinable()) shard->thread.join();
+    }
+    closeSockets();
+    sync_group_count_.store(0);
+    running_.store(false);
+}
+
+std::vector<DMXShardStats> DMXIngest::shards() const {
+    std::vector<DMXShardStats> result;
+    for (const auto& shard : shards_) {
+        DMXShardStats info;
+        info.index = shard->index;
+        if (shard->first_group != 0) {
+            info.first_universe = (uint16_t)std::max(0, (int32_t)shard->first_group + config_.sacn_universe_offset);
+            info.last_universe = (uint16_t)std::max(0, (int32_t)shard->last_group + config_.sacn_universe_offset);
+        }
+        info.art_net = shard->art_net;
+        info.sockets = (uint32_t)shard->sockets.size();
+        info.packets = shard->packets.load(std::memory_order_relaxed);
+        info.batches = shard->batches.load(std::memory_order_relaxed);
+        info.last_packet_ns = shard->last_packet_ns.load(std::memory_order_relaxed);
+        result.push_back(info);
+    }
+    return result;
+}
+
+// Sockets
+
+int DMXIngest::bindSocket(uint16_t port, bool multicast, const std::string& interface) {
+    int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd < 0) {
+        fprintf(stderr, "DMXEngine: socket() failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    int yes = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes));
+    setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &yes, sizeof(yes));
+
+    // Room for a full refresh of every universe while the loop is busy
+    int rcvbuf = (int)config_.socket_buffer_bytes;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    sockaddr_in addr = {};
+#ifdef __APPLE__
+    addr.sin_len = sizeof(addr);
+#endif
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+
+    // Multicast binds to INADDR_ANY - the interfaces are selected by IP_ADD_MEMBERSHIP
+    if (multicast || interface.empty() || interface == "0.0.0.0") {
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    } else {
+        addr.sin_addr.s_addr = inet_addr(interface.c_str());
+    }
+
+#ifdef IP_MULTICAST_ALL
+    // Linux delivers every group joined by any socket on the port unless told
+    // otherwise; a shard must only see its own groups
+    if (multicast) {
+        int no = 0;
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_ALL, &no, sizeof(no));
+    }
+#endif
+
+    if (bind(fd, (const sockaddr*)&addr, sizeof(addr)) != 0) {
+        fprintf(stderr, "DMXEngine: Bind failed on port %u: %s\n", port, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    return fd;
+}
+
+void DMXIngest::joinGroup(int fd, uint16_t universe) {
+    // sACN universe N lives on 239.255.<N hi>.<N lo>, joined on every interface
+    ip_mreq mreq = {};
+    mreq.imr_multiaddr.s_addr = htonl(0xEFFF0000u | universe);
+
+    for (const std::string& interface : config_.interfaces) {
+        if (interface.empty() || interface == "0.0.0.0") {
+            mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+        } else {
+            mreq.imr_interface.s_addr = inet_addr(interface.c_str());
+        }
+
+        if (setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0) {
+            fprintf(stderr, "DMXEngine: Failed to join multicast group 239.255.%u.%u on %s: %s\n",
+                    universe >> 8, universe & 0xFF, interface.c_str(), strerror(errno));
+        }
+    }
+    if (config_.interfaces.empty()) {
+        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+        setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq));
+    }
+}
+
+void DMXIngest::closeSockets() {
+    for (auto& shard : shards_) {
+        for (const Socket& socket : shard->sockets) {
+            close(socket.fd);
+        }
+    }
+    shards_.clear();
+}
+
+// Receive loop
+
+void DMXIngest::receiveLoop(Shard& shard) {
+    std::vector<pollfd> fds(shard.sockets.size());
+    for (size_t i = 0; i < fds.size(); i++) {
+        fds[i].fd = shard.sockets[i].fd;
+        fds[i].events = POLLIN;
+    }
+
+    while (!should_stop_.load()) {
+        int ready = poll(fds.data(), (nfds_t)fds.size(), kPollTimeoutMs);
+        if (ready <= 0) {
+            // Quiet network - sources still have to time out
+            expireSources(dmxClockNs());
+            if (update_handler_) update_handler_();
+            continue;
+        }
+
+        for (size_t i = 0; i < fds.size(); i++) {
+            if (fds[i].revents & POLLIN) drain(shard, shard.sockets[i]);
+        }
+        if (update_handler_) update_handler_();
+    }
+}
+
+// Read until the socket would block, one batch per system call where the platform allows
+void DMXIngest::drain(Shard& shard, const Socket& socket) {
+    ReceiveBatch& batch = *shard.batch;
+
+    for (;;) {
+        uint32_t received = 0;
+#ifdef __linux__
+        for (auto& msg : batch.msgs) msg.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        int n = recvmmsg(socket.fd, batch.msgs.data(), batch.size(), MSG_DONTWAIT, nullptr);
+        if (n <= 0) return;
+        received = (uint32_t)n;
+        for (uint32_t i = 0; i < received; i++) {
+            batch.lengths[i] = batch.msgs[i].msg_len;
+        }
+#else
+        while (received < batch.size()) {
+            socklen_t fromLength = sizeof(sockaddr_in);
+            ssize_t len = recvfrom(socket.fd, batch.buffer(received), kMaxDMXDatagram, MSG_DONTWAIT,
+                                   (sockaddr*)&batch.from[received], &fromLength);
+            if (len <= 0) break;
+            batch.lengths[received++] = (size_t)len;
+        }
+        if (received == 0) return;
+#endif
+
+        uint64_t now = dmxClockNs();
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        shard.batches.fetch_add(1, std::memory_order_relaxed);
+        shard.packets.fetch_add(received, std::memory_order_relaxed);
+        shard.last_packet_ns.store(now, std::memory_order_relaxed);
+        DMXCaptureWriter* capture = capture_.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < received; i++) {
+            if (capture) capture->record(socket.wire, batch.buffer(i), batch.lengths[i], now, batch.source(i));
+            ingest(socket.wire, batch.buffer(i), batch.lengths[i], now, batch.source(i));
+        }
+
+        if (received < batch.size()) return;
+    }
+}
+
+void DMXIngest::ingest(DMXWire wire, const uint8_t* data, size_t length, uint64_t timestampNs,
+                       uint32_t sourceAddress) {
+    packets_.fetch_add(1, std::memory_order_relaxed);
+    expireSources(timestampNs);
+
+    DMXPacket packet;
+    DMXPacketType type = parseDMXPacket(wire, data, length, packet);
+    if (type == DMXPacketType::Invalid) {
+        invalid_packets_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (type == DMXPacketType::Sync) {
+        latch_.sync(wire == DMXWire::ArtNet ? SyncLatch::kArtSyncDomain : packet.universe, timestampNs);
+        return;
+    }
+    if (type != DMXPacketType::Dmx) return;
+
+    // One store universe per wire universe (see DMXIngestConfig offsets)
+    int32_t offset = wire == DMXWire::ArtNet ? config_.art_net_universe_offset : config_.sacn_universe_offset;
+    int32_t universe = (int32_t)packet.universe + offset;
+    if (universe < 0 || universe >= (int32_t)UniverseStore::kUniverseRange) {
+        unmapped_packets_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    packet.universe = (uint16_t)universe;
+
+    if (wire == DMXWire::ArtNet) {
+        // The sender's sequence number again: its datagram read on a second interface
+        if (!stats_.recordPacket(wire, packet.universe, packet.sequence, timestampNs, sourceAddress)) {
+            duplicate_packets_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (!latch_.write(packet.universe, packet.slots, packet.slotCount, timestampNs, SyncLatch::kArtSyncDomain)) {
+            store_full_.fetch_add(1, std::memory_order_relaxed);
+        }
+    } else {
+        if (packet.syncAddress != 0) joinSyncGroup(packet.syncAddress);
+        if (!merger_.apply(packet, timestampNs)) return;
+        stats_.recordPacket(wire, packet.universe, packet.sequence, timestampNs);
+    }
+
+    dmx_packets_.fetch_add(1, std::memory_order_relaxed);
+    last_packet_ns_.store(timestampNs, std::memory_order_relaxed);
+}
+
+void DMXIngest::resetSenders() {
+    merger_.reset();
+    latch_.reset();
+    stats_.resetSequences();
+    last_expire_ns_.store(0, std::memory_order_relaxed);
+}
+
+void DMXIngest::expireSources(uint64_t nowNs) {
+    uint64_t last = last_expire_ns_.load(std::memory_order_relaxed);
+    if (nowNs - last < kExpireIntervalNs && nowNs >= last) return;
+    // One shard sweeps per interval
+    if (!last_expire_ns_.compare_exchange_strong(last, nowNs, std::memory_order_relaxed)) return;
+    merger_.expire(nowNs);
+    latch_.expire(nowNs);
+}
+
+// Sync packets go to the synchronization address's own multicast group
+void DMXIngest::joinSyncGroup(uint16_t syncAddress) {
+    // Nothing to join while stopped (replayed captures call ingest() directly)
+    if (config_.loopback || !running_.load(std::memory_order_relaxed)) return;
+    uint32_t count = sync_group_count_.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; i++) {
+        if (sync_groups_[i].load(std::memory_order_relaxed) == syncAddress) return;
+    }
+
+    std::lock_guard<std::mutex> lock(sync_group_mutex_);
+    count = sync_group_count_.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < count; i++) {
+        if (sync_groups_[i].load(std::memory_order_relaxed) == syncAddress) return;
+    }
+    if (count >= sync_groups_.size()) return;
+
+    // Joined once, on the first shard with an sACN socket, which then reads the
+    // sync packets for every shard. A sync packet only calls SyncLatch::sync()
+    // (locked), and one per frame is too little traffic to be worth spreading.
+    for (const auto& shard : shards_) {
+        for (const Socket& socket : shard->sockets) {
+            if (socket.wire != DMXWire::SACN) continue;
+            joinGroup(socket.fd, syncAddress);
+            sync_groups_[count].store(syncAddress, std::memory_order_relaxed);
+            sync_group_count_.store(count + 1, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,187 @@
+// dmx_ingest.h - Art-Net / sACN receive loop
+// Receive is split into shards, one thread each, that poll their own sockets
+// and drain them in batches (recvmmsg on Linux) into preallocated datagram
+// buffers; DMX slots go from those buffers straight into a UniverseStore. The
+// sACN multicast groups are split into contiguous ranges, one SO_REUSEPORT
+// socket per shard that only joins its range, so no single thread reads every
+// universe. Every socket listens on each configured interface, so primary and
+// backup lighting networks feed the same store. sACN goes through a
+// SACNMerger (which also drops the second copy of a packet seen on both
+// networks), and both protocols through a SyncLatch for ArtSync / E1.31 sync.
+// E1.31 sync addresses are joined on one shard only (see joinSyncGroup).
+// Every DMX packet is timed per universe and wire in DMXStats.
+
+#pragma once
+
+#include "dmx_protocol.h"
+#include "dmx_stats.h"
+#include "sacn_merger.h"
+#include "sync_latch.h"
+#include "universe_store.h"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RocKontrol {
+
+class DMXCaptureWriter;
+
+struct DMXIngestConfig {
+    bool art_net = true;
+    bool sacn = true;
+    std::vector<std::string> interfaces = {"0.0.0.0"};  // Interfaces to bind / join multicast on
+    bool loopback = false;                  // Loopback: unicast only, no multicast joins
+    uint32_t shards = 1;                    // Receive threads (up to DMXIngest::kMaxShards)
+    uint16_t start_universe = 1;            // sACN multicast groups joined for store universes
+    uint16_t universe_count = 1;            // start_universe ... start_universe + count - 1
+    // Store universe = wire universe + offset. Art-Net port-addresses count from
+    // 0 and the patch from 1; sACN universes already count from 1. Packets that
+    // map outside 0-65535 are dropped.
+    int32_t art_net_universe_offset = 1;
+    int32_t sacn_universe_offset = 0;
+    uint32_t batch_size = 32;               // Datagrams per receive call
+    uint32_t socket_buffer_bytes = 4 * 1024 * 1024;
+};
+
+// One receive shard (see DMXIngest::shards())
+struct DMXShardStats {
+    uint32_t index = 0;
+    uint16_t first_universe = 0;            // sACN groups joined, store numbering (0 = none)
+    uint16_t last_universe = 0;
+    bool art_net = false;                   // Also reads the Art-Net sockets
+    uint32_t sockets = 0;
+    uint64_t packets = 0;
+    uint64_t batches = 0;
+    uint64_t last_packet_ns = 0;
+};
+
+class DMXIngest {
+public:
+    static constexpr uint32_t kMaxShards = 8;
+
+    explicit DMXIngest(UniverseStore& store);
+    ~DMXIngest();
+
+    DMXIngest(const DMXIngest&) = delete;
+    DMXIngest& operator=(const DMXIngest&) = delete;
+
+    // Configure (only while stopped)
+    bool configure(const DMXIngestConfig& config);
+
+    // Called on a receive thread after each wakeup that may have changed the
+    // store (a drained batch or a source timeout sweep). With several shards it
+    // runs on several threads. Set while stopped.
+    void setUpdateHandler(std::function<void()> handler) { update_handler_ = std::move(handler); }
+
+    // Run the update handler (for callers feeding ingest() themselves)
+    void notifyUpdate() {
+        if (update_handler_) update_handler_();
+    }
+
+    // Record every datagram read from the sockets (nullptr to stop). The writer
+    // must outlive the receive thread or be detached first.
+    void setCapture(DMXCaptureWriter* capture) { capture_.store(capture, std::memory_order_release); }
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running_.load(); }
+
+    // Parse one datagram and apply it, as if it had arrived on the wire's port
+    // from sourceAddress (IPv4, host order; 0 = unknown, every such datagram
+    // counts as one Art-Net sender). Also times out silent sACN sources
+    // against timestampNs. Thread-safe.
+    void ingest(DMXWire wire, const uint8_t* data, size_t length, uint64_t timestampNs, uint32_t sourceAddress = 0);
+
+    // Forget every sACN source, sync domain and Art-Net sequence number, as if
+    // each sender had just restarted: a capture replay starting its next pass,
+    // or live input resuming after a replay whose timestamps ran ahead of the
+    // clock. The store keeps its levels. Only while no other thread calls ingest().
+    void resetSenders();
+
+    const SACNMerger& sacnMerger() const { return merger_; }
+    const SyncLatch& syncLatch() const { return latch_; }
+
+    // Per-universe timing. Frame latency is recorded by whoever renders from the
+    // store (DMXStats::recordFrame), so this one is not const.
+    DMXStats& stats() { return stats_; }
+    const DMXStats& stats() const { return stats_; }
+
+    // Statistics
+    uint64_t packetsReceived() const { return packets_.load(std::memory_order_relaxed); }
+    uint64_t dmxPackets() const { return dmx_packets_.load(std::memory_order_relaxed); }
+    uint64_t invalidPackets() const { return invalid_packets_.load(std::memory_order_relaxed); }
+    uint64_t receiveBatches() const { return batches_.load(std::memory_order_relaxed); }
+    // Second copies of a packet read on another interface: sACN by CID and
+    // sequence, Art-Net by sender address and sequence
+    uint64_t duplicatePackets() const {
+        return duplicate_packets_.load(std::memory_order_relaxed) + merger_.duplicatePackets();
+    }
+    uint64_t storeFull() const { return store_full_.load(std::memory_order_relaxed); }
+    uint64_t unmappedPackets() const { return unmapped_packets_.load(std::memory_order_relaxed); }
+    uint64_t lastPacketNs() const { return last_packet_ns_.load(std::memory_order_relaxed); }
+
+    // Per-shard counters (allocates; call from the thread that starts / stops)
+    std::vector<DMXShardStats> shards() const;
+
+private:
+    struct Socket {
+        int fd = -1;
+        DMXWire wire = DMXWire::ArtNet;
+    };
+    struct ReceiveBatch;    // Platform receive buffers (dmx_ingest.cpp)
+
+    struct Shard {
+        uint32_t index = 0;
+        uint16_t first_group = 0;           // sACN universes joined, wire numbering (0 = none)
+        uint16_t last_group = 0;
+        bool art_net = false;
+        std::vector<Socket> sockets;
+        std::unique_ptr<ReceiveBatch> batch;
+        std::thread thread;
+        std::atomic<uint64_t> packets{0};
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> last_packet_ns{0};
+    };
+
+    int bindSocket(uint16_t port, bool multicast, const std::string& interface);
+    void joinGroup(int fd, uint16_t universe);
+    void closeSockets();
+    void receiveLoop(Shard& shard);
+    void drain(Shard& shard, const Socket& socket);
+
+    void expireSources(uint64_t nowNs);
+    void joinSyncGroup(uint16_t syncAddress);     // On the first shard with an sACN socket
+
+    SyncLatch latch_;
+    SACNMerger merger_;
+    DMXStats stats_;
+    std::array<std::atomic<uint16_t>, SyncLatch::kMaxDomains> sync_groups_{};  // sACN sync addresses joined
+    std::atomic<uint32_t> sync_group_count_{0};
+    std::mutex sync_group_mutex_;                                   // Joins only
+    std::atomic<uint64_t> last_expire_ns_{0};
+    DMXIngestConfig config_;
+    std::function<void()> update_handler_;
+    std::atomic<DMXCaptureWriter*> capture_{nullptr};
+
+    // Sockets, threads and datagram buffers, built in start()
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> should_stop_{false};
+
+    std::atomic<uint64_t> packets_{0};
+    std::atomic<uint64_t> dmx_packets_{0};
+    std::atomic<uint64_t> invalid_packets_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> duplicate_packets_{0};
+    std::atomic<uint64_t> store_full_{0};
+    std::atomic<uint64_t> unmapped_packets_{0};
+    std::atomic<uint64_t> last_packet_ns_{0};
+};
+
+} // namespace RocKontrol
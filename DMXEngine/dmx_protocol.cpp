@@ -0,0 +1,114 @@
+// dmx_protocol.cpp - Art-Net / sACN (E1.31) packet parsing
+// Portable C++ - offsets follow Art-Net 4 (ArtDmx) and ANSI E1.31-2018
+
+#include "dmx_protocol.h"
+#include <algorithm>
+#include <cstring>
+
+namespace RocKontrol {
+
+namespace {
+
+// Art-Net
+const uint8_t kArtNetId[8] = {'A', 'r', 't', '-', 'N', 'e', 't', 0};
+constexpr uint16_t kOpDmx = 0x5000;
+constexpr uint16_t kOpSync = 0x5200;
+constexpr size_t kArtSyncLength = 14;
+constexpr size_t kArtDmxHeader = 18;
+
+// E1.31
+const uint8_t kACNPacketId[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+constexpr uint32_t kVectorRootData = 0x00000004;
+constexpr uint32_t kVectorRootExtended = 0x00000008;
+constexpr uint32_t kVectorFramingData = 0x00000002;
+constexpr uint32_t kVectorExtendedSync = 0x00000001;
+constexpr size_t kSACNSyncLength = 49;
+constexpr uint8_t kVectorDMPSetProperty = 0x02;
+constexpr size_t kSACNDataHeader = 125;         // Up to (not including) the start code
+
+inline uint16_t readBE16(const uint8_t* p) { return (uint16_t)((p[0] << 8) | p[1]); }
+inline uint32_t readBE32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+} // namespace
+
+DMXPacketType parseArtNet(const uint8_t* data, size_t length, DMXPacket& packet) {
+    if (!data || length < 10 || memcmp(data, kArtNetId, sizeof(kArtNetId)) != 0) {
+        return DMXPacketType::Invalid;
+    }
+
+    uint16_t opcode = (uint16_t)(data[8] | (data[9] << 8));
+    if (opcode == kOpSync) {
+        if (length < kArtSyncLength) return DMXPacketType::Invalid;
+        packet = DMXPacket{};
+        packet.wire = DMXWire::ArtNet;
+        return DMXPacketType::Sync;
+    }
+    if (opcode != kOpDmx) return DMXPacketType::Ignored;
+    if (length < kArtDmxHeader) return DMXPacketType::Invalid;
+
+    // Length is big-endian, port-address (SubUni + Net) little-endian
+    uint16_t slotCount = readBE16(data + 16);
+    if (slotCount == 0 || length < kArtDmxHeader + slotCount) return DMXPacketType::Invalid;
+
+    packet = DMXPacket{};
+    packet.wire = DMXWire::ArtNet;
+    packet.sequence = data[12];
+    packet.universe = (uint16_t)((data[14] | (data[15] << 8)) & 0x7FFF);
+    packet.slotCount = (uint16_t)std::min<uint32_t>(slotCount, kDMXSlots);
+    packet.slots = data + kArtDmxHeader;
+    return DMXPacketType::Dmx;
+}
+
+DMXPacketType parseSACN(const uint8_t* data, size_t length, DMXPacket& packet) {
+    if (!data || length < 22 || memcmp(data + 4, kACNPacketId, sizeof(kACNPacketId)) != 0) {
+        return DMXPacketType::Invalid;
+    }
+
+    uint32_t rootVector = readBE32(data + 18);
+    if (rootVector == kVectorRootExtended) {
+        // Synchronization packet: sequence at 44, sync address at 45-46
+        if (length < kSACNSyncLength || readBE32(data + 40) != kVectorExtendedSync) {
+            return DMXPacketType::Ignored;
+        }
+        packet = DMXPacket{};
+        packet.wire = DMXWire::SACN;
+        packet.cid = data + 22;
+        packet.sequence = data[44];
+        packet.universe = readBE16(data + 45);
+        return packet.universe != 0 ? DMXPacketType::Sync : DMXPacketType::Invalid;
+    }
+    if (rootVector != kVectorRootData) return DMXPacketType::Ignored;
+    if (length < kSACNDataHeader + 1) return DMXPacketType::Invalid;
+    if (readBE32(data + 40) != kVectorFramingData || data[117] != kVectorDMPSetProperty) {
+        return DMXPacketType::Invalid;
+    }
+
+    uint16_t universe = readBE16(data + 113);
+    if (universe == 0) return DMXPacketType::Invalid;
+
+    // Property value count includes the start code
+    uint16_t propertyCount = readBE16(data + 123);
+    size_t available = std::min<size_t>(propertyCount, length - kSACNDataHeader);
+    if (available < 1) return DMXPacketType::Invalid;
+
+    packet = DMXPacket{};
+    packet.wire = DMXWire::SACN;
+    packet.cid = data + 22;
+    packet.sourceName = (const char*)(data + 44);
+    packet.priority = data[108];
+    packet.syncAddress = readBE16(data + 109);
+    packet.sequence = data[111];
+    packet.options = data[112];
+    packet.universe = universe;
+    packet.startCode = data[kSACNDataHeader];
+    packet.slotCount = (uint16_t)std::min<size_t>(available - 1, kDMXSlots);
+    packet.slots = data + kSACNDataHeader + 1;
+
+    // Alternate start codes (per-address priority, text, ...) carry no levels
+    if (packet.startCode != 0) return DMXPacketType::Ignored;
+    return packet.slotCount > 0 ? DMXPacketType::Dmx : DMXPacketType::Invalid;
+}
+
+} // namespace RocKontrol
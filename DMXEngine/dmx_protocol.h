@@ -0,0 +1,63 @@
+// dmx_protocol.h - Art-Net / sACN (E1.31) packet parsing
+// Parsers return views into the datagram, so DMX slots are copied exactly once:
+// from the receive buffer straight into the universe store.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace RocKontrol {
+
+constexpr uint16_t kArtNetPort = 6454;
+constexpr uint16_t kSACNPort = 5568;
+constexpr uint32_t kDMXSlots = 512;
+constexpr size_t kMaxDMXDatagram = 2048;        // Larger than any ArtDmx / E1.31 data packet
+
+enum class DMXWire : uint8_t {
+    ArtNet = 0,
+    SACN = 1
+};
+
+enum class DMXPacketType : uint8_t {
+    Invalid = 0,    // Not Art-Net / E1.31, or malformed
+    Ignored,        // Valid header, but nothing we consume (ArtPoll, non-zero start code, ...)
+    Dmx,            // DMX slot data for one universe
+    Sync            // ArtSync / E1.31 synchronization - publish latched universes
+};
+
+// View of a parsed packet - slots and cid point into the datagram
+struct DMXPacket {
+    DMXWire wire = DMXWire::ArtNet;
+    uint16_t universe = 0;          // Art-Net: 15-bit port-address (0-based), sACN: 1-63999
+                                    // (sACN sync packets: the synchronization address)
+    uint16_t syncAddress = 0;       // sACN data: sync universe to wait for (0 = unsynchronized)
+    uint8_t sequence = 0;           // 0 = sequencing disabled
+    uint8_t priority = 100;         // sACN priority (0-200), Art-Net always 100
+    uint8_t options = 0;            // sACN framing options (preview / stream terminated)
+    uint8_t startCode = 0;
+    uint16_t slotCount = 0;         // DMX slots after the start code
+    const uint8_t* slots = nullptr;
+    const uint8_t* cid = nullptr;   // sACN 16-byte component identifier, nullptr for Art-Net
+    const char* sourceName = nullptr;   // sACN 64-byte source name (may lack a terminator)
+};
+
+// sACN framing options
+constexpr uint8_t kSACNOptionPreview = 0x80;
+constexpr uint8_t kSACNOptionTerminated = 0x40;
+
+DMXPacketType parseArtNet(const uint8_t* data, size_t length, DMXPacket& packet);
+DMXPacketType parseSACN(const uint8_t* data, size_t length, DMXPacket& packet);
+
+inline DMXPacketType parseDMXPacket(DMXWire wire, const uint8_t* data, size_t length, DMXPacket& packet) {
+    return wire == DMXWire::ArtNet ? parseArtNet(data, length, packet) : parseSACN(data, length, packet);
+}
+
+// Monotonic clock used for every DMX timestamp
+inline uint64_t dmxClockNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,191 @@
+// dmx_stats.cpp - Per-universe DMX timing statistics
+// Portable C++ - no Foundation dependency
+
+#include "dmx_stats.h"
+
+namespace RocKontrol {
+
+namespace {
+
+inline void bump(std::atomic<uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+DMXStats::DMXStats() : index_(kWires * UniverseStore::kUniverseRange), entries_(kMaxUniverses) {
+    for (auto& entry : index_) entry.store(0, std::memory_order_relaxed);
+}
+
+DMXStats::Entry* DMXStats::entryFor(DMXWire wire, uint16_t universe) {
+    const uint32_t key = keyFor(wire, universe);
+    uint16_t entry = index_[key].load(std::memory_order_acquire);
+    if (entry != 0) return &entries_[entry - 1];
+
+    std::lock_guard<std::mutex> lock(claim_mutex_);
+    entry = index_[key].load(std::memory_order_relaxed);
+    if (entry == 0) {
+        uint32_t used = used_.load(std::memory_order_relaxed);
+        if (used >= kMaxUniverses || !entries_.reserve(used + 1)) return nullptr;
+        entries_[used].universe.store(universe, std::memory_order_relaxed);
+        entries_[used].wire.store((uint8_t)wire, std::memory_order_relaxed);
+        entry = (uint16_t)(used + 1);
+        used_.store(used + 1, std::memory_order_release);
+        index_[key].store(entry, std::memory_order_release);
+    }
+    return &entries_[entry - 1];
+}
+
+bool DMXStats::recordPacket(DMXWire wire, uint16_t universe, uint8_t sequence, uint64_t nowNs, uint32_t source) {
+    Entry* e = entryFor(wire, universe);
+    if (!e) return true;
+
+    while (e->recording.exchange(true, std::memory_order_acquire)) {
+        cpuRelax();
+    }
+    bool recorded = recordLocked(*e, wire, sequence, source, nowNs);
+    e->recording.store(false, std::memory_order_release);
+    return recorded;
+}
+
+DMXStats::Sender& DMXStats::senderFor(Entry& e, uint32_t source) {
+    for (Sender& sender : e.senders) {
+        if (sender.sequence != 0 && sender.address == source) return sender;
+    }
+    for (Sender& sender : e.senders) {
+        if (sender.sequence == 0) return sender;
+    }
+    Sender& oldest = e.senders[e.next_sender];
+    e.next_sender = (uint8_t)((e.next_sender + 1) % kMaxSenders);
+    oldest = Sender{};
+    return oldest;
+}
+
+bool DMXStats::recordLocked(Entry& e, DMXWire wire, uint8_t sequence, uint32_t source, uint64_t nowNs) {
+    bool sequenced = wire == DMXWire::ArtNet && sequence != 0;
+    Sender* sender = sequenced ? &senderFor(e, source) : nullptr;
+    if (sender && sequence == sender->sequence) return false;
+
+    bump(e.packets);
+    e.last_packet_ns.store(nowNs, std::memory_order_relaxed);
+
+    int64_t change = e.timing.update(nowNs);
+    e.interval_ns.store(e.timing.interval_ns, std::memory_order_relaxed);
+    if (change >= 0) {
+        e.jitter_ns.store(e.timing.jitter_ns, std::memory_order_relaxed);
+        bump(e.jitter_histogram[timingBucket((uint64_t)change)]);
+    }
+
+    // Art-Net counts 1-255 and wraps to 1; anything but the next number is a gap
+    if (sender) {
+        uint8_t expected = sender->sequence == 255 ? 1 : (uint8_t)(sender->sequence + 1);
+        if (sender->sequence != 0 && sequence != expected) bump(e.sequence_gaps);
+        sender->address = source;
+        sender->sequence = sequence;
+    }
+    return true;
+}
+
+void DMXStats::recordFrame(const UniverseSnapshot& frame) {
+    if (frame.fullRefresh()) return;
+
+    uint64_t taken = frame.takenNs();
+    for (uint32_t slot = 0; slot < frame.slotCount(); slot++) {
+        if (!frame.slotUpdated(slot)) continue;
+
+        uint16_t universe = frame.slotUniverse(slot);
+        uint64_t updated = frame.slotUpdatedNs(slot);
+        uint64_t latency = taken > updated ? taken - updated : 0;
+
+        // The store cannot tell which wire the newest write came from
+        for (DMXWire wire : {DMXWire::ArtNet, DMXWire::SACN}) {
+            uint16_t entry = index_[keyFor(wire, universe)].load(std::memory_order_acquire);
+            if (entry != 0) recordLatency(entries_[entry - 1], latency);
+        }
+    }
+}
+
+void DMXStats::recordLatency(Entry& e, uint64_t latency) {
+    bump(e.frames);
+    e.latency_last_ns.store(latency, std::memory_order_relaxed);
+    uint64_t mean = e.latency_mean_ns.load(std::memory_order_relaxed);
+    e.latency_mean_ns.store(mean ? mean + ((int64_t)(latency - mean) >> 4) : latency, std::memory_order_relaxed);
+    if (latency > e.latency_max_ns.load(std::memory_order_relaxed)) {
+        e.latency_max_ns.store(latency, std::memory_order_relaxed);
+    }
+    bump(e.latency_histogram[timingBucket(latency)]);
+}
+
+void DMXStats::reset() {
+    std::lock_guard<std::mutex> lock(claim_mutex_);
+    uint32_t used = used_.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < used; i++) {
+        Entry& e = entries_[i];
+        DMXWire wire = (DMXWire)e.wire.load(std::memory_order_relaxed);
+        index_[keyFor(wire, e.universe.load(std::memory_order_relaxed))].store(0, std::memory_order_relaxed);
+
+        e.packets.store(0, std::memory_order_relaxed);
+        e.last_packet_ns.store(0, std::memory_order_relaxed);
+        e.interval_ns.store(0, std::memory_order_relaxed);
+        e.jitter_ns.store(0, std::memory_order_relaxed);
+        e.sequence_gaps.store(0, std::memory_order_relaxed);
+        e.frames.store(0, std::memory_order_relaxed);
+        e.latency_last_ns.store(0, std::memory_order_relaxed);
+        e.latency_mean_ns.store(0, std::memory_order_relaxed);
+        e.latency_max_ns.store(0, std::memory_order_relaxed);
+        for (auto& count : e.jitter_histogram) count.store(0, std::memory_order_relaxed);
+        for (auto& count : e.latency_histogram) count.store(0, std::memory_order_relaxed);
+        e.timing = ArrivalTiming{};
+        e.senders = {};
+        e.next_sender = 0;
+    }
+    used_.store(0, std::memory_order_release);
+}
+
+void DMXStats::resetSequences() {
+    std::lock_guard<std::mutex> lock(claim_mutex_);
+    uint32_t used = used_.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < used; i++) {
+        Entry& e = entries_[i];
+        while (e.recording.exchange(true, std::memory_order_acquire)) {
+            cpuRelax();
+        }
+        e.senders = {};
+        e.next_sender = 0;
+        e.recording.store(false, std::memory_order_release);
+    }
+}
+
+std::vector<DMXUniverseStats> DMXStats::universes() const {
+    uint64_t now = dmxClockNs();
+    uint32_t used = used_.load(std::memory_order_acquire);
+
+    std::vector<DMXUniverseStats> result(used);
+    for (uint32_t i = 0; i < used; i++) {
+        const Entry& e = entries_[i];
+        DMXUniverseStats& info = result[i];
+        info.universe = e.universe.load(std::memory_order_relaxed);
+        info.wire = (DMXWire)e.wire.load(std::memory_order_relaxed);
+        info.packets = e.packets.load(std::memory_order_relaxed);
+        info.interval_ns = e.interval_ns.load(std::memory_order_relaxed);
+        info.jitter_ns = e.jitter_ns.load(std::memory_order_relaxed);
+        info.sequence_gaps = e.sequence_gaps.load(std::memory_order_relaxed);
+        info.last_packet_ns = e.last_packet_ns.load(std::memory_order_relaxed);
+        info.frames = e.frames.load(std::memory_order_relaxed);
+        info.latency_last_ns = e.latency_last_ns.load(std::memory_order_relaxed);
+        info.latency_mean_ns = e.latency_mean_ns.load(std::memory_order_relaxed);
+        info.latency_max_ns = e.latency_max_ns.load(std::memory_order_relaxed);
+        for (uint32_t b = 0; b < kTimingBuckets; b++) {
+            info.jitter_histogram[b] = e.jitter_histogram[b].load(std::memory_order_relaxed);
+            info.latency_histogram[b] = e.latency_histogram[b].load(std::memory_order_relaxed);
+        }
+
+        ArrivalTiming timing;
+        timing.last_ns = info.last_packet_ns;
+        timing.interval_ns = info.interval_ns;
+        info.rate_hz = timing.rate(now);
+    }
+    return result;
+}
+
+} // namespace RocKontrol
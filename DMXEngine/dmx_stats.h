@@ -0,0 +1,182 @@
+// dmx_stats.h - Per-universe DMX timing statistics
+// The receive thread records every DMX packet against its universe: packet
+// rate, inter-arrival jitter (RFC 3550 style running estimate plus a
+// histogram), and Art-Net sequence gaps per sender. The render thread records, per frame
+// snapshot, how long the newest packet of each updated universe waited before
+// a frame consumed it. Entries are keyed by (wire, universe), so Art-Net and
+// sACN feeding the same store universe do not share one. Unicast sACN for a
+// universe can still land on any SO_REUSEPORT shard, so receive-side updates
+// take a per-entry spinlock, uncontended unless two shards really do read the
+// same universe. Entries are claimed through a flat 16-bit index and allocated
+// in arena chunks like UniverseStore; every counter is a relaxed atomic, so
+// readers never block either side.
+
+#pragma once
+
+#include "dmx_protocol.h"
+#include "universe_arena.h"
+#include "universe_store.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace RocKontrol {
+
+// Log2 histogram: bucket 0 is < 250 us, bucket i < 250 us << i, the last is open-ended
+constexpr uint32_t kTimingBuckets = 12;
+constexpr uint64_t kTimingBucketBaseNs = 250000;
+
+inline uint32_t timingBucket(uint64_t ns) {
+    uint32_t bucket = 0;
+    for (uint64_t edge = kTimingBucketBaseNs; ns >= edge && bucket < kTimingBuckets - 1; edge <<= 1) bucket++;
+    return bucket;
+}
+
+// Upper edge of a bucket (0 for the open-ended last one)
+inline uint64_t timingBucketLimitNs(uint32_t bucket) {
+    return bucket < kTimingBuckets - 1 ? kTimingBucketBaseNs << bucket : 0;
+}
+
+// Inter-arrival tracking for one packet stream. Not atomic - owned by one writer.
+struct ArrivalTiming {
+    static constexpr uint64_t kGapNs = 1000000000ull;   // Longer silences restart the estimate
+
+    uint64_t last_ns = 0;
+    uint64_t interval_ns = 0;       // Running mean (1/16 gain)
+    uint64_t jitter_ns = 0;         // Running mean of |interval change| (1/16 gain)
+    uint64_t previous_interval_ns = 0;
+
+    // Returns the interval change for this packet, or -1 when there is none yet
+    int64_t update(uint64_t nowNs) {
+        uint64_t last = last_ns;
+        last_ns = nowNs;
+        if (last == 0 || nowNs <= last || nowNs - last > kGapNs) {
+            previous_interval_ns = 0;
+            return -1;
+        }
+
+        uint64_t interval = nowNs - last;
+        interval_ns = interval_ns ? interval_ns + ((int64_t)(interval - interval_ns) >> 4) : interval;
+        if (previous_interval_ns == 0) {
+            previous_interval_ns = interval;
+            return -1;
+        }
+
+        int64_t delta = (int64_t)interval - (int64_t)previous_interval_ns;
+        uint64_t change = (uint64_t)(delta < 0 ? -delta : delta);
+        previous_interval_ns = interval;
+        jitter_ns = jitter_ns + ((int64_t)(change - jitter_ns) >> 4);
+        return (int64_t)change;
+    }
+
+    // Packets per second over the running mean, 0 once the stream went quiet
+    double rate(uint64_t nowNs) const {
+        if (interval_ns == 0 || nowNs < last_ns || nowNs - last_ns > kGapNs) return 0.0;
+        return 1e9 / (double)interval_ns;
+    }
+};
+
+// Copy of one universe's statistics for one protocol (see DMXStats::universes())
+struct DMXUniverseStats {
+    uint16_t universe = 0;
+    DMXWire wire = DMXWire::ArtNet;
+    uint64_t packets = 0;
+    double rate_hz = 0.0;
+    uint64_t interval_ns = 0;
+    uint64_t jitter_ns = 0;
+    std::array<uint64_t, kTimingBuckets> jitter_histogram{};
+    uint64_t sequence_gaps = 0;             // Art-Net only, all senders - sACN gaps are per source
+    uint64_t last_packet_ns = 0;
+
+    // Ingest to render: packet arrival to the frame snapshot that consumed it
+    uint64_t frames = 0;                    // Snapshots that took a new packet of this universe
+    uint64_t latency_last_ns = 0;
+    uint64_t latency_mean_ns = 0;           // Running mean (1/16 gain)
+    uint64_t latency_max_ns = 0;
+    std::array<uint64_t, kTimingBuckets> latency_histogram{};
+};
+
+class DMXStats {
+public:
+    static constexpr uint32_t kMaxUniverses = UniverseStore::kMaxUniverses;    // Entries, both wires together
+    static constexpr uint32_t kMaxSenders = 4;      // Art-Net senders followed per universe (oldest replaced)
+
+    DMXStats();
+
+    DMXStats(const DMXStats&) = delete;
+    DMXStats& operator=(const DMXStats&) = delete;
+
+    // Receive thread: one DMX packet for universe (store numbering) at nowNs
+    // from the sender's IPv4 address (host order, 0 = unknown). sequence 0
+    // means sequencing is disabled. Art-Net sequence numbers are followed per
+    // sender, so consoles sharing a universe neither look like duplicates nor
+    // like gaps in each other's count. False (and nothing recorded) for an
+    // Art-Net packet repeating its sender's previous sequence number - the
+    // same datagram read a second time, on another interface.
+    bool recordPacket(DMXWire wire, uint16_t universe, uint8_t sequence, uint64_t nowNs, uint32_t source = 0);
+
+    // Render thread: latency of every universe the snapshot took a new packet of,
+    // recorded against each wire that feeds it. Skipped on full refreshes, where
+    // the copies are not new arrivals.
+    void recordFrame(const UniverseSnapshot& frame);
+
+    // Forget every universe (call while ingest is stopped)
+    void reset();
+
+    // Forget the Art-Net senders of every universe, so a sender that restarted
+    // is not taken for a duplicate. Counters are kept.
+    void resetSequences();
+
+    // Per (universe, wire) copies (allocates - not for the packet path)
+    std::vector<DMXUniverseStats> universes() const;
+
+    uint32_t universeCount() const { return used_.load(std::memory_order_acquire); }
+
+private:
+    struct Sender {
+        uint32_t address = 0;
+        uint8_t sequence = 0;                       // 0 = none yet
+    };
+
+    struct Entry {
+        std::atomic<uint16_t> universe{0};
+        std::atomic<uint8_t> wire{0};              // Set when claimed
+        std::atomic<uint64_t> packets{0};
+        std::atomic<uint64_t> last_packet_ns{0};
+        std::atomic<uint64_t> interval_ns{0};
+        std::atomic<uint64_t> jitter_ns{0};
+        std::atomic<uint64_t> sequence_gaps{0};
+        std::array<std::atomic<uint64_t>, kTimingBuckets> jitter_histogram{};
+
+        std::atomic<uint64_t> frames{0};
+        std::atomic<uint64_t> latency_last_ns{0};
+        std::atomic<uint64_t> latency_mean_ns{0};
+        std::atomic<uint64_t> latency_max_ns{0};
+        std::array<std::atomic<uint64_t>, kTimingBuckets> latency_histogram{};
+
+        // Receive side, under recording
+        std::atomic<bool> recording{false};
+        ArrivalTiming timing;
+        std::array<Sender, kMaxSenders> senders{};
+        uint8_t next_sender = 0;                    // Replaced when a new sender does not fit
+    };
+
+    static constexpr uint32_t kWires = 2;
+
+    static uint32_t keyFor(DMXWire wire, uint16_t universe) {
+        return (uint32_t)wire * UniverseStore::kUniverseRange + universe;
+    }
+    Entry* entryFor(DMXWire wire, uint16_t universe);
+    bool recordLocked(Entry& e, DMXWire wire, uint8_t sequence, uint32_t source, uint64_t nowNs);
+    static Sender& senderFor(Entry& e, uint32_t source);
+    void recordLatency(Entry& e, uint64_t latency);
+
+    std::vector<std::atomic<uint16_t>> index_;      // keyFor(wire, universe) -> entry + 1 (0 = none)
+    UniverseArena<Entry> entries_;
+    std::atomic<uint32_t> used_{0};
+    std::mutex claim_mutex_;
+};
+
+} // namespace RocKontrol
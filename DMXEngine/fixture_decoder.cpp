@@ -0,0 +1,556 @@
+// fixture_decoder.cpp - Fixture channel decode into structure-of-arrays
+// Two passes per frame:
+//   gather  - each fixture's channels are copied into byte rows in the Full
+//             channel order (stage[channel][fixture]); channels the mode lacks
+//             get the value Full mode would need to behave the same
+//   convert - every attribute row is turned into floats for all fixtures at
+//             once (SSE2 / NEON with a scalar tail), so the cost is a handful
+//             of straight-line passes instead of per-fixture branching
+// Mappings match the Swift parsers they replace (map8 / map16 / mapPosition16).
+
+#include "fixture_decoder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define ROCK_DECODE_X86 1
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ROCK_DECODE_NEON 1
+#endif
+
+namespace RocKontrol {
+
+namespace {
+
+// Full mode channel order (0-based)
+enum Channel : uint32_t {
+    kContent = 0,
+    kXCoarse, kXFine, kYCoarse, kYFine, kZ,
+    kScaleCoarse, kScaleFine, kHScaleCoarse, kHScaleFine, kVScaleCoarse, kVScaleFine,
+    kSoftness, kOpacity, kIntensity, kRed, kGreen, kBlue,
+    kRotation, kSpin, kPlayback, kVideoMode, kVolume,
+    kIris,
+    kTopInsertion, kTopAngle, kBottomInsertion, kBottomAngle,
+    kLeftInsertion, kLeftAngle, kRightInsertion, kRightAngle,
+    kShutterRotation,
+    kPrism, kAnimation, kPrismatics, kPrismRotation,
+    kChannelCount
+};
+
+static_assert(kChannelCount == FixtureDecoder::kCanonicalChannels, "Full mode is 37 channels");
+
+constexpr int8_t kFill = -1;
+
+// Where each canonical channel comes from in a mode (channel offset or kFill)
+// and the byte used when the mode lacks it
+struct ModeLayout {
+    uint32_t channels;
+    int8_t source[kChannelCount];
+    uint8_t fill[kChannelCount];
+};
+
+constexpr ModeLayout makeFullLayout() {
+    ModeLayout l{37, {}, {}};
+    for (uint32_t c = 0; c < kChannelCount; c++) l.source[c] = (int8_t)c;
+    return l;
+}
+
+// Standard is the first 23 Full channels; open iris, no shutters or prism
+constexpr ModeLayout makeStandardLayout() {
+    ModeLayout l{23, {}, {}};
+    for (uint32_t c = 0; c < kChannelCount; c++) {
+        l.source[c] = c < 23 ? (int8_t)c : kFill;
+        l.fill[c] = 0;
+    }
+    l.fill[kIris] = 255;
+    l.fill[kTopAngle] = l.fill[kBottomAngle] = l.fill[kLeftAngle] = l.fill[kRightAngle] = 128;
+    l.fill[kShutterRotation] = 128;
+    return l;
+}
+
+// Compact: Content, X, Y, Scale, Opacity, R, G, B, Softness, Spin. The 8-bit
+// channels land in both coarse and fine bytes: (v * 257) / 65535 == v / 255.
+constexpr ModeLayout makeCompactLayout() {
+    ModeLayout l = makeStandardLayout();
+    l.channels = 10;
+    for (uint32_t c = 0; c < kChannelCount; c++) l.source[c] = kFill;
+    l.source[kContent] = 0;
+    l.source[kXCoarse] = l.source[kXFine] = 1;
+    l.source[kYCoarse] = l.source[kYFine] = 2;
+    l.source[kScaleCoarse] = l.source[kScaleFine] = 3;
+    l.source[kOpacity] = 4;
+    l.source[kRed] = 5;
+    l.source[kGreen] = 6;
+    l.source[kBlue] = 7;
+    l.source[kSoftness] = 8;
+    l.source[kSpin] = 9;
+    l.fill[kIntensity] = 255;
+    l.fill[kVolume] = 255;
+    return l;
+}
+
+constexpr ModeLayout kLayouts[3] = {makeFullLayout(), makeStandardLayout(), makeCompactLayout()};
+
+inline const ModeLayout& layoutFor(FixtureMode mode) {
+    uint32_t index = (uint32_t)mode;
+    return kLayouts[index < 3 ? index : 0];
+}
+
+constexpr float kPi = 3.14159265358979f;
+
+// Spin: 0-127 = CCW fast to stop, 128-255 = stop to CW fast (180 deg/s max)
+struct SpinTable {
+    float radiansPerSecond[256];
+    SpinTable() {
+        for (int v = 0; v < 256; v++) {
+            float degrees = v <= 127 ? -(float)v / 127.0f * 180.0f : (float)(v - 128) / 127.0f * 180.0f;
+            radiansPerSecond[v] = degrees * (kPi / 180.0f);
+        }
+    }
+};
+
+const SpinTable kSpinTable;
+
+// Row kernels: out[i] = in[i] * scale + offset
+
+void affine8Scalar(const uint8_t* in, float* out, uint32_t i, uint32_t n, float scale, float offset) {
+    for (; i < n; i++) out[i] = (float)in[i] * scale + offset;
+}
+
+void affine16Scalar(const uint8_t* hi, const uint8_t* lo, float* out, uint32_t i, uint32_t n, float scale, float offset) {
+    for (; i < n; i++) out[i] = (float)((hi[i] << 8) | lo[i]) * scale + offset;
+}
+
+#if defined(ROCK_DECODE_X86)
+
+inline void storeAffine(float* out, __m128i u16, __m128 scale, __m128 offset) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128 a = _mm_cvtepi32_ps(_mm_unpacklo_epi16(u16, zero));
+    __m128 b = _mm_cvtepi32_ps(_mm_unpackhi_epi16(u16, zero));
+    _mm_storeu_ps(out, _mm_add_ps(_mm_mul_ps(a, scale), offset));
+    _mm_storeu_ps(out + 4, _mm_add_ps(_mm_mul_ps(b, scale), offset));
+}
+
+void affine8(const uint8_t* in, float* out, uint32_t n, float scale, float offset) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 o = _mm_set1_ps(offset);
+    uint32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        storeAffine(out + i, _mm_unpacklo_epi8(v, zero), s, o);
+        storeAffine(out + i + 8, _mm_unpackhi_epi8(v, zero), s, o);
+    }
+    affine8Scalar(in, out, i, n, scale, offset);
+}
+
+void affine16(const uint8_t* hi, const uint8_t* lo, float* out, uint32_t n, float scale, float offset) {
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 o = _mm_set1_ps(offset);
+    uint32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi + i));
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lo + i));
+        storeAffine(out + i, _mm_unpacklo_epi8(l, h), s, o);
+        storeAffine(out + i + 8, _mm_unpackhi_epi8(l, h), s, o);
+    }
+    affine16Scalar(hi, lo, out, i, n, scale, offset);
+}
+
+// out[i] = a[i] * max(b[i], floor)
+void mulClamped(const float* a, const float* b, float* out, uint32_t n, float floor) {
+    const __m128 f = _mm_set1_ps(floor);
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 m = _mm_max_ps(_mm_loadu_ps(b + i), f);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), m));
+    }
+    for (; i < n; i++) out[i] = a[i] * std::max(b[i], floor);
+}
+
+void mulInPlace(float* a, const float* b, uint32_t n) {
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(a + i, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    for (; i < n; i++) a[i] *= b[i];
+}
+
+#elif defined(ROCK_DECODE_NEON)
+
+inline void storeAffine(float* out, uint16x8_t u16, float32x4_t scale, float32x4_t offset) {
+    float32x4_t a = vcvtq_f32_u32(vmovl_u16(vget_low_u16(u16)));
+    float32x4_t b = vcvtq_f32_u32(vmovl_u16(vget_high_u16(u16)));
+    vst1q_f32(out, vmlaq_f32(offset, a, scale));
+    vst1q_f32(out + 4, vmlaq_f32(offset, b, scale));
+}
+
+void affine8(const uint8_t* in, float* out, uint32_t n, float scale, float offset) {
+    const float32x4_t s = vdupq_n_f32(scale);
+    const float32x4_t o = vdupq_n_f32(offset);
+    uint32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t v = vld1q_u8(in + i);
+        storeAffine(out + i, vmovl_u8(vget_low_u8(v)), s, o);
+        storeAffine(out + i + 8, vmovl_u8(vget_high_u8(v)), s, o);
+    }
+    affine8Scalar(in, out, i, n, scale, offset);
+}
+
+void affine16(const uint8_t* hi, const uint8_t* lo, float* out, uint32_t n, float scale, float offset) {
+    const float32x4_t s = vdupq_n_f32(scale);
+    const float32x4_t o = vdupq_n_f32(offset);
+    uint32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t h = vld1q_u8(hi + i);
+        uint8x16_t l = vld1q_u8(lo + i);
+        uint16x8_t v0 = vorrq_u16(vshll_n_u8(vget_low_u8(h), 8), vmovl_u8(vget_low_u8(l)));
+        uint16x8_t v1 = vorrq_u16(vshll_n_u8(vget_high_u8(h), 8), vmovl_u8(vget_high_u8(l)));
+        storeAffine(out + i, v0, s, o);
+        storeAffine(out + i + 8, v1, s, o);
+    }
+    affine16Scalar(hi, lo, out, i, n, scale, offset);
+}
+
+void mulClamped(const float* a, const float* b, float* out, uint32_t n, float floor) {
+    const float32x4_t f = vdupq_n_f32(floor);
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t m = vmaxq_f32(vld1q_f32(b + i), f);
+        vst1q_f32(out + i, vmulq_f32(vld1q_f32(a + i), m));
+    }
+    for (; i < n; i++) out[i] = a[i] * std::max(b[i], floor);
+}
+
+void mulInPlace(float* a, const float* b, uint32_t n) {
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(a + i, vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+    }
+    for (; i < n; i++) a[i] *= b[i];
+}
+
+#else
+
+void affine8(const uint8_t* in, float* out, uint32_t n, float scale, float offset) {
+    affine8Scalar(in, out, 0, n, scale, offset);
+}
+
+void affine16(const uint8_t* hi, const uint8_t* lo, float* out, uint32_t n, float scale, float offset) {
+    affine16Scalar(hi, lo, out, 0, n, scale, offset);
+}
+
+void mulClamped(const float* a, const float* b, float* out, uint32_t n, float floor) {
+    for (uint32_t i = 0; i < n; i++) out[i] = a[i] * std::max(b[i], floor);
+}
+
+void mulInPlace(float* a, const float* b, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) a[i] *= b[i];
+}
+
+#endif
+
+} // namespace
+
+uint32_t fixtureChannelCount(FixtureMode mode) {
+    return layoutFor(mode).channels;
+}
+
+void FixtureFrame::reserve(uint32_t fixtures) {
+    if (fixtures <= capacity) return;
+    capacity = fixtures;
+    fields.assign((size_t)FixtureField::Count * capacity, 0.0f);
+    bytes.assign((size_t)FixtureByte::Count * capacity, 0);
+    stamps.assign(capacity, 0);
+}
+
+void FixtureFrame::copyFrom(const FixtureFrame& other) {
+    reserve(other.count);
+    count = other.count;
+    sequence = other.sequence;
+    decoded = other.decoded;
+    patch_version = other.patch_version;
+    decoded_ns = other.decoded_ns;
+    decode_ns = other.decode_ns;
+    if (count == 0) return;
+
+    for (uint32_t f = 0; f < (uint32_t)FixtureField::Count; f++) {
+        memcpy(field((FixtureField)f), other.field((FixtureField)f), count * sizeof(float));
+    }
+    for (uint32_t b = 0; b < (uint32_t)FixtureByte::Count; b++) {
+        memcpy(byteRow((FixtureByte)b), other.byteRow((FixtureByte)b), count);
+    }
+    memcpy(stamps.data(), other.stamps.data(), count * sizeof(uint64_t));
+}
+
+// FixtureDecoder
+
+void FixtureDecoder::setPatch(const FixturePatch* patch, uint32_t count) {
+    patch_.assign(patch, patch + count);
+    dirty_.reserve(count);
+    repatched_ = true;
+
+    if (count > stage_capacity_) {
+        stage_capacity_ = count;
+        stage_.assign((size_t)kCanonicalChannels * stage_capacity_, 0);
+    }
+}
+
+uint32_t FixtureDecoder::decode(const UniverseSnapshot& snapshot) {
+    const uint32_t n = (uint32_t)patch_.size();
+    frame_.reserve(n);
+    frame_.count = n;
+    frame_.sequence++;
+
+    // Only fixtures whose channel range changed since the previous snapshot
+    dirty_.clear();
+    for (uint32_t i = 0; i < n; i++) {
+        const FixturePatch& p = patch_[i];
+        const uint32_t base = p.address >= 1 ? p.address - 1u : kDMXSlots;
+        if (repatched_ || snapshot.changed(p.universe, base, layoutFor(p.mode).channels)) {
+            dirty_.push_back(i);
+        }
+    }
+    repatched_ = false;
+
+    const uint32_t m = (uint32_t)dirty_.size();
+    frame_.decoded = m;
+    total_decoded_ += m;
+    if (m == 0) return 0;
+
+    // Everything dirty: decode straight into the frame, else into a compact
+    // scratch frame and scatter the results to their slots
+    const bool all = m == n;
+    FixtureFrame& out = all ? frame_ : scratch_;
+    if (!all) {
+        scratch_.reserve(m);
+        scratch_.count = m;
+    }
+    convert(snapshot, out, m);
+
+    if (!all) {
+        for (uint32_t f = 0; f < (uint32_t)FixtureField::Count; f++) {
+            const float* src = scratch_.field((FixtureField)f);
+            float* dst = frame_.field((FixtureField)f);
+            for (uint32_t j = 0; j < m; j++) dst[dirty_[j]] = src[j];
+        }
+        for (uint32_t b = 0; b < (uint32_t)FixtureByte::Count; b++) {
+            const uint8_t* src = scratch_.byteRow((FixtureByte)b);
+            uint8_t* dst = frame_.byteRow((FixtureByte)b);
+            for (uint32_t j = 0; j < m; j++) dst[dirty_[j]] = src[j];
+        }
+    }
+    for (uint32_t j = 0; j < m; j++) frame_.stamps[dirty_[j]] = frame_.sequence;
+    return m;
+}
+
+// Decode the n fixtures listed in dirty_ into rows 0..n-1 of out
+void FixtureDecoder::convert(const UniverseSnapshot& snapshot, FixtureFrame& out, uint32_t n) {
+    const size_t cap = stage_capacity_;
+    uint8_t* stage = stage_.data();
+    uint8_t* valid = out.byteRow(FixtureByte::Valid);
+
+    // Gather
+    compact_.clear();
+    for (uint32_t j = 0; j < n; j++) {
+        const FixturePatch& p = patch_[dirty_[j]];
+        const ModeLayout& layout = layoutFor(p.mode);
+        const uint32_t base = p.address >= 1 ? p.address - 1u : kDMXSlots;
+        if (p.mode == FixtureMode::Compact) compact_.push_back(j);
+
+        if (base + layout.channels > kDMXSlots) {
+            valid[j] = 0;
+            for (uint32_t c = 0; c < kChannelCount; c++) stage[c * cap + j] = layout.fill[c];
+            continue;
+        }
+
+        const uint8_t* dmx = snapshot.universe(p.universe) + base;
+        valid[j] = 1;
+        for (uint32_t c = 0; c < kChannelCount; c++) {
+            int8_t src = layout.source[c];
+            stage[c * cap + j] = src >= 0 ? dmx[src] : layout.fill[c];
+        }
+    }
+
+    auto row = [&](uint32_t channel) { return stage + channel * cap; };
+    auto field = [&](FixtureField f) { return out.field(f); };
+
+    // Convert - position in canvas units with 20% overflow each side
+    const float kPosition16 = 1.4f / 65535.0f;
+    affine16(row(kXCoarse), row(kXFine), field(FixtureField::PositionX), n, kPosition16, -0.2f);
+    affine16(row(kYCoarse), row(kYFine), field(FixtureField::PositionY), n, kPosition16, -0.2f);
+
+    // Scale: uniform 0-6 times H/V multipliers 0-2 (floored at 0.1). The H/V
+    // rows go through the output rows first, then get multiplied in place.
+    float* scaleX = field(FixtureField::ScaleX);
+    float* scaleY = field(FixtureField::ScaleY);
+    float* uniform = field(FixtureField::Spin);     // Scratch until spin is written
+    affine16(row(kScaleCoarse), row(kScaleFine), uniform, n, 6.0f / 65535.0f, 0.0f);
+    affine16(row(kHScaleCoarse), row(kHScaleFine), scaleX, n, 2.0f / 65535.0f, 0.0f);
+    affine16(row(kVScaleCoarse), row(kVScaleFine), scaleY, n, 2.0f / 65535.0f, 0.0f);
+    mulClamped(uniform, scaleX, scaleX, n, 0.1f);
+    mulClamped(uniform, scaleY, scaleY, n, 0.1f);
+    for (uint32_t j : compact_) {
+        scaleX[j] = uniform[j];
+        scaleY[j] = uniform[j];
+    }
+
+    const float k8 = 1.0f / 255.0f;
+    affine8(row(kSoftness), field(FixtureField::Softness), n, 40.0f / 255.0f, 0.0f);
+    affine8(row(kOpacity), field(FixtureField::Opacity), n, k8, 0.0f);
+    affine8(row(kIntensity), field(FixtureField::Intensity), n, k8, 0.0f);
+
+    // Colour is premultiplied by intensity
+    const float* intensity = field(FixtureField::Intensity);
+    affine8(row(kRed), field(FixtureField::Red), n, k8, 0.0f);
+    affine8(row(kGreen), field(FixtureField::Green), n, k8, 0.0f);
+    affine8(row(kBlue), field(FixtureField::Blue), n, k8, 0.0f);
+    mulInPlace(field(FixtureField::Red), intensity, n);
+    mulInPlace(field(FixtureField::Green), intensity, n);
+    mulInPlace(field(FixtureField::Blue), intensity, n);
+
+    affine8(row(kRotation), field(FixtureField::Rotation), n, 2.0f * kPi / 255.0f, 0.0f);
+    const uint8_t* spinRow = row(kSpin);
+    float* spin = field(FixtureField::Spin);
+    for (uint32_t i = 0; i < n; i++) spin[i] = kSpinTable.radiansPerSecond[spinRow[i]];
+
+    affine8(row(kVideoMode), field(FixtureField::VideoMaskBlend), n, k8, 0.0f);
+    affine8(row(kVolume), field(FixtureField::VideoVolume), n, k8, 0.0f);
+
+    // Iris and framing shutters: insertion 0-1, angles +-45 deg around 128
+    const float kAngle = (kPi / 4.0f) / 127.0f;
+    const float kAngleOffset = -128.0f * kAngle;
+    affine8(row(kIris), field(FixtureField::Iris), n, k8, 0.0f);
+    affine8(row(kTopInsertion), field(FixtureField::ShutterTopInsertion), n, k8, 0.0f);
+    affine8(row(kTopAngle), field(FixtureField::ShutterTopAngle), n, kAngle, kAngleOffset);
+    affine8(row(kBottomInsertion), field(FixtureField::ShutterBottomInsertion), n, k8, 0.0f);
+    affine8(row(kBottomAngle), field(FixtureField::ShutterBottomAngle), n, kAngle, kAngleOffset);
+    affine8(row(kLeftInsertion), field(FixtureField::ShutterLeftInsertion), n, k8, 0.0f);
+    affine8(row(kLeftAngle), field(FixtureField::ShutterLeftAngle), n, kAngle, kAngleOffset);
+    affine8(row(kRightInsertion), field(FixtureField::ShutterRightInsertion), n, k8, 0.0f);
+    affine8(row(kRightAngle), field(FixtureField::ShutterRightAngle), n, kAngle, kAngleOffset);
+    affine8(row(kShutterRotation), field(FixtureField::ShutterRotation), n, kAngle, kAngleOffset);
+
+    // Behaviour channels pass through
+    memcpy(out.byteRow(FixtureByte::Content), row(kContent), n);
+    memcpy(out.byteRow(FixtureByte::Z), row(kZ), n);
+    memcpy(out.byteRow(FixtureByte::Playback), row(kPlayback), n);
+    memcpy(out.byteRow(FixtureByte::Prism), row(kPrism), n);
+    memcpy(out.byteRow(FixtureByte::Animation), row(kAnimation), n);
+    memcpy(out.byteRow(FixtureByte::Prismatics), row(kPrismatics), n);
+    memcpy(out.byteRow(FixtureByte::PrismRotation), row(kPrismRotation), n);
+}
+
+// FixtureDecodeWorker
+
+FixtureDecodeWorker::FixtureDecodeWorker(const UniverseStore& store) : store_(store) {}
+
+FixtureDecodeWorker::~FixtureDecodeWorker() {
+    stop();
+}
+
+void FixtureDecodeWorker::start() {
+    if (thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_ = false;
+        pending_ = true;
+    }
+    thread_ = std::thread(&FixtureDecodeWorker::decodeLoop, this);
+}
+
+void FixtureDecodeWorker::stop() {
+    if (!thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stop_ = true;
+    }
+    wake_cv_.notify_one();
+    thread_.join();
+}
+
+uint64_t FixtureDecodeWorker::setPatch(const FixturePatch* patch, uint32_t count) {
+    uint64_t version;
+    {
+        std::lock_guard<std::mutex> lock(decode_mutex_);
+        decoder_.setPatch(patch, count);
+        version = patch_version_.fetch_add(1) + 1;
+    }
+    notify();
+    return version;
+}
+
+void FixtureDecodeWorker::notify() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        pending_ = true;
+    }
+    wake_cv_.notify_one();
+}
+
+bool FixtureDecodeWorker::decodeLatest() {
+    uint64_t start = dmxClockNs();
+
+    store_.snapshot(snapshot_);
+    uint32_t decoded = decoder_.decode(snapshot_);
+
+    FixtureFrame& frame = decoder_.frame();
+    frame.patch_version = patch_version_.load();
+    frame.decoded_ns = dmxClockNs();
+    frame.decode_ns = frame.decoded_ns - start;
+
+    last_decoded_.store(decoded, std::memory_order_relaxed);
+    if (decoded == 0) {
+        frames_unchanged_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    frames_decoded_.fetch_add(1, std::memory_order_relaxed);
+    last_decode_ns_.store(frame.decode_ns, std::memory_order_relaxed);
+    return true;
+}
+
+void FixtureDecodeWorker::decodeLoop() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_cv_.wait(lock, [this] { return pending_ || stop_; });
+            if (stop_) return;
+            pending_ = false;
+        }
+
+        // Nothing any fixture reads changed - keep the frame the reader has
+        {
+            std::lock_guard<std::mutex> lock(decode_mutex_);
+            if (!decodeLatest()) continue;
+            frames_[back_].copyFrom(decoder_.frame());
+        }
+
+        std::lock_guard<std::mutex> lock(swap_mutex_);
+        std::swap(back_, ready_);
+        ready_fresh_ = true;
+    }
+}
+
+const FixtureFrame& FixtureDecodeWorker::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(swap_mutex_);
+        if (ready_fresh_) {
+            std::swap(front_, ready_);
+            ready_fresh_ = false;
+        }
+    }
+
+    // No decode thread, or the newest frame was decoded against an older patch
+    FixtureFrame& frame = frames_[front_];
+    if (!thread_.joinable() || frame.patch_version != patch_version_.load()) {
+        std::lock_guard<std::mutex> lock(decode_mutex_);
+        decodeLatest();
+        frame.copyFrom(decoder_.frame());
+    }
+    return frame;
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,192 @@
+// fixture_decoder.h - Fixture channel decode into structure-of-arrays
+// Every patched fixture is gathered into the canonical Full (37ch) channel
+// order through a per-mode layout table, then each attribute is converted for
+// all fixtures at once (SIMD affine kernels) into contiguous float rows.
+// Only fixtures whose channel range changed since the previous snapshot are
+// decoded; the rest keep their values. FixtureDecodeWorker runs the decode on
+// its own thread whenever new DMX arrives, so the render tick only picks up the
+// latest finished frame.
+
+#pragma once
+
+#include "universe_store.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RocKontrol {
+
+// Raw values match DMXMode in main.swift
+enum class FixtureMode : uint8_t {
+    Full = 0,       // 37 channels
+    Standard = 1,   // 23 channels - no iris / shutters / prism
+    Compact = 2     // 10 channels - 8-bit position, uniform scale
+};
+
+uint32_t fixtureChannelCount(FixtureMode mode);
+
+// Float attributes, one row of FixtureFrame::capacity values each
+enum class FixtureField : uint32_t {
+    PositionX = 0,          // Canvas widths (-0.2 ... 1.2, 20% overflow each side)
+    PositionY,              // Canvas heights
+    ScaleX,                 // Uniform scale x horizontal multiplier
+    ScaleY,
+    Softness,               // 0-40
+    Opacity,                // 0-1
+    Intensity,              // 0-1
+    Red,                    // 0-1, multiplied by intensity
+    Green,
+    Blue,
+    Rotation,               // Radians
+    Spin,                   // Radians per second (negative = CCW)
+    VideoMaskBlend,         // 0-1
+    VideoVolume,            // 0-1
+    Iris,                   // 0-1 (1 = open)
+    ShutterTopInsertion,    // 0-1
+    ShutterTopAngle,        // Radians (+-pi/4)
+    ShutterBottomInsertion,
+    ShutterBottomAngle,
+    ShutterLeftInsertion,
+    ShutterLeftAngle,
+    ShutterRightInsertion,
+    ShutterRightAngle,
+    ShutterRotation,
+    Count
+};
+
+// Channels that select a behaviour rather than a level, passed through raw
+enum class FixtureByte : uint32_t {
+    Valid = 0,              // 0 = fixture runs past the end of its universe (not decoded)
+    Content,                // CH1 shape / gobo / media slot
+    Z,
+    Playback,               // Video playback control
+    Prism,
+    Animation,
+    Prismatics,
+    PrismRotation,
+    Count
+};
+
+struct FixturePatch {
+    FixtureMode mode = FixtureMode::Full;
+    uint16_t universe = 1;
+    uint16_t address = 1;   // 1-based start address
+};
+
+// One decoded frame: fields[field * capacity + slot], bytes[byte * capacity + slot]
+struct FixtureFrame {
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+    uint64_t sequence = 0;          // Decode pass that produced this frame
+    uint32_t decoded = 0;           // Fixtures that pass decoded (the rest were unchanged)
+    uint64_t patch_version = 0;
+    uint64_t decoded_ns = 0;        // When the decode finished
+    uint64_t decode_ns = 0;         // How long it took
+    std::vector<float> fields;
+    std::vector<uint8_t> bytes;
+    std::vector<uint64_t> stamps;   // Per slot: sequence of the pass that last decoded it
+
+    void reserve(uint32_t fixtures);
+    void copyFrom(const FixtureFrame& other);
+    float* field(FixtureField f) { return fields.data() + (size_t)f * capacity; }
+    const float* field(FixtureField f) const { return fields.data() + (size_t)f * capacity; }
+    uint8_t* byteRow(FixtureByte b) { return bytes.data() + (size_t)b * capacity; }
+    const uint8_t* byteRow(FixtureByte b) const { return bytes.data() + (size_t)b * capacity; }
+};
+
+// The decode kernel - not thread-safe, one caller at a time
+class FixtureDecoder {
+public:
+    static constexpr uint32_t kCanonicalChannels = 37;
+
+    // The next decode() decodes every fixture
+    void setPatch(const FixturePatch* patch, uint32_t count);
+    uint32_t fixtureCount() const { return (uint32_t)patch_.size(); }
+
+    // Update frame() from the snapshot, decoding only fixtures whose channels
+    // changed since the previous snapshot. Returns how many were decoded.
+    uint32_t decode(const UniverseSnapshot& snapshot);
+
+    FixtureFrame& frame() { return frame_; }
+    const FixtureFrame& frame() const { return frame_; }
+    uint64_t totalDecoded() const { return total_decoded_; }
+
+private:
+    void convert(const UniverseSnapshot& snapshot, FixtureFrame& out, uint32_t n);
+
+    std::vector<FixturePatch> patch_;
+    bool repatched_ = true;
+    FixtureFrame frame_;                    // Every fixture as of the last decode
+    FixtureFrame scratch_;                  // Dirty fixtures, packed
+    std::vector<uint32_t> dirty_;           // Slots decoded this pass
+    std::vector<uint32_t> compact_;         // Packed rows with uniform scale only
+    std::vector<uint8_t> stage_;            // kCanonicalChannels rows of gathered bytes
+    uint32_t stage_capacity_ = 0;
+    uint64_t total_decoded_ = 0;
+};
+
+// Decodes on a dedicated thread whenever notify() is called (new DMX or a new
+// patch) and hands frames to one reader through a triple buffer.
+class FixtureDecodeWorker {
+public:
+    explicit FixtureDecodeWorker(const UniverseStore& store);
+    ~FixtureDecodeWorker();
+
+    FixtureDecodeWorker(const FixtureDecodeWorker&) = delete;
+    FixtureDecodeWorker& operator=(const FixtureDecodeWorker&) = delete;
+
+    void start();
+    void stop();
+
+    // Returns the new patch version; the next decoded frame carries it
+    uint64_t setPatch(const FixturePatch* patch, uint32_t count);
+    uint64_t patchVersion() const { return patch_version_.load(); }
+
+    // Wake the decode thread (called from ingest after each receive batch)
+    void notify();
+
+    // Latest finished frame. If it predates the current patch, decode on the
+    // calling thread first. The frame stays valid until the next acquire().
+    const FixtureFrame& acquire();
+
+    // Statistics
+    uint64_t framesDecoded() const { return frames_decoded_.load(std::memory_order_relaxed); }
+    uint64_t framesUnchanged() const { return frames_unchanged_.load(std::memory_order_relaxed); }   // Wakeups with nothing to decode
+    uint32_t lastFixturesDecoded() const { return last_decoded_.load(std::memory_order_relaxed); }
+    uint64_t lastDecodeNs() const { return last_decode_ns_.load(std::memory_order_relaxed); }
+
+private:
+    void decodeLoop();
+    bool decodeLatest();                // Caller holds decode_mutex_; false if nothing changed
+
+    const UniverseStore& store_;
+
+    std::mutex decode_mutex_;           // Decoder, snapshot and the back frame
+    FixtureDecoder decoder_;
+    UniverseSnapshot snapshot_;
+    FixtureFrame frames_[3];
+
+    std::mutex swap_mutex_;             // Triple buffer indices
+    uint32_t back_ = 0;
+    uint32_t ready_ = 1;
+    uint32_t front_ = 2;
+    bool ready_fresh_ = false;
+
+    std::thread thread_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    bool pending_ = false;
+    bool stop_ = false;
+
+    std::atomic<uint64_t> patch_version_{0};
+    std::atomic<uint64_t> frames_decoded_{0};
+    std::atomic<uint64_t> frames_unchanged_{0};
+    std::atomic<uint32_t> last_decoded_{0};
+    std::atomic<uint64_t> last_decode_ns_{0};
+};
+
+} // namespace RocKontrol
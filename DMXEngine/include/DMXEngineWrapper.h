@@ -0,0 +1,233 @@
+// DMXEngineWrapper.h - Objective-C bridge for Swift to access the C++ DMX engine
+// This header exposes Art-Net / sACN ingest and the universe store to Swift
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+#pragma mark - Enums
+
+typedef NS_OPTIONS(NSUInteger, GDDMXProtocols) {
+    GDDMXProtocolArtNet = 1 << 0,
+    GDDMXProtocolSACN = 1 << 1
+};
+
+// Float rows of a decoded fixture frame (mirrors FixtureField in fixture_decoder.h)
+typedef NS_ENUM(NSInteger, GDFixtureField) {
+    GDFixtureFieldPositionX = 0,        // Canvas widths, -0.2 ... 1.2
+    GDFixtureFieldPositionY,            // Canvas heights
+    GDFixtureFieldScaleX,
+    GDFixtureFieldScaleY,
+    GDFixtureFieldSoftness,             // 0-40
+    GDFixtureFieldOpacity,
+    GDFixtureFieldIntensity,
+    GDFixtureFieldRed,                  // Multiplied by intensity
+    GDFixtureFieldGreen,
+    GDFixtureFieldBlue,
+    GDFixtureFieldRotation,             // Radians
+    GDFixtureFieldSpin,                 // Radians per second
+    GDFixtureFieldVideoMaskBlend,
+    GDFixtureFieldVideoVolume,
+    GDFixtureFieldIris,
+    GDFixtureFieldShutterTopInsertion,
+    GDFixtureFieldShutterTopAngle,      // Radians
+    GDFixtureFieldShutterBottomInsertion,
+    GDFixtureFieldShutterBottomAngle,
+    GDFixtureFieldShutterLeftInsertion,
+    GDFixtureFieldShutterLeftAngle,
+    GDFixtureFieldShutterRightInsertion,
+    GDFixtureFieldShutterRightAngle,
+    GDFixtureFieldShutterRotation
+};
+
+// Raw byte rows of a decoded fixture frame (mirrors FixtureByte)
+typedef NS_ENUM(NSInteger, GDFixtureByte) {
+    GDFixtureByteValid = 0,             // 0 = fixture runs past the end of its universe
+    GDFixtureByteContent,
+    GDFixtureByteZ,
+    GDFixtureBytePlayback,
+    GDFixtureBytePrism,
+    GDFixtureByteAnimation,
+    GDFixtureBytePrismatics,
+    GDFixtureBytePrismRotation
+};
+
+#pragma mark - Fixture Frame
+
+// Every patched fixture decoded as structure-of-arrays: value of a field for
+// patch slot i is fields[field * stride + i]. Borrowed from the engine and
+// valid until the next acquireFixtureFrame. Only fixtures whose channels
+// changed are decoded; stamps[i] is the sequence of the pass that last
+// decoded slot i, so a slot changed since sequence s if stamps[i] > s.
+typedef struct {
+    NSInteger count;
+    NSInteger stride;
+    const float *fields;
+    const uint8_t *bytes;
+    const uint64_t *stamps;
+    uint64_t sequence;
+    NSInteger decodedCount;             // Fixtures decoded by the pass that made this frame
+    uint64_t patchVersion;
+    uint64_t decodeNanoseconds;
+} GDFixtureFrame;
+
+#pragma mark - sACN Source
+
+@interface GDSACNSource : NSObject
+@property (nonatomic, copy) NSString *cid;          // Component identifier (UUID string)
+@property (nonatomic, copy) NSString *name;         // Source name from the framing layer
+@property (nonatomic) NSInteger universe;
+@property (nonatomic) NSInteger priority;           // 0-200
+@property (nonatomic) BOOL winning;                 // At the universe's highest priority (merged HTP)
+@property (nonatomic) uint64_t packetCount;
+@property (nonatomic) uint64_t sequenceErrorCount;  // Out-of-order packets dropped
+@property (nonatomic) uint64_t duplicateCount;      // Repeated sequence numbers (copy from a backup network)
+@property (nonatomic) uint64_t sequenceGapCount;    // Jumps past the next sequence number
+@property (nonatomic) double secondsSinceLastPacket;
+@property (nonatomic) double packetsPerSecond;
+@property (nonatomic) double jitter;                // Seconds, running mean inter-arrival change
+@end
+
+#pragma mark - Receive Shard
+
+@interface GDReceiveShard : NSObject
+@property (nonatomic) NSInteger index;
+@property (nonatomic) NSInteger firstUniverse;      // sACN universes joined (0 when none)
+@property (nonatomic) NSInteger lastUniverse;
+@property (nonatomic) BOOL readsArtNet;
+@property (nonatomic) NSInteger socketCount;
+@property (nonatomic) uint64_t packetCount;         // Datagrams read
+@property (nonatomic) uint64_t batchCount;
+@property (nonatomic) double secondsSinceLastPacket;
+@end
+
+#pragma mark - Universe Statistics
+
+// Timing histograms are log2 buckets: bucket 0 is below 250 us and bucket i
+// below 250 us << i; the last one is open-ended (see timingHistogramLimits).
+@interface GDUniverseStats : NSObject
+@property (nonatomic) NSInteger universe;
+@property (nonatomic) GDDMXProtocols protocol;       // Of the latest packet
+@property (nonatomic) uint64_t packetCount;
+@property (nonatomic) double packetsPerSecond;
+@property (nonatomic) double interval;              // Seconds, running mean
+@property (nonatomic) double jitter;                // Seconds, running mean inter-arrival change
+@property (nonatomic, copy) NSArray<NSNumber *> *jitterHistogram;
+@property (nonatomic) uint64_t sequenceGapCount;    // Art-Net only - sACN gaps are per source
+@property (nonatomic) double secondsSinceLastPacket;
+// Ingest to render: packet arrival to the captureFrame that took it
+@property (nonatomic) uint64_t frameCount;
+@property (nonatomic) double latency;               // Seconds, latest frame
+@property (nonatomic) double latencyMean;
+@property (nonatomic) double latencyMax;
+@property (nonatomic, copy) NSArray<NSNumber *> *latencyHistogram;
+@end
+
+#pragma mark - DMX Engine
+
+@interface GDDMXEngine : NSObject
+
+// Bind the protocol sockets and start the receive thread.
+// sACN joins multicast groups startUniverse ... startUniverse + universeCount - 1
+// unless loopback is set (unicast only).
+- (BOOL)startWithProtocols:(GDDMXProtocols)protocols
+               interfaceIP:(NSString *)interfaceIP
+                  loopback:(BOOL)loopback
+             startUniverse:(NSInteger)startUniverse
+             universeCount:(NSInteger)universeCount;
+// Listen on several interfaces at once (primary / backup networks feed the
+// same universes) with receiveThreads shards; sACN multicast groups are split
+// into contiguous ranges, one socket and thread per range.
+- (BOOL)startWithProtocols:(GDDMXProtocols)protocols
+              interfaceIPs:(NSArray<NSString *> *)interfaceIPs
+                  loopback:(BOOL)loopback
+             startUniverse:(NSInteger)startUniverse
+             universeCount:(NSInteger)universeCount
+            receiveThreads:(NSInteger)receiveThreads;
+- (void)stop;
+@property (readonly) BOOL isRunning;
+
+// Universe numbering, applied on the next start: store universe = wire
+// universe + offset. Art-Net defaults to +1 (port-address 0 is universe 1),
+// sACN to 0. Packets mapping outside 0-65535 are dropped.
+@property (nonatomic) NSInteger artNetUniverseOffset;
+@property (nonatomic) NSInteger sacnUniverseOffset;
+
+// Copy 512 slots of a universe into buffer. Returns NO (and zeros) if it was never received.
+- (BOOL)copyUniverse:(NSInteger)universe into:(uint8_t *)buffer;
+- (BOOL)hasReceivedDataForUniverse:(NSInteger)universe;
+
+// Frame snapshot: copy every universe once (tear-free per universe), then read
+// borrowed pointers with no locking or copying. Call from one thread only.
+// Also records ingest-to-render latency for every universe with a new packet.
+- (void)captureFrame;
+// 512 slots of a universe in the captured frame (zeros if never received).
+// The pointer is valid until the next captureFrame.
+- (const uint8_t *)frameUniverse:(NSInteger)universe;
+- (BOOL)frameHasUniverse:(NSInteger)universe;
+// Whether any of count slots from start (0-based) changed since the previous captureFrame
+- (BOOL)frameUniverse:(NSInteger)universe changedFrom:(NSInteger)start count:(NSInteger)count;
+
+// Fixture decode: a worker thread decodes every patched fixture whenever new
+// DMX arrives. Modes are DMXMode raw values (0 = full, 1 = standard,
+// 2 = compact); addresses are 1-based. Returns the new patch version.
+- (uint64_t)setFixturePatchWithModes:(const uint8_t *)modes
+                           universes:(const uint16_t *)universes
+                           addresses:(const uint16_t *)addresses
+                               count:(NSInteger)count;
+// Latest decoded frame (decodes on the calling thread if it predates the patch).
+// Call from one thread only.
+- (GDFixtureFrame)acquireFixtureFrame;
+@property (readonly) uint64_t fixtureFramesDecoded;       // Decode passes that changed at least one fixture
+@property (readonly) uint64_t fixtureFramesUnchanged;     // Wakeups where no patched channel changed
+@property (readonly) NSInteger fixturesDecodedLastFrame;
+
+// Statistics
+@property (readonly) uint64_t packetCount;        // DMX packets applied
+@property (readonly) uint64_t invalidPacketCount;
+@property (readonly) uint64_t unmappedPacketCount;    // Dropped by the universe offset mapping
+@property (readonly) uint64_t duplicatePacketCount;   // Second copies from a backup network
+@property (readonly) NSArray<GDReceiveShard *> *receiveShards;
+@property (readonly) uint64_t receiveBatchCount;  // Socket reads (each drains up to one batch)
+@property (readonly) NSDate *lastPacketTime;      // distantPast before the first packet
+
+// Per-universe rate, jitter, sequence gaps and ingest-to-render latency
+@property (readonly) NSArray<GDUniverseStats *> *universeStats;
+@property (class, readonly) NSArray<NSNumber *> *timingHistogramLimits;    // Upper bucket edges in seconds (last: 0, open-ended)
+
+// Capture: append every received Art-Net / sACN datagram to a file
+- (BOOL)startCaptureToPath:(NSString *)path;
+- (void)stopCapture;
+@property (readonly) BOOL isCapturing;
+@property (readonly) uint64_t capturePacketCount;
+@property (readonly) uint64_t captureByteCount;
+@property (readonly) uint64_t captureWriteErrorCount;   // Records lost to write errors (disk full)
+
+// Replay a capture through the ingest path. Live receive is stopped for the
+// replay and restarted by stopReplay. speed: 1 = as recorded, N = N times
+// faster, 0 = as fast as ingest takes it (load test).
+- (BOOL)startReplayFromPath:(NSString *)path speed:(double)speed loop:(BOOL)loop;
+- (void)stopReplay;
+@property (readonly) BOOL isReplaying;
+@property (readonly) uint64_t replayRecordCount;          // Datagrams in the capture file
+@property (readonly) double replayDuration;               // Seconds, as recorded
+@property (readonly) uint64_t replayPacketCount;          // Datagrams replayed this run
+@property (readonly) uint64_t replayLoopCount;
+@property (readonly) double replayPacketsPerSecond;       // Over the current / last run
+
+// sACN merge (highest priority wins, HTP within a priority, 2.5 s source timeout)
+@property (readonly) NSArray<GDSACNSource *> *sacnSources;
+@property (readonly) NSInteger sacnActiveSourceCount;
+@property (readonly) uint64_t sacnSequenceErrorCount;
+@property (readonly) uint64_t sacnSourcesTimedOut;
+
+// Universe synchronization (ArtSync / E1.31 sync). Universes written while a
+// console sends sync packets are held back and published together on the sync.
+@property (readonly) uint64_t syncLatchedFrameCount;      // Sync packets that published universes
+@property (readonly) uint64_t syncLatchedUniverseCount;   // Universe updates published by a sync
+@property (readonly) uint64_t unsyncedUniverseCount;      // Universe updates applied immediately
+@property (readonly) uint64_t syncTimeoutCount;           // Fallbacks to immediate mode
+
+@end
+
+NS_ASSUME_NONNULL_END
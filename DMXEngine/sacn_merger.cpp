@@ -0,0 +1,234 @@
+// sacn_merger.cpp - E1.31 multi-source merge
+// Portable C++ - receive rules from ANSI E1.31-2018 sections 6.2.6, 6.7.2 and 6.7.1
+
+#include "sacn_merger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace RocKontrol {
+
+namespace {
+constexpr uint8_t kMaxPriority = 200;
+}
+
+SACNMerger::SACNMerger(SyncLatch& output)
+    : output_(output), index_(UniverseStore::kUniverseRange), universes_(UniverseStore::kMaxUniverses) {
+    for (auto& entry : index_) entry.store(0, std::memory_order_relaxed);
+}
+
+SACNMerger::Universe* SACNMerger::universeFor(uint16_t universe) {
+    // Only this universe's stripe claims it, so the entry cannot appear meanwhile
+    uint16_t entry = index_[universe].load(std::memory_order_acquire);
+    if (entry != 0) return &universes_[entry - 1];
+
+    std::lock_guard<std::mutex> lock(claim_mutex_);
+    uint32_t used = used_.load(std::memory_order_relaxed);
+    if (used >= UniverseStore::kMaxUniverses || !universes_.reserve(used + 1)) return nullptr;
+
+    Universe& u = universes_[used];
+    u = Universe{};
+    u.universe = universe;
+    used_.store(used + 1, std::memory_order_release);
+    index_[universe].store((uint16_t)(used + 1), std::memory_order_release);
+    return &u;
+}
+
+bool SACNMerger::apply(const DMXPacket& packet, uint64_t nowNs) {
+    // A visualizer is not a preview display
+    if (packet.options & kSACNOptionPreview) {
+        preview_packets_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(lockFor(packet.universe));
+    Universe* u = universeFor(packet.universe);
+    if (!u) {
+        sources_rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Find the source by CID
+    uint32_t index = kMaxSourcesPerUniverse;
+    uint32_t freeIndex = kMaxSourcesPerUniverse;
+    for (uint32_t i = 0; i < kMaxSourcesPerUniverse; i++) {
+        const Source& s = u->sources[i];
+        if (!s.active) {
+            if (freeIndex == kMaxSourcesPerUniverse) freeIndex = i;
+        } else if (memcmp(s.cid.data(), packet.cid, s.cid.size()) == 0) {
+            index = i;
+            break;
+        }
+    }
+
+    bool terminated = (packet.options & kSACNOptionTerminated) != 0;
+
+    if (index == kMaxSourcesPerUniverse) {
+        if (terminated) return false;
+        if (freeIndex == kMaxSourcesPerUniverse) {
+            sources_rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        index = freeIndex;
+        Source& s = u->sources[index];
+        s = Source{};
+        s.active = true;
+        memcpy(s.cid.data(), packet.cid, s.cid.size());
+        u->source_count++;
+        active_sources_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        // Out of order if the new sequence is 0 to 19 behind the last one (wrap-aware).
+        // The same number again is the copy from a redundant network.
+        int8_t diff = (int8_t)(uint8_t)(packet.sequence - u->sources[index].sequence);
+        if (diff == 0) {
+            u->sources[index].duplicates++;
+            duplicate_packets_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (diff < 0 && diff > -20) {
+            u->sources[index].sequence_errors++;
+            sequence_errors_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (diff > 1) u->sources[index].sequence_gaps++;
+    }
+
+    if (terminated) {
+        removeSource(*u, index);
+        sources_terminated_.fetch_add(1, std::memory_order_relaxed);
+        merge(*u, nowNs);
+        return true;
+    }
+
+    Source& s = u->sources[index];
+    u->sync_address = packet.syncAddress;
+    s.priority = std::min(packet.priority, kMaxPriority);
+    s.sequence = packet.sequence;
+    s.last_seen_ns = nowNs;
+    s.packets++;
+    s.timing.update(nowNs);
+
+    // Slots past the end of a short packet count as zero
+    memcpy(s.levels.data(), packet.slots, packet.slotCount);
+    if (packet.slotCount < s.slot_count) {
+        memset(s.levels.data() + packet.slotCount, 0, s.slot_count - packet.slotCount);
+    }
+    s.slot_count = packet.slotCount;
+
+    if (packet.sourceName && s.packets == 1) {
+        strncpy(s.name, packet.sourceName, sizeof(s.name) - 1);
+        s.name[sizeof(s.name) - 1] = '\0';
+    }
+
+    merge(*u, nowNs);
+    return true;
+}
+
+void SACNMerger::removeSource(Universe& u, uint32_t index) {
+    u.sources[index].active = false;
+    u.source_count--;
+    active_sources_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void SACNMerger::merge(Universe& u, uint64_t nowNs) {
+    // No sources left - hold the last look
+    if (u.source_count == 0) return;
+
+    uint8_t winning = 0;
+    for (const Source& s : u.sources) {
+        if (s.active) winning = std::max(winning, s.priority);
+    }
+    u.winning_priority = winning;
+
+    const Source* first = nullptr;
+    uint32_t winners = 0;
+    for (const Source& s : u.sources) {
+        if (s.active && s.priority == winning) {
+            if (!first) first = &s;
+            winners++;
+        }
+    }
+
+    // Single winner (the common case) is written without a merge pass
+    if (winners == 1) {
+        output_.write(u.universe, first->levels.data(), kDMXSlots, nowNs, u.sync_address);
+        return;
+    }
+
+    // HTP among sources at the winning priority
+    u.merged = first->levels;
+    for (const Source& s : u.sources) {
+        if (!s.active || s.priority != winning || &s == first) continue;
+        for (uint32_t i = 0; i < s.slot_count; i++) {
+            u.merged[i] = std::max(u.merged[i], s.levels[i]);
+        }
+    }
+    output_.write(u.universe, u.merged.data(), kDMXSlots, nowNs, u.sync_address);
+}
+
+void SACNMerger::expire(uint64_t nowNs) {
+    uint32_t used = used_.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < used; i++) {
+        Universe& u = universes_[i];
+        std::lock_guard<std::mutex> lock(lockFor(u.universe));
+        if (u.source_count == 0) continue;
+
+        bool removed = false;
+        for (uint32_t j = 0; j < kMaxSourcesPerUniverse; j++) {
+            const Source& s = u.sources[j];
+            if (s.active && nowNs > s.last_seen_ns && nowNs - s.last_seen_ns > kSourceTimeoutNs) {
+                removeSource(u, j);
+                sources_timed_out_.fetch_add(1, std::memory_order_relaxed);
+                removed = true;
+            }
+        }
+        if (removed) merge(u, nowNs);
+    }
+}
+
+void SACNMerger::reset() {
+    // Every stripe, in order (apply() holds one stripe, then claim_mutex_)
+    for (Stripe& stripe : stripes_) stripe.mutex.lock();
+    {
+        std::lock_guard<std::mutex> lock(claim_mutex_);
+        uint32_t used = used_.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < used; i++) {
+            index_[universes_[i].universe].store(0, std::memory_order_relaxed);
+        }
+        used_.store(0, std::memory_order_release);
+        active_sources_.store(0, std::memory_order_relaxed);
+    }
+    for (Stripe& stripe : stripes_) stripe.mutex.unlock();
+}
+
+std::vector<SACNSourceInfo> SACNMerger::sources() const {
+    uint64_t now = dmxClockNs();
+    std::vector<SACNSourceInfo> result;
+    uint32_t used = used_.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < used; i++) {
+        const Universe& u = universes_[i];
+        std::lock_guard<std::mutex> lock(lockFor(u.universe));
+        for (const Source& s : u.sources) {
+            if (!s.active) continue;
+
+            SACNSourceInfo info;
+            info.cid = s.cid;
+            info.name = s.name;
+            info.universe = u.universe;
+            info.priority = s.priority;
+            info.winning = s.priority == u.winning_priority;
+            info.packets = s.packets;
+            info.sequence_errors = s.sequence_errors;
+            info.duplicates = s.duplicates;
+            info.sequence_gaps = s.sequence_gaps;
+            info.last_seen_ns = s.last_seen_ns;
+            info.rate_hz = s.timing.rate(now);
+            info.interval_ns = s.timing.interval_ns;
+            info.jitter_ns = s.timing.jitter_ns;
+            result.push_back(std::move(info));
+        }
+    }
+    return result;
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,131 @@
+// sacn_merger.h - E1.31 multi-source merge
+// Tracks every source (CID) per universe in fixed tables: the highest priority
+// wins, sources sharing that priority merge HTP, sources time out after 2.5 s
+// of silence or on a stream-terminated packet, and out-of-order sequence
+// numbers are rejected. Merged universes go out through a SyncLatch under the
+// winning packet's synchronization address. All time comes from the caller, so
+// a recorded packet stream replays deterministically. Universe tables are
+// locked in stripes by universe number rather than under one lock, so receive
+// shards reading different universes do not serialize on the merge.
+
+#pragma once
+
+#include "dmx_protocol.h"
+#include "dmx_stats.h"
+#include "sync_latch.h"
+#include "universe_arena.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RocKontrol {
+
+struct SACNSourceInfo {
+    std::array<uint8_t, 16> cid{};
+    std::string name;
+    uint16_t universe = 0;
+    uint8_t priority = 0;
+    bool winning = false;           // Contributes to the merged output
+    uint64_t packets = 0;
+    uint64_t sequence_errors = 0;   // Out-of-order packets dropped
+    uint64_t duplicates = 0;        // Repeated sequence numbers (same packet on a second network)
+    uint64_t sequence_gaps = 0;     // Jumps past the next sequence number (lost packets)
+    uint64_t last_seen_ns = 0;
+    double rate_hz = 0.0;
+    uint64_t interval_ns = 0;       // Running mean inter-arrival time
+    uint64_t jitter_ns = 0;         // Running mean inter-arrival change
+};
+
+class SACNMerger {
+public:
+    static constexpr uint32_t kMaxSourcesPerUniverse = 8;
+    static constexpr uint32_t kLockStripes = 64;
+    static constexpr uint64_t kSourceTimeoutNs = 2500000000ull;    // E1.31 network data loss
+
+    explicit SACNMerger(SyncLatch& output);
+
+    SACNMerger(const SACNMerger&) = delete;
+    SACNMerger& operator=(const SACNMerger&) = delete;
+
+    // Apply one sACN DMX packet received at nowNs and write the merged universe
+    // to the output. Only allocates when a new universe opens an arena chunk.
+    // False when the packet was dropped (preview, out of order, duplicate, no room).
+    bool apply(const DMXPacket& packet, uint64_t nowNs);
+
+    // Drop sources silent for longer than the timeout and re-merge their universes
+    void expire(uint64_t nowNs);
+
+    // Forget every source. Tables are reused afterwards, so only while no other
+    // thread applies packets or expires sources.
+    void reset();
+
+    // Per-source state (allocates - not for the packet path)
+    std::vector<SACNSourceInfo> sources() const;
+
+    // Statistics
+    uint32_t activeSources() const { return active_sources_.load(std::memory_order_relaxed); }
+    uint64_t sequenceErrors() const { return sequence_errors_.load(std::memory_order_relaxed); }
+    uint64_t duplicatePackets() const { return duplicate_packets_.load(std::memory_order_relaxed); }
+    uint64_t previewPackets() const { return preview_packets_.load(std::memory_order_relaxed); }
+    uint64_t sourcesTimedOut() const { return sources_timed_out_.load(std::memory_order_relaxed); }
+    uint64_t sourcesTerminated() const { return sources_terminated_.load(std::memory_order_relaxed); }
+    uint64_t sourcesRejected() const { return sources_rejected_.load(std::memory_order_relaxed); }
+
+private:
+    struct Source {
+        bool active = false;
+        std::array<uint8_t, 16> cid{};
+        char name[64] = {};
+        uint8_t priority = 0;
+        uint8_t sequence = 0;
+        uint16_t slot_count = 0;
+        uint64_t last_seen_ns = 0;
+        uint64_t packets = 0;
+        uint64_t sequence_errors = 0;
+        uint64_t duplicates = 0;
+        uint64_t sequence_gaps = 0;
+        ArrivalTiming timing;
+        std::array<uint8_t, kDMXSlots> levels{};
+    };
+
+    struct Universe {
+        uint16_t universe = 0;
+        uint16_t sync_address = 0;      // From the latest accepted packet
+        uint32_t source_count = 0;
+        uint8_t winning_priority = 0;
+        std::array<Source, kMaxSourcesPerUniverse> sources;
+        std::array<uint8_t, kDMXSlots> merged{};
+    };
+
+    struct alignas(64) Stripe {
+        std::mutex mutex;
+    };
+
+    std::mutex& lockFor(uint16_t universe) const { return stripes_[universe % kLockStripes].mutex; }
+    Universe* universeFor(uint16_t universe);     // Under lockFor(universe)
+    void removeSource(Universe& u, uint32_t index);
+    void merge(Universe& u, uint64_t nowNs);
+
+    SyncLatch& output_;
+
+    // A table is only touched under its universe's stripe; claiming one also
+    // takes claim_mutex_ for used_ and the arena
+    mutable std::array<Stripe, kLockStripes> stripes_;
+    std::mutex claim_mutex_;
+    std::vector<std::atomic<uint16_t>> index_;  // universe -> table + 1 (0 = none)
+    UniverseArena<Universe> universes_;         // Up to UniverseStore::kMaxUniverses tables
+    std::atomic<uint32_t> used_{0};
+
+    std::atomic<uint32_t> active_sources_{0};
+    std::atomic<uint64_t> sequence_errors_{0};
+    std::atomic<uint64_t> duplicate_packets_{0};
+    std::atomic<uint64_t> preview_packets_{0};
+    std::atomic<uint64_t> sources_timed_out_{0};
+    std::atomic<uint64_t> sources_terminated_{0};
+    std::atomic<uint64_t> sources_rejected_{0};
+};
+
+} // namespace RocKontrol
@@ -0,0 +1,164 @@
+// sync_latch.cpp - ArtSync / E1.31 universe synchronization
+// Portable C++ - staging tables grow in chunks as universes appear; sync never allocates
+
+#include "sync_latch.h"
+#include <algorithm>
+#include <cstring>
+
+namespace RocKontrol {
+
+SyncLatch::SyncLatch(UniverseStore& store)
+    : store_(store), index_(UniverseStore::kUniverseRange, 0), staged_(UniverseStore::kMaxUniverses) {}
+
+SyncLatch::Domain* SyncLatch::findDomain(uint32_t id) {
+    for (Domain& d : domains_) {
+        if (d.id == id) return &d;
+    }
+    return nullptr;
+}
+
+const SyncLatch::Domain* SyncLatch::findDomain(uint32_t id) const {
+    for (const Domain& d : domains_) {
+        if (d.id == id) return &d;
+    }
+    return nullptr;
+}
+
+bool SyncLatch::domainActive(const Domain& d, uint64_t nowNs) const {
+    if (d.id == kNoSync || d.last_sync_ns == 0) return false;
+    uint64_t timeout = d.id == kArtSyncDomain ? kArtSyncTimeoutNs : kSACNSyncTimeoutNs;
+    return nowNs < d.last_sync_ns || nowNs - d.last_sync_ns <= timeout;
+}
+
+bool SyncLatch::isSynchronizing(uint32_t domain, uint64_t nowNs) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const Domain* d = domain != kNoSync ? findDomain(domain) : nullptr;
+    return d && domainActive(*d, nowNs);
+}
+
+bool SyncLatch::writeStore(uint16_t universe, const uint8_t* slots, uint32_t count, uint64_t timestampNs) {
+    if (store_.write(universe, slots, count, timestampNs)) return true;
+    store_full_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool SyncLatch::write(uint16_t universe, const uint8_t* slots, uint32_t count, uint64_t timestampNs, uint32_t domain) {
+    // No domain: nothing staged anywhere, and a sync racing this write only
+    // publishes what was staged before it
+    if (domain_count_.load(std::memory_order_acquire) == 0) {
+        unsynced_writes_.fetch_add(1, std::memory_order_relaxed);
+        return writeStore(universe, slots, count, timestampNs);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    const Domain* d = domain != kNoSync ? findDomain(domain) : nullptr;
+    uint16_t entry = index_[universe];
+
+    if (!d || !domainActive(*d, timestampNs)) {
+        // Immediate mode - anything still staged for this universe is older than this
+        if (entry != 0 && staged_[entry - 1].pending) {
+            staged_[entry - 1].pending = false;
+            pending_--;
+        }
+        unsynced_writes_.fetch_add(1, std::memory_order_relaxed);
+        return writeStore(universe, slots, count, timestampNs);
+    }
+
+    if (entry == 0) {
+        if (used_ >= UniverseStore::kMaxUniverses || !staged_.reserve(used_ + 1)) {
+            unsynced_writes_.fetch_add(1, std::memory_order_relaxed);
+            return writeStore(universe, slots, count, timestampNs);
+        }
+        entry = (uint16_t)(++used_);
+        index_[universe] = entry;
+        staged_[entry - 1] = Staged{};
+        staged_[entry - 1].universe = universe;
+    }
+
+    Staged& s = staged_[entry - 1];
+    s.count = std::min(count, kDMXSlots);
+    memcpy(s.values.data(), slots, s.count);
+    s.timestamp_ns = timestampNs;
+    s.domain = domain;
+    if (!s.pending) {
+        s.pending = true;
+        pending_++;
+    }
+    return true;
+}
+
+void SyncLatch::publish(uint32_t domain) {
+    if (pending_ == 0) return;
+
+    uint64_t published = 0;
+    for (uint32_t i = 0; i < used_ && pending_ > 0; i++) {
+        Staged& s = staged_[i];
+        if (!s.pending || s.domain != domain) continue;
+
+        if (published == 0) store_.beginBatch();
+        writeStore(s.universe, s.values.data(), s.count, s.timestamp_ns);
+        s.pending = false;
+        pending_--;
+        published++;
+    }
+
+    if (published > 0) {
+        store_.endBatch();
+        latched_frames_.fetch_add(1, std::memory_order_relaxed);
+        latched_universes_.fetch_add(published, std::memory_order_relaxed);
+    }
+}
+
+void SyncLatch::sync(uint32_t domain, uint64_t nowNs) {
+    if (domain == kNoSync) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Domain* d = findDomain(domain);
+    if (!d) {
+        // New domain - take a free entry, else the one that synced longest ago
+        d = &domains_[0];
+        for (Domain& candidate : domains_) {
+            if (candidate.id == kNoSync) {
+                d = &candidate;
+                break;
+            }
+            if (candidate.last_sync_ns < d->last_sync_ns) d = &candidate;
+        }
+        if (d->id != kNoSync) {
+            publish(d->id);
+        } else {
+            domain_count_.fetch_add(1, std::memory_order_release);
+        }
+        d->id = domain;
+    }
+
+    d->last_sync_ns = nowNs;
+    publish(domain);
+}
+
+void SyncLatch::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Domain& d : domains_) {
+        if (d.id == kNoSync) continue;
+        publish(d.id);
+        d = Domain{};
+    }
+    domain_count_.store(0, std::memory_order_release);
+}
+
+void SyncLatch::expire(uint64_t nowNs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (Domain& d : domains_) {
+        if (d.id == kNoSync || domainActive(d, nowNs)) continue;
+
+        // Sync packets stopped - show what was staged and go back to immediate mode
+        publish(d.id);
+        d = Domain{};
+        domain_count_.fetch_sub(1, std::memory_order_release);
+        sync_timeouts_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,99 @@
+// sync_latch.h - ArtSync / E1.31 universe synchronization
+// Universe writes tagged with a sync domain are staged in a back buffer and
+// published to the UniverseStore in one batch when that domain's sync packet
+// arrives, so a frame spread over many universes lands all at once. A domain
+// that has not seen a sync packet within its timeout runs in immediate mode.
+// Until some domain has seen a sync packet nothing can be staged, so writes
+// go straight to the store without taking the latch's lock.
+
+#pragma once
+
+#include "dmx_protocol.h"
+#include "universe_arena.h"
+#include "universe_store.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace RocKontrol {
+
+class SyncLatch {
+public:
+    // Sync domains: 0 = unsynchronized, 1-63999 = sACN synchronization address,
+    // kArtSyncDomain = ArtSync
+    static constexpr uint32_t kNoSync = 0;
+    static constexpr uint32_t kArtSyncDomain = 0x10000;
+    static constexpr uint32_t kMaxDomains = 16;
+    static constexpr uint64_t kArtSyncTimeoutNs = 4000000000ull;   // Art-Net 4: back to immediate after 4 s
+    static constexpr uint64_t kSACNSyncTimeoutNs = 2500000000ull;  // E1.31 network data loss
+
+    explicit SyncLatch(UniverseStore& store);
+
+    SyncLatch(const SyncLatch&) = delete;
+    SyncLatch& operator=(const SyncLatch&) = delete;
+
+    // Write now (domain not synchronizing) or stage until the domain's next sync
+    bool write(uint16_t universe, const uint8_t* slots, uint32_t count, uint64_t timestampNs, uint32_t domain);
+
+    // Sync packet for a domain: publish everything staged for it in one store batch
+    void sync(uint32_t domain, uint64_t nowNs);
+
+    // Domains whose sync packets stopped fall back to immediate mode; their
+    // staged universes are published as they are
+    void expire(uint64_t nowNs);
+
+    // Forget every domain (back to immediate mode); staged universes are
+    // published as they are
+    void reset();
+
+    // True while sync packets for the domain keep arriving
+    bool isSynchronizing(uint32_t domain, uint64_t nowNs) const;
+
+    // Statistics
+    uint64_t latchedFrames() const { return latched_frames_.load(std::memory_order_relaxed); }         // Sync packets that published
+    uint64_t latchedUniverses() const { return latched_universes_.load(std::memory_order_relaxed); }   // Universe writes published by a sync
+    uint64_t unsyncedWrites() const { return unsynced_writes_.load(std::memory_order_relaxed); }       // Universe writes applied immediately
+    uint64_t syncTimeouts() const { return sync_timeouts_.load(std::memory_order_relaxed); }           // Domains that fell back to immediate
+    uint64_t storeFull() const { return store_full_.load(std::memory_order_relaxed); }
+
+private:
+    struct Domain {
+        uint32_t id = kNoSync;
+        uint64_t last_sync_ns = 0;
+    };
+
+    struct Staged {
+        uint16_t universe = 0;
+        uint32_t domain = kNoSync;
+        bool pending = false;
+        uint32_t count = 0;
+        uint64_t timestamp_ns = 0;
+        std::array<uint8_t, kDMXSlots> values{};
+    };
+
+    Domain* findDomain(uint32_t id);
+    const Domain* findDomain(uint32_t id) const;
+    bool domainActive(const Domain& d, uint64_t nowNs) const;
+    void publish(uint32_t domain);
+    bool writeStore(uint16_t universe, const uint8_t* slots, uint32_t count, uint64_t timestampNs);
+
+    UniverseStore& store_;
+
+    mutable std::mutex mutex_;
+    std::array<Domain, kMaxDomains> domains_;
+    std::atomic<uint32_t> domain_count_{0};    // Domains with an id; changed under mutex_
+    std::vector<uint16_t> index_;       // universe -> staged + 1 (0 = none)
+    UniverseArena<Staged> staged_;      // Up to UniverseStore::kMaxUniverses entries
+    uint32_t used_ = 0;
+    uint32_t pending_ = 0;
+
+    std::atomic<uint64_t> latched_frames_{0};
+    std::atomic<uint64_t> latched_universes_{0};
+    std::atomic<uint64_t> unsynced_writes_{0};
+    std::atomic<uint64_t> sync_timeouts_{0};
+    std::atomic<uint64_t> store_full_{0};
+};
+
+} // namespace RocKontrol
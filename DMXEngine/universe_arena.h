@@ -0,0 +1,43 @@
+// universe_arena.h - Sparse per-universe tables
+// Entries live in fixed-size chunks allocated when the first entry landing in
+// them is claimed, so a table sized for every Art-Net port-address only costs
+// memory for the universes actually received. Entries never move once
+// allocated; callers map universe numbers to entries through their own flat
+// 16-bit index and publish an entry only after reserve() covered it.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace RocKontrol {
+
+template <typename T, uint32_t ChunkEntries = 64>
+class UniverseArena {
+public:
+    explicit UniverseArena(uint32_t capacity) : chunks_((capacity + ChunkEntries - 1) / ChunkEntries) {}
+
+    UniverseArena(const UniverseArena&) = delete;
+    UniverseArena& operator=(const UniverseArena&) = delete;
+
+    uint32_t capacity() const { return (uint32_t)chunks_.size() * ChunkEntries; }
+
+    // Make entries [0, count) addressable. Allocates at most one chunk per
+    // ChunkEntries claims; callers serialize it with their claim path.
+    bool reserve(uint32_t count) {
+        if (count > capacity()) return false;
+        for (uint32_t chunk = 0; chunk * ChunkEntries < count; chunk++) {
+            if (!chunks_[chunk]) chunks_[chunk].reset(new T[ChunkEntries]());
+        }
+        return true;
+    }
+
+    T& operator[](uint32_t i) { return chunks_[i / ChunkEntries][i % ChunkEntries]; }
+    const T& operator[](uint32_t i) const { return chunks_[i / ChunkEntries][i % ChunkEntries]; }
+
+private:
+    std::vector<std::unique_ptr<T[]>> chunks_;
+};
+
+} // namespace RocKontrol
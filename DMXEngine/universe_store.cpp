@@ -0,0 +1,232 @@
+// universe_store.cpp - DMX universe buffers
+// Portable C++ - no Foundation dependency
+
+#include "universe_store.h"
+#include <algorithm>
+#include <cstring>
+
+namespace RocKontrol {
+
+namespace {
+
+// Bit per kDirtyBlockSlots-byte block that differs
+inline uint64_t diffBlocks(const uint8_t* a, const uint8_t* b) {
+    static_assert(kDMXSlots / UniverseStore::kDirtyBlockSlots == 64, "one mask bit per block");
+    uint64_t mask = 0;
+    for (uint32_t block = 0; block < 64; block++) {
+        uint64_t x, y;
+        memcpy(&x, a + block * 8, 8);
+        memcpy(&y, b + block * 8, 8);
+        mask |= (uint64_t)(x != y) << block;
+    }
+    return mask;
+}
+
+} // namespace
+
+// UniverseStore
+
+UniverseStore::UniverseStore() : index_(kUniverseRange), slots_(kMaxUniverses) {
+    for (auto& entry : index_) entry.store(0, std::memory_order_relaxed);
+}
+
+bool UniverseStore::write(uint16_t universe, const uint8_t* slots, uint32_t count, uint64_t timestampNs) {
+    uint16_t entry = index_[universe].load(std::memory_order_acquire);
+    if (entry == 0) {
+        // First packet of the universe: claim, fill and publish under the lock,
+        // so two receive shards seeing it at once cannot both take a slot
+        std::lock_guard<std::mutex> lock(claim_mutex_);
+        entry = index_[universe].load(std::memory_order_relaxed);
+        if (entry == 0) {
+            uint32_t used = used_.load(std::memory_order_relaxed);
+            if (used >= kMaxUniverses || !slots_.reserve(used + 1)) return false;
+
+            Slot& slot = slots_[used];
+            slot.values.fill(0);
+            memcpy(slot.values.data(), slots, std::min(count, kDMXSlots));
+            slot.updated_ns = timestampNs;
+            slot.universe = universe;
+            // Still even; a slot reused after clear() reads as a new write
+            slot.seq.store(slot.seq.load(std::memory_order_relaxed) + 2, std::memory_order_release);
+
+            // Publish the universe only once its first frame is complete
+            used_.store(used + 1, std::memory_order_release);
+            index_[universe].store((uint16_t)(used + 1), std::memory_order_release);
+            return true;
+        }
+    }
+
+    Slot& slot = slots_[entry - 1];
+    while (slot.writing.exchange(true, std::memory_order_acquire)) {
+        cpuRelax();
+    }
+
+    uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy(slot.values.data(), slots, std::min(count, kDMXSlots));
+    slot.updated_ns = timestampNs;
+
+    slot.seq.store(seq + 2, std::memory_order_release);
+    slot.writing.store(false, std::memory_order_release);
+    return true;
+}
+
+uint32_t UniverseStore::readSlot(const Slot& slot, uint8_t* dst, uint64_t* updatedNs) const {
+    for (;;) {
+        uint32_t before = slot.seq.load(std::memory_order_acquire);
+        if (before & 1) {
+            cpuRelax();
+            continue;
+        }
+
+        memcpy(dst, slot.values.data(), kDMXSlots);
+        uint64_t updated = slot.updated_ns;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == before) {
+            if (updatedNs) *updatedNs = updated;
+            return before;
+        }
+    }
+}
+
+bool UniverseStore::read(uint16_t universe, uint8_t* dst) const {
+    uint16_t entry = index_[universe].load(std::memory_order_acquire);
+    if (entry == 0) {
+        memset(dst, 0, kDMXSlots);
+        return false;
+    }
+    readSlot(slots_[entry - 1], dst, nullptr);
+    return true;
+}
+
+uint64_t UniverseStore::lastUpdateNs(uint16_t universe) const {
+    uint16_t entry = index_[universe].load(std::memory_order_acquire);
+    if (entry == 0) return 0;
+
+    const Slot& slot = slots_[entry - 1];
+    for (;;) {
+        uint32_t before = slot.seq.load(std::memory_order_acquire);
+        uint64_t updated = slot.updated_ns;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!(before & 1) && slot.seq.load(std::memory_order_relaxed) == before) return updated;
+        cpuRelax();
+    }
+}
+
+void UniverseStore::snapshot(UniverseSnapshot& out) const {
+    // Diff against what out already holds, unless it came from another store
+    // or slots were handed to other universes since
+    uint32_t epoch = epoch_.load(std::memory_order_acquire);
+    out.full_refresh_ = out.store_ != this || out.epoch_ != epoch;
+    if (out.full_refresh_) {
+        std::fill(out.seq_.begin(), out.seq_.end(), UniverseSnapshot::kNotCopied);
+        std::fill(out.index_.begin(), out.index_.end(), 0);
+    }
+    out.store_ = this;
+    out.epoch_ = epoch;
+    std::fill(out.dirty_.begin(), out.dirty_.end(), 0);
+    std::fill(out.updated_.begin(), out.updated_.end(), 0);
+
+    uint8_t copy[kDMXSlots];
+    for (;;) {
+        uint32_t batch = batch_seq_.load(std::memory_order_acquire);
+        if (batch & 1) {
+            cpuRelax();
+            continue;
+        }
+
+        uint32_t count = used_.load(std::memory_order_acquire);
+        out.grow(count);
+        out.slot_count_ = count;
+        out.taken_ns_ = dmxClockNs();
+        for (uint32_t i = 0; i < count; i++) {
+            // Unchanged since the copy out already has
+            if (slots_[i].seq.load(std::memory_order_acquire) == out.seq_[i]) continue;
+
+            uint8_t* values = out.values_.data() + (size_t)i * kDMXSlots;
+            bool fresh = out.seq_[i] == UniverseSnapshot::kNotCopied;
+            out.seq_[i] = readSlot(slots_[i], copy, &out.updated_ns_[i]);
+            out.dirty_[i] |= fresh ? ~0ull : diffBlocks(values, copy);
+            out.universes_[i] = slots_[i].universe;
+            out.updated_[i] = 1;
+            if (fresh) out.index_[slots_[i].universe] = (uint16_t)(i + 1);
+            memcpy(values, copy, kDMXSlots);
+        }
+
+        // A batch published while copying may be half in this snapshot - take it again
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (batch_seq_.load(std::memory_order_relaxed) == batch) break;
+    }
+
+    out.changed_universes_ = 0;
+    for (uint32_t i = 0; i < out.slot_count_; i++) {
+        if (out.dirty_[i]) out.changed_universes_++;
+    }
+}
+
+void UniverseStore::beginBatch() {
+    batch_seq_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void UniverseStore::endBatch() {
+    batch_seq_.fetch_add(1, std::memory_order_release);
+}
+
+void UniverseStore::clear() {
+    std::lock_guard<std::mutex> lock(claim_mutex_);
+    for (auto& entry : index_) entry.store(0, std::memory_order_relaxed);
+    used_.store(0, std::memory_order_release);
+    epoch_.fetch_add(1, std::memory_order_acq_rel);
+}
+
+// UniverseSnapshot
+
+UniverseSnapshot::UniverseSnapshot() : index_(UniverseStore::kUniverseRange, 0) {
+    grow(kGrowSlots);
+}
+
+void UniverseSnapshot::grow(uint32_t slots) {
+    if (slots <= seq_.size()) return;
+    // Whole chunks, so a rig adding universes one by one reallocates rarely
+    size_t size = ((size_t)slots + kGrowSlots - 1) / kGrowSlots * kGrowSlots;
+    values_.resize(size * kDMXSlots);
+    updated_ns_.resize(size, 0);
+    seq_.resize(size, kNotCopied);
+    dirty_.resize(size, 0);
+    universes_.resize(size, 0);
+    updated_.resize(size, 0);
+}
+
+uint32_t UniverseSnapshot::slotFor(uint16_t universe) const {
+    // Slots claimed after the snapshot was taken are not part of this frame
+    return index_[universe];
+}
+
+const uint8_t* UniverseSnapshot::universe(uint16_t universe) const {
+    uint32_t entry = slotFor(universe);
+    return entry ? values_.data() + (size_t)(entry - 1) * kDMXSlots : zeros_.data();
+}
+
+uint64_t UniverseSnapshot::updatedNs(uint16_t universe) const {
+    uint32_t entry = slotFor(universe);
+    return entry ? updated_ns_[entry - 1] : 0;
+}
+
+bool UniverseSnapshot::changed(uint16_t universe, uint32_t first, uint32_t count) const {
+    if (full_refresh_) return true;
+    if (count == 0 || first >= kDMXSlots) return false;
+
+    uint32_t entry = slotFor(universe);
+    if (entry == 0) return false;   // Still zeros
+
+    uint32_t last = std::min(first + count, kDMXSlots) - 1;
+    uint32_t lo = first / UniverseStore::kDirtyBlockSlots;
+    uint32_t hi = last / UniverseStore::kDirtyBlockSlots;
+    uint64_t mask = (hi == 63 ? ~0ull : ((1ull << (hi + 1)) - 1)) & ~((1ull << lo) - 1);
+    return (dirty_[entry - 1] & mask) != 0;
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,154 @@
+// universe_store.h - DMX universe buffers
+// A universe claims a slot on its first packet through a flat 16-bit index.
+// Slots live in a UniverseArena: up to 32768 universes, allocated 64 slots at
+// a time as universes appear, so ingest only touches the heap on the claim
+// that opens a new chunk. Each slot is a
+// seqlock: writers serialize on a per-slot spinlock, readers never block and
+// retry the copy if a write overlapped it. Snapshots only copy universes whose
+// sequence moved and diff them against the previous frame, so readers can skip
+// work for channels that did not change.
+
+#pragma once
+
+#include "dmx_protocol.h"
+#include "universe_arena.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RocKontrol {
+
+class UniverseSnapshot;
+
+// Spin-wait hint for the short per-slot writer locks (here and in DMXStats)
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+class UniverseStore {
+public:
+    static constexpr uint32_t kMaxUniverses = 32768;    // Slots (sparse - allocated in chunks on claim)
+    static constexpr uint32_t kUniverseRange = 65536;   // Universe numbers the index covers
+    static constexpr uint32_t kDirtyBlockSlots = 8;     // Change tracking granularity (64 blocks per universe)
+
+    UniverseStore();
+
+    UniverseStore(const UniverseStore&) = delete;
+    UniverseStore& operator=(const UniverseStore&) = delete;
+
+    // Copy count slots into the universe (claims a slot on first write).
+    // False when every slot is taken by other universes.
+    bool write(uint16_t universe, const uint8_t* slots, uint32_t count, uint64_t timestampNs);
+
+    // Copy the universe into dst (kDMXSlots bytes), tear-free. Never-received universes read as zeros.
+    bool read(uint16_t universe, uint8_t* dst) const;
+
+    // Tear-free copy of every universe in one pass (see UniverseSnapshot). Never
+    // lands inside a batch, so universes published together are seen together.
+    // Universes not written since the previous snapshot into out are not copied.
+    void snapshot(UniverseSnapshot& out) const;
+
+    // Group writes that must become visible together (sync-latched universes).
+    // One batch at a time; keep them short - snapshots wait for endBatch().
+    void beginBatch();
+    void endBatch();
+
+    bool hasData(uint16_t universe) const { return index_[universe].load(std::memory_order_acquire) != 0; }
+    uint64_t lastUpdateNs(uint16_t universe) const;
+    uint32_t universeCount() const { return used_.load(std::memory_order_acquire); }
+
+    // Forget every universe (slots stay allocated). Not safe against concurrent readers
+    // of the same slots - call while ingest is stopped.
+    void clear();
+
+private:
+    friend class UniverseSnapshot;
+
+    struct alignas(64) Slot {
+        std::atomic<uint32_t> seq{0};           // Odd while a write is in progress
+        std::atomic<bool> writing{false};       // Writer spinlock
+        uint16_t universe = 0;                  // Set on claim, before the index publishes the slot
+        uint64_t updated_ns = 0;
+        std::array<uint8_t, kDMXSlots> values{};
+    };
+
+    // Returns the sequence the copy was consistent at
+    uint32_t readSlot(const Slot& slot, uint8_t* dst, uint64_t* updatedNs) const;
+
+    std::vector<std::atomic<uint16_t>> index_;      // universe -> slot + 1 (0 = none)
+    UniverseArena<Slot> slots_;
+    std::atomic<uint32_t> used_{0};
+    std::atomic<uint32_t> batch_seq_{0};            // Odd while a batch is being written
+    std::atomic<uint32_t> epoch_{0};                // Bumped by clear() - slots may hold other universes
+    std::mutex claim_mutex_;                        // Slot claims only (first packet of a universe)
+};
+
+// One frame of DMX: every universe copied once, then read in place. Pointers
+// returned by universe() are borrowed and stay valid until the next
+// UniverseStore::snapshot() into this object. Not thread-safe - one reader thread.
+// Buffers grow with the store, so the first snapshot after new universes
+// appear may allocate.
+// Change queries compare against the previous snapshot taken into this object,
+// so each reader keeps its own snapshot. Universes are looked up through the
+// snapshot's own copy of the index, so a UniverseStore::clear() that hands
+// slots to other universes cannot redirect a snapshot taken before it.
+class UniverseSnapshot {
+public:
+    UniverseSnapshot();
+
+    // Slots of a universe in this frame (kDMXSlots bytes, zeros if never received)
+    const uint8_t* universe(uint16_t universe) const;
+    bool hasData(uint16_t universe) const { return slotFor(universe) != 0; }
+    uint64_t updatedNs(uint16_t universe) const;
+    uint64_t takenNs() const { return taken_ns_; }
+
+    // Whether any of count slots starting at first (0-based) changed since the
+    // previous snapshot (kDirtyBlockSlots granularity). Everything counts as
+    // changed on the first snapshot and after UniverseStore::clear().
+    bool changed(uint16_t universe, uint32_t first, uint32_t count) const;
+    bool fullRefresh() const { return full_refresh_; }
+    uint32_t changedUniverses() const { return changed_universes_; }
+
+    // Per store slot, in claim order: which universe it holds and whether this
+    // snapshot copied a new write of it (even one that left the values unchanged)
+    uint32_t slotCount() const { return slot_count_; }
+    uint16_t slotUniverse(uint32_t slot) const { return universes_[slot]; }
+    bool slotUpdated(uint32_t slot) const { return updated_[slot] != 0; }
+    uint64_t slotUpdatedNs(uint32_t slot) const { return updated_ns_[slot]; }
+
+private:
+    friend class UniverseStore;
+
+    static constexpr uint32_t kNotCopied = 0xFFFFFFFFu;    // Odd - never a stable sequence
+    static constexpr uint32_t kGrowSlots = 64;              // Per-slot buffers grow in these steps
+
+    uint32_t slotFor(uint16_t universe) const;
+
+    const UniverseStore* store_ = nullptr;
+    uint32_t slot_count_ = 0;
+    uint32_t epoch_ = 0;
+    bool full_refresh_ = true;
+    uint32_t changed_universes_ = 0;
+    uint64_t taken_ns_ = 0;
+    void grow(uint32_t slots);
+
+    std::vector<uint8_t> values_;                   // Grows with the store: slots x kDMXSlots
+    std::vector<uint64_t> updated_ns_;
+    std::vector<uint32_t> seq_;                     // Slot sequence each copy was taken at
+    std::vector<uint64_t> dirty_;                   // Per slot: blocks changed since the previous snapshot
+    std::vector<uint16_t> universes_;               // Per slot: universe number
+    std::vector<uint8_t> updated_;                  // Per slot: copied by this snapshot
+    std::vector<uint16_t> index_;                   // universe -> slot + 1 as of this snapshot (0 = none)
+    std::array<uint8_t, kDMXSlots> zeros_{};
+};
+
+} // namespace RocKontrol
@@ -1,10 +1,12 @@
 // OutputEngineWrapper.mm - Objective-C++ implementation bridging C++ output engine to Swift
 
 #import "include/OutputEngineWrapper.h"
+#import "draw_list.h"
 #import "output_display.h"
 #import "output_ndi.h"
 #import "switcher_frame.h"
 #include <memory>
+#include <unordered_map>
 
 #pragma mark - GDCropRegion
 
@@ -385,6 +387,59 @@
     return _impl ? _impl->isLegacyMode() : NO;
 }
 
+- (void)setPixelFormat:(GDNDIPixelFormat)format colorMatrix:(GDColorMatrix)matrix {
+    if (!_impl) return;
+    RocKontrol::NDIPixelFormat pixelFormat = RocKontrol::NDIPixelFormat::BGRA;
+    switch (format) {
+        case GDNDIPixelFormatUYVY: pixelFormat = RocKontrol::NDIPixelFormat::UYVY; break;
+        case GDNDIPixelFormatUYVA: pixelFormat = RocKontrol::NDIPixelFormat::UYVA; break;
+        default: break;
+    }
+    _impl->setPixelFormat(pixelFormat,
+                          matrix == GDColorMatrixBT601 ? RocKontrol::ColorMatrix::BT601 : RocKontrol::ColorMatrix::BT709);
+}
+
+- (void)setAsyncSend:(BOOL)enabled {
+    if (_impl) _impl->setAsyncSend(enabled);
+}
+
+- (BOOL)isAsyncSend {
+    return _impl ? _impl->isAsyncSend() : NO;
+}
+
+- (void)setPrepBandCount:(uint32_t)bands {
+    if (_impl) _impl->setPrepBandCount(bands);
+}
+
+- (NSInteger)connectionCount {
+    return _impl ? _impl->connectionCount() : 0;
+}
+
+- (void)setReadbackDepth:(uint32_t)depth {
+    if (_impl) _impl->setReadbackDepth(depth);
+}
+
+- (double)readbackLatencyMs {
+    return _impl ? _impl->readbackStats().last_ms : 0.0;
+}
+
+- (double)readbackLatencyAvgMs {
+    return _impl ? _impl->readbackStats().avg_ms : 0.0;
+}
+
+- (double)readbackLatencyMaxMs {
+    return _impl ? _impl->readbackStats().max_ms : 0.0;
+}
+
+- (GDNDIPixelFormat)pixelFormat {
+    if (!_impl) return GDNDIPixelFormatBGRA;
+    switch (_impl->pixelFormat()) {
+        case RocKontrol::NDIPixelFormat::UYVY: return GDNDIPixelFormatUYVY;
+        case RocKontrol::NDIPixelFormat::UYVA: return GDNDIPixelFormatUYVA;
+        default: return GDNDIPixelFormatBGRA;
+    }
+}
+
 - (GDOutputType)type {
     return GDOutputTypeNDI;
 }
@@ -425,6 +480,18 @@
     return _impl ? _impl->framesDropped() : 0;
 }
 
+- (uint64_t)bufferAllocations {
+    return _impl ? _impl->bufferAllocations() : 0;
+}
+
+- (uint64_t)bufferReuses {
+    return _impl ? _impl->bufferReuses() : 0;
+}
+
+- (uint64_t)bufferBytesReserved {
+    return _impl ? _impl->bufferBytesReserved() : 0;
+}
+
 - (BOOL)setName:(NSString *)name {
     if (!_impl || !name) return NO;
     return _impl->setName([name UTF8String]);
@@ -437,6 +504,102 @@
 
 @end
 
+#pragma mark - GDDrawList
+
+@implementation GDDrawList {
+    std::unique_ptr<RocKontrol::DrawList> _list;
+    // Textures referenced this frame; the list stores index + 1 (0 = none)
+    NSMutableArray<id<MTLTexture>> *_textures;
+    std::unordered_map<const void *, uint32_t> _textureIndex;
+}
+
+- (instancetype)initWithInstanceStride:(NSUInteger)stride {
+    if (self = [super init]) {
+        _list = std::make_unique<RocKontrol::DrawList>(stride);
+        _textures = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)reset {
+    _list->reset();
+    [_textures removeAllObjects];
+    _textureIndex.clear();
+}
+
+- (void)addInstance:(const void *)uniforms
+           pipeline:(GDDrawPipeline)pipeline
+            texture:(nullable id<MTLTexture>)texture {
+    uint32_t textureKey = 0;
+    if (texture) {
+        auto inserted = _textureIndex.emplace((__bridge const void *)texture, (uint32_t)_textures.count + 1);
+        if (inserted.second) [_textures addObject:texture];
+        textureKey = inserted.first->second;
+    }
+    _list->add((uint32_t)pipeline, textureKey, uniforms);
+}
+
+- (void)buildWithStateGrouping:(BOOL)groupByState {
+    _list->build(groupByState ? RocKontrol::DrawOrder::ByState : RocKontrol::DrawOrder::Submission);
+}
+
+- (const void *)instanceData {
+    return _list->instanceData();
+}
+
+- (NSUInteger)instanceBytes {
+    return _list->instanceBytes();
+}
+
+- (NSUInteger)instanceCount {
+    return _list->instanceCount();
+}
+
+- (void)encodeWithEncoder:(id<MTLRenderCommandEncoder>)encoder
+           instanceBuffer:(id<MTLBuffer>)instanceBuffer
+                   offset:(NSUInteger)offset
+                pipelines:(NSArray<id<MTLRenderPipelineState>> *)pipelines
+                  sampler:(nullable id<MTLSamplerState>)sampler {
+    if (_list->batches().empty()) return;
+
+    [encoder setVertexBuffer:instanceBuffer offset:offset atIndex:1];
+    [encoder setFragmentBuffer:instanceBuffer offset:offset atIndex:1];
+    if (sampler) [encoder setFragmentSamplerState:sampler atIndex:0];
+
+    NSInteger pipeline = -1;
+    uint32_t texture = 0;
+    for (const RocKontrol::DrawBatch& batch : _list->batches()) {
+        if ((NSInteger)batch.pipeline != pipeline) {
+            if (batch.pipeline >= pipelines.count) continue;
+            pipeline = batch.pipeline;
+            [encoder setRenderPipelineState:pipelines[batch.pipeline]];
+        }
+        if (batch.texture != 0 && batch.texture != texture) {
+            texture = batch.texture;
+            [encoder setFragmentTexture:_textures[texture - 1] atIndex:0];
+        }
+        [encoder drawPrimitives:MTLPrimitiveTypeTriangleStrip
+                    vertexStart:0
+                    vertexCount:4
+                  instanceCount:batch.instance_count
+                   baseInstance:batch.first_instance];
+    }
+}
+
+- (NSUInteger)drawCallCount {
+    return _list->batches().size();
+}
+
+- (NSUInteger)pipelineChangeCount {
+    return _list->pipelineChanges();
+}
+
+- (NSUInteger)textureChangeCount {
+    return _list->textureChanges();
+}
+
+@end
+
 #pragma mark - Utility Functions
 
 NSArray<GDDisplayInfo *> *GDListDisplays(void) {
@@ -0,0 +1,122 @@
+// band_worker_pool.cpp - Small persistent thread pool for splitting a frame into row bands
+// Portable C++ (std::thread) - no Metal / Foundation dependency
+
+#include "band_worker_pool.h"
+#include <algorithm>
+
+namespace RocKontrol {
+
+namespace {
+constexpr size_t kMaxDefaultWorkers = 7;
+}
+
+BandWorkerPool::BandWorkerPool(size_t workerCount) {
+    threads_.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++) {
+        threads_.emplace_back(&BandWorkerPool::workerLoop, this);
+    }
+}
+
+BandWorkerPool::~BandWorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& t : threads_) {
+        if (t.joinable()) t.join();
+    }
+}
+
+size_t BandWorkerPool::defaultWorkerCount() {
+    unsigned hw = std::thread::hardware_concurrency();
+    if (hw <= 1) return 0;
+    return std::min<size_t>(hw - 1, kMaxDefaultWorkers);
+}
+
+BandWorkerPool& BandWorkerPool::shared() {
+    static BandWorkerPool pool;
+    return pool;
+}
+
+void BandWorkerPool::dispatch(uint32_t count, JobFn fn, void* ctx) {
+    if (count == 0) return;
+
+    Job* job = nullptr;
+    if (count > 1 && !threads_.empty()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Job& slot : jobs_) {
+            if (!slot.active && slot.workers == 0) {
+                job = &slot;
+                break;
+            }
+        }
+        if (job) {
+            job->fn = fn;
+            job->ctx = ctx;
+            job->count = count;
+            job->next_index.store(0, std::memory_order_relaxed);
+            job->active = true;
+        }
+    }
+
+    // Single band, no workers, or every slot taken by other callers
+    if (!job) {
+        for (uint32_t i = 0; i < count; i++) fn(ctx, i);
+        return;
+    }
+    work_cv_.notify_all();
+
+    // Caller takes bands too
+    drain(*job);
+
+    // Every band is claimed now, so no worker can join; wait for the ones
+    // still running a band before the slot is handed to another caller
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [job] { return job->workers == 0; });
+    job->active = false;
+    job->fn = nullptr;
+    job->ctx = nullptr;
+    job->count = 0;
+}
+
+void BandWorkerPool::drain(Job& job) {
+    for (;;) {
+        uint32_t index = job.next_index.fetch_add(1, std::memory_order_relaxed);
+        if (index >= job.count) break;
+        job.fn(job.ctx, index);
+    }
+}
+
+BandWorkerPool::Job* BandWorkerPool::findWork() {
+    for (uint32_t i = 0; i < kMaxJobs; i++) {
+        Job& job = jobs_[(next_job_ + i) % kMaxJobs];
+        if (job.hasBands()) {
+            next_job_ = (next_job_ + i + 1) % kMaxJobs;
+            return &job;
+        }
+    }
+    return nullptr;
+}
+
+void BandWorkerPool::workerLoop() {
+    for (;;) {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait(lock, [&] { return stop_ || (job = findWork()) != nullptr; });
+            if (stop_) return;
+            job->workers++;
+        }
+
+        drain(*job);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job->workers--;
+        }
+        done_cv_.notify_all();
+    }
+}
+
+} // namespace RocKontrol
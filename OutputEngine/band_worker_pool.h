@@ -0,0 +1,80 @@
+// band_worker_pool.h - Small persistent thread pool for splitting a frame into row bands
+// The calling thread works alongside the pool and parallelFor() returns when every band is done
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace RocKontrol {
+
+class BandWorkerPool {
+public:
+    // workerCount threads in addition to the caller (0 = run everything inline)
+    explicit BandWorkerPool(size_t workerCount = defaultWorkerCount());
+    ~BandWorkerPool();
+
+    BandWorkerPool(const BandWorkerPool&) = delete;
+    BandWorkerPool& operator=(const BandWorkerPool&) = delete;
+
+    // Run fn(0) ... fn(count - 1) across the pool and the calling thread.
+    // fn must be safe to call concurrently for different indices. Calls from
+    // several threads (one per output) run side by side: each caller works on
+    // its own job and idle workers join whichever job still has bands left.
+    // Past kMaxJobs concurrent calls the extra caller runs its job inline.
+    // Never allocates.
+    template <typename Fn>
+    void parallelFor(uint32_t count, Fn&& fn) {
+        using FnType = typename std::remove_reference<Fn>::type;
+        dispatch(count, [](void* ctx, uint32_t index) { (*static_cast<FnType*>(ctx))(index); },
+                 const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+
+    size_t workerCount() const { return threads_.size(); }
+
+    // Hardware threads minus one for the caller, capped to keep render headroom
+    static size_t defaultWorkerCount();
+
+    // Process-wide pool shared by all outputs
+    static BandWorkerPool& shared();
+
+    static constexpr uint32_t kMaxJobs = 8;
+
+private:
+    using JobFn = void (*)(void* ctx, uint32_t index);
+
+    // One in-flight parallelFor. Fields other than next_index are guarded by mutex_.
+    struct alignas(64) Job {
+        JobFn fn = nullptr;
+        void* ctx = nullptr;
+        uint32_t count = 0;
+        uint32_t workers = 0;           // Workers still inside this job
+        bool active = false;            // Posted and not yet collected by its caller
+        std::atomic<uint32_t> next_index{0};
+
+        bool hasBands() const { return active && next_index.load(std::memory_order_relaxed) < count; }
+    };
+
+    void dispatch(uint32_t count, JobFn fn, void* ctx);
+    void workerLoop();
+    static void drain(Job& job);
+    Job* findWork();                    // Caller holds mutex_
+
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    bool stop_ = false;
+    uint32_t next_job_ = 0;             // Where workers start looking, for fairness
+
+    Job jobs_[kMaxJobs];
+};
+
+} // namespace RocKontrol
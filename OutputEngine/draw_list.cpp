@@ -0,0 +1,85 @@
+// draw_list.cpp - Per-frame instanced draw list for the fixture renderer
+// Portable C++ - no Metal dependency
+
+#include "draw_list.h"
+#include <algorithm>
+#include <cstring>
+
+namespace RocKontrol {
+
+DrawList::DrawList(size_t instanceStride) : stride_(instanceStride) {}
+
+void DrawList::reset() {
+    count_ = 0;
+    sorted_ = false;
+    keys_.clear();
+    batches_.clear();
+    pipeline_changes_ = 0;
+    texture_changes_ = 0;
+}
+
+uint8_t* DrawList::add(uint32_t pipeline, uint32_t texture, const void* instance) {
+    size_t needed = (size_t)(count_ + 1) * stride_;
+    if (staged_.size() < needed) staged_.resize(std::max(needed, staged_.size() * 2));
+
+    uint8_t* block = staged_.data() + (size_t)count_ * stride_;
+    memcpy(block, instance, stride_);
+    keys_.push_back({pipeline, texture});
+    count_++;
+    return block;
+}
+
+void DrawList::appendBatch(uint32_t pipeline, uint32_t texture, uint32_t first) {
+    if (!batches_.empty()) {
+        DrawBatch& last = batches_.back();
+        if (last.pipeline == pipeline && last.texture == texture) {
+            last.instance_count++;
+            return;
+        }
+        if (last.pipeline != pipeline) pipeline_changes_++;
+        if (last.texture != texture) texture_changes_++;
+    } else {
+        pipeline_changes_ = 1;
+        texture_changes_ = texture != 0 ? 1 : 0;
+    }
+
+    DrawBatch batch;
+    batch.pipeline = pipeline;
+    batch.texture = texture;
+    batch.first_instance = first;
+    batch.instance_count = 1;
+    batches_.push_back(batch);
+}
+
+void DrawList::build(DrawOrder order) {
+    batches_.clear();
+    pipeline_changes_ = 0;
+    texture_changes_ = 0;
+    sorted_ = order == DrawOrder::ByState;
+
+    if (!sorted_) {
+        for (uint32_t i = 0; i < count_; i++) appendBatch(keys_[i].pipeline, keys_[i].texture, i);
+        return;
+    }
+
+    order_.resize(count_);
+    for (uint32_t i = 0; i < count_; i++) order_[i] = i;
+    std::stable_sort(order_.begin(), order_.end(), [this](uint32_t a, uint32_t b) {
+        const Key& ka = keys_[a];
+        const Key& kb = keys_[b];
+        return ka.pipeline != kb.pipeline ? ka.pipeline < kb.pipeline : ka.texture < kb.texture;
+    });
+
+    if (packed_.size() < instanceBytes()) packed_.resize(std::max(instanceBytes(), packed_.size() * 2));
+    for (uint32_t i = 0; i < count_; i++) {
+        uint32_t source = order_[i];
+        memcpy(packed_.data() + (size_t)i * stride_, staged_.data() + (size_t)source * stride_, stride_);
+        appendBatch(keys_[source].pipeline, keys_[source].texture, i);
+    }
+}
+
+const uint8_t* DrawList::instanceData() const {
+    return sorted_ ? packed_.data() : staged_.data();
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,84 @@
+// draw_list.h - Per-frame instanced draw list for the fixture renderer
+// The renderer queues one fixed-size uniform block per quad together with the
+// pipeline and texture it needs; build() packs the blocks into one instance
+// buffer and turns them into batches, each of which is a single instanced draw
+// (baseInstance = firstInstance). Pipelines and textures are opaque small
+// integers here, so the builder has no Metal dependency.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RocKontrol {
+
+// One instanced draw: instances [first_instance, first_instance + instance_count)
+struct DrawBatch {
+    uint32_t pipeline = 0;
+    uint32_t texture = 0;           // 0 = no texture
+    uint32_t first_instance = 0;
+    uint32_t instance_count = 0;
+};
+
+enum class DrawOrder {
+    // Keep queue order and merge neighbours with the same state. Blending
+    // result is identical to one draw per quad.
+    Submission,
+    // Stable sort by (pipeline, texture): fewest draws, but quads of different
+    // kinds can swap stacking order where they overlap.
+    ByState
+};
+
+class DrawList {
+public:
+    explicit DrawList(size_t instanceStride);
+
+    DrawList(const DrawList&) = delete;
+    DrawList& operator=(const DrawList&) = delete;
+
+    // Start a frame (keeps capacity - no allocation once warmed up)
+    void reset();
+
+    // Queue one quad; copies instanceStride bytes from instance. Returns the
+    // staged block so callers can patch it in place (valid until the next add).
+    uint8_t* add(uint32_t pipeline, uint32_t texture, const void* instance);
+
+    // Build batches and the packed instance buffer for everything queued
+    void build(DrawOrder order = DrawOrder::Submission);
+
+    const std::vector<DrawBatch>& batches() const { return batches_; }
+
+    // Packed instances in batch order (valid after build())
+    const uint8_t* instanceData() const;
+    size_t instanceBytes() const { return (size_t)count_ * stride_; }
+    uint32_t instanceCount() const { return count_; }
+    size_t instanceStride() const { return stride_; }
+
+    // State changes the batches need (first batch counts its pipeline and texture)
+    uint32_t pipelineChanges() const { return pipeline_changes_; }
+    uint32_t textureChanges() const { return texture_changes_; }
+
+private:
+    struct Key {
+        uint32_t pipeline;
+        uint32_t texture;
+    };
+
+    void appendBatch(uint32_t pipeline, uint32_t texture, uint32_t first);
+
+    size_t stride_;
+    uint32_t count_ = 0;
+    bool sorted_ = false;
+
+    std::vector<uint8_t> staged_;       // Queue order
+    std::vector<uint8_t> packed_;       // Batch order (ByState only)
+    std::vector<Key> keys_;
+    std::vector<uint32_t> order_;
+    std::vector<DrawBatch> batches_;
+
+    uint32_t pipeline_changes_ = 0;
+    uint32_t texture_changes_ = 0;
+};
+
+} // namespace RocKontrol
@@ -0,0 +1,333 @@
+// edge_blend_cpu.cpp - CPU reference of the NDI edge blend / warp shader
+// Portable C++ - evaluated at pixel centres like the fragment shader's texCoord
+
+#include "edge_blend_cpu.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define ROCK_BLEND_X86 1
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ROCK_BLEND_NEON 1
+#endif
+
+namespace RocKontrol {
+
+namespace {
+
+constexpr uint32_t kMinBandRows = 16;
+
+inline float clamp01(float v) { return std::min(std::max(v, 0.0f), 1.0f); }
+
+// Float to unorm8 the way a BGRA8Unorm render target stores it
+inline uint8_t toUnorm8(float v) { return (uint8_t)(clamp01(v) * 255.0f + 0.5f); }
+
+// Per pixel shading, four channels at a time. The taps are a gather (each
+// output pixel reads its own four texels), so the vector work is across the
+// channels of one pixel. The bilinear sums are integers below 2^24 and stay
+// exact in float, so every path produces the same bytes as the scalar one.
+// blend / floor / scale are {b, b, b, 1/255} / {black, black, black, 0} /
+// {intensity, intensity, intensity, 1}: alpha only takes the 1/255.
+#if defined(ROCK_BLEND_X86)
+
+inline __m128i loadTexel(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return _mm_cvtsi32_si128((int)v);
+}
+
+inline __m128 shadePixel(const uint8_t* p00, const uint8_t* p10, const uint8_t* p01, const uint8_t* p11,
+                         uint32_t fx, uint32_t fy, __m128 blend, __m128 floor, __m128 scale) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i wx = _mm_set1_epi32((int)((fx << 16) | (256 - fx)));
+    __m128i top = _mm_madd_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(loadTexel(p00), loadTexel(p10)), zero), wx);
+    __m128i bottom = _mm_madd_epi16(_mm_unpacklo_epi8(_mm_unpacklo_epi8(loadTexel(p01), loadTexel(p11)), zero), wx);
+    __m128 color = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(top), _mm_set1_ps((float)(256 - fy))),
+                              _mm_mul_ps(_mm_cvtepi32_ps(bottom), _mm_set1_ps((float)fy)));
+    color = _mm_mul_ps(color, _mm_set1_ps(1.0f / 65536.0f));
+    return _mm_mul_ps(_mm_max_ps(_mm_mul_ps(color, blend), floor), scale);
+}
+
+inline void storeUnorm8(uint8_t* out, __m128 rgba) {
+    rgba = _mm_min_ps(_mm_max_ps(rgba, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    __m128i v = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(rgba, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f)));
+    v = _mm_packs_epi32(v, v);
+    v = _mm_packus_epi16(v, v);
+    uint32_t px = (uint32_t)_mm_cvtsi128_si32(v);
+    memcpy(out, &px, 4);
+}
+
+typedef __m128 Rgba;
+inline Rgba rgbaLanes(float rgb, float a) { return _mm_setr_ps(rgb, rgb, rgb, a); }
+inline Rgba loadRgba(const float* v) { return _mm_loadu_ps(v); }
+inline void storeRgba(float* v, Rgba rgba) { _mm_storeu_ps(v, rgba); }
+
+#elif defined(ROCK_BLEND_NEON)
+
+inline uint16x4_t loadTexel(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return vget_low_u16(vmovl_u8(vcreate_u8(v)));
+}
+
+inline float32x4_t shadePixel(const uint8_t* p00, const uint8_t* p10, const uint8_t* p01, const uint8_t* p11,
+                              uint32_t fx, uint32_t fy, float32x4_t blend, float32x4_t floor, float32x4_t scale) {
+    const uint16_t wx0 = (uint16_t)(256 - fx), wx1 = (uint16_t)fx;
+    uint32x4_t top = vmlal_n_u16(vmull_n_u16(loadTexel(p00), wx0), loadTexel(p10), wx1);
+    uint32x4_t bottom = vmlal_n_u16(vmull_n_u16(loadTexel(p01), wx0), loadTexel(p11), wx1);
+    float32x4_t color = vaddq_f32(vmulq_n_f32(vcvtq_f32_u32(top), (float)(256 - fy)),
+                                  vmulq_n_f32(vcvtq_f32_u32(bottom), (float)fy));
+    color = vmulq_n_f32(color, 1.0f / 65536.0f);
+    return vmulq_f32(vmaxq_f32(vmulq_f32(color, blend), floor), scale);
+}
+
+inline void storeUnorm8(uint8_t* out, float32x4_t rgba) {
+    rgba = vminq_f32(vmaxq_f32(rgba, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+    uint32x4_t v = vcvtq_u32_f32(vaddq_f32(vmulq_n_f32(rgba, 255.0f), vdupq_n_f32(0.5f)));
+    uint8x8_t px = vmovn_u16(vcombine_u16(vmovn_u32(v), vmovn_u32(v)));
+    vst1_lane_u32((uint32_t*)(void*)out, vreinterpret_u32_u8(px), 0);
+}
+
+typedef float32x4_t Rgba;
+inline Rgba rgbaLanes(float rgb, float a) { float v[4] = {rgb, rgb, rgb, a}; return vld1q_f32(v); }
+inline Rgba loadRgba(const float* v) { return vld1q_f32(v); }
+inline void storeRgba(float* v, Rgba rgba) { vst1q_f32(v, rgba); }
+
+#endif
+
+// Feather ramp for one axis at normalized position t (both edges combined)
+float featherRamp(float t, float nearWidth, float farWidth, float power) {
+    float blend = 1.0f;
+    if (nearWidth > 0.0f && t < nearWidth) {
+        blend *= std::pow(t / nearWidth, power);
+    }
+    if (farWidth > 0.0f && t > 1.0f - farWidth) {
+        blend *= std::pow((1.0f - t) / farWidth, power);
+    }
+    return blend;
+}
+
+// drawCornerOverlay - returns true and sets rgba (0-1) if the pixel is part of the marker
+bool cornerOverlay(float u, float v, int activeCorner, const float warpOffset[2], float rgba[4]) {
+    const float markerSize = 0.08f;
+    const float lineWidth = 0.006f;
+    float cornerX, cornerY, inwardX, inwardY;
+
+    // warpOffset represents source sampling offset, so negate for visual position
+    switch (activeCorner) {
+        case 1: cornerX = 0.0f; cornerY = 0.0f; inwardX = 1.0f;  inwardY = 1.0f;  break;
+        case 2: cornerX = 1.0f; cornerY = 0.0f; inwardX = -1.0f; inwardY = 1.0f;  break;
+        case 3: cornerX = 0.0f; cornerY = 1.0f; inwardX = 1.0f;  inwardY = -1.0f; break;
+        case 4: cornerX = 1.0f; cornerY = 1.0f; inwardX = -1.0f; inwardY = -1.0f; break;
+        default: return false;
+    }
+    cornerX -= warpOffset[0];
+    cornerY -= warpOffset[1];
+
+    float toX = u - cornerX;
+    float toY = v - cornerY;
+    float distX = std::fabs(toX);
+    float distY = std::fabs(toY);
+
+    bool inHorizArm = distY < lineWidth && toX * inwardX >= 0.0f && distX < markerSize;
+    bool inVertArm = distX < lineWidth && toY * inwardY >= 0.0f && distY < markerSize;
+    bool inHorizOutline = distY < lineWidth * 1.5f && toX * inwardX >= -lineWidth && distX < markerSize + lineWidth;
+    bool inVertOutline = distX < lineWidth * 1.5f && toY * inwardY >= -lineWidth && distY < markerSize + lineWidth;
+
+    bool cyan;
+    if (inHorizOutline || inVertOutline) {
+        cyan = inHorizArm || inVertArm;
+    } else {
+        float dist = std::sqrt(toX * toX + toY * toY);
+        if (dist >= 0.02f) return false;
+        cyan = dist < 0.012f;
+    }
+
+    // Cyan marker with black outline, in BGRA order
+    rgba[0] = cyan ? 1.0f : 0.0f;
+    rgba[1] = cyan ? 1.0f : 0.0f;
+    rgba[2] = 0.0f;
+    rgba[3] = 1.0f;
+    return true;
+}
+
+bool sameRamps(const EdgeBlendSettings& a, const EdgeBlendSettings& b) {
+    return a.featherLeft == b.featherLeft && a.featherRight == b.featherRight &&
+           a.featherTop == b.featherTop && a.featherBottom == b.featherBottom &&
+           a.gamma == b.gamma && a.power == b.power;
+}
+
+} // namespace
+
+void EdgeBlendRenderer::updateRamps(const EdgeBlendSettings& s, uint32_t width, uint32_t height) {
+    if (ramps_valid_ && column_blend_.size() == width && row_blend_.size() == height &&
+        sameRamps(ramp_settings_, s)) {
+        return;
+    }
+
+    float invGamma = 1.0f / s.gamma;
+    column_blend_.resize(width);
+    for (uint32_t x = 0; x < width; x++) {
+        float u = ((float)x + 0.5f) / (float)width;
+        column_blend_[x] = std::pow(featherRamp(u, s.featherLeft, s.featherRight, s.power), invGamma);
+    }
+    row_blend_.resize(height);
+    for (uint32_t y = 0; y < height; y++) {
+        float v = ((float)y + 0.5f) / (float)height;
+        row_blend_[y] = std::pow(featherRamp(v, s.featherTop, s.featherBottom, s.power), invGamma);
+    }
+
+    ramp_settings_ = s;
+    ramps_valid_ = true;
+}
+
+// Resolve the warp map into texel offsets and 8-bit weights (the precision of
+// the GPU's linear filter), so the per-frame loop is integer loads and lerps.
+void EdgeBlendRenderer::updateTaps(uint32_t srcWidth, uint32_t srcHeight, size_t srcStride) {
+    if (taps_map_build_ == warp_map_.builds() && taps_src_width_ == srcWidth &&
+        taps_src_height_ == srcHeight && taps_src_stride_ == srcStride) {
+        return;
+    }
+
+    uint32_t width = warp_map_.width();
+    uint32_t height = warp_map_.height();
+    taps_.resize((size_t)width * height);
+
+    uint32_t bands = std::max<uint32_t>(1, std::min<uint32_t>((uint32_t)pool_.workerCount() + 1, height / kMinBandRows));
+    pool_.parallelFor(bands, [&](uint32_t band) {
+        uint32_t y0 = (uint32_t)((uint64_t)height * band / bands);
+        uint32_t y1 = (uint32_t)((uint64_t)height * (band + 1) / bands);
+        for (uint32_t y = y0; y < y1; y++) {
+            const float* map = warp_map_.row(y);
+            SampleTap* tap = taps_.data() + (size_t)y * width;
+            for (uint32_t x = 0; x < width; x++, map += 2, tap++) {
+                if (map[0] < 0.0f) {
+                    *tap = {kOutsideTap, 0, 0, 0, 0};
+                    continue;
+                }
+
+                // Texel-centre convention of a linear, clamp-to-edge sampler
+                float fx = map[0] * (float)srcWidth - 0.5f;
+                float fy = map[1] * (float)srcHeight - 0.5f;
+                float x0f = std::floor(fx);
+                float y0f = std::floor(fy);
+                int wx = (int)((fx - x0f) * 256.0f + 0.5f);
+                int wy = (int)((fy - y0f) * 256.0f + 0.5f);
+                int x0 = (int)x0f;
+                int y0i = (int)y0f;
+                if (wx == 256) { x0++; wx = 0; }
+                if (wy == 256) { y0i++; wy = 0; }
+
+                int maxX = (int)srcWidth - 1;
+                int maxY = (int)srcHeight - 1;
+                int x1 = std::min(std::max(x0 + 1, 0), maxX);
+                int y1 = std::min(std::max(y0i + 1, 0), maxY);
+                x0 = std::min(std::max(x0, 0), maxX);
+                y0i = std::min(std::max(y0i, 0), maxY);
+
+                tap->offset = (uint32_t)((size_t)y0i * srcStride + (size_t)x0 * 4);
+                tap->fx = (uint8_t)wx;
+                tap->fy = (uint8_t)wy;
+                tap->stepX = (uint8_t)(x1 - x0);
+                tap->stepY = (uint8_t)(y1 - y0i);
+            }
+        }
+    });
+
+    taps_map_build_ = warp_map_.builds();
+    taps_src_width_ = srcWidth;
+    taps_src_height_ = srcHeight;
+    taps_src_stride_ = srcStride;
+}
+
+bool EdgeBlendRenderer::render(const EdgeBlendSettings& settings,
+                               const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, size_t srcStride,
+                               uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight, size_t dstStride) {
+    if (!src || !dst || srcWidth == 0 || srcHeight == 0 || dstWidth == 0 || dstHeight == 0) {
+        return false;
+    }
+
+    warp_map_.update(settings.geometry, dstWidth, dstHeight, pool_);
+    updateTaps(srcWidth, srcHeight, srcStride);
+    updateRamps(settings, dstWidth, dstHeight);
+
+    const float blackLevel = settings.blackLevel;
+    const float intensity = settings.intensity;
+    const int corner = settings.activeCorner;
+    static const int kCornerPoint[5] = {0, WarpGeometry::TopLeft, WarpGeometry::TopRight,
+                                        WarpGeometry::BottomLeft, WarpGeometry::BottomRight};
+    const float* cornerOffset = (corner >= 1 && corner <= 4) ? settings.geometry.warp[kCornerPoint[corner]] : nullptr;
+#if defined(ROCK_BLEND_X86) || defined(ROCK_BLEND_NEON)
+    const Rgba blackLanes = rgbaLanes(blackLevel, 0.0f);
+    const Rgba intensityLanes = rgbaLanes(intensity, 1.0f);
+#endif
+
+    uint32_t bands = std::max<uint32_t>(1, std::min<uint32_t>((uint32_t)pool_.workerCount() + 1, dstHeight / kMinBandRows));
+    pool_.parallelFor(bands, [&](uint32_t band) {
+        uint32_t y0 = (uint32_t)((uint64_t)dstHeight * band / bands);
+        uint32_t y1 = (uint32_t)((uint64_t)dstHeight * (band + 1) / bands);
+
+        for (uint32_t y = y0; y < y1; y++) {
+            const SampleTap* tap = taps_.data() + (size_t)y * dstWidth;
+            const float rowBlend = row_blend_[y] * (1.0f / 255.0f);
+            const float v = ((float)y + 0.5f) / (float)dstHeight;
+            uint8_t* out = dst + (size_t)y * dstStride;
+
+            for (uint32_t x = 0; x < dstWidth; x++, tap++, out += 4) {
+                if (tap->offset == kOutsideTap) {
+                    // Outside the warped region - opaque black, no blend or overlay
+                    out[0] = 0; out[1] = 0; out[2] = 0; out[3] = 255;
+                    continue;
+                }
+
+                const uint8_t* p00 = src + tap->offset;
+                const uint8_t* p10 = p00 + tap->stepX * 4;
+                const uint8_t* p01 = p00 + tap->stepY * srcStride;
+                const uint8_t* p11 = p01 + tap->stepX * 4;
+                const uint32_t fx = tap->fx, fy = tap->fy;
+                const float blend = column_blend_[x] * rowBlend;
+#if defined(ROCK_BLEND_X86) || defined(ROCK_BLEND_NEON)
+                Rgba rgba = shadePixel(p00, p10, p01, p11, fx, fy, rgbaLanes(blend, 1.0f / 255.0f), blackLanes, intensityLanes);
+                if (cornerOffset) {
+                    float color[4];
+                    storeRgba(color, rgba);
+                    float u = ((float)x + 0.5f) / (float)dstWidth;
+                    cornerOverlay(u, v, corner, cornerOffset, color);
+                    rgba = loadRgba(color);
+                }
+                storeUnorm8(out, rgba);
+#else
+                // Bilinear in 16.16 fixed point, then back to 0-255 floats
+                float color[4];
+                for (int c = 0; c < 4; c++) {
+                    uint32_t top = p00[c] * (256 - fx) + p10[c] * fx;
+                    uint32_t bottom = p01[c] * (256 - fx) + p11[c] * fx;
+                    color[c] = (float)(top * (256 - fy) + bottom * fy) * (1.0f / 65536.0f);
+                }
+
+                // Blend, black level and intensity in 0-1 (the 1/255 is folded into the blend)
+                for (int c = 0; c < 3; c++) {
+                    color[c] = std::max(color[c] * blend, blackLevel) * intensity;
+                }
+                color[3] *= (1.0f / 255.0f);
+
+                if (cornerOffset) {
+                    float u = ((float)x + 0.5f) / (float)dstWidth;
+                    cornerOverlay(u, v, corner, cornerOffset, color);
+                }
+
+                out[0] = toUnorm8(color[0]);
+                out[1] = toUnorm8(color[1]);
+                out[2] = toUnorm8(color[2]);
+                out[3] = toUnorm8(color[3]);
+#endif
+            }
+        }
+    });
+    return true;
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,72 @@
+// edge_blend_cpu.h - CPU reference of the NDI edge blend / warp shader
+// Reproduces edgeBlendFragment (output_ndi.mm) on BGRA8 buffers: geometry via WarpMap,
+// bilinear clamp-to-edge sampling, feather ramps with power/gamma, black level,
+// intensity and the corner overlay. Rows are split across a BandWorkerPool.
+
+#pragma once
+
+#include "band_worker_pool.h"
+#include "warp_map.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RocKontrol {
+
+// Shader EdgeBlendParams in normalized output coordinates
+struct EdgeBlendSettings {
+    float featherLeft = 0.0f;       // Feather width (0-1 of output width/height)
+    float featherRight = 0.0f;
+    float featherTop = 0.0f;
+    float featherBottom = 0.0f;
+    float gamma = 2.2f;             // Blend gamma
+    float power = 1.0f;             // Blend power curve
+    float blackLevel = 0.0f;        // Black level floor (0-1)
+    int activeCorner = 0;           // 0=none, 1=TL, 2=TR, 3=BL, 4=BR
+    float intensity = 1.0f;         // Master intensity (0-1)
+    WarpGeometry geometry;          // Warp, curvature, lens and crop
+};
+
+class EdgeBlendRenderer {
+public:
+    explicit EdgeBlendRenderer(BandWorkerPool& pool = BandWorkerPool::shared()) : pool_(pool) {}
+
+    // Render src (BGRA8, srcWidth x srcHeight) into dst (BGRA8, dstWidth x dstHeight).
+    // The warp map and feather ramps are cached and rebuilt only when they change.
+    bool render(const EdgeBlendSettings& settings,
+                const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, size_t srcStride,
+                uint8_t* dst, uint32_t dstWidth, uint32_t dstHeight, size_t dstStride);
+
+    const WarpMap& warpMap() const { return warp_map_; }
+
+private:
+    // Bilinear footprint of one output pixel, resolved from the warp map once
+    struct SampleTap {
+        uint32_t offset;        // Byte offset of the top-left texel (kOutsideTap = black)
+        uint8_t fx;             // Horizontal weight of the right texel (1/256)
+        uint8_t fy;             // Vertical weight of the bottom texel (1/256)
+        uint8_t stepX;          // 0 at the clamped right edge, else 1
+        uint8_t stepY;          // 0 at the clamped bottom edge, else 1
+    };
+    static constexpr uint32_t kOutsideTap = 0xFFFFFFFFu;
+
+    void updateRamps(const EdgeBlendSettings& settings, uint32_t width, uint32_t height);
+    void updateTaps(uint32_t srcWidth, uint32_t srcHeight, size_t srcStride);
+
+    BandWorkerPool& pool_;
+    WarpMap warp_map_;
+
+    std::vector<SampleTap> taps_;
+    uint64_t taps_map_build_ = 0;   // warp_map_.builds() the taps were made from
+    uint32_t taps_src_width_ = 0;
+    uint32_t taps_src_height_ = 0;
+    size_t taps_src_stride_ = 0;
+
+    // Separable blend: pow(L*R*T*B, 1/gamma) == pow(L*R, 1/gamma) * pow(T*B, 1/gamma)
+    std::vector<float> column_blend_;
+    std::vector<float> row_blend_;
+    EdgeBlendSettings ramp_settings_;
+    bool ramps_valid_ = false;
+};
+
+} // namespace RocKontrol
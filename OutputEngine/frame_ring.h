@@ -0,0 +1,187 @@
+// frame_ring.h - Lock-free single-producer / multi-consumer frame ring
+// Portable C++ - FrameRingBuffer in switcher_frame.h is FrameRing<SwitcherFrame>.
+//
+// One thread pushes; any number of threads may peekLatest() or pop() concurrently
+// without taking a lock. Each slot carries the sequence number of the frame it
+// holds plus a pin count: a reader pins the slot, checks the sequence, copies the
+// frame and unpins. The producer only ever writes into a slot that holds no live
+// sequence and has no pins, so a reader can never observe a half-written frame or
+// retain a texture that is being released underneath it.
+//
+// push() is wait-free: it scans the free slots once and never waits for a
+// reader. A couple of spare slots beyond the capacity absorb readers that are
+// mid-copy; if every one of them is pinned at that instant the new frame is
+// dropped instead (push() returns false and dropped() counts it).
+//
+// Frame must be copy-assignable and provide reset().
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace RocKontrol {
+
+template <typename Frame>
+class FrameRing {
+public:
+    explicit FrameRing(size_t capacity = 5) {
+        allocate(capacity);
+    }
+
+    FrameRing(const FrameRing&) = delete;
+    FrameRing& operator=(const FrameRing&) = delete;
+
+    // Producer: push a new frame (overwrites the oldest if full). Returns false
+    // only when every spare slot is pinned by a reader; the frame is dropped.
+    bool push(const Frame& frame) {
+        uint64_t seq = head_.load(std::memory_order_relaxed) + 1;
+        size_t idx = seq % capacity_;
+
+        // Drop oldest: move the tail past the sequence we are about to evict
+        // before its slot can be recycled, so a racing pop() retries cleanly.
+        if (seq > capacity_) advanceTail(seq - capacity_ + 1);
+        if (live_[idx] != kNoSlot) {
+            free_.push_back(live_[idx]);
+            live_[idx] = kNoSlot;
+        }
+
+        uint32_t slotIdx = claimFreeSlot();
+        if (slotIdx == kNoSlot) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        Slot& slot = slots_[slotIdx];
+        slot.frame = frame;
+        slot.seq.store(seq, std::memory_order_release);
+        live_[idx] = slotIdx;
+        order_[idx].store(slotIdx, std::memory_order_release);
+        head_.store(seq, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: get the latest frame without removing it
+    bool peekLatest(Frame& out) {
+        for (;;) {
+            uint64_t head = head_.load(std::memory_order_acquire);
+            if (head == 0 || head < tail_.load(std::memory_order_acquire)) return false;
+            if (readSequence(head, out)) return true;
+            // Producer lapped us (capacity pushes since we read head) - try again
+        }
+    }
+
+    // Consumer: pop the oldest frame
+    bool pop(Frame& out) {
+        for (;;) {
+            uint64_t tail = tail_.load(std::memory_order_acquire);
+            if (tail > head_.load(std::memory_order_acquire)) return false;
+            if (!readSequence(tail, out)) continue;  // Evicted, tail already moved on
+            if (tail_.compare_exchange_strong(tail, tail + 1, std::memory_order_acq_rel)) {
+                return true;
+            }
+            // Another consumer took it (or it was dropped) - discard our copy
+        }
+    }
+
+    size_t size() const {
+        uint64_t tail = tail_.load(std::memory_order_acquire);
+        uint64_t head = head_.load(std::memory_order_acquire);
+        if (tail > head) return 0;
+        return std::min<size_t>(static_cast<size_t>(head - tail + 1), capacity_);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    // Any thread. Everything pushed so far becomes invisible to peekLatest() and
+    // pop(); the slots keep their frames (and texture references) until the
+    // producer reuses them, or until resize().
+    void clear() {
+        advanceTail(head_.load(std::memory_order_acquire) + 1);
+    }
+
+    // Reallocates storage and releases every frame - must not run concurrently
+    // with push/pop/peekLatest.
+    void resize(size_t capacity) {
+        allocate(capacity);
+    }
+
+    // Frames push() dropped because every spare slot was pinned
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+    static constexpr size_t kSpareSlots = 2;
+
+    struct alignas(64) Slot {
+        Frame frame;
+        std::atomic<uint64_t> seq{0};    // Sequence held by this slot (0 = none)
+        std::atomic<uint32_t> pins{0};   // Readers currently copying this slot
+    };
+
+    void allocate(size_t capacity) {
+        capacity_ = std::max<size_t>(capacity, 1);
+        slot_count_ = capacity_ + kSpareSlots;
+        slots_.reset(new Slot[slot_count_]);
+        order_.reset(new std::atomic<uint32_t>[capacity_]);
+        live_.assign(capacity_, kNoSlot);
+        free_.clear();
+        free_.reserve(slot_count_);
+        for (size_t i = 0; i < capacity_; i++) order_[i].store(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < slot_count_; i++) free_.push_back(static_cast<uint32_t>(i));
+        head_.store(0, std::memory_order_release);
+        tail_.store(1, std::memory_order_release);
+        dropped_.store(0, std::memory_order_relaxed);
+    }
+
+    // Tail only ever moves forward (eviction, clear and pop all race on it)
+    void advanceTail(uint64_t to) {
+        uint64_t tail = tail_.load(std::memory_order_acquire);
+        while (tail < to && !tail_.compare_exchange_weak(tail, to, std::memory_order_acq_rel)) {}
+    }
+
+    // Pick a free slot no reader is pinning, in one pass (kNoSlot if all are
+    // pinned). Clearing the sequence first and then checking pins (both
+    // seq_cst) pairs with readSequence(): either the reader sees the cleared
+    // sequence and backs off, or we see its pin.
+    uint32_t claimFreeSlot() {
+        for (size_t i = 0; i < free_.size(); i++) {
+            Slot& slot = slots_[free_[i]];
+            slot.seq.store(0, std::memory_order_seq_cst);
+            if (slot.pins.load(std::memory_order_seq_cst) == 0) {
+                uint32_t slotIdx = free_[i];
+                free_[i] = free_.back();
+                free_.pop_back();
+                return slotIdx;
+            }
+        }
+        return kNoSlot;
+    }
+
+    bool readSequence(uint64_t seq, Frame& out) {
+        Slot& slot = slots_[order_[seq % capacity_].load(std::memory_order_acquire)];
+        slot.pins.fetch_add(1, std::memory_order_seq_cst);
+        bool match = slot.seq.load(std::memory_order_seq_cst) == seq;
+        if (match) out = slot.frame;
+        slot.pins.fetch_sub(1, std::memory_order_release);
+        return match;
+    }
+
+    size_t capacity_ = 0;
+    size_t slot_count_ = 0;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<std::atomic<uint32_t>[]> order_;  // seq % capacity -> slot
+    std::vector<uint32_t> live_;                      // Producer-only mirror of order_
+    std::vector<uint32_t> free_;                      // Producer-only: slots with no live sequence
+    std::atomic<uint64_t> dropped_{0};
+    alignas(64) std::atomic<uint64_t> head_{0};      // Last published sequence (0 = none)
+    alignas(64) std::atomic<uint64_t> tail_{1};      // Oldest unconsumed sequence
+};
+
+} // namespace RocKontrol
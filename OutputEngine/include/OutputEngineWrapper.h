@@ -21,6 +21,24 @@ typedef NS_ENUM(NSInteger, GDOutputStatus) {
     GDOutputStatusError = 3
 };
 
+typedef NS_ENUM(NSInteger, GDNDIPixelFormat) {
+    GDNDIPixelFormatBGRA = 0,   // No conversion
+    GDNDIPixelFormatUYVY = 1,   // 4:2:2, half the bandwidth of BGRA
+    GDNDIPixelFormatUYVA = 2    // 4:2:2 plus alpha plane
+};
+
+typedef NS_ENUM(NSInteger, GDColorMatrix) {
+    GDColorMatrixBT709 = 0,
+    GDColorMatrixBT601 = 1
+};
+
+// Index into the pipelines array passed to -[GDDrawList encodeWithEncoder:...]
+typedef NS_ENUM(NSInteger, GDDrawPipeline) {
+    GDDrawPipelineShape = 0,
+    GDDrawPipelineGobo = 1,
+    GDDrawPipelineVideo = 2
+};
+
 #pragma mark - Crop Region
 
 @interface GDCropRegion : NSObject
@@ -180,6 +198,27 @@ typedef NS_ENUM(NSInteger, GDOutputStatus) {
 - (void)setLegacyMode:(BOOL)enabled;
 - (BOOL)isLegacyMode;
 
+// Wire pixel format (BGRA default; UYVY/UYVA converted with SIMD on the send thread)
+- (void)setPixelFormat:(GDNDIPixelFormat)format colorMatrix:(GDColorMatrix)matrix;
+@property (nonatomic, readonly) GDNDIPixelFormat pixelFormat;
+
+// Async send (default on): NDI reads one buffer while the next frame is prepared
+- (void)setAsyncSend:(BOOL)enabled;
+- (BOOL)isAsyncSend;
+
+// Row bands for the parallel crop/intensity/convert stage (0 = one per worker thread)
+- (void)setPrepBandCount:(uint32_t)bands;
+
+// Receivers currently connected to this sender (0 while stopped)
+@property (nonatomic, readonly) NSInteger connectionCount;
+
+// Edge-blended frames read back from the GPU without blocking the render thread
+// (depth 1-3 = frames of added latency); GPU -> CPU latency in milliseconds
+- (void)setReadbackDepth:(uint32_t)depth;
+@property (nonatomic, readonly) double readbackLatencyMs;
+@property (nonatomic, readonly) double readbackLatencyAvgMs;
+@property (nonatomic, readonly) double readbackLatencyMaxMs;
+
 // Properties
 @property (nonatomic, readonly) GDOutputType type;
 @property (nonatomic, readonly, copy) NSString *name;
@@ -191,12 +230,52 @@ typedef NS_ENUM(NSInteger, GDOutputStatus) {
 // Statistics
 @property (nonatomic, readonly) uint64_t framesSent;
 @property (nonatomic, readonly) uint64_t framesDropped;
+@property (nonatomic, readonly) uint64_t bufferAllocations;    // Frame buffers taken from the heap
+@property (nonatomic, readonly) uint64_t bufferReuses;         // Frame buffers served from the pool
+@property (nonatomic, readonly) uint64_t bufferBytesReserved;  // Bytes held by the frame buffer pool
 
 - (BOOL)setName:(NSString *)name;
 - (BOOL)setResolutionWidth:(uint32_t)width height:(uint32_t)height;
 
 @end
 
+#pragma mark - Draw List
+
+// Per-frame instanced draw list: queue one uniform block per quad, then encode
+// one instanced triangle-strip draw per run of quads sharing pipeline and texture.
+// Shaders read their uniforms as objects[instance_id] from buffer index 1.
+@interface GDDrawList : NSObject
+
+- (instancetype)initWithInstanceStride:(NSUInteger)stride;
+
+- (void)reset;
+- (void)addInstance:(const void *)uniforms
+           pipeline:(GDDrawPipeline)pipeline
+            texture:(nullable id<MTLTexture>)texture;
+
+// Group by pipeline/texture across the whole frame instead of only neighbours
+// (fewer draws; overlapping quads of different kinds may change stacking order)
+- (void)buildWithStateGrouping:(BOOL)groupByState;
+
+// Packed instance data in draw order (valid after build)
+@property (nonatomic, readonly, nullable) const void *instanceData;
+@property (nonatomic, readonly) NSUInteger instanceBytes;
+@property (nonatomic, readonly) NSUInteger instanceCount;
+
+// Binds instanceBuffer at vertex/fragment index 1 and issues every batch
+- (void)encodeWithEncoder:(id<MTLRenderCommandEncoder>)encoder
+           instanceBuffer:(id<MTLBuffer>)instanceBuffer
+                   offset:(NSUInteger)offset
+                pipelines:(NSArray<id<MTLRenderPipelineState>> *)pipelines
+                  sampler:(nullable id<MTLSamplerState>)sampler;
+
+// Statistics for the last build
+@property (nonatomic, readonly) NSUInteger drawCallCount;
+@property (nonatomic, readonly) NSUInteger pipelineChangeCount;
+@property (nonatomic, readonly) NSUInteger textureChangeCount;
+
+@end
+
 #pragma mark - Utility Functions
 
 // List all available displays
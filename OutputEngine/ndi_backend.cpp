@@ -0,0 +1,325 @@
+// ndi_backend.cpp - Pluggable NDI sender backend
+// Portable C++ (dlopen + std::thread) so the send path also builds headless on Linux
+
+#include "ndi_backend.h"
+#include <chrono>
+#include <dlfcn.h>
+#include <thread>
+#include <unordered_map>
+
+namespace RocKontrol {
+
+namespace {
+
+uint64_t steadyNowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t fnv1a(const uint8_t* data, size_t size) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+#if ROCKONTROL_NDI_SDK_VENDORED
+
+// The vendored NDIlib_v5 does not match the runtime's table layout
+const NDIlib_v5* loadRuntime() {
+    fprintf(stderr, "NDIOutput: Built without the NDI SDK headers - cannot load the NDI runtime\n");
+    return nullptr;
+}
+
+#else
+
+// NDI runtime loaded once per process
+std::mutex g_runtime_mutex;
+const NDIlib_v5* g_runtime = nullptr;
+void* g_runtime_handle = nullptr;
+
+const NDIlib_v5* loadRuntime() {
+    std::lock_guard<std::mutex> lock(g_runtime_mutex);
+    if (g_runtime) return g_runtime;
+
+    // Try to load NDI runtime library
+    const char* ndi_paths[] = {
+#if defined(__APPLE__)
+        "/usr/local/lib/libndi.dylib",
+        "/Library/NDI SDK for Apple/lib/macOS/libndi.dylib",
+        "libndi.dylib"
+#else
+        "libndi.so.6",
+        "libndi.so.5",
+        "/usr/local/lib/libndi.so"
+#endif
+    };
+
+    for (const char* path : ndi_paths) {
+        g_runtime_handle = dlopen(path, RTLD_LOCAL | RTLD_LAZY);
+        if (g_runtime_handle) break;
+    }
+
+    if (!g_runtime_handle) {
+        fprintf(stderr, "NDIOutput: Failed to load NDI runtime library\n");
+        return nullptr;
+    }
+
+    // Get the load function
+    typedef const NDIlib_v5* (*NDIlib_v5_load_fn)(void);
+    NDIlib_v5_load_fn load_fn = (NDIlib_v5_load_fn)dlsym(g_runtime_handle, "NDIlib_v5_load");
+    if (!load_fn) {
+        fprintf(stderr, "NDIOutput: Failed to find NDIlib_v5_load\n");
+        dlclose(g_runtime_handle);
+        g_runtime_handle = nullptr;
+        return nullptr;
+    }
+
+    g_runtime = load_fn();
+    if (!g_runtime) {
+        fprintf(stderr, "NDIOutput: NDIlib_v5_load returned null\n");
+        dlclose(g_runtime_handle);
+        g_runtime_handle = nullptr;
+        return nullptr;
+    }
+
+    fprintf(stderr, "NDIOutput: NDI library loaded successfully\n");
+    return g_runtime;
+}
+
+#endif
+
+} // namespace
+
+size_t ndiFrameDataSize(const NDIlib_video_frame_v2_t& frame) {
+    size_t plane = (size_t)frame.line_stride_in_bytes * (size_t)frame.yres;
+    if (frame.FourCC == NDIlib_FourCC_type_UYVA) {
+        return plane + (size_t)frame.xres * (size_t)frame.yres;
+    }
+    return plane;
+}
+
+// NDILibBackend
+
+bool NDILibBackend::load() {
+    // runtime() is shared by every output, so several threads can get here at
+    // once; loadRuntime() serializes the dlopen and a failed load is retried
+    if (table_.load(std::memory_order_acquire)) return true;
+    const NDIlib_v5* table = loadRuntime();
+    if (!table) return false;
+    table_.store(table, std::memory_order_release);
+    return true;
+}
+
+NDIlib_send_instance_t NDILibBackend::createSender(const NDIlib_send_create_t& settings) {
+    if (!load()) return nullptr;
+    return table_.load(std::memory_order_acquire)->send_create(&settings);
+}
+
+void NDILibBackend::destroySender(NDIlib_send_instance_t sender) {
+    const NDIlib_v5* table = table_.load(std::memory_order_acquire);
+    if (table && sender) table->send_destroy(sender);
+}
+
+void NDILibBackend::sendVideo(NDIlib_send_instance_t sender, const NDIlib_video_frame_v2_t& frame) {
+    const NDIlib_v5* table = table_.load(std::memory_order_acquire);
+    if (table && sender) table->send_send_video_v2(sender, &frame);
+}
+
+void NDILibBackend::sendVideoAsync(NDIlib_send_instance_t sender, const NDIlib_video_frame_v2_t* frame) {
+    const NDIlib_v5* table = table_.load(std::memory_order_acquire);
+    if (table && sender) table->send_send_video_async_v2(sender, frame);
+}
+
+int NDILibBackend::connectionCount(NDIlib_send_instance_t sender, uint32_t timeoutMs) {
+    const NDIlib_v5* table = table_.load(std::memory_order_acquire);
+    if (!table || !sender) return 0;
+    return table->send_get_no_connections(sender, timeoutMs);
+}
+
+std::shared_ptr<NDISenderBackend> NDILibBackend::runtime() {
+    static std::shared_ptr<NDISenderBackend> backend = std::make_shared<NDILibBackend>();
+    return backend;
+}
+
+// FakeNDIBackend
+
+struct FakeNDIBackend::Sender {
+    uint32_t id;
+    bool clock_video;
+    uint64_t next_deadline_ns = 0;
+
+    // Async buffer the "SDK" still owns (pinned in PinTracker)
+    const uint8_t* pending_data = nullptr;
+};
+
+// Buffers currently owned by an async send, keyed by data pointer (a count,
+// since two senders may be handed the same buffer)
+class FakeNDIBackend::PinTracker : public PixelBufferObserver {
+public:
+    void pin(const uint8_t* data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pinned_[data]++;
+    }
+
+    void unpin(const uint8_t* data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pinned_.find(data);
+        if (it != pinned_.end() && --it->second == 0) pinned_.erase(it);
+    }
+
+    // The pool is taking the block back while the SDK could still read it
+    void blockReleased(const uint8_t* data) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pinned_.find(data);
+        if (it == pinned_.end()) return;
+        violations_.fetch_add(it->second);
+        pinned_.erase(it);
+    }
+
+    uint64_t violations() const { return violations_.load(); }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<const uint8_t*, uint32_t> pinned_;
+    std::atomic<uint64_t> violations_{0};
+};
+
+FakeNDIBackend::FakeNDIBackend() : FakeNDIBackend(Options()) {}
+
+FakeNDIBackend::FakeNDIBackend(const Options& options)
+    : options_(options), pins_(std::make_shared<PinTracker>()) {
+    if (!options_.csv_path.empty()) {
+        csv_ = fopen(options_.csv_path.c_str(), "w");
+        if (csv_) {
+            fprintf(csv_, "sender,xres,yres,fourcc,line_stride,frame_rate_N,frame_rate_D,timecode,send_time_ns,checksum,async\n");
+        } else {
+            fprintf(stderr, "NDIOutput: Fake backend could not open %s\n", options_.csv_path.c_str());
+        }
+    }
+}
+
+FakeNDIBackend::~FakeNDIBackend() {
+    if (csv_) fclose(csv_);
+}
+
+NDIlib_send_instance_t FakeNDIBackend::createSender(const NDIlib_send_create_t& settings) {
+    auto* sender = new Sender();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sender->id = next_sender_id_++;
+    }
+    sender->clock_video = settings.clock_video;
+    senders_alive_.fetch_add(1);
+    return reinterpret_cast<NDIlib_send_instance_t>(sender);
+}
+
+void FakeNDIBackend::destroySender(NDIlib_send_instance_t instance) {
+    auto* sender = reinterpret_cast<Sender*>(instance);
+    if (!sender) return;
+    retireAsync(sender);
+    delete sender;
+    senders_alive_.fetch_sub(1);
+}
+
+void FakeNDIBackend::sendVideo(NDIlib_send_instance_t instance, const NDIlib_video_frame_v2_t& frame) {
+    auto* sender = reinterpret_cast<Sender*>(instance);
+    if (!sender) return;
+    retireAsync(sender);   // A synchronous send waits for any async frame
+    pace(sender, frame);
+    record(sender, frame, false);
+}
+
+void FakeNDIBackend::sendVideoAsync(NDIlib_send_instance_t instance, const NDIlib_video_frame_v2_t* frame) {
+    auto* sender = reinterpret_cast<Sender*>(instance);
+    if (!sender) return;
+    retireAsync(sender);
+    if (!frame) {
+        async_flushes_.fetch_add(1);
+        return;
+    }
+
+    if (frame->p_data) {
+        sender->pending_data = frame->p_data;
+        pins_->pin(sender->pending_data);
+    }
+    pace(sender, *frame);
+    record(sender, *frame, true);
+}
+
+int FakeNDIBackend::connectionCount(NDIlib_send_instance_t, uint32_t) {
+    return options_.connections;
+}
+
+std::vector<NDISentFrame> FakeNDIBackend::records() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_;
+}
+
+void FakeNDIBackend::clearRecords() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    records_.clear();
+}
+
+uint64_t FakeNDIBackend::ownershipViolations() const {
+    return pins_->violations();
+}
+
+std::shared_ptr<PixelBufferObserver> FakeNDIBackend::ownershipObserver() const {
+    return pins_;
+}
+
+// The SDK lets go of the previous async buffer - the caller may now reuse it
+void FakeNDIBackend::retireAsync(Sender* sender) {
+    if (!sender->pending_data) return;
+    pins_->unpin(sender->pending_data);
+    sender->pending_data = nullptr;
+}
+
+// clock_video: hold each send to the frame's own rate like the SDK does
+void FakeNDIBackend::pace(Sender* sender, const NDIlib_video_frame_v2_t& frame) {
+    if (!options_.simulate_clock || !sender->clock_video || frame.frame_rate_N <= 0 || frame.frame_rate_D <= 0) {
+        return;
+    }
+    uint64_t interval = (uint64_t)(1000000000.0 * frame.frame_rate_D / frame.frame_rate_N);
+    uint64_t now = steadyNowNs();
+    if (sender->next_deadline_ns > now) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(sender->next_deadline_ns - now));
+        now = sender->next_deadline_ns;
+    }
+    sender->next_deadline_ns = now + interval;
+}
+
+void FakeNDIBackend::record(Sender* sender, const NDIlib_video_frame_v2_t& frame, bool async) {
+    NDISentFrame rec;
+    rec.sender_id = sender->id;
+    rec.xres = frame.xres;
+    rec.yres = frame.yres;
+    rec.fourcc = frame.FourCC;
+    rec.line_stride = frame.line_stride_in_bytes;
+    rec.frame_rate_N = frame.frame_rate_N;
+    rec.frame_rate_D = frame.frame_rate_D;
+    rec.timecode = frame.timecode;
+    rec.send_time_ns = steadyNowNs();
+    rec.async = async;
+    if (options_.checksum_frames && frame.p_data) {
+        rec.checksum = fnv1a(frame.p_data, ndiFrameDataSize(frame));
+    }
+
+    frames_sent_.fetch_add(1);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (options_.max_records == 0 || records_.size() < options_.max_records) {
+        records_.push_back(rec);
+    }
+    if (csv_) {
+        fprintf(csv_, "%u,%d,%d,0x%08x,%d,%d,%d,%lld,%llu,%016llx,%d\n",
+                rec.sender_id, rec.xres, rec.yres, (unsigned)rec.fourcc, rec.line_stride,
+                rec.frame_rate_N, rec.frame_rate_D, (long long)rec.timecode,
+                (unsigned long long)rec.send_time_ns, (unsigned long long)rec.checksum, rec.async ? 1 : 0);
+    }
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,147 @@
+// ndi_backend.h - Pluggable NDI sender backend
+// NDIOutput talks to NDI only through this interface: the real runtime (or any
+// NDIlib_v5 function table) via NDILibBackend, or an in-process FakeNDIBackend
+// that records what would have gone on the wire.
+
+#pragma once
+
+#include "ndi_sdk.h"
+#include "pixel_buffer_pool.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RocKontrol {
+
+class NDISenderBackend {
+public:
+    virtual ~NDISenderBackend() = default;
+
+    virtual const char* name() const = 0;
+
+    // Make the runtime available (idempotent). False = NDI unavailable.
+    virtual bool load() = 0;
+
+    virtual NDIlib_send_instance_t createSender(const NDIlib_send_create_t& settings) = 0;
+    virtual void destroySender(NDIlib_send_instance_t sender) = 0;
+
+    // Synchronous send - returns once the SDK no longer needs frame.p_data
+    virtual void sendVideo(NDIlib_send_instance_t sender, const NDIlib_video_frame_v2_t& frame) = 0;
+
+    // Async send - frame->p_data must stay valid until the next send on this
+    // sender or a flush (frame == nullptr) has returned; only then may the
+    // caller release or rewrite it
+    virtual void sendVideoAsync(NDIlib_send_instance_t sender, const NDIlib_video_frame_v2_t* frame) = 0;
+
+    // Number of receivers connected (waits up to timeoutMs for at least one)
+    virtual int connectionCount(NDIlib_send_instance_t sender, uint32_t timeoutMs) = 0;
+};
+
+// Backend over an NDIlib_v5 function table. With no table the NDI runtime is
+// loaded with dlopen on first load(); a caller-supplied table (e.g. a stand-in
+// for tests) is used as-is.
+class NDILibBackend : public NDISenderBackend {
+public:
+    explicit NDILibBackend(const NDIlib_v5* table = nullptr) : table_(table) {}
+
+    const char* name() const override { return "NDI runtime"; }
+    bool load() override;
+    NDIlib_send_instance_t createSender(const NDIlib_send_create_t& settings) override;
+    void destroySender(NDIlib_send_instance_t sender) override;
+    void sendVideo(NDIlib_send_instance_t sender, const NDIlib_video_frame_v2_t& frame) override;
+    void sendVideoAsync(NDIlib_send_instance_t sender, const NDIlib_video_frame_v2_t* frame) override;
+    int connectionCount(NDIlib_send_instance_t sender, uint32_t timeoutMs) override;
+
+    // Shared backend over the dynamically loaded runtime
+    static std::shared_ptr<NDISenderBackend> runtime();
+
+private:
+    std::atomic<const NDIlib_v5*> table_;   // Set once by load(); never cleared
+};
+
+// One frame as seen by FakeNDIBackend
+struct NDISentFrame {
+    uint32_t sender_id = 0;
+    int xres = 0;
+    int yres = 0;
+    NDIlib_FourCC_video_type_e fourcc = NDIlib_FourCC_type_BGRA;
+    int line_stride = 0;
+    int frame_rate_N = 0;
+    int frame_rate_D = 0;
+    int64_t timecode = 0;
+    uint64_t send_time_ns = 0;   // Steady clock when the send call returned
+    uint64_t checksum = 0;       // FNV-1a of the frame bytes (0 unless enabled)
+    bool async = false;
+};
+
+// In-process fake for headless runs: records frames, timecodes and timing in
+// memory (and optionally as CSV) and simulates clock_video pacing.
+//
+// It also checks the async ownership rule. Every async buffer is pinned from
+// the send call until the next send or flush on that sender. Attach
+// ownershipObserver() to the pool the sender's buffers come from; any pinned
+// block released back to that pool counts as a violation. The check never
+// reads the buffer, so it also catches a recycled block refilled with
+// identical bytes. Buffers that are not pool leases are not checked.
+class FakeNDIBackend : public NDISenderBackend {
+public:
+    struct Options {
+        bool simulate_clock = true;    // Block like NDI does when clock_video is set
+        bool checksum_frames = false;  // Hash every frame (costs a pass over the pixels)
+        int connections = 1;           // Reported receiver count
+        size_t max_records = 0;        // Keep at most this many records in memory (0 = unlimited)
+        std::string csv_path;          // Append one CSV line per frame when set
+    };
+
+    FakeNDIBackend();
+    explicit FakeNDIBackend(const Options& options);
+    ~FakeNDIBackend() override;
+
+    const char* name() const override { return "Fake NDI"; }
+    bool load() override { return true; }
+    NDIlib_send_instance_t createSender(const NDIlib_send_create_t& settings) override;
+    void destroySender(NDIlib_send_instance_t sender) override;
+    void sendVideo(NDIlib_send_instance_t sender, const NDIlib_video_frame_v2_t& frame) override;
+    void sendVideoAsync(NDIlib_send_instance_t sender, const NDIlib_video_frame_v2_t* frame) override;
+    int connectionCount(NDIlib_send_instance_t sender, uint32_t timeoutMs) override;
+
+    // Recorded data
+    std::vector<NDISentFrame> records() const;
+    void clearRecords();
+    uint64_t framesSent() const { return frames_sent_.load(); }
+    uint64_t asyncFlushes() const { return async_flushes_.load(); }
+    uint64_t ownershipViolations() const;
+    uint32_t sendersAlive() const { return senders_alive_.load(); }
+
+    // Pass to PixelBufferPool::setObserver (e.g. via setBufferObserver on the
+    // output) so buffers released while pinned are caught
+    std::shared_ptr<PixelBufferObserver> ownershipObserver() const;
+
+private:
+    struct Sender;
+    class PinTracker;
+
+    void record(Sender* sender, const NDIlib_video_frame_v2_t& frame, bool async);
+    void pace(Sender* sender, const NDIlib_video_frame_v2_t& frame);
+    void retireAsync(Sender* sender);
+
+    Options options_;
+    mutable std::mutex mutex_;
+    std::vector<NDISentFrame> records_;
+    FILE* csv_ = nullptr;
+    uint32_t next_sender_id_ = 1;
+
+    std::atomic<uint64_t> frames_sent_{0};
+    std::atomic<uint64_t> async_flushes_{0};
+    std::shared_ptr<PinTracker> pins_;   // Shared with the pools it observes
+    std::atomic<uint32_t> senders_alive_{0};
+};
+
+// Size of one frame's pixel data as NDI reads it (both planes for UYVA)
+size_t ndiFrameDataSize(const NDIlib_video_frame_v2_t& frame);
+
+} // namespace RocKontrol
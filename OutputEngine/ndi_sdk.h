@@ -0,0 +1,89 @@
+// ndi_sdk.h - NDI SDK declarations used by the sender backend seam
+// Uses the real Processing.NDI.Lib.h when the SDK is installed. Otherwise
+// declares the handful of types, enums and NDIlib_v5 entries the portable send
+// path needs (same names, values and field order as the SDK), so
+// ndi_backend.cpp and software_ndi_output.cpp build headless on Linux.
+//
+// The vendored NDIlib_v5 only has the send entries, so it is NOT layout
+// compatible with the runtime's table: without the SDK headers
+// NDILibBackend refuses to dlopen the runtime and only works with a
+// caller-supplied table (e.g. a stand-in in tests).
+
+#pragma once
+
+#if __has_include(<Processing.NDI.Lib.h>)
+
+#include <Processing.NDI.Lib.h>
+#define ROCKONTROL_NDI_SDK_VENDORED 0
+
+#else
+
+#include <cstdint>
+#define ROCKONTROL_NDI_SDK_VENDORED 1
+
+#ifndef NDI_LIB_FOURCC
+#define NDI_LIB_FOURCC(ch0, ch1, ch2, ch3) \
+    ((uint32_t)(uint8_t)(ch0) | ((uint32_t)(uint8_t)(ch1) << 8) | \
+     ((uint32_t)(uint8_t)(ch2) << 16) | ((uint32_t)(uint8_t)(ch3) << 24))
+#endif
+
+enum NDIlib_FourCC_video_type_e {
+    NDIlib_FourCC_video_type_UYVY = NDI_LIB_FOURCC('U', 'Y', 'V', 'Y'),
+    NDIlib_FourCC_type_UYVY = NDIlib_FourCC_video_type_UYVY,
+    NDIlib_FourCC_video_type_UYVA = NDI_LIB_FOURCC('U', 'Y', 'V', 'A'),
+    NDIlib_FourCC_type_UYVA = NDIlib_FourCC_video_type_UYVA,
+    NDIlib_FourCC_video_type_BGRA = NDI_LIB_FOURCC('B', 'G', 'R', 'A'),
+    NDIlib_FourCC_type_BGRA = NDIlib_FourCC_video_type_BGRA,
+    NDIlib_FourCC_video_type_max = 0x7fffffff
+};
+
+enum NDIlib_frame_format_type_e {
+    NDIlib_frame_format_type_interleaved = 0,
+    NDIlib_frame_format_type_progressive = 1,
+    NDIlib_frame_format_type_field_0 = 2,
+    NDIlib_frame_format_type_field_1 = 3,
+    NDIlib_frame_format_type_max = 0x7fffffff
+};
+
+static const int64_t NDIlib_send_timecode_synthesize = INT64_MAX;
+
+struct NDIlib_send_instance_type;
+typedef struct NDIlib_send_instance_type* NDIlib_send_instance_t;
+
+struct NDIlib_send_create_t {
+    const char* p_ndi_name = nullptr;
+    const char* p_groups = nullptr;
+    bool clock_video = true;
+    bool clock_audio = true;
+};
+
+struct NDIlib_video_frame_v2_t {
+    int xres = 0;
+    int yres = 0;
+    NDIlib_FourCC_video_type_e FourCC = NDIlib_FourCC_video_type_UYVY;
+    int frame_rate_N = 30000;
+    int frame_rate_D = 1001;
+    float picture_aspect_ratio = 0.0f;
+    NDIlib_frame_format_type_e frame_format_type = NDIlib_frame_format_type_progressive;
+    int64_t timecode = NDIlib_send_timecode_synthesize;
+    uint8_t* p_data = nullptr;
+    union {
+        int line_stride_in_bytes;
+        int data_size_in_bytes;
+    };
+    const char* p_metadata = nullptr;
+    int64_t timestamp = 0;
+
+    NDIlib_video_frame_v2_t() : line_stride_in_bytes(0) {}
+};
+
+// Send entries only - see the note at the top of this file
+struct NDIlib_v5 {
+    NDIlib_send_instance_t (*send_create)(const NDIlib_send_create_t* p_create_settings) = nullptr;
+    void (*send_destroy)(NDIlib_send_instance_t p_instance) = nullptr;
+    void (*send_send_video_v2)(NDIlib_send_instance_t p_instance, const NDIlib_video_frame_v2_t* p_video_data) = nullptr;
+    void (*send_send_video_async_v2)(NDIlib_send_instance_t p_instance, const NDIlib_video_frame_v2_t* p_video_data) = nullptr;
+    int (*send_get_no_connections)(NDIlib_send_instance_t p_instance, uint32_t timeout_in_ms) = nullptr;
+};
+
+#endif
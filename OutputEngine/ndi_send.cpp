@@ -0,0 +1,98 @@
+// ndi_send.cpp - NDI output stages shared by NDIOutput and SoftwareNDIOutput
+
+#include "ndi_send.h"
+#include <cstdio>
+#include <utility>
+
+namespace RocKontrol {
+
+bool prepareNDIPixelFrame(PixelBufferPool& pool, PixelPrep& prep, NDIPixelFormat format, ColorMatrix matrix,
+                          PixelPrepJob& job, NDIPixelFrame& frame) {
+    size_t required_size = convertedFrameSize(format, job.width, job.height);
+    frame.data = pool.acquire(required_size);
+    if (!frame.data) {
+        fprintf(stderr, "NDI: Failed to acquire %zu byte frame buffer\n", required_size);
+        return false;
+    }
+
+    job.format = format;
+    job.matrix = matrix;
+    job.dst = frame.data.data();
+    if (format == NDIPixelFormat::BGRA) {
+        job.dstStride = (size_t)job.width * 4;
+        frame.fourcc = NDIlib_FourCC_type_BGRA;
+    } else {
+        // UYVA: alpha plane follows the UYVY plane directly, one byte per pixel
+        job.dstStride = uyvyLineStride(job.width);
+        job.dstAlpha = frame.data.data() + job.dstStride * job.height;
+        job.dstAlphaStride = job.width;
+        frame.fourcc = (format == NDIPixelFormat::UYVA) ? NDIlib_FourCC_type_UYVA : NDIlib_FourCC_type_UYVY;
+    }
+
+    if (!prep.run(job)) {
+        frame.data.reset();
+        return false;
+    }
+
+    frame.width = job.width;
+    frame.height = job.height;
+    frame.line_stride = (uint32_t)job.dstStride;
+    frame.valid = true;
+    return true;
+}
+
+void setNDIFrameRate(NDIlib_video_frame_v2_t& frame, float fps) {
+    if (fps > 59.9f && fps < 60.1f) {
+        frame.frame_rate_N = 60000;     // 59.94
+        frame.frame_rate_D = 1001;
+    } else if (fps > 29.9f && fps < 30.1f) {
+        frame.frame_rate_N = 30000;     // 29.97
+        frame.frame_rate_D = 1001;
+    } else if (fps > 23.9f && fps < 24.1f) {
+        frame.frame_rate_N = 24000;     // 23.976
+        frame.frame_rate_D = 1001;
+    } else {
+        frame.frame_rate_N = (int)(fps * 1000);
+        frame.frame_rate_D = 1000;
+    }
+}
+
+NDIlib_video_frame_v2_t ndiVideoFrame(const NDIPixelFrame& frame, float fps) {
+    NDIlib_video_frame_v2_t ndi_frame;
+    ndi_frame.xres = frame.width;
+    ndi_frame.yres = frame.height;
+    ndi_frame.FourCC = frame.fourcc;
+    ndi_frame.line_stride_in_bytes = frame.line_stride;
+    ndi_frame.p_data = frame.data.data();
+    setNDIFrameRate(ndi_frame, fps > 0 ? fps : 59.94f);
+    ndi_frame.frame_format_type = NDIlib_frame_format_type_progressive;
+    // NDI timecode is in 100 ns units
+    ndi_frame.timecode = (frame.timestamp_ns > 0) ?
+        (int64_t)(frame.timestamp_ns / 100) : NDIlib_send_timecode_synthesize;
+    ndi_frame.picture_aspect_ratio = (float)frame.width / frame.height;
+    ndi_frame.p_metadata = nullptr;
+    return ndi_frame;
+}
+
+void NDIFrameSender::send(NDISenderBackend& backend, NDIlib_send_instance_t sender,
+                          const NDIlib_video_frame_v2_t& frame, PixelBuffer&& lease, bool async) {
+    if (async) {
+        // The SDK is done with the old pin once this call returns
+        backend.sendVideoAsync(sender, &frame);
+        pinned_ = std::move(lease);
+    } else {
+        backend.sendVideo(sender, frame);
+        lease.reset();
+        pinned_.reset();  // A synchronous send also retires any async frame
+    }
+}
+
+void NDIFrameSender::flush(NDISenderBackend& backend, NDIlib_send_instance_t sender) {
+    // A NULL async frame waits until the SDK has let go of the last buffer
+    if (pinned_ && sender) {
+        backend.sendVideoAsync(sender, nullptr);
+    }
+    pinned_.reset();
+}
+
+} // namespace RocKontrol
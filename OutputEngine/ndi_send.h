@@ -0,0 +1,105 @@
+// ndi_send.h - NDI output stages shared by NDIOutput and SoftwareNDIOutput
+// Crop / edge blend normalization, pooled pixel prep into the wire format,
+// NDI frame setup and the async send stage. NDIFrameSender owns the lease of
+// the frame handed to send_send_video_async_v2, which the SDK keeps reading
+// until the next send on the sender or a flush has returned.
+
+#pragma once
+
+#include "edge_blend_cpu.h"
+#include "ndi_backend.h"
+#include "output_sink.h"
+#include "pixel_buffer_pool.h"
+#include "pixel_convert.h"
+#include "pixel_prep.h"
+#include <cstdint>
+
+namespace RocKontrol {
+
+// Prepared frame waiting for the send thread
+struct NDIPixelFrame {
+    PixelBuffer data;               // Pooled lease in the wire format
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t line_stride = 0;       // Bytes per line of data (first plane for UYVA)
+    NDIlib_FourCC_video_type_e fourcc = NDIlib_FourCC_type_BGRA;
+    uint64_t timestamp_ns = 0;
+    float frame_rate = 0.0f;
+    bool valid = false;
+};
+
+// Acquire a pooled buffer for job.width x job.height in `format`, point the
+// job's destination at it and run the prep. On failure frame.data is empty.
+bool prepareNDIPixelFrame(PixelBufferPool& pool, PixelPrep& prep, NDIPixelFormat format, ColorMatrix matrix,
+                          PixelPrepJob& job, NDIPixelFrame& frame);
+
+// Common broadcast rates as exact NTSC fractions, anything else in 1/1000 fps
+void setNDIFrameRate(NDIlib_video_frame_v2_t& frame, float fps);
+
+// Progressive NDI frame over frame.data (fps <= 0 = 59.94, no timestamp = synthesized timecode)
+NDIlib_video_frame_v2_t ndiVideoFrame(const NDIPixelFrame& frame, float fps);
+
+// OutputSink::EdgeBlendParams (pixel feathers and warp offsets) normalized to
+// the crop for the edge blend shader / EdgeBlendRenderer. A template because
+// the params type is protected inside OutputSink; pass currentEdgeBlend().
+template <typename Blend>
+EdgeBlendSettings edgeBlendSettingsFor(const Blend& blend, const PixelCrop& crop,
+                                       uint32_t srcWidth, uint32_t srcHeight, float intensity) {
+    float outW = (float)crop.w;
+    float outH = (float)crop.h;
+
+    EdgeBlendSettings settings;
+    settings.featherLeft = blend.featherLeft / outW;
+    settings.featherRight = blend.featherRight / outW;
+    settings.featherTop = blend.featherTop / outH;
+    settings.featherBottom = blend.featherBottom / outH;
+    settings.gamma = blend.blendGamma;
+    settings.power = blend.blendPower;
+    settings.blackLevel = blend.blackLevel;
+    settings.activeCorner = blend.activeCorner;
+    settings.intensity = intensity;
+
+    WarpGeometry& g = settings.geometry;
+    const float warpPx[WarpGeometry::PointCount][2] = {
+        {blend.warpTopLeftX, blend.warpTopLeftY}, {blend.warpTopMiddleX, blend.warpTopMiddleY},
+        {blend.warpTopRightX, blend.warpTopRightY},
+        {blend.warpMiddleLeftX, blend.warpMiddleLeftY}, {blend.warpMiddleRightX, blend.warpMiddleRightY},
+        {blend.warpBottomLeftX, blend.warpBottomLeftY}, {blend.warpBottomMiddleX, blend.warpBottomMiddleY},
+        {blend.warpBottomRightX, blend.warpBottomRightY}
+    };
+    for (int i = 0; i < WarpGeometry::PointCount; i++) {
+        g.warp[i][0] = warpPx[i][0] / outW;
+        g.warp[i][1] = warpPx[i][1] / outH;
+    }
+    g.curvature = blend.warpCurvature;
+    g.lensK1 = blend.lensK1;
+    g.lensK2 = blend.lensK2;
+    g.lensCenterX = blend.lensCenterX;
+    g.lensCenterY = blend.lensCenterY;
+    g.cropOriginX = (float)crop.x / (float)srcWidth;
+    g.cropOriginY = (float)crop.y / (float)srcHeight;
+    g.cropSizeX = (float)crop.w / (float)srcWidth;
+    g.cropSizeY = (float)crop.h / (float)srcHeight;
+    return settings;
+}
+
+// One per sender, used only from that sender's send thread
+class NDIFrameSender {
+public:
+    // Async: `lease` stays pinned until the next send or flush; the previously
+    // pinned buffer is released only after this call has returned.
+    // Sync: `lease` and any pinned buffer are released once the SDK returns.
+    void send(NDISenderBackend& backend, NDIlib_send_instance_t sender,
+              const NDIlib_video_frame_v2_t& frame, PixelBuffer&& lease, bool async);
+
+    // Wait until the SDK has let go of the pinned buffer, then release it.
+    // Must run before the sender is destroyed; no-op if nothing is pinned.
+    void flush(NDISenderBackend& backend, NDIlib_send_instance_t sender);
+
+    bool hasPinned() const { return (bool)pinned_; }
+
+private:
+    PixelBuffer pinned_;
+};
+
+} // namespace RocKontrol
@@ -4,12 +4,20 @@
 #pragma once
 
 #include "output_sink.h"
+#include "ndi_backend.h"
+#include "ndi_send.h"
 #include "switcher_frame.h"
+#include "pixel_buffer_pool.h"
+#include "pixel_convert.h"
+#include "pixel_prep.h"
+#include "warp_map.h"
 #include <Processing.NDI.Lib.h>
 #include <thread>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <queue>
 #include <string>
 
@@ -24,8 +32,15 @@ struct NDIOutputConfig {
     bool clock_audio = false;          // Use NDI for audio timing
     uint32_t async_queue_size = 5;     // Async send queue depth (5 for edge-blend stability)
     bool legacy_mode = false;          // Use synchronous sending (more compatible but slower)
+    bool async_send = true;            // send_send_video_async_v2 - don't block on the NDI clock
+    NDIPixelFormat pixel_format = NDIPixelFormat::BGRA;  // Wire format (UYVY halves bandwidth)
+    ColorMatrix color_matrix = ColorMatrix::BT709;       // Matrix for UYVY/UYVA conversion
+    uint32_t prep_bands = 0;           // Row bands for crop/intensity/convert (0 = one per worker)
+    uint32_t readback_depth = 2;       // Edge-blended frames in flight on the GPU before readback (1-3)
 };
 
+struct EdgeBlendShaderParams;
+
 // NDI Output Sink
 class NDIOutput : public OutputSink {
 public:
@@ -66,6 +81,9 @@ public:
     // Statistics
     uint64_t framesSent() const { return frames_sent_.load(); }
     uint64_t framesDropped() const { return frames_dropped_.load(); }
+    uint64_t bufferAllocations() const { return buffer_pool_.allocations(); }
+    uint64_t bufferReuses() const { return buffer_pool_.reuses(); }
+    uint64_t bufferBytesReserved() const { return buffer_pool_.bytesReserved(); }
 
     // Legacy mode (synchronous sending, more compatible)
     void setLegacyMode(bool enabled);
@@ -75,6 +93,54 @@ public:
     void setTargetFrameRate(float fps);
     float targetFrameRate() const { return target_frame_rate_.load(); }
 
+    // Wire pixel format (BGRA is sent as-is, UYVY/UYVA are converted during pixel prep)
+    void setPixelFormat(NDIPixelFormat format, ColorMatrix matrix);
+    NDIPixelFormat pixelFormat() const { return pixel_format_.load(); }
+    ColorMatrix colorMatrix() const { return color_matrix_.load(); }
+
+    // Async send: the SDK gets one buffer while the next is being prepared
+    void setAsyncSend(bool enabled);
+    bool isAsyncSend() const { return async_send_.load(); }
+
+    // Send through a different backend (e.g. FakeNDIBackend for headless runs).
+    // Only while stopped; nullptr = the dynamically loaded runtime.
+    void setBackend(std::shared_ptr<NDISenderBackend> backend);
+    std::shared_ptr<NDISenderBackend> backend() const { return backend_; }
+
+    // Watch the send buffer pool (e.g. FakeNDIBackend::ownershipObserver())
+    void setBufferObserver(std::shared_ptr<PixelBufferObserver> observer) { buffer_pool_.setObserver(std::move(observer)); }
+
+    // Use a specific NDI function table instead of the dynamically loaded runtime
+    // (shorthand for setBackend with an NDILibBackend). nullptr = runtime.
+    void setNDILibrary(const NDIlib_v5* library);
+
+    // Receivers currently connected to this sender (0 while stopped)
+    int connectionCount() const;
+
+    // Row bands used by the pixel prep stage (0 = one per pool worker plus the caller)
+    void setPrepBandCount(uint32_t bands);
+    uint32_t prepBandCount() const { return pixel_prep_.bandCount(); }
+
+    // Times the warp/lens geometry map was re-baked (once per parameter change,
+    // plus a retry for any bake the GPU did not complete)
+    uint64_t warpMapBuilds() const { return warp_map_builds_.load(); }
+
+    // Edge-blended frames are read back through a ring of shared buffers; the
+    // render thread never waits on the GPU. Depth = frames of added latency (1-3).
+    static constexpr uint32_t kMaxReadbackDepth = 3;
+    void setReadbackDepth(uint32_t depth);
+    uint32_t readbackDepth() const { return readback_depth_.load(); }
+
+    // GPU -> CPU latency of edge-blended frames (commit to readback complete)
+    struct ReadbackStats {
+        uint64_t completed = 0;        // Readbacks finished
+        uint64_t ring_full = 0;        // Frames dropped because every slot was in flight
+        double last_ms = 0.0;
+        double avg_ms = 0.0;
+        double max_ms = 0.0;
+    };
+    ReadbackStats readbackStats() const;
+
 private:
     // Async send thread
     void sendLoop();
@@ -82,23 +148,48 @@ private:
     // Convert Metal texture to NDI frame
     bool convertFromTexture(const SwitcherFrame& frame, NDIlib_video_frame_v2_t& ndi_frame);
 
+    // Crop / scale / convert a BGRA source into a pooled frame in the wire format
+    bool preparePixelFrame(PixelPrepJob& job, NDIPixelFrame& frame);
+
 private:
     // Metal resources
     id<MTLDevice> device_;
     id<MTLCommandQueue> command_queue_;
     id<MTLRenderPipelineState> edge_blend_pipeline_;
+    id<MTLRenderPipelineState> edge_blend_mapped_pipeline_;  // Geometry read from warp_map_texture_
+    id<MTLRenderPipelineState> warp_map_pipeline_;           // Bakes the geometry map
     id<MTLSamplerState> sampler_;
     id<MTLTexture> temp_texture_;  // For edge blend rendering
     uint32_t temp_texture_width_{0};
     uint32_t temp_texture_height_{0};
 
+    // Cached source UV per output pixel (RG32Float), rebuilt only when the geometry changes
+    id<MTLTexture> warp_map_texture_;
+    std::atomic<uint64_t> warp_map_builds_{0};
+
+    // What warp_map_texture_ holds. Shared with the bake's completion handler,
+    // which alone marks it valid, and only when the GPU completed the bake.
+    struct WarpMapCache {
+        std::mutex mutex;
+        WarpGeometry geometry;      // Geometry of the latest encoded bake
+        uint64_t generation = 0;    // Bumped per encoded bake
+        bool pending = false;       // Latest bake encoded, GPU not done yet
+        bool valid = false;         // Latest bake completed
+    };
+    std::shared_ptr<WarpMapCache> warp_map_cache_ = std::make_shared<WarpMapCache>();
+
     // Edge blend shader and pipeline setup
     bool setupEdgeBlendPipeline();
     bool ensureTempTexture(uint32_t width, uint32_t height);
     bool renderWithEdgeBlend(id<MTLTexture> sourceTexture, uint32_t cropX, uint32_t cropY,
                               uint32_t cropW, uint32_t cropH);
+    bool encodeEdgeBlend(id<MTLCommandBuffer> commandBuffer, id<MTLTexture> sourceTexture,
+                         uint32_t cropX, uint32_t cropY, uint32_t cropW, uint32_t cropH);
+    bool encodeWarpMap(id<MTLCommandBuffer> commandBuffer, const EdgeBlendShaderParams& params,
+                       uint32_t width, uint32_t height);
 
     // NDI resources
+    std::shared_ptr<NDISenderBackend> backend_ = NDILibBackend::runtime();
     NDIlib_send_instance_t sender_;
     NDIOutputConfig config_;
 
@@ -107,7 +198,10 @@ private:
     std::atomic<bool> should_stop_{false};
     std::atomic<OutputStatus> status_{OutputStatus::Stopped};
     std::atomic<bool> legacy_mode_{false};  // Synchronous sending mode
+    std::atomic<bool> async_send_{true};    // send_send_video_async_v2 in the send loop
     std::atomic<float> target_frame_rate_{0.0f};  // 0 = unlimited
+    std::atomic<NDIPixelFormat> pixel_format_{NDIPixelFormat::BGRA};
+    std::atomic<ColorMatrix> color_matrix_{ColorMatrix::BT709};
 
     // Frame info
     std::atomic<uint32_t> width_{0};
@@ -118,23 +212,60 @@ private:
     std::atomic<uint32_t> target_width_{0};
     std::atomic<uint32_t> target_height_{0};
 
-    // Pre-rendered frame data (for batch processing path)
-    struct PixelFrame {
-        std::vector<uint8_t> data;
-        uint32_t width;
-        uint32_t height;
-        uint64_t timestamp_ns;
-        float frame_rate;
-        bool valid;
+    // Reusable pixel storage - declared before the queue so queued leases are
+    // released before the pool itself goes away
+    PixelBufferPool buffer_pool_;
+
+    // Crop / intensity / format conversion split across the shared band pool
+    PixelPrep pixel_prep_;
+
+    // Queue a prepared frame for the send thread (drops the oldest when full)
+    void enqueuePixelFrame(NDIPixelFrame&& frame);
 
-        PixelFrame() : width(0), height(0), timestamp_ns(0), frame_rate(0), valid(false) {}
+    // Pipelined readback of the edge blend result
+    struct ReadbackSlot {
+        id<MTLBuffer> buffer = nil;     // Shared storage, filled by a blit
+        uint32_t width = 0;
+        uint32_t height = 0;
+        size_t bytes_per_row = 0;
+        uint64_t timestamp_ns = 0;
+        float frame_rate = 0.0f;
+        uint64_t submit_ns = 0;
+        std::atomic<bool> busy{false};  // Owned by an in-flight command buffer
     };
+    struct CompletedReadback {
+        uint32_t slot;
+        bool succeeded;
+        uint64_t complete_ns;
+    };
+
+    // Send thread wake-up, shared with the Metal completion handlers. A handler
+    // only touches this (it holds a reference), never the NDIOutput itself.
+    struct SendHandoff {
+        std::mutex mutex;                          // Also guards pixel_queue_
+        std::condition_variable cv;
+        uint32_t readbacks_in_flight = 0;          // Committed, GPU not done yet
+        bool readbacks_closed = true;              // Until start(), and from stop() on
+        std::deque<CompletedReadback> completed;   // GPU done, prep pending on the send thread
+    };
+
+    bool submitReadback(const SwitcherFrame& frame, id<MTLTexture> texture, uint32_t cropX, uint32_t cropY,
+                        uint32_t cropW, uint32_t cropH);
+    bool prepareReadback(const CompletedReadback& done, NDIPixelFrame& frame);
+    void waitForReadbacks();
+
+    ReadbackSlot readback_slots_[kMaxReadbackDepth];
+    std::atomic<uint32_t> readback_depth_{2};
+    std::atomic<uint64_t> readbacks_completed_{0};
+    std::atomic<uint64_t> readback_ring_full_{0};
+    std::atomic<uint64_t> readback_last_ns_{0};
+    std::atomic<uint64_t> readback_max_ns_{0};
+    std::atomic<uint64_t> readback_total_ns_{0};
 
     // Async send queue - now uses pre-rendered pixel data
     std::thread send_thread_;
-    std::queue<PixelFrame> pixel_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable queue_cv_;
+    std::queue<NDIPixelFrame> pixel_queue_;
+    std::shared_ptr<SendHandoff> handoff_ = std::make_shared<SendHandoff>();
 
     // Frame buffer for NDI (reused)
     std::vector<uint8_t> ndi_buffer_;
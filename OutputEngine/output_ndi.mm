@@ -3,53 +3,6 @@
 
 #import "output_ndi.h"
 #import <Foundation/Foundation.h>
-#include <dlfcn.h>
-
-// NDI dynamic loading - the SDK is loaded at runtime
-static const NDIlib_v5* ndi_lib = nullptr;
-static void* ndi_handle = nullptr;
-
-static bool loadNDI() {
-    if (ndi_lib) return true;
-
-    // Try to load NDI runtime library
-    const char* ndi_paths[] = {
-        "/usr/local/lib/libndi.dylib",
-        "/Library/NDI SDK for Apple/lib/macOS/libndi.dylib",
-        "libndi.dylib"
-    };
-
-    for (const char* path : ndi_paths) {
-        ndi_handle = dlopen(path, RTLD_LOCAL | RTLD_LAZY);
-        if (ndi_handle) break;
-    }
-
-    if (!ndi_handle) {
-        NSLog(@"NDIOutput: Failed to load NDI runtime library");
-        return false;
-    }
-
-    // Get the load function
-    typedef const NDIlib_v5* (*NDIlib_v5_load_fn)(void);
-    NDIlib_v5_load_fn load_fn = (NDIlib_v5_load_fn)dlsym(ndi_handle, "NDIlib_v5_load");
-    if (!load_fn) {
-        NSLog(@"NDIOutput: Failed to find NDIlib_v5_load");
-        dlclose(ndi_handle);
-        ndi_handle = nullptr;
-        return false;
-    }
-
-    ndi_lib = load_fn();
-    if (!ndi_lib) {
-        NSLog(@"NDIOutput: NDIlib_v5_load returned null");
-        dlclose(ndi_handle);
-        ndi_handle = nullptr;
-        return false;
-    }
-
-    NSLog(@"NDIOutput: NDI library loaded successfully");
-    return true;
-}
 
 // Edge blend shader source code with geometric correction
 static NSString* const edgeBlendShaderSource = @R"(
@@ -384,12 +337,10 @@ bool has8PointWarpActive(float2 tl, float2 tm, float2 tr,
            length(bl) > 0.001 || length(bm) > 0.001 || length(br) > 0.001;
 }
 
-fragment float4 edgeBlendFragment(VertexOut in [[stage_in]],
-                                   texture2d<float> sourceTexture [[texture(0)]],
-                                   sampler textureSampler [[sampler(0)]],
-                                   constant EdgeBlendParams& params [[buffer(0)]]) {
-    float2 uv = in.texCoord;
-
+// Geometry chain: 8-point warp, curvature, lens and crop.
+// Returns the source texture coordinate, or (-1,-1) outside the warped region.
+// Mirrored on the CPU by warpSourceUV() in warp_map.cpp - keep them in step.
+float2 warpSourceCoord(float2 uv, constant EdgeBlendParams& params) {
     // Calculate all 8 warped control point positions (3x3 grid without center)
     float2 warpedTL = float2(0.0, 0.0) + params.warpTopLeft;
     float2 warpedTM = float2(0.5, 0.0) + params.warpTopMiddle;
@@ -422,7 +373,7 @@ fragment float4 edgeBlendFragment(VertexOut in [[stage_in]],
 
         if (invUV.x < 0.0) {
             // Outside the warped region - render black (keystone border)
-            return float4(0.0, 0.0, 0.0, 1.0);
+            return float2(-1.0, -1.0);
         }
 
         // Use inverse-mapped UV for texture sampling
@@ -440,34 +391,35 @@ fragment float4 edgeBlendFragment(VertexOut in [[stage_in]],
     float2 sourceCoord = params.cropOrigin + sampleUV * params.cropSize;
 
     // Clamp to valid texture coordinates
-    sourceCoord = clamp(sourceCoord, float2(0.0), float2(1.0));
-
-    float4 color = sourceTexture.sample(textureSampler, sourceCoord);
+    return clamp(sourceCoord, float2(0.0), float2(1.0));
+}
 
+// Feather ramps, gamma, black level, intensity and corner overlay
+float4 applyEdgeBlend(float2 uv, float4 color, constant EdgeBlendParams& params) {
     // 4. Calculate edge blend factors
     float blendL = 1.0, blendR = 1.0, blendT = 1.0, blendB = 1.0;
 
     // Left edge fade
-    if (params.featherLeft > 0.0 && in.texCoord.x < params.featherLeft) {
-        float t = in.texCoord.x / params.featherLeft;
+    if (params.featherLeft > 0.0 && uv.x < params.featherLeft) {
+        float t = uv.x / params.featherLeft;
         blendL = pow(t, params.power);
     }
 
     // Right edge fade
-    if (params.featherRight > 0.0 && in.texCoord.x > (1.0 - params.featherRight)) {
-        float t = (1.0 - in.texCoord.x) / params.featherRight;
+    if (params.featherRight > 0.0 && uv.x > (1.0 - params.featherRight)) {
+        float t = (1.0 - uv.x) / params.featherRight;
         blendR = pow(t, params.power);
     }
 
     // Top edge fade
-    if (params.featherTop > 0.0 && in.texCoord.y < params.featherTop) {
-        float t = in.texCoord.y / params.featherTop;
+    if (params.featherTop > 0.0 && uv.y < params.featherTop) {
+        float t = uv.y / params.featherTop;
         blendT = pow(t, params.power);
     }
 
     // Bottom edge fade
-    if (params.featherBottom > 0.0 && in.texCoord.y > (1.0 - params.featherBottom)) {
-        float t = (1.0 - in.texCoord.y) / params.featherBottom;
+    if (params.featherBottom > 0.0 && uv.y > (1.0 - params.featherBottom)) {
+        float t = (1.0 - uv.y) / params.featherBottom;
         blendB = pow(t, params.power);
     }
 
@@ -494,21 +446,166 @@ fragment float4 edgeBlendFragment(VertexOut in [[stage_in]],
         else if (corner == 2) warpOffset = params.warpTopRight;
         else if (corner == 3) warpOffset = params.warpBottomLeft;
         else if (corner == 4) warpOffset = params.warpBottomRight;
-        result = drawCornerOverlay(in.texCoord, result, corner, warpOffset);
+        result = drawCornerOverlay(uv, result, corner, warpOffset);
     }
 
     return result;
 }
+
+fragment float4 edgeBlendFragment(VertexOut in [[stage_in]],
+                                   texture2d<float> sourceTexture [[texture(0)]],
+                                   sampler textureSampler [[sampler(0)]],
+                                   constant EdgeBlendParams& params [[buffer(0)]]) {
+    float2 sourceCoord = warpSourceCoord(in.texCoord, params);
+    if (sourceCoord.x < 0.0) {
+        return float4(0.0, 0.0, 0.0, 1.0);
+    }
+    float4 color = sourceTexture.sample(textureSampler, sourceCoord);
+    return applyEdgeBlend(in.texCoord, color, params);
+}
+
+// Bake the geometry chain into an RG32Float map (one source UV per output pixel)
+fragment float4 warpMapFragment(VertexOut in [[stage_in]],
+                                constant EdgeBlendParams& params [[buffer(0)]]) {
+    return float4(warpSourceCoord(in.texCoord, params), 0.0, 0.0);
+}
+
+// Edge blend with the geometry chain read from the baked map - one dependent fetch
+fragment float4 edgeBlendMappedFragment(VertexOut in [[stage_in]],
+                                        texture2d<float> sourceTexture [[texture(0)]],
+                                        texture2d<float> warpMap [[texture(1)]],
+                                        sampler textureSampler [[sampler(0)]],
+                                        constant EdgeBlendParams& params [[buffer(0)]]) {
+    float2 sourceCoord = warpMap.read(uint2(in.position.xy)).xy;
+    if (sourceCoord.x < 0.0) {
+        return float4(0.0, 0.0, 0.0, 1.0);
+    }
+    float4 color = sourceTexture.sample(textureSampler, sourceCoord);
+    return applyEdgeBlend(in.texCoord, color, params);
+}
 )";
 
 namespace RocKontrol {
 
+// Edge blend params structure (must match shader)
+struct EdgeBlendShaderParams {
+    float featherLeft;
+    float featherRight;
+    float featherTop;
+    float featherBottom;
+    float gamma;
+    float power;
+    float blackLevel;
+    float activeCorner;  // 0=none, 1=TL, 2=TR, 3=BL, 4=BR
+    float cropOriginX;
+    float cropOriginY;
+    float cropSizeX;
+    float cropSizeY;
+    // 8-point warp
+    float warpTopLeftX;
+    float warpTopLeftY;
+    float warpTopMiddleX;
+    float warpTopMiddleY;
+    float warpTopRightX;
+    float warpTopRightY;
+    float warpMiddleLeftX;
+    float warpMiddleLeftY;
+    float warpMiddleRightX;
+    float warpMiddleRightY;
+    float warpBottomLeftX;
+    float warpBottomLeftY;
+    float warpBottomMiddleX;
+    float warpBottomMiddleY;
+    float warpBottomRightX;
+    float warpBottomRightY;
+    // Lens distortion
+    float lensK1;
+    float lensK2;
+    float lensCenterX;
+    float lensCenterY;
+    // Warp curvature
+    float warpCurvature;
+    // Output intensity
+    float intensity;
+};
+
+// Shader layout of the normalized edge blend settings
+static EdgeBlendShaderParams shaderParamsFrom(const EdgeBlendSettings& s) {
+    const WarpGeometry& g = s.geometry;
+    EdgeBlendShaderParams p;
+    p.featherLeft = s.featherLeft;
+    p.featherRight = s.featherRight;
+    p.featherTop = s.featherTop;
+    p.featherBottom = s.featherBottom;
+    p.gamma = s.gamma;
+    p.power = s.power;
+    p.blackLevel = s.blackLevel;
+    p.activeCorner = (float)s.activeCorner;
+    p.cropOriginX = g.cropOriginX;
+    p.cropOriginY = g.cropOriginY;
+    p.cropSizeX = g.cropSizeX;
+    p.cropSizeY = g.cropSizeY;
+    float* points[WarpGeometry::PointCount][2] = {
+        {&p.warpTopLeftX, &p.warpTopLeftY}, {&p.warpTopMiddleX, &p.warpTopMiddleY},
+        {&p.warpTopRightX, &p.warpTopRightY},
+        {&p.warpMiddleLeftX, &p.warpMiddleLeftY}, {&p.warpMiddleRightX, &p.warpMiddleRightY},
+        {&p.warpBottomLeftX, &p.warpBottomLeftY}, {&p.warpBottomMiddleX, &p.warpBottomMiddleY},
+        {&p.warpBottomRightX, &p.warpBottomRightY}
+    };
+    for (int i = 0; i < WarpGeometry::PointCount; i++) {
+        *points[i][0] = g.warp[i][0];
+        *points[i][1] = g.warp[i][1];
+    }
+    p.lensK1 = g.lensK1;
+    p.lensK2 = g.lensK2;
+    p.lensCenterX = g.lensCenterX;
+    p.lensCenterY = g.lensCenterY;
+    p.warpCurvature = g.curvature;
+    p.intensity = s.intensity;
+    return p;
+}
+
+// Geometry part of the shader params, as the warp map cache key
+static WarpGeometry warpGeometryFrom(const EdgeBlendShaderParams& p) {
+    WarpGeometry g;
+    const float points[WarpGeometry::PointCount][2] = {
+        {p.warpTopLeftX, p.warpTopLeftY}, {p.warpTopMiddleX, p.warpTopMiddleY}, {p.warpTopRightX, p.warpTopRightY},
+        {p.warpMiddleLeftX, p.warpMiddleLeftY}, {p.warpMiddleRightX, p.warpMiddleRightY},
+        {p.warpBottomLeftX, p.warpBottomLeftY}, {p.warpBottomMiddleX, p.warpBottomMiddleY},
+        {p.warpBottomRightX, p.warpBottomRightY}
+    };
+    memcpy(g.warp, points, sizeof(points));
+    g.curvature = p.warpCurvature;
+    g.lensK1 = p.lensK1;
+    g.lensK2 = p.lensK2;
+    g.lensCenterX = p.lensCenterX;
+    g.lensCenterY = p.lensCenterY;
+    g.cropOriginX = p.cropOriginX;
+    g.cropOriginY = p.cropOriginY;
+    g.cropSizeX = p.cropSizeX;
+    g.cropSizeY = p.cropSizeY;
+    return g;
+}
+
+// PixelRowReader for Metal textures - getBytes is safe from several bands at once
+static void readTextureRows(void* context, uint32_t x, uint32_t y, uint32_t width, uint32_t rows,
+                            uint8_t* dst, size_t dstStride) {
+    id<MTLTexture> texture = (__bridge id<MTLTexture>)context;
+    [texture getBytes:dst
+          bytesPerRow:dstStride
+           fromRegion:MTLRegionMake2D(x, y, width, rows)
+          mipmapLevel:0];
+}
+
 NDIOutput::NDIOutput(id<MTLDevice> device)
     : device_(device)
     , command_queue_(nil)
     , edge_blend_pipeline_(nil)
+    , edge_blend_mapped_pipeline_(nil)
+    , warp_map_pipeline_(nil)
     , sampler_(nil)
     , temp_texture_(nil)
+    , warp_map_texture_(nil)
     , sender_(nullptr) {
     // Create command queue for edge blend rendering
     command_queue_ = [device_ newCommandQueue];
@@ -532,6 +629,11 @@ bool NDIOutput::configure(const NDIOutputConfig& config) {
     }
 
     config_ = config;
+    async_send_.store(config.async_send);
+    pixel_format_.store(config.pixel_format);
+    color_matrix_.store(config.color_matrix);
+    pixel_prep_.setBandCount(config.prep_bands);
+    readback_depth_.store(std::max<uint32_t>(1, std::min(config.readback_depth, kMaxReadbackDepth)));
     return true;
 }
 
@@ -588,6 +690,45 @@ void NDIOutput::setTargetFrameRate(float fps) {
     }
 }
 
+void NDIOutput::setPixelFormat(NDIPixelFormat format, ColorMatrix matrix) {
+    pixel_format_.store(format);
+    color_matrix_.store(matrix);
+    config_.pixel_format = format;
+    config_.color_matrix = matrix;
+    NSLog(@"NDIOutput: Pixel format set to %s (%s, %s kernel)", ndiPixelFormatToString(format),
+          matrix == ColorMatrix::BT601 ? "BT.601" : "BT.709",
+          convertPathName(resolveConvertPath(ConvertPath::Auto)));
+}
+
+void NDIOutput::setAsyncSend(bool enabled) {
+    async_send_.store(enabled);
+    config_.async_send = enabled;
+    NSLog(@"NDIOutput: Async send %s", enabled ? "ENABLED" : "DISABLED");
+}
+
+void NDIOutput::setBackend(std::shared_ptr<NDISenderBackend> backend) {
+    if (running_.load()) {
+        NSLog(@"NDIOutput: Cannot replace NDI backend while running");
+        return;
+    }
+    backend_ = backend ? std::move(backend) : NDILibBackend::runtime();
+    NSLog(@"NDIOutput: Using %s backend", backend_->name());
+}
+
+void NDIOutput::setNDILibrary(const NDIlib_v5* library) {
+    setBackend(library ? std::make_shared<NDILibBackend>(library) : nullptr);
+}
+
+int NDIOutput::connectionCount() const {
+    if (!running_.load() || !sender_) return 0;
+    return backend_->connectionCount(sender_, 0);
+}
+
+void NDIOutput::setPrepBandCount(uint32_t bands) {
+    pixel_prep_.setBandCount(bands);
+    config_.prep_bands = bands;
+}
+
 bool NDIOutput::start() {
     if (running_.load()) {
         return true;
@@ -597,7 +738,7 @@ bool NDIOutput::start() {
     notifyStatus(OutputStatus::Starting, "Starting NDI sender...");
 
     // Load NDI library if not already loaded
-    if (!loadNDI()) {
+    if (!backend_->load()) {
         status_.store(OutputStatus::Error);
         notifyStatus(OutputStatus::Error, "Failed to load NDI library");
         return false;
@@ -616,7 +757,7 @@ bool NDIOutput::start() {
     send_create.clock_video = config_.clock_video;
     send_create.clock_audio = config_.clock_audio;
 
-    sender_ = ndi_lib->send_create(&send_create);
+    sender_ = backend_->createSender(send_create);
     if (!sender_) {
         status_.store(OutputStatus::Error);
         notifyStatus(OutputStatus::Error, "Failed to create NDI sender");
@@ -626,6 +767,10 @@ bool NDIOutput::start() {
     // Start async send thread
     should_stop_.store(false);
     running_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(handoff_->mutex);
+        handoff_->readbacks_closed = false;
+    }
     send_thread_ = std::thread(&NDIOutput::sendLoop, this);
 
     status_.store(OutputStatus::Running);
@@ -642,32 +787,49 @@ void NDIOutput::stop() {
 
     should_stop_.store(true);
 
-    // Wake up send thread
+    // Refuse new readbacks (submitReadback checks this under the same lock, so a
+    // racing pushFrame either got its readback counted or commits nothing) and
+    // wake the send thread
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        queue_cv_.notify_all();
+        std::lock_guard<std::mutex> lock(handoff_->mutex);
+        handoff_->readbacks_closed = true;
+        handoff_->cv.notify_all();
     }
 
+    // Let in-flight GPU readbacks finish
+    waitForReadbacks();
+
     if (send_thread_.joinable()) {
         send_thread_.join();
     }
 
+    // Nothing may still be writing a slot when the sender and buffers go away
+    waitForReadbacks();
+
     running_.store(false);
 
     // Clean up NDI sender
-    if (sender_ && ndi_lib) {
-        ndi_lib->send_destroy(sender_);
+    if (sender_) {
+        backend_->destroySender(sender_);
         sender_ = nullptr;
     }
 
-    // Clear queue
+    // Clear queue and readbacks the send thread never got to
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
+        std::lock_guard<std::mutex> lock(handoff_->mutex);
         while (!pixel_queue_.empty()) {
             pixel_queue_.pop();
         }
+        frames_dropped_.fetch_add(handoff_->completed.size());
+        handoff_->completed.clear();
+    }
+    for (auto& slot : readback_slots_) {
+        slot.busy.store(false, std::memory_order_release);
     }
 
+    // Give idle frame buffers back to the system while stopped
+    buffer_pool_.trim();
+
     status_.store(OutputStatus::Stopped);
     notifyStatus(OutputStatus::Stopped, "NDI sender stopped");
 
@@ -710,6 +872,25 @@ bool NDIOutput::setupEdgeBlendPipeline() {
             return false;
         }
 
+        // Cached warp map path (optional - falls back to the per-pixel solve above)
+        id<MTLFunction> mappedFunc = [library newFunctionWithName:@"edgeBlendMappedFragment"];
+        id<MTLFunction> mapFunc = [library newFunctionWithName:@"warpMapFragment"];
+        if (mappedFunc && mapFunc) {
+            pipelineDesc.fragmentFunction = mappedFunc;
+            edge_blend_mapped_pipeline_ = [device_ newRenderPipelineStateWithDescriptor:pipelineDesc error:&error];
+
+            MTLRenderPipelineDescriptor* mapDesc = [[MTLRenderPipelineDescriptor alloc] init];
+            mapDesc.vertexFunction = vertexFunc;
+            mapDesc.fragmentFunction = mapFunc;
+            mapDesc.colorAttachments[0].pixelFormat = MTLPixelFormatRG32Float;
+            warp_map_pipeline_ = [device_ newRenderPipelineStateWithDescriptor:mapDesc error:&error];
+        }
+        if (!edge_blend_mapped_pipeline_ || !warp_map_pipeline_) {
+            NSLog(@"NDIOutput: Warp map pipeline unavailable, using per-pixel warp: %@", error);
+            edge_blend_mapped_pipeline_ = nil;
+            warp_map_pipeline_ = nil;
+        }
+
         // Create sampler
         MTLSamplerDescriptor* samplerDesc = [[MTLSamplerDescriptor alloc] init];
         samplerDesc.minFilter = MTLSamplerMinMagFilterLinear;
@@ -754,141 +935,144 @@ bool NDIOutput::ensureTempTexture(uint32_t width, uint32_t height) {
     }
 }
 
-// Render source texture with edge blend to temp texture
+// Render source texture with edge blend to temp texture and wait for the GPU
+// (legacy mode - the pipelined path is submitReadback)
 bool NDIOutput::renderWithEdgeBlend(id<MTLTexture> sourceTexture, uint32_t cropX, uint32_t cropY,
                                      uint32_t cropW, uint32_t cropH) {
-    if (!edge_blend_pipeline_ || !command_queue_ || !sampler_ || !temp_texture_) {
-        return false;
-    }
+    if (!command_queue_) return false;
 
     @autoreleasepool {
         id<MTLCommandBuffer> commandBuffer = [command_queue_ commandBuffer];
         if (!commandBuffer) return false;
 
-        // Create render pass to draw to temp texture
-        MTLRenderPassDescriptor* passDesc = [MTLRenderPassDescriptor renderPassDescriptor];
-        passDesc.colorAttachments[0].texture = temp_texture_;
-        passDesc.colorAttachments[0].loadAction = MTLLoadActionClear;
-        passDesc.colorAttachments[0].storeAction = MTLStoreActionStore;
-        passDesc.colorAttachments[0].clearColor = MTLClearColorMake(0, 0, 0, 1);
-
-        id<MTLRenderCommandEncoder> encoder = [commandBuffer renderCommandEncoderWithDescriptor:passDesc];
-        if (!encoder) return false;
-
-        // Get edge blend params
-        const auto& blend = currentEdgeBlend();
-        float texW = (float)sourceTexture.width;
-        float texH = (float)sourceTexture.height;
-
-        // Convert feather from pixels to normalized (0-1) relative to output size
-        float outW = (float)cropW;
-        float outH = (float)cropH;
-
-        // Edge blend params structure (must match shader)
-        struct {
-            float featherLeft;
-            float featherRight;
-            float featherTop;
-            float featherBottom;
-            float gamma;
-            float power;
-            float blackLevel;
-            float activeCorner;  // 0=none, 1=TL, 2=TR, 3=BL, 4=BR
-            float cropOriginX;
-            float cropOriginY;
-            float cropSizeX;
-            float cropSizeY;
-            // 8-point warp
-            float warpTopLeftX;
-            float warpTopLeftY;
-            float warpTopMiddleX;
-            float warpTopMiddleY;
-            float warpTopRightX;
-            float warpTopRightY;
-            float warpMiddleLeftX;
-            float warpMiddleLeftY;
-            float warpMiddleRightX;
-            float warpMiddleRightY;
-            float warpBottomLeftX;
-            float warpBottomLeftY;
-            float warpBottomMiddleX;
-            float warpBottomMiddleY;
-            float warpBottomRightX;
-            float warpBottomRightY;
-            // Lens distortion
-            float lensK1;
-            float lensK2;
-            float lensCenterX;
-            float lensCenterY;
-            // Warp curvature
-            float warpCurvature;
-            // Output intensity
-            float intensity;
-        } params;
-
-        params.featherLeft = blend.featherLeft / outW;
-        params.featherRight = blend.featherRight / outW;
-        params.featherTop = blend.featherTop / outH;
-        params.featherBottom = blend.featherBottom / outH;
-        params.gamma = blend.blendGamma;
-        params.power = blend.blendPower;
-        params.blackLevel = blend.blackLevel;
-        params.activeCorner = (float)blend.activeCorner;
-        params.cropOriginX = (float)cropX / texW;
-        params.cropOriginY = (float)cropY / texH;
-        params.cropSizeX = (float)cropW / texW;
-        params.cropSizeY = (float)cropH / texH;
-        // 8-point warp (normalize from pixels to 0-1 range)
-        params.warpTopLeftX = blend.warpTopLeftX / outW;
-        params.warpTopLeftY = blend.warpTopLeftY / outH;
-        params.warpTopMiddleX = blend.warpTopMiddleX / outW;
-        params.warpTopMiddleY = blend.warpTopMiddleY / outH;
-
-        // Debug: log normalized warp values
-        static int paramLogCounter = 0;
-        if (++paramLogCounter % 300 == 0 && (params.warpTopMiddleX != 0 || params.warpTopMiddleY != 0)) {
-            NSLog(@"NDIOutput: Shader params - TM(%.4f,%.4f) normalized, outW=%.0f outH=%.0f",
-                  params.warpTopMiddleX, params.warpTopMiddleY, outW, outH);
+        if (!encodeEdgeBlend(commandBuffer, sourceTexture, cropX, cropY, cropW, cropH)) {
+            return false;
         }
-        params.warpTopRightX = blend.warpTopRightX / outW;
-        params.warpTopRightY = blend.warpTopRightY / outH;
-        params.warpMiddleLeftX = blend.warpMiddleLeftX / outW;
-        params.warpMiddleLeftY = blend.warpMiddleLeftY / outH;
-        params.warpMiddleRightX = blend.warpMiddleRightX / outW;
-        params.warpMiddleRightY = blend.warpMiddleRightY / outH;
-        params.warpBottomLeftX = blend.warpBottomLeftX / outW;
-        params.warpBottomLeftY = blend.warpBottomLeftY / outH;
-        params.warpBottomMiddleX = blend.warpBottomMiddleX / outW;
-        params.warpBottomMiddleY = blend.warpBottomMiddleY / outH;
-        params.warpBottomRightX = blend.warpBottomRightX / outW;
-        params.warpBottomRightY = blend.warpBottomRightY / outH;
-        // Lens distortion
-        params.lensK1 = blend.lensK1;
-        params.lensK2 = blend.lensK2;
-        params.lensCenterX = blend.lensCenterX;
-        params.lensCenterY = blend.lensCenterY;
-        // Warp curvature for curved surfaces
-        params.warpCurvature = blend.warpCurvature;
-        // Output intensity from DMX
-        params.intensity = intensity_;
-
-        [encoder setRenderPipelineState:edge_blend_pipeline_];
-        [encoder setFragmentTexture:sourceTexture atIndex:0];
-        [encoder setFragmentSamplerState:sampler_ atIndex:0];
-        [encoder setFragmentBytes:&params length:sizeof(params) atIndex:0];
-
-        // Draw fullscreen triangle
-        [encoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:3];
-        [encoder endEncoding];
 
         // Wait for completion (needed before getBytes)
         [commandBuffer commit];
         [commandBuffer waitUntilCompleted];
-
         return true;
     }
 }
 
+// Encode the edge blend pass (and a warp map re-bake if needed) into temp_texture_
+bool NDIOutput::encodeEdgeBlend(id<MTLCommandBuffer> commandBuffer, id<MTLTexture> sourceTexture,
+                                uint32_t cropX, uint32_t cropY, uint32_t cropW, uint32_t cropH) {
+    if (!edge_blend_pipeline_ || !sampler_ || !temp_texture_) {
+        return false;
+    }
+
+    // Same normalization as the CPU renderer (ndi_send.h)
+    PixelCrop crop = {cropX, cropY, cropW, cropH};
+    EdgeBlendShaderParams params = shaderParamsFrom(
+        edgeBlendSettingsFor(currentEdgeBlend(), crop, (uint32_t)sourceTexture.width,
+                             (uint32_t)sourceTexture.height, intensity_));
+
+    // Re-bake the geometry map first if the warp, lens, crop or size changed
+    bool mapped = encodeWarpMap(commandBuffer, params, cropW, cropH);
+
+    // Create render pass to draw to temp texture
+    MTLRenderPassDescriptor* passDesc = [MTLRenderPassDescriptor renderPassDescriptor];
+    passDesc.colorAttachments[0].texture = temp_texture_;
+    passDesc.colorAttachments[0].loadAction = MTLLoadActionClear;
+    passDesc.colorAttachments[0].storeAction = MTLStoreActionStore;
+    passDesc.colorAttachments[0].clearColor = MTLClearColorMake(0, 0, 0, 1);
+
+    id<MTLRenderCommandEncoder> encoder = [commandBuffer renderCommandEncoderWithDescriptor:passDesc];
+    if (!encoder) {
+        warp_map_texture_ = nil;  // A bake encoded above never runs - force it next frame
+        return false;
+    }
+
+    [encoder setRenderPipelineState:mapped ? edge_blend_mapped_pipeline_ : edge_blend_pipeline_];
+    [encoder setFragmentTexture:sourceTexture atIndex:0];
+    if (mapped) {
+        [encoder setFragmentTexture:warp_map_texture_ atIndex:1];
+    }
+    [encoder setFragmentSamplerState:sampler_ atIndex:0];
+    [encoder setFragmentBytes:&params length:sizeof(params) atIndex:0];
+
+    // Draw fullscreen triangle
+    [encoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:3];
+    [encoder endEncoding];
+    return true;
+}
+
+// Bake warp + curvature + lens + crop into warp_map_texture_ when they change.
+// Returns false if the mapped pipeline is unavailable (use the per-pixel path).
+bool NDIOutput::encodeWarpMap(id<MTLCommandBuffer> commandBuffer, const EdgeBlendShaderParams& params,
+                              uint32_t width, uint32_t height) {
+    if (!warp_map_pipeline_ || !edge_blend_mapped_pipeline_) {
+        return false;
+    }
+
+    WarpGeometry geometry = warpGeometryFrom(params);
+    bool sizeChanged = !warp_map_texture_ || warp_map_texture_.width != width || warp_map_texture_.height != height;
+    std::shared_ptr<WarpMapCache> cache = warp_map_cache_;
+    uint64_t generation;
+    {
+        // A bake still in flight runs before this frame's blend pass (same
+        // queue); if it fails, its handler leaves the cache invalid and the
+        // next frame bakes again
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        if (!sizeChanged && (cache->valid || cache->pending) && geometry == cache->geometry) {
+            return true;
+        }
+        generation = ++cache->generation;
+        cache->geometry = geometry;
+        cache->pending = true;
+        cache->valid = false;
+    }
+    // Nothing was encoded - don't leave the cache waiting on a handler that never runs
+    auto abandon = [&cache, generation]() {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        if (cache->generation == generation) cache->pending = false;
+    };
+
+    if (sizeChanged) {
+        MTLTextureDescriptor* desc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:MTLPixelFormatRG32Float
+                                                                                        width:width
+                                                                                       height:height
+                                                                                    mipmapped:NO];
+        desc.usage = MTLTextureUsageRenderTarget | MTLTextureUsageShaderRead;
+        desc.storageMode = MTLStorageModePrivate;
+        warp_map_texture_ = [device_ newTextureWithDescriptor:desc];
+        if (!warp_map_texture_) {
+            NSLog(@"NDIOutput: Failed to create warp map %ux%u", width, height);
+            abandon();
+            return false;
+        }
+    }
+
+    MTLRenderPassDescriptor* passDesc = [MTLRenderPassDescriptor renderPassDescriptor];
+    passDesc.colorAttachments[0].texture = warp_map_texture_;
+    passDesc.colorAttachments[0].loadAction = MTLLoadActionDontCare;
+    passDesc.colorAttachments[0].storeAction = MTLStoreActionStore;
+
+    id<MTLRenderCommandEncoder> encoder = [commandBuffer renderCommandEncoderWithDescriptor:passDesc];
+    if (!encoder) {
+        warp_map_texture_ = nil;
+        abandon();
+        return false;
+    }
+    [encoder setRenderPipelineState:warp_map_pipeline_];
+    [encoder setFragmentBytes:&params length:sizeof(params) atIndex:0];
+    [encoder drawPrimitives:MTLPrimitiveTypeTriangle vertexStart:0 vertexCount:3];
+    [encoder endEncoding];
+
+    // The map is only known good once the GPU has run the bake; a newer bake
+    // (later generation) owns the flags from the moment it is encoded
+    [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        if (cache->generation != generation) return;
+        cache->pending = false;
+        cache->valid = buffer.status == MTLCommandBufferStatusCompleted;
+    }];
+    warp_map_builds_.fetch_add(1);
+    return true;
+}
+
 bool NDIOutput::pushFrame(const SwitcherFrame& frame) {
     if (!running_.load() || !frame.valid || !frame.texture) {
         return false;
@@ -905,18 +1089,12 @@ bool NDIOutput::pushFrame(const SwitcherFrame& frame) {
     uint32_t texW = (uint32_t)texture.width;
     uint32_t texH = (uint32_t)texture.height;
 
-    // Apply crop region
-    const auto& crop = currentCrop();
-    uint32_t cropX = (uint32_t)(crop.x * texW);
-    uint32_t cropY = (uint32_t)(crop.y * texH);
-    uint32_t cropW = (uint32_t)(crop.w * texW);
-    uint32_t cropH = (uint32_t)(crop.h * texH);
-
-    // Clamp to texture bounds
-    if (cropX >= texW) cropX = 0;
-    if (cropY >= texH) cropY = 0;
-    if (cropW == 0 || cropX + cropW > texW) cropW = texW - cropX;
-    if (cropH == 0 || cropY + cropH > texH) cropH = texH - cropY;
+    // Apply crop region (clamped to texture bounds)
+    PixelCrop crop = cropPixels(texW, texH);
+    uint32_t cropX = crop.x;
+    uint32_t cropY = crop.y;
+    uint32_t cropW = crop.w;
+    uint32_t cropH = crop.h;
 
     uint32_t w = cropW;
     uint32_t h = cropH;
@@ -937,17 +1115,8 @@ bool NDIOutput::pushFrame(const SwitcherFrame& frame) {
         }
     }
 
-    bool hasGeometricCorrection = (blend.warpTopLeftX != 0 || blend.warpTopLeftY != 0 ||
-                                   blend.warpTopMiddleX != 0 || blend.warpTopMiddleY != 0 ||
-                                   blend.warpTopRightX != 0 || blend.warpTopRightY != 0 ||
-                                   blend.warpMiddleLeftX != 0 || blend.warpMiddleLeftY != 0 ||
-                                   blend.warpMiddleRightX != 0 || blend.warpMiddleRightY != 0 ||
-                                   blend.warpBottomLeftX != 0 || blend.warpBottomLeftY != 0 ||
-                                   blend.warpBottomMiddleX != 0 || blend.warpBottomMiddleY != 0 ||
-                                   blend.warpBottomRightX != 0 || blend.warpBottomRightY != 0 ||
-                                   blend.warpCurvature != 0 ||
-                                   blend.lensK1 != 0 || blend.lensK2 != 0);
-    bool needsEdgeBlend = (blend.hasBlending() || hasGeometricCorrection || blend.activeCorner > 0) && edge_blend_pipeline_;
+    bool hasGeometricCorrection = blend.hasGeometricCorrection();
+    bool needsEdgeBlend = blend.needsEdgeBlendPass() && edge_blend_pipeline_;
 
     // Debug: log when edge blend is active due to geometric correction
     static int blendLogCounter = 0;
@@ -956,98 +1125,59 @@ bool NDIOutput::pushFrame(const SwitcherFrame& frame) {
               needsEdgeBlend, hasGeometricCorrection, blend.warpCurvature, edge_blend_pipeline_);
     }
 
-    // Create pixel frame
-    PixelFrame pixelFrame;
-    pixelFrame.width = w;
-    pixelFrame.height = h;
+    // Edge blend without waiting on the GPU: render + blit into a readback slot,
+    // pixel prep runs on the send thread once it lands (legacy mode stays synchronous)
+    if (needsEdgeBlend && !legacy_mode_.load() && ensureTempTexture(w, h)) {
+        return submitReadback(frame, texture, cropX, cropY, cropW, cropH);
+    }
+
+    // Render through the edge blend shader when needed; fall back to a direct read
+    bool blended = needsEdgeBlend && ensureTempTexture(w, h) &&
+                   renderWithEdgeBlend(texture, cropX, cropY, cropW, cropH);
+
+    // Crop, intensity and wire-format conversion in parallel row bands.
+    // The edge blend shader already applied intensity, so only scale direct reads.
+    PixelPrepJob job;
+    job.readRows = readTextureRows;
+    job.readContext = (__bridge void*)(blended ? temp_texture_ : texture);
+    job.cropX = blended ? 0 : cropX;
+    job.cropY = blended ? 0 : cropY;
+    job.width = w;
+    job.height = h;
+    job.intensity = blended ? 1.0f : intensity();
+
+    NDIPixelFrame pixelFrame;
     pixelFrame.timestamp_ns = frame.timestamp_ns;
     pixelFrame.frame_rate = frame.frame_rate;
-    pixelFrame.valid = true;
-
-    size_t required_size = w * h * 4;
-    pixelFrame.data.resize(required_size);
-
-    if (needsEdgeBlend) {
-        // Ensure temp texture exists
-        if (ensureTempTexture(w, h)) {
-            // Render through edge blend shader
-            if (renderWithEdgeBlend(texture, cropX, cropY, cropW, cropH)) {
-                // Read from edge-blended temp texture
-                MTLRegion region = MTLRegionMake2D(0, 0, w, h);
-                [temp_texture_ getBytes:pixelFrame.data.data()
-                            bytesPerRow:w * 4
-                             fromRegion:region
-                            mipmapLevel:0];
-            } else {
-                // Fallback to direct read
-                MTLRegion region = MTLRegionMake2D(cropX, cropY, w, h);
-                [texture getBytes:pixelFrame.data.data()
-                      bytesPerRow:w * 4
-                       fromRegion:region
-                      mipmapLevel:0];
-            }
-        } else {
-            // Fallback to direct read
-            MTLRegion region = MTLRegionMake2D(cropX, cropY, w, h);
-            [texture getBytes:pixelFrame.data.data()
-                  bytesPerRow:w * 4
-                   fromRegion:region
-                  mipmapLevel:0];
-        }
-    } else {
-        // Direct read from source texture
-        MTLRegion region = MTLRegionMake2D(cropX, cropY, w, h);
-        [texture getBytes:pixelFrame.data.data()
-              bytesPerRow:w * 4
-               fromRegion:region
-              mipmapLevel:0];
+    if (!preparePixelFrame(job, pixelFrame)) {
+        frames_dropped_.fetch_add(1);
+        return false;
     }
 
     // Legacy mode: send synchronously on caller's thread (more compatible)
     if (legacy_mode_.load()) {
         NDIlib_send_instance_t sender = sender_;
-        if (!sender || !ndi_lib) {
+        if (!sender) {
             return false;
         }
 
         // Setup NDI frame
-        NDIlib_video_frame_v2_t ndi_frame;
-        ndi_frame.xres = pixelFrame.width;
-        ndi_frame.yres = pixelFrame.height;
-        ndi_frame.FourCC = NDIlib_FourCC_type_BGRA;
-        ndi_frame.line_stride_in_bytes = pixelFrame.width * 4;
-        ndi_frame.p_data = pixelFrame.data.data();
+        NDIlib_video_frame_v2_t ndi_frame = ndiVideoFrame(pixelFrame, pixelFrame.frame_rate);
 
         // Use simple frame rate
         float fps = pixelFrame.frame_rate > 0 ? pixelFrame.frame_rate : 60.0f;
         ndi_frame.frame_rate_N = (int)(fps * 1000);
         ndi_frame.frame_rate_D = 1000;
-
-        ndi_frame.frame_format_type = NDIlib_frame_format_type_progressive;
         ndi_frame.timecode = NDIlib_send_timecode_synthesize;  // Let NDI handle timing
-        ndi_frame.picture_aspect_ratio = (float)pixelFrame.width / pixelFrame.height;
-        ndi_frame.p_metadata = nullptr;
 
         // Send synchronously
-        ndi_lib->send_send_video_v2(sender, &ndi_frame);
+        backend_->sendVideo(sender, ndi_frame);
         frames_sent_.fetch_add(1);
         return true;
     }
 
     // Normal mode: Add to async queue
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-
-        // Drop oldest frame if queue is full
-        if (pixel_queue_.size() >= config_.async_queue_size) {
-            pixel_queue_.pop();
-            frames_dropped_.fetch_add(1);
-        }
-
-        pixel_queue_.push(std::move(pixelFrame));
-    }
-
-    queue_cv_.notify_one();
+    enqueuePixelFrame(std::move(pixelFrame));
     return true;
 }
 
@@ -1062,21 +1192,30 @@ bool NDIOutput::pushPixelData(const uint8_t* data, uint32_t width, uint32_t heig
     height_.store(height);
     frame_rate_.store(frameRate);
 
-    // Create pixel frame with copy of data
-    PixelFrame pixelFrame;
-    pixelFrame.width = width;
-    pixelFrame.height = height;
+    // Copy (and convert) into a pooled frame
+    PixelPrepJob job;
+    job.src = data;
+    job.srcStride = (size_t)width * 4;
+    job.width = width;
+    job.height = height;
+    job.intensity = intensity();
+
+    NDIPixelFrame pixelFrame;
     pixelFrame.timestamp_ns = timestamp_ns;
     pixelFrame.frame_rate = frameRate;
-    pixelFrame.valid = true;
-
-    size_t dataSize = width * height * 4;
-    pixelFrame.data.resize(dataSize);
-    memcpy(pixelFrame.data.data(), data, dataSize);
+    if (!preparePixelFrame(job, pixelFrame)) {
+        frames_dropped_.fetch_add(1);
+        return false;
+    }
 
     // Add to async queue
+    enqueuePixelFrame(std::move(pixelFrame));
+    return true;
+}
+
+void NDIOutput::enqueuePixelFrame(NDIPixelFrame&& pixelFrame) {
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
+        std::lock_guard<std::mutex> lock(handoff_->mutex);
 
         // Drop oldest frame if queue is full
         if (pixel_queue_.size() >= config_.async_queue_size) {
@@ -1087,36 +1226,198 @@ bool NDIOutput::pushPixelData(const uint8_t* data, uint32_t width, uint32_t heig
         pixel_queue_.push(std::move(pixelFrame));
     }
 
-    queue_cv_.notify_one();
+    // notify_all: stop() may be waiting on the same condition for readbacks
+    handoff_->cv.notify_all();
+}
+
+void NDIOutput::setReadbackDepth(uint32_t depth) {
+    depth = std::max<uint32_t>(1, std::min(depth, kMaxReadbackDepth));
+    readback_depth_.store(depth);
+    config_.readback_depth = depth;
+    NSLog(@"NDIOutput: Readback depth set to %u frame(s)", depth);
+}
+
+NDIOutput::ReadbackStats NDIOutput::readbackStats() const {
+    ReadbackStats stats;
+    stats.completed = readbacks_completed_.load();
+    stats.ring_full = readback_ring_full_.load();
+    stats.last_ms = readback_last_ns_.load() / 1e6;
+    stats.max_ms = readback_max_ns_.load() / 1e6;
+    stats.avg_ms = stats.completed ? (readback_total_ns_.load() / 1e6) / stats.completed : 0.0;
+    return stats;
+}
+
+// Encode edge blend + blit into a free readback slot and commit without waiting.
+// Drops the frame if every slot is still in flight or the output is stopping.
+bool NDIOutput::submitReadback(const SwitcherFrame& frame, id<MTLTexture> texture, uint32_t cropX, uint32_t cropY,
+                               uint32_t cropW, uint32_t cropH) {
+    // Count the readback before encoding anything, so stop() waits for it
+    {
+        std::lock_guard<std::mutex> lock(handoff_->mutex);
+        if (handoff_->readbacks_closed) {
+            frames_dropped_.fetch_add(1);
+            return false;
+        }
+        handoff_->readbacks_in_flight++;
+    }
+    auto abandon = [this](ReadbackSlot* slot) {
+        if (slot) slot->busy.store(false, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(handoff_->mutex);
+            handoff_->readbacks_in_flight--;
+        }
+        handoff_->cv.notify_all();
+        frames_dropped_.fetch_add(1);
+        return false;
+    };
+
+    uint32_t depth = readback_depth_.load();
+    int slotIndex = -1;
+    for (uint32_t i = 0; i < depth; i++) {
+        bool expected = false;
+        if (readback_slots_[i].busy.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            slotIndex = (int)i;
+            break;
+        }
+    }
+    if (slotIndex < 0) {
+        readback_ring_full_.fetch_add(1);
+        return abandon(nullptr);
+    }
+    ReadbackSlot& slot = readback_slots_[slotIndex];
+
+    @autoreleasepool {
+        size_t bytesPerRow = (size_t)cropW * 4;
+        size_t bytes = bytesPerRow * cropH;
+        if (!slot.buffer || slot.buffer.length < bytes) {
+            slot.buffer = [device_ newBufferWithLength:bytes options:MTLResourceStorageModeShared];
+        }
+
+        id<MTLCommandBuffer> commandBuffer = slot.buffer ? [command_queue_ commandBuffer] : nil;
+        if (!commandBuffer || !encodeEdgeBlend(commandBuffer, texture, cropX, cropY, cropW, cropH)) {
+            return abandon(&slot);
+        }
+
+        id<MTLBlitCommandEncoder> blit = [commandBuffer blitCommandEncoder];
+        if (!blit) {
+            [commandBuffer commit];  // Still run any warp map bake that was encoded
+            return abandon(&slot);
+        }
+        [blit copyFromTexture:temp_texture_
+                  sourceSlice:0
+                  sourceLevel:0
+                 sourceOrigin:MTLOriginMake(0, 0, 0)
+                   sourceSize:MTLSizeMake(cropW, cropH, 1)
+                     toBuffer:slot.buffer
+            destinationOffset:0
+       destinationBytesPerRow:bytesPerRow
+     destinationBytesPerImage:bytes];
+        [blit endEncoding];
+
+        slot.width = cropW;
+        slot.height = cropH;
+        slot.bytes_per_row = bytesPerRow;
+        slot.timestamp_ns = frame.timestamp_ns;
+        slot.frame_rate = frame.frame_rate;
+        slot.submit_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        // The handler runs on a Metal thread and may outlive this call; it only
+        // queues the slot for the send thread through the shared handoff
+        std::shared_ptr<SendHandoff> handoff = handoff_;
+        uint32_t index = (uint32_t)slotIndex;
+        [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+            uint64_t completeNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            std::lock_guard<std::mutex> lock(handoff->mutex);
+            handoff->completed.push_back({index, buffer.status == MTLCommandBufferStatusCompleted, completeNs});
+            handoff->readbacks_in_flight--;
+            handoff->cv.notify_all();
+        }];
+        [commandBuffer commit];
+    }
     return true;
 }
 
+// Send thread: record the latency and convert the read-back pixels into a
+// pooled frame, then hand the slot back for the next submit
+bool NDIOutput::prepareReadback(const CompletedReadback& done, NDIPixelFrame& pixelFrame) {
+    ReadbackSlot& slot = readback_slots_[done.slot];
+
+    uint64_t latency = done.complete_ns - slot.submit_ns;
+    readback_last_ns_.store(latency);
+    readback_total_ns_.fetch_add(latency);
+    uint64_t prevMax = readback_max_ns_.load();
+    while (latency > prevMax && !readback_max_ns_.compare_exchange_weak(prevMax, latency)) {}
+    readbacks_completed_.fetch_add(1);
+
+    bool prepared = false;
+    if (done.succeeded) {
+        // The shader already applied intensity
+        PixelPrepJob job;
+        job.src = static_cast<const uint8_t*>(slot.buffer.contents);
+        job.srcStride = slot.bytes_per_row;
+        job.width = slot.width;
+        job.height = slot.height;
+        job.intensity = 1.0f;
+
+        pixelFrame.timestamp_ns = slot.timestamp_ns;
+        pixelFrame.frame_rate = slot.frame_rate;
+        prepared = preparePixelFrame(job, pixelFrame);
+    }
+    if (!prepared) {
+        frames_dropped_.fetch_add(1);
+    }
+
+    slot.busy.store(false, std::memory_order_release);
+    return prepared;
+}
+
+void NDIOutput::waitForReadbacks() {
+    std::unique_lock<std::mutex> lock(handoff_->mutex);
+    handoff_->cv.wait(lock, [this] { return handoff_->readbacks_in_flight == 0; });
+}
+
 void NDIOutput::sendLoop() {
     NSLog(@"NDIOutput: Send loop started");
 
     // Frame rate throttling
     auto lastSendTime = std::chrono::high_resolution_clock::now();
 
+    // Pins the frame handed to send_send_video_async_v2 until the next send or flush
+    NDIFrameSender ndi_sender;
+
     while (!should_stop_.load()) {
-        PixelFrame pixelFrame;
+        NDIPixelFrame pixelFrame;
+        CompletedReadback readback = {};
+        bool haveReadback = false;
 
-        // Wait for frame
+        // Wait for a prepared frame or a landed edge blend readback
         {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            queue_cv_.wait(lock, [this] {
-                return !pixel_queue_.empty() || should_stop_.load();
+            std::unique_lock<std::mutex> lock(handoff_->mutex);
+            handoff_->cv.wait(lock, [this] {
+                return !pixel_queue_.empty() || !handoff_->completed.empty() || should_stop_.load();
             });
 
             if (should_stop_.load()) {
                 break;
             }
 
-            if (!pixel_queue_.empty()) {
+            if (!handoff_->completed.empty()) {
+                readback = handoff_->completed.front();
+                handoff_->completed.pop_front();
+                haveReadback = true;
+            } else if (!pixel_queue_.empty()) {
                 pixelFrame = std::move(pixel_queue_.front());
                 pixel_queue_.pop();
             }
         }
 
+        // Readback pixel prep runs here, off Metal's completion thread
+        if (haveReadback && !prepareReadback(readback, pixelFrame)) {
+            continue;
+        }
+
         if (!pixelFrame.valid || pixelFrame.data.empty()) {
             continue;
         }
@@ -1143,45 +1444,24 @@ void NDIOutput::sendLoop() {
         }
 
         // Setup NDI frame from pre-rendered pixel data (NO GPU WORK HERE)
-        NDIlib_video_frame_v2_t ndi_frame;
-        ndi_frame.xres = pixelFrame.width;
-        ndi_frame.yres = pixelFrame.height;
-        ndi_frame.FourCC = NDIlib_FourCC_type_BGRA;
-        ndi_frame.line_stride_in_bytes = pixelFrame.width * 4;
-        ndi_frame.p_data = pixelFrame.data.data();
-
-        // Calculate frame rate - use target if set, otherwise source
-        float fps = targetFps > 0 ? targetFps : (pixelFrame.frame_rate > 0 ? pixelFrame.frame_rate : 59.94f);
-        if (fps > 59.9f && fps < 60.1f) {
-            ndi_frame.frame_rate_N = 60000;
-            ndi_frame.frame_rate_D = 1001;
-        } else if (fps > 29.9f && fps < 30.1f) {
-            ndi_frame.frame_rate_N = 30000;
-            ndi_frame.frame_rate_D = 1001;
-        } else if (fps > 23.9f && fps < 24.1f) {
-            ndi_frame.frame_rate_N = 24000;
-            ndi_frame.frame_rate_D = 1001;
-        } else {
-            ndi_frame.frame_rate_N = (int)(fps * 1000);
-            ndi_frame.frame_rate_D = 1000;
-        }
-
-        ndi_frame.frame_format_type = NDIlib_frame_format_type_progressive;
-        ndi_frame.timecode = (pixelFrame.timestamp_ns > 0) ?
-            (int64_t)(pixelFrame.timestamp_ns / 100) : NDIlib_send_timecode_synthesize;
-        ndi_frame.picture_aspect_ratio = (float)pixelFrame.width / pixelFrame.height;
-        ndi_frame.p_metadata = nullptr;
+        // Frame rate - use target if set, otherwise source
+        NDIlib_video_frame_v2_t ndi_frame =
+            ndiVideoFrame(pixelFrame, targetFps > 0 ? targetFps : pixelFrame.frame_rate);
 
         // Send frame (NDI handles timing if clock_video is true)
-        if (ndi_lib) {
-            ndi_lib->send_send_video_v2(sender, &ndi_frame);
-            frames_sent_.fetch_add(1);
-        }
+        ndi_sender.send(*backend_, sender, ndi_frame, std::move(pixelFrame.data), async_send_.load());
+        frames_sent_.fetch_add(1);
     }
 
+    ndi_sender.flush(*backend_, sender_);
+
     NSLog(@"NDIOutput: Send loop ended");
 }
 
+bool NDIOutput::preparePixelFrame(PixelPrepJob& job, NDIPixelFrame& frame) {
+    return prepareNDIPixelFrame(buffer_pool_, pixel_prep_, pixel_format_.load(), color_matrix_.load(), job, frame);
+}
+
 bool NDIOutput::convertFromTexture(const SwitcherFrame& frame, NDIlib_video_frame_v2_t& ndi_frame) {
     if (!frame.texture) {
         NSLog(@"NDIOutput: convertFromTexture called with nil texture");
@@ -1198,18 +1478,12 @@ bool NDIOutput::convertFromTexture(const SwitcherFrame& frame, NDIlib_video_fram
         return false;
     }
 
-    // Apply crop region (normalized 0-1 coordinates)
-    const auto& crop = currentCrop();
-    uint32_t cropX = (uint32_t)(crop.x * texW);
-    uint32_t cropY = (uint32_t)(crop.y * texH);
-    uint32_t cropW = (uint32_t)(crop.w * texW);
-    uint32_t cropH = (uint32_t)(crop.h * texH);
-
-    // Clamp to texture bounds
-    if (cropX >= texW) cropX = 0;
-    if (cropY >= texH) cropY = 0;
-    if (cropW == 0 || cropX + cropW > texW) cropW = texW - cropX;
-    if (cropH == 0 || cropY + cropH > texH) cropH = texH - cropY;
+    // Apply crop region (normalized 0-1 coordinates, clamped to texture bounds)
+    PixelCrop crop = cropPixels(texW, texH);
+    uint32_t cropX = crop.x;
+    uint32_t cropY = crop.y;
+    uint32_t cropW = crop.w;
+    uint32_t cropH = crop.h;
 
     // Use configured output resolution, or cropped size if not set
     uint32_t outputW = width_.load();
@@ -1235,17 +1509,7 @@ bool NDIOutput::convertFromTexture(const SwitcherFrame& frame, NDIlib_video_fram
     // Check if edge blending is needed
     const auto& blend = currentEdgeBlend();
     // Run edge blend shader if any blending, warp, lens correction, curvature, or corner overlay is active
-    bool hasGeometricCorrection = (blend.warpTopLeftX != 0 || blend.warpTopLeftY != 0 ||
-                                   blend.warpTopMiddleX != 0 || blend.warpTopMiddleY != 0 ||
-                                   blend.warpTopRightX != 0 || blend.warpTopRightY != 0 ||
-                                   blend.warpMiddleLeftX != 0 || blend.warpMiddleLeftY != 0 ||
-                                   blend.warpMiddleRightX != 0 || blend.warpMiddleRightY != 0 ||
-                                   blend.warpBottomLeftX != 0 || blend.warpBottomLeftY != 0 ||
-                                   blend.warpBottomMiddleX != 0 || blend.warpBottomMiddleY != 0 ||
-                                   blend.warpBottomRightX != 0 || blend.warpBottomRightY != 0 ||
-                                   blend.warpCurvature != 0 ||
-                                   blend.lensK1 != 0 || blend.lensK2 != 0);
-    bool needsEdgeBlend = (blend.hasBlending() || hasGeometricCorrection || blend.activeCorner > 0) && edge_blend_pipeline_;
+    bool needsEdgeBlend = blend.needsEdgeBlendPass() && edge_blend_pipeline_;
 
     if (needsEdgeBlend) {
         // Ensure temp texture exists
@@ -1292,25 +1556,8 @@ bool NDIOutput::convertFromTexture(const SwitcherFrame& frame, NDIlib_video_fram
     ndi_frame.line_stride_in_bytes = w * 4;
     ndi_frame.p_data = ndi_buffer_.data();
 
-    // Calculate frame rate
-    float fps = frame.frame_rate > 0 ? frame.frame_rate : 59.94f;
-    if (fps > 59.9f && fps < 60.1f) {
-        // 59.94 fps (60000/1001)
-        ndi_frame.frame_rate_N = 60000;
-        ndi_frame.frame_rate_D = 1001;
-    } else if (fps > 29.9f && fps < 30.1f) {
-        // 29.97 fps (30000/1001)
-        ndi_frame.frame_rate_N = 30000;
-        ndi_frame.frame_rate_D = 1001;
-    } else if (fps > 23.9f && fps < 24.1f) {
-        // 23.976 fps (24000/1001)
-        ndi_frame.frame_rate_N = 24000;
-        ndi_frame.frame_rate_D = 1001;
-    } else {
-        // Generic rate
-        ndi_frame.frame_rate_N = (int)(fps * 1000);
-        ndi_frame.frame_rate_D = 1000;
-    }
+    // Calculate frame rate (59.94 / 29.97 / 23.976 as exact fractions)
+    setNDIFrameRate(ndi_frame, frame.frame_rate > 0 ? frame.frame_rate : 59.94f);
 
     // Frame format
     ndi_frame.frame_format_type = frame.interlaced ?
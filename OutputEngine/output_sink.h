@@ -3,12 +3,16 @@
 
 #pragma once
 
-#include "switcher_frame.h"
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <functional>
 
 namespace RocKontrol {
 
+// Defined in switcher_frame.h (Objective-C++ only - it holds an id<MTLTexture>)
+struct SwitcherFrame;
+
 // Output types
 enum class OutputType {
     Display,        // Physical display (Metal layer)
@@ -51,6 +55,14 @@ enum class OutputTransitionType {
     Dip         // Dip to color then reveal
 };
 
+// Crop region resolved against a source size, in pixels
+struct PixelCrop {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t w = 0;
+    uint32_t h = 0;
+};
+
 // Callback for output status changes
 using OutputStatusCallback = std::function<void(int outputId, OutputStatus status, const std::string& message)>;
 
@@ -349,6 +361,25 @@ protected:
         bool hasBlending() const {
             return enableEdgeBlend && (featherLeft > 0 || featherRight > 0 || featherTop > 0 || featherBottom > 0);
         }
+
+        // Any warp point, curvature or lens distortion set
+        bool hasGeometricCorrection() const {
+            return warpTopLeftX != 0 || warpTopLeftY != 0 ||
+                   warpTopMiddleX != 0 || warpTopMiddleY != 0 ||
+                   warpTopRightX != 0 || warpTopRightY != 0 ||
+                   warpMiddleLeftX != 0 || warpMiddleLeftY != 0 ||
+                   warpMiddleRightX != 0 || warpMiddleRightY != 0 ||
+                   warpBottomLeftX != 0 || warpBottomLeftY != 0 ||
+                   warpBottomMiddleX != 0 || warpBottomMiddleY != 0 ||
+                   warpBottomRightX != 0 || warpBottomRightY != 0 ||
+                   warpCurvature != 0 ||
+                   lensK1 != 0 || lensK2 != 0;
+        }
+
+        // Edge blend pass needed: feathering, geometric correction or corner overlay
+        bool needsEdgeBlendPass() const {
+            return hasBlending() || hasGeometricCorrection() || activeCorner > 0;
+        }
     };
 
     EdgeBlendParams current_edge_blend_;  // Edge blend for current frame
@@ -365,6 +396,21 @@ public:
     const CropRegion& currentCrop() const { return current_crop_; }
     const CropRegion& pendingCrop() const { return pending_crop_; }
 
+    // Current crop in pixels of a srcWidth x srcHeight source. An origin outside
+    // the source falls back to 0 and an empty or overhanging size extends to the edge.
+    PixelCrop cropPixels(uint32_t srcWidth, uint32_t srcHeight) const {
+        PixelCrop crop;
+        crop.x = (uint32_t)(current_crop_.x * srcWidth);
+        crop.y = (uint32_t)(current_crop_.y * srcHeight);
+        crop.w = (uint32_t)(current_crop_.w * srcWidth);
+        crop.h = (uint32_t)(current_crop_.h * srcHeight);
+        if (crop.x >= srcWidth) crop.x = 0;
+        if (crop.y >= srcHeight) crop.y = 0;
+        if (crop.w == 0 || crop.x + crop.w > srcWidth) crop.w = srcWidth - crop.x;
+        if (crop.h == 0 || crop.y + crop.h > srcHeight) crop.h = srcHeight - crop.y;
+        return crop;
+    }
+
     void setCrop(float x, float y, float w, float h) {
         current_crop_ = {x, y, w, h};
     }
@@ -0,0 +1,218 @@
+// pixel_buffer_pool.cpp - Size-class pool of reusable CPU pixel buffers
+// Portable C++ (no Metal / Foundation) so it can be shared by CPU-only paths
+
+#include "pixel_buffer_pool.h"
+#include <new>
+
+namespace RocKontrol {
+
+namespace {
+
+constexpr size_t kMinClassShift = 16;   // Smallest class: 64 KB
+constexpr size_t kNumClasses = 24;      // Up to 64 KB << 23 (512 GB) - effectively unbounded
+constexpr size_t kAlignment = 64;       // Cache line (and NEON/AVX friendly) alignment
+
+size_t classForSize(size_t bytes) {
+    size_t cls = 0;
+    while (cls + 1 < kNumClasses && (size_t(1) << (kMinClassShift + cls)) < bytes) {
+        cls++;
+    }
+    return cls;
+}
+
+size_t classCapacity(size_t cls) {
+    return size_t(1) << (kMinClassShift + cls);
+}
+
+} // namespace
+
+// Header lives in the first cache line of the allocation, pixels follow it
+struct PixelBuffer::Block {
+    std::atomic<uint32_t> refs{1};
+    uint32_t size_class = 0;
+    size_t capacity = 0;
+    PixelBufferPool::Core* core = nullptr;
+
+    uint8_t* pixels() { return reinterpret_cast<uint8_t*>(this) + kAlignment; }
+};
+
+struct PixelBufferPool::Core {
+    static_assert(sizeof(PixelBuffer::Block) <= kAlignment, "Block header must fit in one cache line");
+
+    std::mutex mutex;
+    std::vector<PixelBuffer::Block*> idle[kNumClasses];
+    size_t max_idle_per_class;
+    bool closed = false;                  // Pool destroyed, leases still outstanding
+    std::shared_ptr<PixelBufferObserver> observer;
+    std::atomic<size_t> refs{1};          // 1 for the pool + 1 per leased block
+
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> reuses{0};
+    std::atomic<uint64_t> bytes_reserved{0};
+
+    static PixelBuffer::Block* allocateBlock(Core* core, size_t cls) {
+        size_t capacity = classCapacity(cls);
+        void* mem = ::operator new(kAlignment + capacity, std::align_val_t(kAlignment), std::nothrow);
+        if (!mem) return nullptr;
+        auto* block = new (mem) PixelBuffer::Block();
+        block->size_class = static_cast<uint32_t>(cls);
+        block->capacity = capacity;
+        block->core = core;
+        core->allocations.fetch_add(1, std::memory_order_relaxed);
+        core->bytes_reserved.fetch_add(capacity, std::memory_order_relaxed);
+        return block;
+    }
+
+    static void freeBlock(Core* core, PixelBuffer::Block* block) {
+        core->bytes_reserved.fetch_sub(block->capacity, std::memory_order_relaxed);
+        block->~Block();
+        ::operator delete(block, std::align_val_t(kAlignment));
+    }
+
+    static void release(Core* core) {
+        if (core->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete core;
+        }
+    }
+
+    // Called when the last lease on a block goes away
+    static void recycle(PixelBuffer::Block* block) {
+        Core* core = block->core;
+        {
+            std::lock_guard<std::mutex> lock(core->mutex);
+            if (core->observer) core->observer->blockReleased(block->pixels());
+            auto& list = core->idle[block->size_class];
+            if (!core->closed && list.size() < core->max_idle_per_class) {
+                block->refs.store(1, std::memory_order_relaxed);
+                list.push_back(block);
+                block = nullptr;
+            }
+        }
+        if (block) freeBlock(core, block);
+        release(core);
+    }
+};
+
+// PixelBuffer
+
+PixelBuffer::PixelBuffer(const PixelBuffer& other) : block_(other.block_), size_(other.size_) {
+    if (block_) block_->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+PixelBuffer::PixelBuffer(PixelBuffer&& other) noexcept : block_(other.block_), size_(other.size_) {
+    other.block_ = nullptr;
+    other.size_ = 0;
+}
+
+PixelBuffer& PixelBuffer::operator=(const PixelBuffer& other) {
+    if (this != &other) {
+        if (other.block_) other.block_->refs.fetch_add(1, std::memory_order_relaxed);
+        reset();
+        block_ = other.block_;
+        size_ = other.size_;
+    }
+    return *this;
+}
+
+PixelBuffer& PixelBuffer::operator=(PixelBuffer&& other) noexcept {
+    if (this != &other) {
+        reset();
+        block_ = other.block_;
+        size_ = other.size_;
+        other.block_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+uint8_t* PixelBuffer::data() const {
+    return block_ ? block_->pixels() : nullptr;
+}
+
+size_t PixelBuffer::capacity() const {
+    return block_ ? block_->capacity : 0;
+}
+
+void PixelBuffer::reset() {
+    Block* block = block_;
+    block_ = nullptr;
+    size_ = 0;
+    if (block && block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        PixelBufferPool::Core::recycle(block);
+    }
+}
+
+// PixelBufferPool
+
+PixelBufferPool::PixelBufferPool(size_t maxIdlePerClass)
+    : core_(new Core()) {
+    core_->max_idle_per_class = maxIdlePerClass;
+    for (auto& list : core_->idle) list.reserve(maxIdlePerClass);
+}
+
+PixelBufferPool::~PixelBufferPool() {
+    // Outstanding leases keep the core alive and free their blocks on release
+    {
+        std::lock_guard<std::mutex> lock(core_->mutex);
+        core_->closed = true;
+        for (auto& list : core_->idle) {
+            for (auto* block : list) Core::freeBlock(core_, block);
+            list.clear();
+        }
+    }
+    Core::release(core_);
+}
+
+PixelBuffer PixelBufferPool::acquire(size_t bytes) {
+    if (bytes == 0) return PixelBuffer();
+
+    size_t cls = classForSize(bytes);
+    if (classCapacity(cls) < bytes) return PixelBuffer();
+
+    PixelBuffer::Block* block = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(core_->mutex);
+        auto& list = core_->idle[cls];
+        if (!list.empty()) {
+            block = list.back();
+            list.pop_back();
+        }
+    }
+
+    if (block) {
+        core_->reuses.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        block = Core::allocateBlock(core_, cls);
+        if (!block) return PixelBuffer();
+    }
+
+    core_->refs.fetch_add(1, std::memory_order_relaxed);
+    return PixelBuffer(block, bytes);
+}
+
+void PixelBufferPool::trim() {
+    std::lock_guard<std::mutex> lock(core_->mutex);
+    for (auto& list : core_->idle) {
+        for (auto* block : list) Core::freeBlock(core_, block);
+        list.clear();
+    }
+}
+
+void PixelBufferPool::setObserver(std::shared_ptr<PixelBufferObserver> observer) {
+    std::lock_guard<std::mutex> lock(core_->mutex);
+    core_->observer = std::move(observer);
+}
+
+uint64_t PixelBufferPool::allocations() const {
+    return core_->allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t PixelBufferPool::reuses() const {
+    return core_->reuses.load(std::memory_order_relaxed);
+}
+
+uint64_t PixelBufferPool::bytesReserved() const {
+    return core_->bytes_reserved.load(std::memory_order_relaxed);
+}
+
+} // namespace RocKontrol
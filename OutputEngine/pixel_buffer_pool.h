@@ -0,0 +1,89 @@
+// pixel_buffer_pool.h - Size-class pool of reusable CPU pixel buffers
+// Queued frames hold ref-counted leases; the last lease hands the block back
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace RocKontrol {
+
+class PixelBufferPool;
+
+// Ref-counted lease on a pooled block. Copying shares the block, the last
+// lease to go away returns it to its pool. Contents are NOT cleared between
+// uses - callers always overwrite the bytes they send.
+class PixelBuffer {
+public:
+    PixelBuffer() = default;
+    PixelBuffer(const PixelBuffer& other);
+    PixelBuffer(PixelBuffer&& other) noexcept;
+    PixelBuffer& operator=(const PixelBuffer& other);
+    PixelBuffer& operator=(PixelBuffer&& other) noexcept;
+    ~PixelBuffer() { reset(); }
+
+    uint8_t* data() const;
+    size_t size() const { return size_; }       // Bytes requested at acquire()
+    size_t capacity() const;                    // Bytes actually backing the lease
+    bool empty() const { return block_ == nullptr || size_ == 0; }
+    explicit operator bool() const { return block_ != nullptr; }
+
+    // Drop this lease (returns the block to the pool if it was the last one)
+    void reset();
+
+private:
+    friend class PixelBufferPool;
+    struct Block;
+
+    PixelBuffer(Block* block, size_t size) : block_(block), size_(size) {}
+
+    Block* block_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Told about every block whose last lease just went away, on the releasing
+// thread and before the block can be handed out again. FakeNDIBackend uses it
+// to catch a buffer being recycled while an async send still owns it.
+class PixelBufferObserver {
+public:
+    virtual ~PixelBufferObserver() = default;
+    virtual void blockReleased(const uint8_t* data) = 0;
+};
+
+// Pool of power-of-two size classes (64 KB and up). A 1080p BGRA frame lands in
+// the 8 MB class and a 4K frame in the 32 MB class, so once the queue depth
+// worth of blocks exists, acquire() never touches the heap.
+class PixelBufferPool {
+public:
+    explicit PixelBufferPool(size_t maxIdlePerClass = 8);
+    ~PixelBufferPool();
+
+    PixelBufferPool(const PixelBufferPool&) = delete;
+    PixelBufferPool& operator=(const PixelBufferPool&) = delete;
+
+    // Get a buffer of at least `bytes` bytes (empty lease on allocation failure)
+    PixelBuffer acquire(size_t bytes);
+
+    // Free all idle blocks (e.g. after a resolution change)
+    void trim();
+
+    // Watch block releases (nullptr to stop). Leases that outlive the pool
+    // still report to it.
+    void setObserver(std::shared_ptr<PixelBufferObserver> observer);
+
+    // Statistics
+    uint64_t allocations() const;       // Blocks obtained from the heap
+    uint64_t reuses() const;            // acquire() calls served from the pool
+    uint64_t bytesReserved() const;     // Bytes currently held (idle + leased)
+
+private:
+    friend class PixelBuffer;
+    struct Core;
+    Core* core_;
+};
+
+} // namespace RocKontrol
@@ -0,0 +1,354 @@
+// pixel_convert.cpp - BGRA to NDI 4:2:2 pixel format conversion
+// All paths share one fixed-point formula so SIMD output matches the scalar
+// reference bit for bit:
+//   Y  = ((cyb*B  + cyg*G  + cyr*R  + 2^12) >> 13) + 16
+//   Cb = ((cub*Bs + cug*Gs + cur*Rs + 2^13) >> 14) + 128    (Bs = B0 + B1 of the pair)
+//   Cr = ((cvb*Bs + cvg*Gs + cvr*Rs + 2^13) >> 14) + 128
+// with coefficients in Q13 and results saturated to 0-255.
+
+#include "pixel_convert.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define ROCK_CONVERT_X86 1
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ROCK_CONVERT_NEON 1
+#endif
+
+namespace RocKontrol {
+
+namespace {
+
+constexpr int kLumaShift = 13;
+constexpr int kChromaShift = kLumaShift + 1;   // Extra bit averages the pixel pair
+constexpr int kLumaRound = 1 << (kLumaShift - 1);
+constexpr int kChromaRound = 1 << (kChromaShift - 1);
+
+struct Coefficients {
+    int16_t yb, yg, yr;
+    int16_t ub, ug, ur;
+    int16_t vb, vg, vr;
+};
+
+constexpr int16_t fixedPoint(double value) {
+    return static_cast<int16_t>(value * (1 << kLumaShift) + (value >= 0 ? 0.5 : -0.5));
+}
+
+// Limited range: luma scaled to 219/255, chroma to 224/255
+constexpr Coefficients makeCoefficients(double kr, double kb) {
+    const double kg = 1.0 - kr - kb;
+    const double ys = 219.0 / 255.0;
+    const double cs = 224.0 / 255.0;
+    return Coefficients{
+        fixedPoint(kb * ys), fixedPoint(kg * ys), fixedPoint(kr * ys),
+        fixedPoint(0.5 * cs), fixedPoint(-kg / (2.0 * (1.0 - kb)) * cs), fixedPoint(-kr / (2.0 * (1.0 - kb)) * cs),
+        fixedPoint(-kb / (2.0 * (1.0 - kr)) * cs), fixedPoint(-kg / (2.0 * (1.0 - kr)) * cs), fixedPoint(0.5 * cs)
+    };
+}
+
+constexpr Coefficients kBT709 = makeCoefficients(0.2126, 0.0722);
+constexpr Coefficients kBT601 = makeCoefficients(0.299, 0.114);
+
+inline const Coefficients& coefficientsFor(ColorMatrix matrix) {
+    return matrix == ColorMatrix::BT601 ? kBT601 : kBT709;
+}
+
+inline uint8_t clampByte(int v) {
+    return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+}
+
+// Scalar reference - also handles the tail the SIMD loops leave behind
+void convertRowScalar(const uint8_t* src, uint8_t* dst, uint32_t x, uint32_t width, const Coefficients& c) {
+    for (; x < width; x += 2) {
+        const uint8_t* p0 = src + x * 4;
+        const uint8_t* p1 = (x + 1 < width) ? p0 + 4 : p0;   // Odd width: repeat last pixel
+
+        int y0 = ((c.yb * p0[0] + c.yg * p0[1] + c.yr * p0[2] + kLumaRound) >> kLumaShift) + 16;
+        int y1 = ((c.yb * p1[0] + c.yg * p1[1] + c.yr * p1[2] + kLumaRound) >> kLumaShift) + 16;
+
+        int bs = p0[0] + p1[0];
+        int gs = p0[1] + p1[1];
+        int rs = p0[2] + p1[2];
+        int u = ((c.ub * bs + c.ug * gs + c.ur * rs + kChromaRound) >> kChromaShift) + 128;
+        int v = ((c.vb * bs + c.vg * gs + c.vr * rs + kChromaRound) >> kChromaShift) + 128;
+
+        uint8_t* out = dst + (x / 2) * 4;
+        out[0] = clampByte(u);
+        out[1] = clampByte(y0);
+        out[2] = clampByte(v);
+        out[3] = clampByte(y1);
+    }
+}
+
+#if ROCK_CONVERT_X86
+
+// SSE2 - 4 pixels per helper call, 8 per loop iteration.
+// Pixels are widened to [B G R A] int16 quads so _mm_madd_epi16 yields
+// (cb*B + cg*G, cr*R) pairs that one shuffle-add folds into a dot product.
+struct SSECoefficients {
+    __m128i y, u, v;
+    __m128i lumaRound, lumaOffset, chromaRound, chromaOffset;
+
+    explicit SSECoefficients(const Coefficients& c)
+        : y(_mm_setr_epi16(c.yb, c.yg, c.yr, 0, c.yb, c.yg, c.yr, 0))
+        , u(_mm_setr_epi16(c.ub, c.ug, c.ur, 0, c.ub, c.ug, c.ur, 0))
+        , v(_mm_setr_epi16(c.vb, c.vg, c.vr, 0, c.vb, c.vg, c.vr, 0))
+        , lumaRound(_mm_set1_epi32(kLumaRound))
+        , lumaOffset(_mm_set1_epi32(16))
+        , chromaRound(_mm_set1_epi32(kChromaRound))
+        , chromaOffset(_mm_set1_epi32(128)) {}
+};
+
+// Sum adjacent int32 lanes; results land in lanes 0 and 2
+inline __m128i pairSums(__m128i v) {
+    return _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+// [a0, a2, b0, b2]
+inline __m128i evenLanes(__m128i a, __m128i b) {
+    return _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+// 4 BGRA pixels -> int16 [U01 Y0 V01 Y1 U23 Y2 V23 Y3]
+inline __m128i uyvy4SSE2(__m128i px, const SSECoefficients& k) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_unpacklo_epi8(px, zero);   // B0 G0 R0 A0 B1 G1 R1 A1
+    __m128i hi = _mm_unpackhi_epi8(px, zero);   // B2 G2 R2 A2 B3 G3 R3 A3
+
+    __m128i y = evenLanes(pairSums(_mm_madd_epi16(lo, k.y)), pairSums(_mm_madd_epi16(hi, k.y)));
+    y = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(y, k.lumaRound), kLumaShift), k.lumaOffset);
+
+    __m128i sums = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+    __m128i u = pairSums(_mm_madd_epi16(sums, k.u));
+    __m128i v = pairSums(_mm_madd_epi16(sums, k.v));
+    __m128i uv = _mm_shuffle_epi32(evenLanes(u, v), _MM_SHUFFLE(3, 1, 2, 0));   // U01 V01 U23 V23
+    uv = _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(uv, k.chromaRound), kChromaShift), k.chromaOffset);
+
+    return _mm_packs_epi32(_mm_unpacklo_epi32(uv, y), _mm_unpackhi_epi32(uv, y));
+}
+
+uint32_t convertRowSSE2(const uint8_t* src, uint8_t* dst, uint32_t width, const SSECoefficients& k) {
+    uint32_t x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m128i a = uyvy4SSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4)), k);
+        __m128i b = uyvy4SSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4 + 16)), k);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2), _mm_packus_epi16(a, b));
+    }
+    return x;
+}
+
+// AVX2 - the same lane-local sequence on 256-bit registers, 16 pixels per iteration
+#define ROCK_AVX2 __attribute__((target("avx2")))
+
+struct AVXCoefficients {
+    __m256i y, u, v;
+    __m256i lumaRound, lumaOffset, chromaRound, chromaOffset;
+};
+
+ROCK_AVX2 inline __m256i pairSumsAVX2(__m256i v) {
+    return _mm256_add_epi32(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+ROCK_AVX2 inline __m256i evenLanesAVX2(__m256i a, __m256i b) {
+    return _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+// 8 BGRA pixels -> int16, pixels 0-3 in the low 128-bit lane and 4-7 in the high lane
+ROCK_AVX2 inline __m256i uyvy8AVX2(__m256i px, const AVXCoefficients& k) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i lo = _mm256_unpacklo_epi8(px, zero);
+    __m256i hi = _mm256_unpackhi_epi8(px, zero);
+
+    __m256i y = evenLanesAVX2(pairSumsAVX2(_mm256_madd_epi16(lo, k.y)), pairSumsAVX2(_mm256_madd_epi16(hi, k.y)));
+    y = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(y, k.lumaRound), kLumaShift), k.lumaOffset);
+
+    __m256i sums = _mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), _mm256_unpackhi_epi64(lo, hi));
+    __m256i u = pairSumsAVX2(_mm256_madd_epi16(sums, k.u));
+    __m256i v = pairSumsAVX2(_mm256_madd_epi16(sums, k.v));
+    __m256i uv = _mm256_shuffle_epi32(evenLanesAVX2(u, v), _MM_SHUFFLE(3, 1, 2, 0));
+    uv = _mm256_add_epi32(_mm256_srai_epi32(_mm256_add_epi32(uv, k.chromaRound), kChromaShift), k.chromaOffset);
+
+    return _mm256_packs_epi32(_mm256_unpacklo_epi32(uv, y), _mm256_unpackhi_epi32(uv, y));
+}
+
+ROCK_AVX2 uint32_t convertRowAVX2(const uint8_t* src, uint8_t* dst, uint32_t width, const Coefficients& c) {
+    AVXCoefficients k;
+    k.y = _mm256_setr_epi16(c.yb, c.yg, c.yr, 0, c.yb, c.yg, c.yr, 0, c.yb, c.yg, c.yr, 0, c.yb, c.yg, c.yr, 0);
+    k.u = _mm256_setr_epi16(c.ub, c.ug, c.ur, 0, c.ub, c.ug, c.ur, 0, c.ub, c.ug, c.ur, 0, c.ub, c.ug, c.ur, 0);
+    k.v = _mm256_setr_epi16(c.vb, c.vg, c.vr, 0, c.vb, c.vg, c.vr, 0, c.vb, c.vg, c.vr, 0, c.vb, c.vg, c.vr, 0);
+    k.lumaRound = _mm256_set1_epi32(kLumaRound);
+    k.lumaOffset = _mm256_set1_epi32(16);
+    k.chromaRound = _mm256_set1_epi32(kChromaRound);
+    k.chromaOffset = _mm256_set1_epi32(128);
+
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m256i a = uyvy8AVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * 4)), k);
+        __m256i b = uyvy8AVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * 4 + 32)), k);
+        // packus interleaves per 128-bit lane: [p0-3, p8-11 | p4-7, p12-15] -> restore pixel order
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 2), packed);
+    }
+    return x;
+}
+
+bool cpuHasAVX2() {
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    return hasAVX2;
+}
+
+#endif // ROCK_CONVERT_X86
+
+#if ROCK_CONVERT_NEON
+
+// NEON - vld4 deinterleaves 16 pixels into B/G/R/A planes, vpaddl gives the
+// pair sums for chroma and vst4 writes U/Y0/V/Y1 back interleaved.
+inline int32x4_t dot3(int16x4_t b, int16x4_t g, int16x4_t r, int16_t cb, int16_t cg, int16_t cr) {
+    int32x4_t acc = vmull_n_s16(b, cb);
+    acc = vmlal_n_s16(acc, g, cg);
+    return vmlal_n_s16(acc, r, cr);
+}
+
+inline uint8x8_t lumaNEON(uint8x8_t b, uint8x8_t g, uint8x8_t r, const Coefficients& c) {
+    int16x8_t b16 = vreinterpretq_s16_u16(vmovl_u8(b));
+    int16x8_t g16 = vreinterpretq_s16_u16(vmovl_u8(g));
+    int16x8_t r16 = vreinterpretq_s16_u16(vmovl_u8(r));
+    const int32x4_t round = vdupq_n_s32(kLumaRound);
+    const int32x4_t offset = vdupq_n_s32(16);
+    int32x4_t lo = dot3(vget_low_s16(b16), vget_low_s16(g16), vget_low_s16(r16), c.yb, c.yg, c.yr);
+    int32x4_t hi = dot3(vget_high_s16(b16), vget_high_s16(g16), vget_high_s16(r16), c.yb, c.yg, c.yr);
+    lo = vaddq_s32(vshrq_n_s32(vaddq_s32(lo, round), kLumaShift), offset);
+    hi = vaddq_s32(vshrq_n_s32(vaddq_s32(hi, round), kLumaShift), offset);
+    return vqmovun_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+}
+
+inline uint8x8_t chromaNEON(int16x8_t bs, int16x8_t gs, int16x8_t rs, int16_t cb, int16_t cg, int16_t cr) {
+    const int32x4_t round = vdupq_n_s32(kChromaRound);
+    const int32x4_t offset = vdupq_n_s32(128);
+    int32x4_t lo = dot3(vget_low_s16(bs), vget_low_s16(gs), vget_low_s16(rs), cb, cg, cr);
+    int32x4_t hi = dot3(vget_high_s16(bs), vget_high_s16(gs), vget_high_s16(rs), cb, cg, cr);
+    lo = vaddq_s32(vshrq_n_s32(vaddq_s32(lo, round), kChromaShift), offset);
+    hi = vaddq_s32(vshrq_n_s32(vaddq_s32(hi, round), kChromaShift), offset);
+    return vqmovun_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+}
+
+uint32_t convertRowNEON(const uint8_t* src, uint8_t* dst, uint32_t width, const Coefficients& c) {
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        uint8x16x4_t px = vld4q_u8(src + x * 4);   // val[0]=B, [1]=G, [2]=R, [3]=A
+
+        uint8x8_t yLo = lumaNEON(vget_low_u8(px.val[0]), vget_low_u8(px.val[1]), vget_low_u8(px.val[2]), c);
+        uint8x8_t yHi = lumaNEON(vget_high_u8(px.val[0]), vget_high_u8(px.val[1]), vget_high_u8(px.val[2]), c);
+        uint8x8x2_t y = vuzp_u8(yLo, yHi);   // val[0] = even pixels, val[1] = odd pixels
+
+        int16x8_t bs = vreinterpretq_s16_u16(vpaddlq_u8(px.val[0]));
+        int16x8_t gs = vreinterpretq_s16_u16(vpaddlq_u8(px.val[1]));
+        int16x8_t rs = vreinterpretq_s16_u16(vpaddlq_u8(px.val[2]));
+
+        uint8x8x4_t out;
+        out.val[0] = chromaNEON(bs, gs, rs, c.ub, c.ug, c.ur);
+        out.val[1] = y.val[0];
+        out.val[2] = chromaNEON(bs, gs, rs, c.vb, c.vg, c.vr);
+        out.val[3] = y.val[1];
+        vst4_u8(dst + x * 2, out);
+    }
+    return x;
+}
+
+#endif // ROCK_CONVERT_NEON
+
+} // namespace
+
+bool convertPathAvailable(ConvertPath path) {
+    switch (path) {
+        case ConvertPath::Auto:
+        case ConvertPath::Scalar:
+            return true;
+#if ROCK_CONVERT_X86
+        case ConvertPath::SSE2:
+            return true;
+        case ConvertPath::AVX2:
+            return cpuHasAVX2();
+#endif
+#if ROCK_CONVERT_NEON
+        case ConvertPath::NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+ConvertPath resolveConvertPath(ConvertPath path) {
+    if (path != ConvertPath::Auto && convertPathAvailable(path)) {
+        return path;
+    }
+#if ROCK_CONVERT_X86
+    return cpuHasAVX2() ? ConvertPath::AVX2 : ConvertPath::SSE2;
+#elif ROCK_CONVERT_NEON
+    return ConvertPath::NEON;
+#else
+    return ConvertPath::Scalar;
+#endif
+}
+
+const char* convertPathName(ConvertPath path) {
+    switch (path) {
+        case ConvertPath::Auto: return "Auto";
+        case ConvertPath::Scalar: return "Scalar";
+        case ConvertPath::SSE2: return "SSE2";
+        case ConvertPath::AVX2: return "AVX2";
+        case ConvertPath::NEON: return "NEON";
+        default: return "Unknown";
+    }
+}
+
+void convertBGRAToUYVY(const uint8_t* src, size_t srcStride,
+                       uint8_t* dst, size_t dstStride,
+                       uint32_t width, uint32_t rows,
+                       ColorMatrix matrix, ConvertPath path) {
+    if (!src || !dst || width == 0) return;
+
+    const Coefficients& c = coefficientsFor(matrix);
+    ConvertPath resolved = resolveConvertPath(path);
+
+#if ROCK_CONVERT_X86
+    const SSECoefficients sse(c);
+#endif
+
+    for (uint32_t row = 0; row < rows; row++) {
+        const uint8_t* s = src + row * srcStride;
+        uint8_t* d = dst + row * dstStride;
+        uint32_t x = 0;
+
+        switch (resolved) {
+#if ROCK_CONVERT_X86
+            case ConvertPath::SSE2: x = convertRowSSE2(s, d, width, sse); break;
+            case ConvertPath::AVX2: x = convertRowAVX2(s, d, width, c); break;
+#endif
+#if ROCK_CONVERT_NEON
+            case ConvertPath::NEON: x = convertRowNEON(s, d, width, c); break;
+#endif
+            default: break;
+        }
+
+        convertRowScalar(s, d, x, width, c);
+    }
+}
+
+void extractAlphaPlane(const uint8_t* src, size_t srcStride,
+                       uint8_t* dst, size_t dstStride,
+                       uint32_t width, uint32_t rows) {
+    if (!src || !dst) return;
+
+    for (uint32_t row = 0; row < rows; row++) {
+        const uint8_t* s = src + row * srcStride + 3;
+        uint8_t* d = dst + row * dstStride;
+        for (uint32_t x = 0; x < width; x++) {
+            d[x] = s[x * 4];
+        }
+    }
+}
+
+} // namespace RocKontrol
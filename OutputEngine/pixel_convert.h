@@ -0,0 +1,74 @@
+// pixel_convert.h - BGRA to NDI 4:2:2 pixel format conversion
+// Scalar reference kernel plus SSE2/AVX2 (x86-64) and NEON (arm64) paths
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace RocKontrol {
+
+// Pixel format put on the wire by an NDI output
+enum class NDIPixelFormat {
+    BGRA,   // 4 bytes/pixel, no conversion (default)
+    UYVY,   // 4:2:2, 2 bytes/pixel - half the bandwidth of BGRA
+    UYVA    // UYVY plane followed by a full-resolution alpha plane
+};
+
+// Y'CbCr matrix (limited/video range, 16-235 / 16-240)
+enum class ColorMatrix {
+    BT709,  // HD and above
+    BT601   // SD receivers
+};
+
+// Kernel selection - Auto picks the fastest path the CPU supports
+enum class ConvertPath {
+    Auto,
+    Scalar,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+// Bytes per line of the UYVY plane (odd widths are padded to a full pair)
+inline size_t uyvyLineStride(uint32_t width) {
+    return static_cast<size_t>((width + 1) / 2) * 4;
+}
+
+// Total bytes needed for one frame in the given format
+inline size_t convertedFrameSize(NDIPixelFormat format, uint32_t width, uint32_t height) {
+    switch (format) {
+        case NDIPixelFormat::UYVY: return uyvyLineStride(width) * height;
+        case NDIPixelFormat::UYVA: return uyvyLineStride(width) * height + static_cast<size_t>(width) * height;
+        case NDIPixelFormat::BGRA:
+        default: return static_cast<size_t>(width) * height * 4;
+    }
+}
+
+// Convert `rows` lines of BGRA to UYVY. Chroma is the rounded average of each
+// horizontal pixel pair. Every path produces bit-identical output to Scalar.
+void convertBGRAToUYVY(const uint8_t* src, size_t srcStride,
+                       uint8_t* dst, size_t dstStride,
+                       uint32_t width, uint32_t rows,
+                       ColorMatrix matrix, ConvertPath path = ConvertPath::Auto);
+
+// Copy the alpha channel of `rows` lines of BGRA into an 8-bit plane (UYVA)
+void extractAlphaPlane(const uint8_t* src, size_t srcStride,
+                       uint8_t* dst, size_t dstStride,
+                       uint32_t width, uint32_t rows);
+
+// Path resolution / introspection
+bool convertPathAvailable(ConvertPath path);
+ConvertPath resolveConvertPath(ConvertPath path);
+const char* convertPathName(ConvertPath path);
+
+inline const char* ndiPixelFormatToString(NDIPixelFormat format) {
+    switch (format) {
+        case NDIPixelFormat::BGRA: return "BGRA";
+        case NDIPixelFormat::UYVY: return "UYVY";
+        case NDIPixelFormat::UYVA: return "UYVA";
+        default: return "Unknown";
+    }
+}
+
+} // namespace RocKontrol
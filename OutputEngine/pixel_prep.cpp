@@ -0,0 +1,121 @@
+// pixel_prep.cpp - NDI pixel preparation stage (crop copy, intensity, format conversion)
+// Every row is processed independently, so any band split gives identical output
+
+#include "pixel_prep.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace RocKontrol {
+
+namespace {
+
+constexpr uint32_t kMinBandRows = 16;   // Below this, threading overhead wins
+constexpr uint32_t kChunkRows = 8;      // Staging rows kept hot in cache before conversion
+
+struct IntensityTable {
+    uint8_t lut[256];
+    bool identity;
+};
+
+void buildIntensityTable(float intensity, IntensityTable& table) {
+    int scale = (int)std::lround(std::max(0.0f, std::min(1.0f, intensity)) * 256.0f);
+    table.identity = scale >= 256;
+    for (int c = 0; c < 256; c++) {
+        table.lut[c] = (uint8_t)((c * scale + 128) >> 8);
+    }
+}
+
+void scaleRows(uint8_t* data, size_t stride, uint32_t width, uint32_t rows, const uint8_t* lut) {
+    for (uint32_t r = 0; r < rows; r++) {
+        uint8_t* p = data + r * stride;
+        for (uint32_t x = 0; x < width; x++, p += 4) {
+            p[0] = lut[p[0]];
+            p[1] = lut[p[1]];
+            p[2] = lut[p[2]];
+        }
+    }
+}
+
+// Copy rows [y, y + rows) of the crop region into dst
+void readSource(const PixelPrepJob& job, uint32_t y, uint32_t rows, uint8_t* dst, size_t dstStride) {
+    if (job.src) {
+        const uint8_t* src = job.src + (size_t)(job.cropY + y) * job.srcStride + (size_t)job.cropX * 4;
+        for (uint32_t r = 0; r < rows; r++) {
+            memcpy(dst + r * dstStride, src + r * job.srcStride, (size_t)job.width * 4);
+        }
+    } else {
+        job.readRows(job.readContext, job.cropX, job.cropY + y, job.width, rows, dst, dstStride);
+    }
+}
+
+void convertRows(const PixelPrepJob& job, const uint8_t* src, size_t srcStride, uint32_t y, uint32_t rows) {
+    convertBGRAToUYVY(src, srcStride, job.dst + (size_t)y * job.dstStride, job.dstStride,
+                      job.width, rows, job.matrix);
+    if (job.format == NDIPixelFormat::UYVA) {
+        extractAlphaPlane(src, srcStride, job.dstAlpha + (size_t)y * job.dstAlphaStride, job.dstAlphaStride,
+                          job.width, rows);
+    }
+}
+
+void prepBand(const PixelPrepJob& job, const IntensityTable& table, uint32_t y0, uint32_t rows) {
+    if (job.format == NDIPixelFormat::BGRA) {
+        // Crop straight into the output, then scale in place
+        uint8_t* dst = job.dst + (size_t)y0 * job.dstStride;
+        readSource(job, y0, rows, dst, job.dstStride);
+        if (!table.identity) scaleRows(dst, job.dstStride, job.width, rows, table.lut);
+        return;
+    }
+
+    if (job.src && table.identity) {
+        // Nothing to change before conversion - read the source in place
+        const uint8_t* src = job.src + (size_t)(job.cropY + y0) * job.srcStride + (size_t)job.cropX * 4;
+        convertRows(job, src, job.srcStride, y0, rows);
+        return;
+    }
+
+    // Stage a few rows at a time in a per-thread buffer (grows once, then reused)
+    thread_local std::vector<uint8_t> staging;
+    size_t stagingStride = (size_t)job.width * 4;
+    if (staging.size() < stagingStride * kChunkRows) {
+        staging.resize(stagingStride * kChunkRows);
+    }
+
+    for (uint32_t y = y0; y < y0 + rows; y += kChunkRows) {
+        uint32_t n = std::min(kChunkRows, y0 + rows - y);
+        readSource(job, y, n, staging.data(), stagingStride);
+        if (!table.identity) scaleRows(staging.data(), stagingStride, job.width, n, table.lut);
+        convertRows(job, staging.data(), stagingStride, y, n);
+    }
+}
+
+} // namespace
+
+uint32_t PixelPrep::bandsFor(uint32_t height) const {
+    uint32_t requested = band_count_.load();
+    if (requested == 0) {
+        requested = (uint32_t)pool_.workerCount() + 1;
+    }
+    uint32_t maxBands = std::max<uint32_t>(1, height / kMinBandRows);
+    return std::max<uint32_t>(1, std::min(requested, maxBands));
+}
+
+bool PixelPrep::run(const PixelPrepJob& job) {
+    if (job.width == 0 || job.height == 0 || !job.dst) return false;
+    if (!job.src && !job.readRows) return false;
+    if (job.format == NDIPixelFormat::UYVA && !job.dstAlpha) return false;
+
+    IntensityTable table;
+    buildIntensityTable(job.intensity, table);
+
+    uint32_t bands = bandsFor(job.height);
+    pool_.parallelFor(bands, [&](uint32_t band) {
+        uint32_t y0 = (uint32_t)((uint64_t)job.height * band / bands);
+        uint32_t y1 = (uint32_t)((uint64_t)job.height * (band + 1) / bands);
+        prepBand(job, table, y0, y1 - y0);
+    });
+    return true;
+}
+
+} // namespace RocKontrol
@@ -0,0 +1,62 @@
+// pixel_prep.h - NDI pixel preparation stage (crop copy, intensity, format conversion)
+// Splits a frame into row bands across a BandWorkerPool; output does not depend on band count
+
+#pragma once
+
+#include "band_worker_pool.h"
+#include "pixel_convert.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace RocKontrol {
+
+// Reads `rows` lines of BGRA starting at (x, y) into dst. Called concurrently
+// from several bands with disjoint row ranges (e.g. MTLTexture getBytes).
+using PixelRowReader = void (*)(void* context, uint32_t x, uint32_t y, uint32_t width, uint32_t rows,
+                                uint8_t* dst, size_t dstStride);
+
+struct PixelPrepJob {
+    // Source - either CPU memory or a row reader
+    const uint8_t* src = nullptr;      // BGRA
+    size_t srcStride = 0;
+    PixelRowReader readRows = nullptr;
+    void* readContext = nullptr;
+
+    // Region of the source to emit
+    uint32_t cropX = 0;
+    uint32_t cropY = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    float intensity = 1.0f;            // RGB scale (0-1), alpha untouched
+
+    NDIPixelFormat format = NDIPixelFormat::BGRA;
+    ColorMatrix matrix = ColorMatrix::BT709;
+
+    // Destination (UYVA: alpha plane written to dstAlpha)
+    uint8_t* dst = nullptr;
+    size_t dstStride = 0;
+    uint8_t* dstAlpha = nullptr;
+    size_t dstAlphaStride = 0;
+};
+
+class PixelPrep {
+public:
+    explicit PixelPrep(BandWorkerPool& pool = BandWorkerPool::shared()) : pool_(pool) {}
+
+    // Number of row bands per frame (0 = one per worker plus the caller)
+    void setBandCount(uint32_t bands) { band_count_.store(bands); }
+    uint32_t bandCount() const { return band_count_.load(); }
+
+    // Run the job to completion; returns false on invalid input
+    bool run(const PixelPrepJob& job);
+
+private:
+    uint32_t bandsFor(uint32_t height) const;
+
+    BandWorkerPool& pool_;
+    std::atomic<uint32_t> band_count_{0};
+};
+
+} // namespace RocKontrol
@@ -0,0 +1,243 @@
+// software_ndi_output.cpp - Headless NDI output sink (no Metal)
+// Same crop / blend / prep / async send stages as NDIOutput (ndi_send.h), with
+// the edge blend shader replaced by EdgeBlendRenderer
+
+#include "software_ndi_output.h"
+#include <chrono>
+#include <cstdio>
+
+namespace RocKontrol {
+
+namespace {
+
+uint64_t steadyNowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+SoftwareNDIOutput::SoftwareNDIOutput(std::shared_ptr<NDISenderBackend> backend)
+    : backend_(backend ? std::move(backend) : NDILibBackend::runtime()) {}
+
+SoftwareNDIOutput::~SoftwareNDIOutput() {
+    stop();
+}
+
+bool SoftwareNDIOutput::configure(const SoftwareNDIOutputConfig& config) {
+    if (running_.load()) {
+        return false;
+    }
+
+    config_ = config;
+    async_send_.store(config.async_send);
+    pixel_format_.store(config.pixel_format);
+    color_matrix_.store(config.color_matrix);
+    pixel_prep_.setBandCount(config.prep_bands);
+    return true;
+}
+
+bool SoftwareNDIOutput::setName(const std::string& name) {
+    if (name.empty()) {
+        return false;
+    }
+    // Takes effect on the next start (NDI can't rename a live sender)
+    config_.source_name = name;
+    return true;
+}
+
+void SoftwareNDIOutput::setPixelFormat(NDIPixelFormat format, ColorMatrix matrix) {
+    pixel_format_.store(format);
+    color_matrix_.store(matrix);
+    config_.pixel_format = format;
+    config_.color_matrix = matrix;
+}
+
+void SoftwareNDIOutput::setBackend(std::shared_ptr<NDISenderBackend> backend) {
+    if (running_.load()) {
+        fprintf(stderr, "SoftwareNDIOutput: Cannot replace NDI backend while running\n");
+        return;
+    }
+    backend_ = backend ? std::move(backend) : NDILibBackend::runtime();
+}
+
+int SoftwareNDIOutput::connectionCount() const {
+    if (!running_.load() || !sender_) return 0;
+    return backend_->connectionCount(sender_, 0);
+}
+
+bool SoftwareNDIOutput::start() {
+    if (running_.load()) {
+        return true;
+    }
+
+    status_.store(OutputStatus::Starting);
+    notifyStatus(OutputStatus::Starting, "Starting NDI sender...");
+
+    if (!backend_->load()) {
+        status_.store(OutputStatus::Error);
+        notifyStatus(OutputStatus::Error, "Failed to load NDI library");
+        return false;
+    }
+
+    NDIlib_send_create_t send_create;
+    send_create.p_ndi_name = config_.source_name.c_str();
+    send_create.p_groups = config_.groups.empty() ? nullptr : config_.groups.c_str();
+    send_create.clock_video = config_.clock_video;
+    send_create.clock_audio = false;
+
+    sender_ = backend_->createSender(send_create);
+    if (!sender_) {
+        status_.store(OutputStatus::Error);
+        notifyStatus(OutputStatus::Error, "Failed to create NDI sender");
+        return false;
+    }
+
+    should_stop_.store(false);
+    running_.store(true);
+    send_thread_ = std::thread(&SoftwareNDIOutput::sendLoop, this);
+
+    status_.store(OutputStatus::Running);
+    notifyStatus(OutputStatus::Running, "NDI sender started: " + config_.source_name);
+    fprintf(stderr, "SoftwareNDIOutput: Started sender '%s' (%s backend)\n",
+            config_.source_name.c_str(), backend_->name());
+    return true;
+}
+
+void SoftwareNDIOutput::stop() {
+    if (!running_.load()) {
+        return;
+    }
+
+    should_stop_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        queue_cv_.notify_all();
+    }
+    if (send_thread_.joinable()) {
+        send_thread_.join();
+    }
+
+    running_.store(false);
+
+    if (sender_) {
+        backend_->destroySender(sender_);
+        sender_ = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        while (!pixel_queue_.empty()) {
+            pixel_queue_.pop();
+        }
+    }
+    buffer_pool_.trim();
+
+    status_.store(OutputStatus::Stopped);
+    notifyStatus(OutputStatus::Stopped, "NDI sender stopped");
+}
+
+bool SoftwareNDIOutput::pushFrame(const SwitcherFrame&) {
+    // No GPU here - callers feed CPU frames through pushPixelData
+    frames_dropped_.fetch_add(1);
+    return false;
+}
+
+bool SoftwareNDIOutput::pushPixelData(const uint8_t* data, uint32_t width, uint32_t height, size_t stride,
+                                      uint64_t timestamp_ns, float frameRate) {
+    if (!running_.load() || !data || width == 0 || height == 0) {
+        return false;
+    }
+    if (stride == 0) stride = (size_t)width * 4;
+
+    uint64_t startNs = steadyNowNs();
+    frame_rate_.store(frameRate);
+
+    PixelCrop crop = cropPixels(width, height);
+    width_.store(crop.w);
+    height_.store(crop.h);
+
+    const auto& blend = currentEdgeBlend();
+    bool needsEdgeBlend = blend.needsEdgeBlendPass();
+
+    PixelPrepJob job;
+    job.width = crop.w;
+    job.height = crop.h;
+
+    if (needsEdgeBlend) {
+        EdgeBlendSettings settings = edgeBlendSettingsFor(blend, crop, width, height, intensity());
+        size_t renderStride = (size_t)crop.w * 4;
+        render_buffer_.resize(renderStride * crop.h);
+        if (!renderer_.render(settings, data, width, height, stride,
+                              render_buffer_.data(), crop.w, crop.h, renderStride)) {
+            // Never send the previous frame's render buffer in its place
+            frames_dropped_.fetch_add(1);
+            return false;
+        }
+
+        // Intensity was applied by the renderer
+        job.src = render_buffer_.data();
+        job.srcStride = renderStride;
+        job.intensity = 1.0f;
+    } else {
+        job.src = data;
+        job.srcStride = stride;
+        job.cropX = crop.x;
+        job.cropY = crop.y;
+        job.intensity = intensity();
+    }
+
+    NDIPixelFrame pixelFrame;
+    pixelFrame.timestamp_ns = timestamp_ns;
+    pixelFrame.frame_rate = frameRate;
+    if (!prepareNDIPixelFrame(buffer_pool_, pixel_prep_, pixel_format_.load(), color_matrix_.load(),
+                              job, pixelFrame)) {
+        frames_dropped_.fetch_add(1);
+        return false;
+    }
+    last_process_ns_.store(steadyNowNs() - startNs);
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+
+        // Drop oldest frame if queue is full
+        if (pixel_queue_.size() >= std::max<uint32_t>(1, config_.queue_size)) {
+            pixel_queue_.pop();
+            frames_dropped_.fetch_add(1);
+        }
+        pixel_queue_.push(std::move(pixelFrame));
+    }
+    queue_cv_.notify_one();
+    return true;
+}
+
+void SoftwareNDIOutput::sendLoop() {
+    NDIFrameSender ndi_sender;
+
+    while (!should_stop_.load()) {
+        NDIPixelFrame pixelFrame;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] {
+                return !pixel_queue_.empty() || should_stop_.load();
+            });
+            if (should_stop_.load()) {
+                break;
+            }
+            pixelFrame = std::move(pixel_queue_.front());
+            pixel_queue_.pop();
+        }
+
+        if (!pixelFrame.valid || pixelFrame.data.empty() || !sender_) {
+            continue;
+        }
+
+        NDIlib_video_frame_v2_t ndi_frame = ndiVideoFrame(pixelFrame, pixelFrame.frame_rate);
+        ndi_sender.send(*backend_, sender_, ndi_frame, std::move(pixelFrame.data), async_send_.load());
+        frames_sent_.fetch_add(1);
+    }
+
+    ndi_sender.flush(*backend_, sender_);
+}
+
+} // namespace RocKontrol
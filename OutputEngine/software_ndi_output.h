@@ -0,0 +1,126 @@
+// software_ndi_output.h - Headless NDI output sink (no Metal)
+// Takes CPU BGRA frames via pushPixelData, applies crop / edge blend / warp /
+// intensity on the CPU and sends through an NDISenderBackend. Portable C++ so
+// spare Linux boxes can fan out extra NDI feeds from a canvas stream.
+
+#pragma once
+
+#include "output_sink.h"
+#include "ndi_backend.h"
+#include "ndi_send.h"
+#include "edge_blend_cpu.h"
+#include "pixel_buffer_pool.h"
+#include "pixel_convert.h"
+#include "pixel_prep.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+
+namespace RocKontrol {
+
+struct SoftwareNDIOutputConfig {
+    std::string source_name = "RocKontrol Software";
+    std::string groups;                // NDI groups (comma-separated)
+    bool clock_video = true;           // Use NDI for timing
+    uint32_t queue_size = 3;           // Prepared frames waiting for the send thread
+    bool async_send = true;            // send_send_video_async_v2
+    NDIPixelFormat pixel_format = NDIPixelFormat::BGRA;
+    ColorMatrix color_matrix = ColorMatrix::BT709;
+    uint32_t prep_bands = 0;           // Row bands for crop/intensity/convert (0 = one per worker)
+};
+
+class SoftwareNDIOutput : public OutputSink {
+public:
+    explicit SoftwareNDIOutput(std::shared_ptr<NDISenderBackend> backend = NDILibBackend::runtime());
+    ~SoftwareNDIOutput() override;
+
+    // Configure (only while stopped)
+    bool configure(const SoftwareNDIOutputConfig& config);
+
+    // OutputSink interface
+    bool start() override;
+    void stop() override;
+    bool isRunning() const override { return running_.load(); }
+
+    // GPU frames are not supported - use pushPixelData
+    bool pushFrame(const SwitcherFrame& frame) override;
+
+    // Push a BGRA frame (stride 0 = width * 4). Crop, edge blend, warp and
+    // intensity run on the calling thread; sending happens on the send thread.
+    bool pushPixelData(const uint8_t* data, uint32_t width, uint32_t height, size_t stride,
+                       uint64_t timestamp_ns, float frameRate);
+
+    OutputType type() const override { return OutputType::NDI; }
+    std::string name() const override { return config_.source_name; }
+    OutputStatus status() const override { return status_.load(); }
+
+    uint32_t width() const override { return width_.load(); }
+    uint32_t height() const override { return height_.load(); }
+    float frameRate() const override { return frame_rate_.load(); }
+
+    bool setName(const std::string& name) override;
+    bool requiresEncoding() const override { return true; }
+
+    // Wire pixel format (BGRA is sent as-is, UYVY/UYVA are converted during pixel prep)
+    void setPixelFormat(NDIPixelFormat format, ColorMatrix matrix);
+    NDIPixelFormat pixelFormat() const { return pixel_format_.load(); }
+
+    void setAsyncSend(bool enabled) { async_send_.store(enabled); }
+    bool isAsyncSend() const { return async_send_.load(); }
+
+    void setPrepBandCount(uint32_t bands) { pixel_prep_.setBandCount(bands); }
+
+    // Only while stopped; nullptr = the dynamically loaded runtime
+    void setBackend(std::shared_ptr<NDISenderBackend> backend);
+
+    // Watch the send buffer pool (e.g. FakeNDIBackend::ownershipObserver())
+    void setBufferObserver(std::shared_ptr<PixelBufferObserver> observer) { buffer_pool_.setObserver(std::move(observer)); }
+
+    int connectionCount() const;
+
+    // Statistics
+    uint64_t framesSent() const { return frames_sent_.load(); }
+    uint64_t framesDropped() const { return frames_dropped_.load(); }
+    uint64_t lastProcessNs() const { return last_process_ns_.load(); }  // Render + prep of the last frame
+
+private:
+    void sendLoop();
+
+    std::shared_ptr<NDISenderBackend> backend_;
+    NDIlib_send_instance_t sender_ = nullptr;
+    SoftwareNDIOutputConfig config_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> should_stop_{false};
+    std::atomic<OutputStatus> status_{OutputStatus::Stopped};
+    std::atomic<bool> async_send_{true};
+    std::atomic<NDIPixelFormat> pixel_format_{NDIPixelFormat::BGRA};
+    std::atomic<ColorMatrix> color_matrix_{ColorMatrix::BT709};
+
+    std::atomic<uint32_t> width_{0};
+    std::atomic<uint32_t> height_{0};
+    std::atomic<float> frame_rate_{0.0f};
+
+    // Declared before the queue so queued leases are released before the pool
+    PixelBufferPool buffer_pool_;
+    PixelPrep pixel_prep_;
+
+    // CPU edge blend / warp (caller thread only)
+    EdgeBlendRenderer renderer_;
+    std::vector<uint8_t> render_buffer_;
+
+    std::thread send_thread_;
+    std::queue<NDIPixelFrame> pixel_queue_;
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+
+    std::atomic<uint64_t> frames_sent_{0};
+    std::atomic<uint64_t> frames_dropped_{0};
+    std::atomic<uint64_t> last_process_ns_{0};
+};
+
+} // namespace RocKontrol
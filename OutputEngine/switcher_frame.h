@@ -3,17 +3,23 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+
+#ifdef __OBJC__
 #import <Metal/Metal.h>
 #import <Foundation/Foundation.h>
-#include <atomic>
-#include <memory>
+#include "frame_ring.h"
 #include <mutex>
 #include <vector>
-#include <string>
+#endif
 
 namespace RocKontrol {
 
-// Frame format - always BGRA8 on GPU
+#ifdef __OBJC__
+// Frame format - always BGRA8 on GPU. Only defined for Objective-C++; plain C++
+// outputs (SoftwareNDIOutput) see the forward declaration in output_sink.h and
+// take CPU pixels instead.
 struct SwitcherFrame {
     id<MTLTexture> texture;          // GPU texture (BGRA8Unorm)
     uint64_t timestamp_ns;           // Presentation timestamp in nanoseconds
@@ -42,80 +48,8 @@ struct SwitcherFrame {
     }
 };
 
-// Ring buffer for frame storage (thread-safe)
-class FrameRingBuffer {
-public:
-    explicit FrameRingBuffer(size_t capacity = 5)
-        : capacity_(capacity), frames_(capacity), write_idx_(0), read_idx_(0), count_(0) {}
-
-    // Producer: push a new frame (may overwrite oldest if full)
-    bool push(const SwitcherFrame& frame) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        frames_[write_idx_] = frame;
-        write_idx_ = (write_idx_ + 1) % capacity_;
-        if (count_ < capacity_) {
-            count_++;
-        } else {
-            // Buffer full, advance read pointer (drop oldest)
-            read_idx_ = (read_idx_ + 1) % capacity_;
-        }
-        return true;
-    }
-
-    // Consumer: get the latest frame without removing it
-    bool peekLatest(SwitcherFrame& out) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (count_ == 0) return false;
-        size_t latest = (write_idx_ + capacity_ - 1) % capacity_;
-        out = frames_[latest];
-        return true;
-    }
-
-    // Consumer: pop the oldest frame
-    bool pop(SwitcherFrame& out) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (count_ == 0) return false;
-        out = frames_[read_idx_];
-        read_idx_ = (read_idx_ + 1) % capacity_;
-        count_--;
-        return true;
-    }
-
-    size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return count_;
-    }
-
-    bool empty() const {
-        return size() == 0;
-    }
-
-    void clear() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        for (auto& f : frames_) f.reset();
-        write_idx_ = 0;
-        read_idx_ = 0;
-        count_ = 0;
-    }
-
-    void resize(size_t capacity) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        capacity_ = capacity;
-        frames_.resize(capacity);
-        for (auto& f : frames_) f.reset();
-        write_idx_ = 0;
-        read_idx_ = 0;
-        count_ = 0;
-    }
-
-private:
-    size_t capacity_;
-    std::vector<SwitcherFrame> frames_;
-    size_t write_idx_;
-    size_t read_idx_;
-    size_t count_;
-    mutable std::mutex mutex_;
-};
+// Ring buffer for frame storage (lock-free, single producer / multiple consumers)
+using FrameRingBuffer = FrameRing<SwitcherFrame>;
 
 // Texture pool for efficient GPU memory reuse
 class TexturePool {
@@ -183,6 +117,7 @@ private:
     std::vector<id<MTLTexture>> available_;
     std::mutex mutex_;
 };
+#endif
 
 // Input source types
 enum class SourceType {
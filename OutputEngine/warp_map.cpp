@@ -0,0 +1,217 @@
+// warp_map.cpp - Cached source-UV lookup map for the NDI geometry chain
+// Float math follows the MSL functions of the same name in output_ndi.mm line for line
+
+#include "warp_map.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace RocKontrol {
+
+namespace {
+
+constexpr uint32_t kMinBandRows = 16;
+
+struct float2 {
+    float x, y;
+};
+
+inline float2 operator+(float2 a, float2 b) { return {a.x + b.x, a.y + b.y}; }
+inline float2 operator-(float2 a, float2 b) { return {a.x - b.x, a.y - b.y}; }
+inline float2 operator*(float2 a, float s) { return {a.x * s, a.y * s}; }
+inline float length(float2 a) { return std::sqrt(a.x * a.x + a.y * a.y); }
+
+const float2 kOutsideUV = {-1.0f, -1.0f};
+
+// Apply pincushion/barrel distortion correction (Brown-Conrady)
+float2 applyLensDistortion(float2 uv, float k1, float k2, float2 center) {
+    if (k1 == 0.0f && k2 == 0.0f) return uv;
+
+    float2 centered = uv - center;
+    float r = length(centered);
+    float r2 = r * r;
+    float r4 = r2 * r2;
+    float distortion = 1.0f + k1 * r2 + k2 * r4;
+    return centered * distortion + center;
+}
+
+// Fisheye-style radial distortion for dome/sphere projection
+float2 applySphericalCurvature(float2 uv, float curvature) {
+    if (std::fabs(curvature) < 0.001f) return uv;
+
+    float2 center = {0.5f, 0.5f};
+    float2 centered = uv - center;
+    float r = length(centered);
+    if (r < 0.001f) return uv;
+
+    float r_norm = r / 0.5f;
+    float k1 = -curvature * 0.5f;
+    float k2 = -curvature * 0.25f;
+
+    float r2 = r_norm * r_norm;
+    float r4 = r2 * r2;
+    float distortion = 1.0f + k1 * r2 + k2 * r4;
+    return centered * distortion + center;
+}
+
+// Inverse bilinear interpolation for a single quad - (0,1) UV or (-1,-1) if outside
+float2 inverseQuadUV(float2 p, float2 q00, float2 q10, float2 q01, float2 q11) {
+    float2 a = q00;
+    float2 b = q10 - q00;
+    float2 c = q01 - q00;
+    float2 d = q00 - q10 - q01 + q11;
+    float2 e = p - a;
+
+    float k1 = c.x * b.y - c.y * b.x;
+    float k2 = d.x * b.y - d.y * b.x;
+    float k3 = e.x * b.y - e.y * b.x;
+    float k4 = b.x * c.y - b.y * c.x;
+    float k5 = d.x * c.y - d.y * c.x;
+    float k6 = e.x * c.y - e.y * c.x;
+
+    float A = k1 * k5;
+    float B = k1 * k4 + k2 * k6 - k3 * k5;
+    float C = -k3 * k4;
+
+    float v;
+    if (std::fabs(A) < 0.0001f) {
+        if (std::fabs(B) < 0.0001f) return kOutsideUV;
+        v = -C / B;
+    } else {
+        float discriminant = B * B - 4.0f * A * C;
+        if (discriminant < 0.0f) return kOutsideUV;
+
+        float sqrtD = std::sqrt(discriminant);
+        float v1 = (-B + sqrtD) / (2.0f * A);
+        float v2 = (-B - sqrtD) / (2.0f * A);
+
+        if (v1 >= -0.01f && v1 <= 1.01f) v = v1;
+        else if (v2 >= -0.01f && v2 <= 1.01f) v = v2;
+        else return kOutsideUV;
+    }
+
+    float denom = k4 + v * k5;
+    if (std::fabs(denom) < 0.0001f) return kOutsideUV;
+    float u = k6 / denom;
+
+    if (u < -0.01f || u > 1.01f || v < -0.01f || v > 1.01f) {
+        return kOutsideUV;
+    }
+    return {std::min(std::max(u, 0.0f), 1.0f), std::min(std::max(v, 0.0f), 1.0f)};
+}
+
+// 8-point warp over a 3x3 grid, one inverse solve per quadrant
+float2 inverse8PointWarpUV(float2 p, float2 tl, float2 tm, float2 tr, float2 ml, float2 mr,
+                           float2 bl, float2 bm, float2 br, float curvature) {
+    float2 center = (tm + ml + mr + bm) * 0.25f;
+    if (std::fabs(curvature) > 0.001f) {
+        float2 idealCenter = {0.5f, 0.5f};
+        center = center + (center - idealCenter) * curvature * 0.5f;
+    }
+
+    float2 uv = inverseQuadUV(p, tl, tm, ml, center);
+    if (uv.x >= 0.0f) return uv * 0.5f;
+
+    uv = inverseQuadUV(p, tm, tr, center, mr);
+    if (uv.x >= 0.0f) return {0.5f + uv.x * 0.5f, uv.y * 0.5f};
+
+    uv = inverseQuadUV(p, ml, center, bl, bm);
+    if (uv.x >= 0.0f) return {uv.x * 0.5f, 0.5f + uv.y * 0.5f};
+
+    uv = inverseQuadUV(p, center, mr, bm, br);
+    if (uv.x >= 0.0f) return {0.5f + uv.x * 0.5f, 0.5f + uv.y * 0.5f};
+
+    return kOutsideUV;
+}
+
+} // namespace
+
+// WarpGeometry
+
+bool WarpGeometry::warpActive() const {
+    for (int i = 0; i < PointCount; i++) {
+        if (length({warp[i][0], warp[i][1]}) > 0.001f) return true;
+    }
+    return false;
+}
+
+bool WarpGeometry::curvatureActive() const {
+    return std::fabs(curvature) > 0.001f;
+}
+
+bool WarpGeometry::operator==(const WarpGeometry& other) const {
+    return memcmp(warp, other.warp, sizeof(warp)) == 0 &&
+           curvature == other.curvature &&
+           lensK1 == other.lensK1 && lensK2 == other.lensK2 &&
+           lensCenterX == other.lensCenterX && lensCenterY == other.lensCenterY &&
+           cropOriginX == other.cropOriginX && cropOriginY == other.cropOriginY &&
+           cropSizeX == other.cropSizeX && cropSizeY == other.cropSizeY;
+}
+
+bool warpSourceUV(const WarpGeometry& g, float u, float v, float& su, float& sv) {
+    float2 sampleUV = {u, v};
+
+    if (g.warpActive() || g.curvatureActive()) {
+        static const float2 kGrid[WarpGeometry::PointCount] = {
+            {0.0f, 0.0f}, {0.5f, 0.0f}, {1.0f, 0.0f},
+            {0.0f, 0.5f},               {1.0f, 0.5f},
+            {0.0f, 1.0f}, {0.5f, 1.0f}, {1.0f, 1.0f}
+        };
+        float2 p[WarpGeometry::PointCount];
+        for (int i = 0; i < WarpGeometry::PointCount; i++) {
+            p[i] = kGrid[i] + float2{g.warp[i][0], g.warp[i][1]};
+        }
+
+        float2 invUV = inverse8PointWarpUV(sampleUV,
+                                           p[WarpGeometry::TopLeft], p[WarpGeometry::TopMiddle], p[WarpGeometry::TopRight],
+                                           p[WarpGeometry::MiddleLeft], p[WarpGeometry::MiddleRight],
+                                           p[WarpGeometry::BottomLeft], p[WarpGeometry::BottomMiddle], p[WarpGeometry::BottomRight],
+                                           g.curvature);
+        if (invUV.x < 0.0f) return false;
+        sampleUV = invUV;
+    }
+
+    sampleUV = applySphericalCurvature(sampleUV, g.curvature);
+    sampleUV = applyLensDistortion(sampleUV, g.lensK1, g.lensK2, {g.lensCenterX, g.lensCenterY});
+
+    su = std::min(std::max(g.cropOriginX + sampleUV.x * g.cropSizeX, 0.0f), 1.0f);
+    sv = std::min(std::max(g.cropOriginY + sampleUV.y * g.cropSizeY, 0.0f), 1.0f);
+    return true;
+}
+
+// WarpMap
+
+bool WarpMap::update(const WarpGeometry& geometry, uint32_t width, uint32_t height, BandWorkerPool& pool) {
+    if (matches(geometry, width, height)) return false;
+    build(geometry, width, height, pool);
+    return true;
+}
+
+void WarpMap::build(const WarpGeometry& geometry, uint32_t width, uint32_t height, BandWorkerPool& pool) {
+    geometry_ = geometry;
+    width_ = width;
+    height_ = height;
+    uv_.resize((size_t)width * height * 2);
+    builds_++;
+    if (width == 0 || height == 0) return;
+
+    uint32_t bands = std::max<uint32_t>(1, std::min<uint32_t>((uint32_t)pool.workerCount() + 1, height / kMinBandRows));
+    pool.parallelFor(bands, [&](uint32_t band) {
+        uint32_t y0 = (uint32_t)((uint64_t)height * band / bands);
+        uint32_t y1 = (uint32_t)((uint64_t)height * (band + 1) / bands);
+        for (uint32_t y = y0; y < y1; y++) {
+            // Pixel centres, matching the fragment shader's interpolated texCoord
+            float v = ((float)y + 0.5f) / (float)height;
+            float* out = uv_.data() + (size_t)y * width * 2;
+            for (uint32_t x = 0; x < width; x++, out += 2) {
+                float u = ((float)x + 0.5f) / (float)width;
+                if (!warpSourceUV(geometry_, u, v, out[0], out[1])) {
+                    out[0] = kOutside;
+                    out[1] = kOutside;
+                }
+            }
+        }
+    });
+}
+
+} // namespace RocKontrol
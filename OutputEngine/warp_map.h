@@ -0,0 +1,75 @@
+// warp_map.h - Cached source-UV lookup map for the NDI geometry chain
+// Bakes 8-point warp + curvature + lens + crop into one UV per output pixel so the
+// per-frame shader does a single dependent fetch instead of inverse bilinear solves.
+// Portable C++ mirror of the edge blend shader math (output_ndi.mm).
+
+#pragma once
+
+#include "band_worker_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace RocKontrol {
+
+// Geometry half of the shader's EdgeBlendParams, in normalized output coordinates
+struct WarpGeometry {
+    enum Point { TopLeft, TopMiddle, TopRight, MiddleLeft, MiddleRight, BottomLeft, BottomMiddle, BottomRight, PointCount };
+
+    float warp[PointCount][2] = {};  // Offsets from the default 3x3 grid positions
+    float curvature = 0.0f;          // 0 = linear, + = convex/barrel, - = concave/pincushion
+    float lensK1 = 0.0f;
+    float lensK2 = 0.0f;
+    float lensCenterX = 0.5f;
+    float lensCenterY = 0.5f;
+    float cropOriginX = 0.0f;        // Crop in the source texture (normalized)
+    float cropOriginY = 0.0f;
+    float cropSizeX = 1.0f;
+    float cropSizeY = 1.0f;
+
+    bool warpActive() const;         // Any of the 8 points moved
+    bool curvatureActive() const;
+
+    bool operator==(const WarpGeometry& other) const;
+    bool operator!=(const WarpGeometry& other) const { return !(*this == other); }
+};
+
+// Source texture coordinate for output UV (u, v), exactly as edgeBlendFragment
+// computes it. Returns false outside the warped region (rendered black).
+bool warpSourceUV(const WarpGeometry& geometry, float u, float v, float& su, float& sv);
+
+// Source UV for every output pixel centre, row-major (u, v) pairs.
+// Pixels outside the warp hold kOutside in both channels.
+class WarpMap {
+public:
+    static constexpr float kOutside = -1.0f;
+
+    // Rebuild only if the geometry or size changed. Returns true if rebuilt.
+    bool update(const WarpGeometry& geometry, uint32_t width, uint32_t height,
+                BandWorkerPool& pool = BandWorkerPool::shared());
+
+    // Unconditional rebuild, split into row bands across the pool
+    void build(const WarpGeometry& geometry, uint32_t width, uint32_t height,
+               BandWorkerPool& pool = BandWorkerPool::shared());
+
+    bool matches(const WarpGeometry& geometry, uint32_t width, uint32_t height) const {
+        return !uv_.empty() && width_ == width && height_ == height && geometry_ == geometry;
+    }
+
+    const float* data() const { return uv_.data(); }
+    const float* row(uint32_t y) const { return uv_.data() + (size_t)y * width_ * 2; }
+    size_t rowBytes() const { return (size_t)width_ * 2 * sizeof(float); }
+    uint32_t width() const { return width_; }
+    uint32_t height() const { return height_; }
+    const WarpGeometry& geometry() const { return geometry_; }
+    uint64_t builds() const { return builds_; }
+
+private:
+    WarpGeometry geometry_;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    std::vector<float> uv_;
+    uint64_t builds_ = 0;
+};
+
+} // namespace RocKontrol
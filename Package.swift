@@ -16,6 +16,16 @@ let package = Package(
             sources: [
                 "output_display.mm",
                 "output_ndi.mm",
+                "pixel_buffer_pool.cpp",
+                "pixel_convert.cpp",
+                "pixel_prep.cpp",
+                "band_worker_pool.cpp",
+                "ndi_backend.cpp",
+                "ndi_send.cpp",
+                "warp_map.cpp",
+                "edge_blend_cpu.cpp",
+                "software_ndi_output.cpp",
+                "draw_list.cpp",
                 "OutputEngineWrapper.mm"
             ],
             publicHeadersPath: "include",
@@ -37,10 +47,31 @@ let package = Package(
                 .linkedFramework("QuartzCore")
             ]
         ),
+        // C++ Art-Net / sACN ingest and universe store
+        .target(
+            name: "DMXEngine",
+            path: "DMXEngine",
+            sources: [
+                "dmx_protocol.cpp",
+                "universe_store.cpp",
+                "sync_latch.cpp",
+                "sacn_merger.cpp",
+                "dmx_ingest.cpp",
+                "fixture_decoder.cpp",
+                "dmx_capture.cpp",
+                "dmx_stats.cpp",
+                "DMXEngineWrapper.mm"
+            ],
+            publicHeadersPath: "include",
+            cxxSettings: [
+                .headerSearchPath("."),
+                .unsafeFlags(["-std=c++17"])
+            ]
+        ),
         // Main Swift executable
         .executableTarget(
             name: "dmx-visualizer",
-            dependencies: ["OutputEngine"],
+            dependencies: ["OutputEngine", "DMXEngine"],
             swiftSettings: [
                 .unsafeFlags(["-F", ".", "-parse-as-library"]),
                 .interoperabilityMode(.Cxx)
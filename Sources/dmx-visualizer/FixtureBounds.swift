@@ -0,0 +1,191 @@
+// FixtureBounds.swift - Conservative visible bounds of a fixture quad
+// Every fixture is a quad of scale * baseRadius, but the SDF shape, iris and
+// framing shutters often leave most of it transparent. The visible region is
+// computed on the CPU in the quad's unit space (-1...1, where the shaders'
+// localPos = unit * baseRadius) as a convex polygon: the shape or iris disk
+// (as a circumscribed octagon) clipped by the quad and by each shutter blade's
+// half-plane. Edges are padded by softness, the masks' soft edge width and
+// the shaders' fwidth anti-aliasing, so tightening never cuts a visible pixel.
+
+import simd
+import OutputEngine
+
+struct FixtureBounds {
+    /// Visible part of the unit quad (minX, minY, maxX, maxY); -1...1 is the whole quad
+    var quad: SIMD4<Float>
+    /// Canvas-space bounding box of the visible part, relative to the fixture position
+    var extent: SIMD4<Float>
+
+    /// Fraction of the full quad's area the tightened quad still covers
+    var coverage: Float {
+        return (quad.z - quad.x) * (quad.w - quad.y) / 4
+    }
+
+    // Shape SDFs are drawn at radius 0.8 (shapeFragment); the line shape has an 8 px stroke
+    private static let shapeRadius: Float = 0.8
+    private static let lineHalfWidth: Float = 8
+    // shapeFragment: softWidth = softness * 0.005; fwidth(d) * 1.5 is up to 1.5 * sqrt(2) px
+    private static let softnessScale: Float = 0.005
+    private static let antialiasPixels: Float = 2.5
+    // sdPolygon's distance is stretched by 1 / cos(pi / n) past the edges (2 for the triangle)
+    private static let polygonBlurStretch: Float = 2
+    private static let maxVertices = 16   // Octagon + 4 quad edges + 4 blades, one vertex each
+
+    /// Bounds of a queued instance, or nil when its output alpha is 0 everywhere:
+    /// zero opacity or scale, closed iris, or blades covering the whole beam.
+    /// Color never culls - blending is source-over and alpha does not depend on
+    /// it, so a black fixture still paints black over what lies beneath.
+    init?(_ u: MetalObjectUniforms, pipeline: GDDrawPipeline) {
+        guard u.opacity > 0, u.iris > 0, u.scale.x != 0, u.scale.y != 0, u.baseRadius > 0 else { return nil }
+
+        let radius = u.baseRadius
+        let pixelsPerUnit = min(abs(u.scale.x), abs(u.scale.y)) * radius
+        let antialias = FixtureBounds.antialiasPixels / pixelsPerUnit
+        let maskEdge = abs(u.shutterEdgeWidth) / radius + antialias
+
+        // Disk that bounds everything the fragment shader can draw (nil = whole quad)
+        var disk: Float? = nil
+        if pipeline == .shape {
+            let blur = max(0, u.softness) * FixtureBounds.softnessScale + antialias
+            var shape = FixtureBounds.shapeRadius + blur * FixtureBounds.polygonBlurStretch
+            if u.shapeType == 0 {
+                shape += FixtureBounds.lineHalfWidth / radius
+            }
+            disk = shape
+        }
+        if u.iris < 1 {
+            let iris = u.iris + maskEdge
+            disk = min(disk ?? iris, iris)
+        }
+
+        var result: FixtureBounds?
+        withUnsafeTemporaryAllocation(of: SIMD2<Float>.self, capacity: FixtureBounds.maxVertices * 2) { storage in
+            var polygon = ConvexPolygon(storage: storage, capacity: FixtureBounds.maxVertices)
+
+            if let disk = disk, disk < 1.4142135 {
+                // Octagon circumscribing the disk
+                let r = disk / cos(Float.pi / 8)
+                for i in 0..<8 {
+                    let angle = (Float(i) + 0.5) * Float.pi / 4
+                    polygon.append(SIMD2<Float>(cos(angle), sin(angle)) * r)
+                }
+            } else {
+                polygon.append(SIMD2<Float>(-1, -1))
+                polygon.append(SIMD2<Float>(1, -1))
+                polygon.append(SIMD2<Float>(1, 1))
+                polygon.append(SIMD2<Float>(-1, 1))
+            }
+
+            // The quad itself
+            polygon.clip(normal: SIMD2<Float>(1, 0), distance: 1)
+            polygon.clip(normal: SIMD2<Float>(-1, 0), distance: 1)
+            polygon.clip(normal: SIMD2<Float>(0, 1), distance: 1)
+            polygon.clip(normal: SIMD2<Float>(0, -1), distance: 1)
+
+            // Framing shutters (applyFramingShutters / applyShutterBlade): a blade
+            // masks dot(R(angle) * R(assembly) * p, dir) > 1 - 2 * insertion
+            func clipBlade(_ blade: SIMD2<Float>, _ direction: SIMD2<Float>) {
+                guard blade.x > 0 else { return }
+                let angle = -(blade.y + u.shutterRotation)
+                let c = cos(angle)
+                let s = sin(angle)
+                let normal = SIMD2<Float>(c * direction.x - s * direction.y, s * direction.x + c * direction.y)
+                polygon.clip(normal: normal, distance: 1 - 2 * blade.x + maskEdge)
+            }
+            clipBlade(u.shutterTop, SIMD2<Float>(0, 1))
+            clipBlade(u.shutterBottom, SIMD2<Float>(0, -1))
+            clipBlade(u.shutterLeft, SIMD2<Float>(-1, 0))
+            clipBlade(u.shutterRight, SIMD2<Float>(1, 0))
+
+            guard polygon.count >= 3 else { return }
+
+            // Quad rect in unit space; canvas extent through the vertex shader's
+            // scale and rotation (float2x2(c, -s, s, c) is column-major)
+            let c = cos(u.rotation)
+            let s = sin(u.rotation)
+            var quadMin = SIMD2<Float>(repeating: .greatestFiniteMagnitude)
+            var quadMax = -quadMin
+            var canvasMin = quadMin
+            var canvasMax = quadMax
+            for i in 0..<polygon.count {
+                let p = polygon[i]
+                quadMin = simd_min(quadMin, p)
+                quadMax = simd_max(quadMax, p)
+
+                let scaled = p * u.scale * radius
+                let world = SIMD2<Float>(c * scaled.x + s * scaled.y, -s * scaled.x + c * scaled.y)
+                canvasMin = simd_min(canvasMin, world)
+                canvasMax = simd_max(canvasMax, world)
+            }
+            result = FixtureBounds(
+                quad: SIMD4<Float>(quadMin.x, quadMin.y, quadMax.x, quadMax.y),
+                extent: SIMD4<Float>(canvasMin.x, canvasMin.y, canvasMax.x, canvasMax.y)
+            )
+        }
+
+        guard let bounds = result else { return nil }
+        self = bounds
+    }
+
+    private init(quad: SIMD4<Float>, extent: SIMD4<Float>) {
+        self.quad = quad
+        self.extent = extent
+    }
+
+    /// Whether the visible part, moved to position, touches the canvas
+    func intersectsCanvas(at position: SIMD2<Float>, width: Float, height: Float) -> Bool {
+        return position.x + extent.z > 0 && position.y + extent.w > 0 &&
+               position.x + extent.x < width && position.y + extent.y < height
+    }
+}
+
+/// Sutherland-Hodgman clipping of a convex polygon against half-planes, in a
+/// caller-provided buffer (two halves, swapped after each clip) so bounds can
+/// be computed per fixture per frame without heap allocation
+private struct ConvexPolygon {
+    private let storage: UnsafeMutableBufferPointer<SIMD2<Float>>
+    private let capacity: Int
+    private var front = 0
+    private(set) var count = 0
+
+    init(storage: UnsafeMutableBufferPointer<SIMD2<Float>>, capacity: Int) {
+        self.storage = storage
+        self.capacity = capacity
+    }
+
+    subscript(i: Int) -> SIMD2<Float> {
+        return storage[front + i]
+    }
+
+    mutating func append(_ point: SIMD2<Float>) {
+        guard count < capacity else { return }
+        storage[front + count] = point
+        count += 1
+    }
+
+    /// Keep the part where dot(normal, p) <= distance
+    mutating func clip(normal: SIMD2<Float>, distance: Float) {
+        guard count > 0 else { return }
+        let back = front == 0 ? capacity : 0
+        var kept = 0
+
+        for i in 0..<count {
+            let a = storage[front + i]
+            let b = storage[front + (i + 1) % count]
+            let da = simd_dot(normal, a) - distance
+            let db = simd_dot(normal, b) - distance
+
+            if da <= 0, kept < capacity {
+                storage[back + kept] = a
+                kept += 1
+            }
+            if (da < 0 && db > 0) || (da > 0 && db < 0), kept < capacity {
+                storage[back + kept] = a + (b - a) * (da / (da - db))
+                kept += 1
+            }
+        }
+
+        front = back
+        count = kept
+    }
+}
@@ -113,6 +113,25 @@ struct OutputConfig: Codable {
     var enableLensCorrection: Bool  // Pincushion/barrel correction
     var enableCurveWarp: Bool       // Spherical curvature mapping
 
+    // NDI wire format: "bgra" (default), "uyvy" or "uyva"; matrix "bt709" (default) or "bt601"
+    var ndiPixelFormat: String?
+    var ndiColorMatrix: String?
+
+    // Edge-blended NDI frames in flight on the GPU before readback (1-3, default 2)
+    var ndiReadbackDepth: Int?
+
+    var ndiPixelFormatValue: GDNDIPixelFormat {
+        switch ndiPixelFormat?.lowercased() {
+        case "uyvy": return .UYVY
+        case "uyva": return .UYVA
+        default: return .BGRA
+        }
+    }
+
+    var ndiColorMatrixValue: GDColorMatrix {
+        ndiColorMatrix?.lowercased() == "bt601" ? .BT601 : .BT709
+    }
+
     static func defaultDisplay(displayId: UInt32, name: String, width: UInt32? = nil, height: UInt32? = nil) -> OutputConfig {
         OutputConfig(
             id: UUID(),
@@ -290,15 +309,17 @@ final class OutputManager: @unchecked Sendable {
         print("OutputManager: Initialized with Metal device")
     }
 
-    // MARK: - Frame Push (called from performDraw)
+    // MARK: - Frame Push (called from the render thread)
 
     /// Push a frame to all enabled outputs
     /// This method is designed to be fast and non-blocking
     /// All outputs receive the same timestamp for sync
-    func pushFrame(texture: MTLTexture, timestamp: UInt64, frameRate: Float) {
+    /// The render thread passes the output list the main thread last published
+    /// (targets) instead of reading the output table while the UI edits it.
+    func pushFrame(texture: MTLTexture, timestamp: UInt64, frameRate: Float, to targets: [ManagedOutput]? = nil) {
         // Push to all enabled outputs - simple loop is faster than concurrentPerform for small counts
         // Each output's pushFrame is non-blocking (queues work for async processing)
-        for output in outputs.values where output.config.enabled {
+        for output in targets ?? Array(outputs.values) where output.config.enabled {
             // Apply intensity before each frame push
             let intensity = output.config.outputIntensity
 
@@ -446,6 +467,8 @@ final class OutputManager: @unchecked Sendable {
         // Apply legacy mode preference
         let legacyMode = UserDefaults.standard.bool(forKey: "NDILegacyMode")
         ndiOutput.setLegacyMode(legacyMode)
+        ndiOutput.setPixelFormat(config.ndiPixelFormatValue, colorMatrix: config.ndiColorMatrixValue)
+        ndiOutput.setReadbackDepth(UInt32(clamping: config.ndiReadbackDepth ?? 2))
 
         output.ndiOutput = ndiOutput
 
@@ -986,6 +1009,8 @@ final class OutputManager: @unchecked Sendable {
                 // Apply legacy mode preference
                 let legacyMode = UserDefaults.standard.bool(forKey: "NDILegacyMode")
                 ndiOutput.setLegacyMode(legacyMode)
+                ndiOutput.setPixelFormat(config.ndiPixelFormatValue, colorMatrix: config.ndiColorMatrixValue)
+                ndiOutput.setReadbackDepth(UInt32(clamping: config.ndiReadbackDepth ?? 2))
 
                 // Restore resolution from config
                 if let width = config.ndiWidth, let height = config.ndiHeight {
@@ -1178,6 +1203,8 @@ final class OutputManager: @unchecked Sendable {
                 // Apply legacy mode preference
                 let legacyMode = UserDefaults.standard.bool(forKey: "NDILegacyMode")
                 ndiOutput.setLegacyMode(legacyMode)
+                ndiOutput.setPixelFormat(config.ndiPixelFormatValue, colorMatrix: config.ndiColorMatrixValue)
+                ndiOutput.setReadbackDepth(UInt32(clamping: config.ndiReadbackDepth ?? 2))
 
                 if let width = config.ndiWidth, let height = config.ndiHeight {
                     _ = ndiOutput.setResolutionWidth(width, height: height)
@@ -0,0 +1,204 @@
+// RenderThread.swift - Display-link driven render thread and fixed-step simulation clock
+// The Metal view renders on its own high-priority thread instead of the main
+// actor, so window animations, sheet presentation and other main-thread work
+// no longer hold frames back. State crosses between the two sides only through
+// SnapshotBox values.
+
+import Foundation
+import CoreVideo
+import QuartzCore
+
+// MARK: - Snapshot Box
+
+/// Latest-value handoff between threads. Writers build a complete value and
+/// replace the stored one; readers take a copy. The lock only ever covers the
+/// copy of the stored value (a few reference counts for the structs used here),
+/// so neither side waits on the other's work.
+final class SnapshotBox<Value>: @unchecked Sendable {
+    private var value: Value
+    private let lock = NSLock()
+
+    init(_ value: Value) {
+        self.value = value
+    }
+
+    func load() -> Value {
+        lock.lock()
+        defer { lock.unlock() }
+        return value
+    }
+
+    func store(_ newValue: Value) {
+        lock.lock()
+        let old = value
+        value = newValue
+        lock.unlock()
+        _ = old  // Release the previous value outside the lock
+    }
+}
+
+// MARK: - Fixed Step Clock
+
+/// Converts presentation time into a whole number of fixed simulation steps.
+/// Animation (spin, prism rotation, prismatics) advances by the same step no
+/// matter how unevenly frames are presented; leftover time carries over to the
+/// next frame. After a long stall the backlog is dropped instead of replayed.
+struct FixedStepClock {
+    let step: CFTimeInterval
+    let maxStepsPerFrame: Int
+    private var accumulator: CFTimeInterval = 0
+    private var lastTime: CFTimeInterval?
+
+    init(rate: Double, maxStepsPerFrame: Int = 8) {
+        self.step = 1.0 / max(rate, 1.0)
+        self.maxStepsPerFrame = maxStepsPerFrame
+    }
+
+    /// Steps to simulate for a frame presented at now
+    mutating func steps(at now: CFTimeInterval) -> Int {
+        defer { lastTime = now }
+        guard let last = lastTime, now > last else { return 0 }
+
+        accumulator += now - last
+        var count = Int(accumulator / step)
+        if count > maxStepsPerFrame {
+            count = maxStepsPerFrame
+            accumulator = 0
+        } else {
+            accumulator -= Double(count) * step
+        }
+        return count
+    }
+}
+
+// MARK: - Render Thread
+
+/// Dedicated render thread woken by a CVDisplayLink. The display link callback
+/// only signals; if a frame is still running when the next vsync arrives the
+/// wakeups coalesce into one, so a slow frame never queues up a backlog.
+/// stop() waits for the thread to finish its frame and exit, after which the
+/// thread can be started again.
+final class RenderThread: @unchecked Sendable {
+    private let name: String
+    private let frame: () -> Void
+    private var thread: Thread?
+    private var displayLink: CVDisplayLink?
+    private var linkContext: Unmanaged<RenderThread>?  // Retain held for the display link callback
+    private let wake = DispatchSemaphore(value: 0)
+    private let exited = DispatchSemaphore(value: 0)
+    private let lock = NSCondition()
+    private var framePending = false
+    private var stopped = false
+    private var callbacksInFlight = 0
+
+    /// Frame interval used when no display link could be created
+    private let fallbackInterval: TimeInterval = 1.0 / 60.0
+
+    init(name: String, frame: @escaping () -> Void) {
+        self.name = name
+        self.frame = frame
+    }
+
+    var isRunning: Bool { thread != nil }
+
+    func start() {
+        guard thread == nil else { return }
+
+        var link: CVDisplayLink?
+        if CVDisplayLinkCreateWithActiveCGDisplays(&link) == kCVReturnSuccess, let link = link {
+            // The callback can outlive every other reference, so the link holds one of its own
+            let context = Unmanaged.passRetained(self)
+            CVDisplayLinkSetOutputCallback(link, { (_, _, _, _, _, userData) -> CVReturn in
+                let renderThread = Unmanaged<RenderThread>.fromOpaque(userData!).takeUnretainedValue()
+                renderThread.displayLinkFired()
+                return kCVReturnSuccess
+            }, context.toOpaque())
+            displayLink = link
+            linkContext = context
+        } else {
+            print("RenderThread: No display link, falling back to a \(Int(1.0 / fallbackInterval)) Hz timer")
+        }
+
+        let usesDisplayLink = displayLink != nil
+        let thread = Thread { [self] in
+            run(usesDisplayLink: usesDisplayLink)
+            exited.signal()
+        }
+        thread.name = name
+        thread.qualityOfService = .userInteractive
+        self.thread = thread
+        thread.start()
+
+        if let link = displayLink {
+            CVDisplayLinkStart(link)
+        }
+    }
+
+    /// Stop the display link, wait for the current frame and the thread to
+    /// finish, and reset so start() can run again. Not from the render thread.
+    func stop() {
+        guard thread != nil else { return }
+
+        if let link = displayLink {
+            CVDisplayLinkStop(link)
+            displayLink = nil
+        }
+        lock.lock()
+        stopped = true
+        // CVDisplayLinkStop does not wait for a callback that is already running
+        while callbacksInFlight > 0 {
+            lock.wait()
+        }
+        lock.unlock()
+        linkContext?.release()
+        linkContext = nil
+
+        wake.signal()
+        exited.wait()
+
+        // Back to the state of a fresh instance
+        while wake.wait(timeout: .now()) == .success {}
+        lock.lock()
+        stopped = false
+        framePending = false
+        lock.unlock()
+        self.thread = nil
+    }
+
+    private func displayLinkFired() {
+        lock.lock()
+        callbacksInFlight += 1
+        let alreadyPending = framePending || stopped
+        framePending = true
+        lock.unlock()
+        if !alreadyPending {
+            wake.signal()
+        }
+        lock.lock()
+        callbacksInFlight -= 1
+        if callbacksInFlight == 0 {
+            lock.broadcast()
+        }
+        lock.unlock()
+    }
+
+    private func run(usesDisplayLink: Bool) {
+        while true {
+            if usesDisplayLink {
+                wake.wait()
+            } else {
+                _ = wake.wait(timeout: .now() + fallbackInterval)
+            }
+
+            lock.lock()
+            framePending = false
+            let shouldStop = stopped
+            lock.unlock()
+            if shouldStop { break }
+
+            autoreleasepool {
+                frame()
+            }
+        }
+    }
+}
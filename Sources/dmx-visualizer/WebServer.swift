@@ -256,6 +256,23 @@ final class WebServer: @unchecked Sendable {
             return handleRefreshNDI()
         }
 
+        // DMX capture / replay endpoints
+        if path == "/dmx/capture" && method == "GET" {
+            return handleGetCaptureStatus()
+        }
+        if path == "/dmx/capture/start" && method == "POST" {
+            return handleStartCapture(request: request)
+        }
+        if path == "/dmx/capture/stop" && method == "POST" {
+            return handleStopCapture()
+        }
+        if path == "/dmx/replay/start" && method == "POST" {
+            return handleStartReplay(request: request)
+        }
+        if path == "/dmx/replay/stop" && method == "POST" {
+            return handleStopReplay()
+        }
+
         // Output endpoints
         if path == "/outputs" && method == "GET" {
             return handleGetOutputs()
@@ -306,7 +323,7 @@ final class WebServer: @unchecked Sendable {
         let canvasWidth = UserDefaults.standard.integer(forKey: "canvasWidth")
         let canvasHeight = UserDefaults.standard.integer(forKey: "canvasHeight")
 
-        let status: [String: Any] = [
+        var status: [String: Any] = [
             "version": AppVersion.string,
             "fixtureCount": fixtureCount,
             "activeFixtures": activeFixtures,
@@ -314,12 +331,101 @@ final class WebServer: @unchecked Sendable {
                 "width": canvasWidth > 0 ? canvasWidth : 1920,
                 "height": canvasHeight > 0 ? canvasHeight : 1080
             ],
-            "outputCount": OutputManager.shared.getAllOutputs().count
+            "outputCount": OutputManager.shared.getAllOutputs().count,
+            "render": [
+                "drawCalls": sharedMetalRenderView?.lastDrawCallCount ?? 0,
+                "instances": sharedMetalRenderView?.lastInstanceCount ?? 0,
+                "culledOffCanvas": sharedMetalRenderView?.lastCulledOffCanvas ?? 0,
+                "culledInvisible": sharedMetalRenderView?.lastCulledInvisible ?? 0,
+                "quadCoverage": sharedMetalRenderView?.lastQuadCoverage ?? 1,
+                "allocationsLastFrame": sharedMetalRenderView?.lastFrameAllocations ?? 0,
+                "allocationsTotal": sharedMetalRenderView?.totalAllocations ?? 0,
+                "uniformBytesLastFrame": sharedMetalRenderView?.uniformBytesLastFrame ?? 0,
+                "uniformRingBytes": sharedMetalRenderView?.uniformRingCapacity ?? 0,
+                "simulationRate": MetalRenderView.simulationRate,
+                "simulationStepsLastFrame": sharedMetalRenderView?.lastSimulationSteps ?? 0,
+                "previewRate": MetalRenderView.previewRate,
+                "previewFramesSkipped": sharedMetalRenderView?.previewFramesSkipped ?? 0
+            ]
         ]
+        if let engine = sharedDMXState?.engine {
+            status["dmx"] = dmxStatus(engine)
+        }
 
         return HTTPResponse.json(status)
     }
 
+    /// Per-universe and per-source DMX timing. Times are milliseconds; histogram
+    /// counts line up with histogramLimitsMs (the last bucket is open-ended).
+    @MainActor
+    private func dmxStatus(_ engine: GDDMXEngine) -> [String: Any] {
+        func ms(_ seconds: Double) -> Double {
+            (seconds * 1_000_000).rounded() / 1000
+        }
+
+        let universes: [[String: Any]] = engine.universeStats.map { u in
+            [
+                "universe": u.universe,
+                "protocol": u.protocol == .artNet ? "artnet" : "sacn",
+                "packets": u.packetCount,
+                "rate": (u.packetsPerSecond * 10).rounded() / 10,
+                "intervalMs": ms(u.interval),
+                "jitterMs": ms(u.jitter),
+                "jitterHistogram": u.jitterHistogram,
+                "sequenceGaps": u.sequenceGapCount,
+                "lastPacketMs": ms(u.secondsSinceLastPacket),
+                "latency": [
+                    "frames": u.frameCount,
+                    "lastMs": ms(u.latency),
+                    "meanMs": ms(u.latencyMean),
+                    "maxMs": ms(u.latencyMax),
+                    "histogram": u.latencyHistogram
+                ]
+            ]
+        }
+
+        let sources: [[String: Any]] = engine.sacnSources.map { s in
+            [
+                "cid": s.cid,
+                "name": s.name,
+                "universe": s.universe,
+                "priority": s.priority,
+                "winning": s.winning,
+                "packets": s.packetCount,
+                "rate": (s.packetsPerSecond * 10).rounded() / 10,
+                "jitterMs": ms(s.jitter),
+                "sequenceErrors": s.sequenceErrorCount,
+                "duplicates": s.duplicateCount,
+                "sequenceGaps": s.sequenceGapCount,
+                "lastPacketMs": ms(s.secondsSinceLastPacket)
+            ]
+        }
+
+        let shards: [[String: Any]] = engine.receiveShards.map { shard in
+            [
+                "index": shard.index,
+                "firstUniverse": shard.firstUniverse,
+                "lastUniverse": shard.lastUniverse,
+                "artnet": shard.readsArtNet,
+                "sockets": shard.socketCount,
+                "packets": shard.packetCount,
+                "batches": shard.batchCount,
+                "lastPacketMs": ms(shard.secondsSinceLastPacket)
+            ]
+        }
+
+        return [
+            "running": engine.isRunning,
+            "packets": engine.packetCount,
+            "invalidPackets": engine.invalidPacketCount,
+            "duplicatePackets": engine.duplicatePacketCount,
+            "shards": shards,
+            "histogramLimitsMs": GDDMXEngine.timingHistogramLimits.map { ms($0.doubleValue) },
+            "universes": universes,
+            "sources": sources
+        ]
+    }
+
     @MainActor
     private func handleGetPreview() -> HTTPResponse {
         guard let renderView = sharedMetalRenderView,
@@ -766,6 +872,103 @@ final class WebServer: @unchecked Sendable {
         return HTTPResponse.json(["success": true])
     }
 
+    // MARK: - DMX Capture Handlers
+
+    @MainActor
+    private func handleGetCaptureStatus() -> HTTPResponse {
+        guard let engine = sharedDMXState?.engine else {
+            return HTTPResponse.error(503, "DMX engine not running")
+        }
+
+        return HTTPResponse.json([
+            "capture": [
+                "active": engine.isCapturing,
+                "packets": engine.capturePacketCount,
+                "bytes": engine.captureByteCount,
+                "writeErrors": engine.captureWriteErrorCount
+            ],
+            "replay": [
+                "active": engine.isReplaying,
+                "records": engine.replayRecordCount,
+                "duration": engine.replayDuration,
+                "packets": engine.replayPacketCount,
+                "loops": engine.replayLoopCount,
+                "packetsPerSecond": engine.replayPacketsPerSecond
+            ]
+        ])
+    }
+
+    @MainActor
+    private func handleStartCapture(request: HTTPRequest) -> HTTPResponse {
+        guard let state = sharedDMXState else {
+            return HTTPResponse.error(503, "DMX engine not running")
+        }
+
+        // Always a new file in the captures folder - the API never names a path to write
+        let formatter = DateFormatter()
+        formatter.dateFormat = "yyyyMMdd-HHmmss"
+        let url = getCapturesFolder().appendingPathComponent("capture-\(formatter.string(from: Date())).rkcap")
+
+        guard state.startCapture(to: url) else {
+            return HTTPResponse.error(500, "Could not open capture file")
+        }
+        return HTTPResponse.json(["success": true, "name": url.lastPathComponent, "path": url.path])
+    }
+
+    @MainActor
+    private func handleStopCapture() -> HTTPResponse {
+        guard let state = sharedDMXState else {
+            return HTTPResponse.error(503, "DMX engine not running")
+        }
+
+        state.stopCapture()
+        return HTTPResponse.json(["success": true, "packets": state.engine.capturePacketCount])
+    }
+
+    @MainActor
+    private func handleStartReplay(request: HTTPRequest) -> HTTPResponse {
+        guard let state = sharedDMXState else {
+            return HTTPResponse.error(503, "DMX engine not running")
+        }
+        guard let json = try? JSONSerialization.jsonObject(with: request.body) as? [String: Any],
+              let name = json["name"] as? String, !name.isEmpty else {
+            return HTTPResponse.badRequest("Expected JSON with name")
+        }
+
+        // Only files in the captures folder, named by file name alone
+        guard !name.contains("/"), !name.contains(".."), !name.contains("~") else {
+            return HTTPResponse.badRequest("Expected a capture file name, not a path")
+        }
+        let url = getCapturesFolder().appendingPathComponent(name)
+        let speed = max(0, (json["speed"] as? Double) ?? 1.0)
+        let loop = (json["loop"] as? Bool) ?? false
+
+        guard state.startReplay(from: url, speed: speed, loop: loop) else {
+            return HTTPResponse.error(500, "Could not replay capture file")
+        }
+        return HTTPResponse.json([
+            "success": true,
+            "name": url.lastPathComponent,
+            "path": url.path,
+            "records": state.engine.replayRecordCount,
+            "duration": state.engine.replayDuration
+        ])
+    }
+
+    @MainActor
+    private func handleStopReplay() -> HTTPResponse {
+        guard let state = sharedDMXState else {
+            return HTTPResponse.error(503, "DMX engine not running")
+        }
+
+        state.stopReplay()
+        return HTTPResponse.json([
+            "success": true,
+            "packets": state.engine.replayPacketCount,
+            "packetsPerSecond": state.engine.replayPacketsPerSecond
+        ])
+    }
+
     // MARK: - Output Handlers
 
     @MainActor
@@ -1042,6 +1245,11 @@ final class WebServer: @unchecked Sendable {
             .appendingPathComponent("Documents/DMXMedia/images")
     }
 
+    private func getCapturesFolder() -> URL {
+        return FileManager.default.homeDirectoryForCurrentUser
+            .appendingPathComponent("Documents/DMXMedia/captures")
+    }
+
     private func extractBoundary(from contentType: String) -> String? {
         let parts = contentType.components(separatedBy: ";")
         for part in parts {
@@ -1808,6 +2016,10 @@ private let indexHTML = """
                         <span>Outputs:</span>
                         <span class="status-value" id="outputCount">-</span>
                     </div>
+                    <div class="status-item">
+                        <span>Render:</span>
+                        <span class="status-value" id="renderStats">-</span>
+                    </div>
                 </div>
                 <div class="preview-container">
                     <img id="preview" src="/api/v1/status/preview" alt="Preview">
@@ -2097,6 +2309,10 @@ private let indexHTML = """
                 document.getElementById('fixtures').textContent = `${data.activeFixtures}/${data.fixtureCount} active`;
                 document.getElementById('resolution').textContent = `${data.resolution.width}x${data.resolution.height}`;
                 document.getElementById('outputCount').textContent = data.outputCount || 0;
+                if (data.render) {
+                    document.getElementById('renderStats').textContent =
+                        `${data.render.drawCalls} draws, ${data.render.allocationsLastFrame} allocs/frame`;
+                }
             } catch (e) { console.error('Status error:', e); }
         }
 
@@ -11,6 +11,7 @@ import SwiftUI
 import Combine
 import UniformTypeIdentifiers
 import OutputEngine
+import DMXEngine
 
 // MARK: - App Version
 struct AppVersion {
@@ -36,6 +37,9 @@ struct AppVersion {
 // Global reference to the render view for live preview access
 nonisolated(unsafe) var sharedMetalRenderView: MetalRenderView?
 
+// Global reference to the DMX state for web API capture / replay control
+nonisolated(unsafe) var sharedDMXState: DMXState?
+
 // Canvas resolution - can be changed in Settings, loaded from UserDefaults
 nonisolated(unsafe) private var canvasSize: CGSize = {
     let savedWidth = UserDefaults.standard.integer(forKey: "canvasWidth")
@@ -880,6 +884,7 @@ struct VertexOut {
     float4 position [[position]];
     float2 texCoord;
     float2 localPos;
+    uint instance [[flat]];   // Index into the per-frame ObjectUniforms buffer
 };
 
 // Per-object uniforms (16-byte aligned for float4)
@@ -918,6 +923,7 @@ struct ObjectUniforms {
     float animationPhase; // offset 260: current animation phase
     float animationSpeed; // offset 264: rotation speed from CH36
     int animPrismaticFill;// offset 268: 1=fill dark areas with prismatic colors
+    float4 localBounds;   // offset 272: visible part of the unit quad (minX, minY, maxX, maxY)
 };
 
 // Canvas uniforms
@@ -1505,15 +1511,23 @@ float4 applyPrismatic(float2 localPos, constant ObjectUniforms &obj, float4 base
 }
 
 // Vertex shader - transforms quad to object space
+// Uniforms come from buffer(1) indexed by instance (baseInstance included), so
+// one instanced draw renders a whole batch of objects
 vertex VertexOut vertexShader(
     VertexIn in [[stage_in]],
-    constant ObjectUniforms &object [[buffer(1)]],
-    constant CanvasUniforms &canvas [[buffer(2)]]
+    constant ObjectUniforms *objects [[buffer(1)]],
+    constant CanvasUniforms &canvas [[buffer(2)]],
+    uint instance [[instance_id]]
 ) {
     VertexOut out;
+    constant ObjectUniforms &object = objects[instance];
+    out.instance = instance;
+
+    // Shrink the unit quad to the part the fragment shader can draw (FixtureBounds)
+    float2 unit = mix(object.localBounds.xy, object.localBounds.zw, in.position * 0.5 + 0.5);
 
     // Apply scale
-    float2 scaled = in.position * object.scale * object.baseRadius;
+    float2 scaled = unit * object.scale * object.baseRadius;
 
     // Apply rotation
     float c = cos(object.rotation);
@@ -1529,8 +1543,8 @@ vertex VertexOut vertexShader(
     ndc.y = -ndc.y;  // Flip Y for Metal coordinate system
 
     out.position = float4(ndc, 0.0, 1.0);
-    out.texCoord = in.texCoord;
-    out.localPos = in.position * object.baseRadius;  // For SDF calculations
+    out.texCoord = float2(unit.x * 0.5 + 0.5, 0.5 - unit.y * 0.5);
+    out.localPos = unit * object.baseRadius;  // For SDF calculations
 
     return out;
 }
@@ -1538,8 +1552,10 @@ vertex VertexOut vertexShader(
 // Fragment shader - SDF shape rendering
 fragment float4 shapeFragment(
     VertexOut in [[stage_in]],
-    constant ObjectUniforms &object [[buffer(1)]]
+    constant ObjectUniforms *objects [[buffer(1)]]
 ) {
+    constant ObjectUniforms &object = objects[in.instance];
+
     // Normalize local position to -1..1 range for SDF
     float2 p = in.localPos / object.baseRadius;
     float d;
@@ -1635,10 +1651,12 @@ fragment float4 shapeFragment(
 // Fragment shader for gobo textures (supports both grayscale and color/glass gobos)
 fragment float4 goboFragment(
     VertexOut in [[stage_in]],
-    constant ObjectUniforms &object [[buffer(1)]],
+    constant ObjectUniforms *objects [[buffer(1)]],
     texture2d<float> goboTexture [[texture(0)]],
     sampler texSampler [[sampler(0)]]
 ) {
+    constant ObjectUniforms &object = objects[in.instance];
+
     // Sample gobo texture
     float2 uv = in.texCoord;
     float4 goboSample = goboTexture.sample(texSampler, uv);
@@ -1712,10 +1730,12 @@ fragment float4 goboFragment(
 // Fragment shader for video textures (full color with crossfade to mask)
 fragment float4 videoFragment(
     VertexOut in [[stage_in]],
-    constant ObjectUniforms &object [[buffer(1)]],
+    constant ObjectUniforms *objects [[buffer(1)]],
     texture2d<float> videoTexture [[texture(0)]],
     sampler texSampler [[sampler(0)]]
 ) {
+    constant ObjectUniforms &object = objects[in.instance];
+
     // Sample video texture - flip V to correct for coordinate system
     float2 uv = float2(in.texCoord.x, 1.0 - in.texCoord.y);
     float4 videoSample = videoTexture.sample(texSampler, uv);
@@ -1790,6 +1810,7 @@ struct MetalObjectUniforms {
     var animationPhase: Float = 0            // offset 260: current animation phase
     var animationSpeed: Float = 0            // offset 264: rotation speed from CH36
     var animPrismaticFill: Int32 = 0         // offset 268: 1=fill dark areas with prismatic colors
+    var localBounds: SIMD4<Float> = SIMD4<Float>(-1, -1, 1, 1)  // offset 272: visible part of the unit quad
 }
 
 struct MetalCanvasUniforms {
@@ -1798,9 +1819,75 @@ struct MetalCanvasUniforms {
     var padding: Float = 0
 }
 
+/// Per-frame uniform arena: a ring of shared buffers, one per frame in flight.
+/// Each frame bump-allocates from its own buffer; the frame fence (a semaphore
+/// signalled when the frame's command buffer completes) keeps the CPU from
+/// overwriting a buffer the GPU is still reading. Once every slot has grown to
+/// the frame's working set, rendering allocates nothing. Owned by the render thread.
+final class UniformRing: @unchecked Sendable {
+    static let framesInFlight = 3
+    private static let alignment = 256              // Buffer offset alignment for constant buffers on macOS
+    private static let initialCapacity = 256 * 1024
+
+    private let device: MTLDevice
+    private var buffers: [MTLBuffer?] = Array(repeating: nil, count: UniformRing.framesInFlight)
+    private var slot = 0
+    private var offset = 0
+    private let inFlight = DispatchSemaphore(value: UniformRing.framesInFlight)
+
+    private(set) var allocations: Int = 0           // Buffers created (growth included)
+    private(set) var bytesUsedLastFrame: Int = 0
+    private var bytesUsed: Int = 0
+
+    var capacity: Int {
+        return buffers.reduce(0) { $0 + ($1?.length ?? 0) }
+    }
+
+    init(device: MTLDevice) {
+        self.device = device
+    }
+
+    /// Wait for the oldest frame in flight to finish, then hand its buffer to
+    /// this frame. Every frame that begins must commit commandBuffer.
+    func beginFrame(commandBuffer: MTLCommandBuffer) {
+        inFlight.wait()
+        slot = (slot + 1) % UniformRing.framesInFlight
+        offset = 0
+        bytesUsedLastFrame = bytesUsed
+        bytesUsed = 0
+
+        let semaphore = inFlight
+        commandBuffer.addCompletedHandler { _ in
+            semaphore.signal()
+        }
+    }
+
+    /// Copy length bytes into this frame's buffer; returns where to bind them
+    func push(_ bytes: UnsafeRawPointer, length: Int) -> (buffer: MTLBuffer, offset: Int)? {
+        var start = (offset + UniformRing.alignment - 1) & ~(UniformRing.alignment - 1)
+        var buffer = buffers[slot]
+        if buffer == nil || start + length > buffer!.length {
+            // Grow this slot. Encoders already bound to the old buffer keep it alive.
+            let size = max(UniformRing.initialCapacity, (buffer?.length ?? 0) * 2, length)
+            guard let grown = device.makeBuffer(length: size, options: .storageModeShared) else { return nil }
+            buffers[slot] = grown
+            buffer = grown
+            allocations += 1
+            start = 0
+        }
+
+        memcpy(buffer!.contents() + start, bytes, length)
+        offset = start + length
+        bytesUsed += length
+        return (buffer!, start)
+    }
+}
+
 /// Metal Renderer - GPU-accelerated rendering engine
-@MainActor
-final class MetalRenderer {
+/// Created on the main thread, then used by the render thread. Pipelines,
+/// buffers and the sampler are immutable after init; gobo textures are loaded on
+/// the main thread (GoboLibrary) and handed over through a locked cache.
+final class MetalRenderer: @unchecked Sendable {
     let device: MTLDevice
     let commandQueue: MTLCommandQueue
 
@@ -1809,19 +1896,36 @@ final class MetalRenderer {
     private(set) var videoPipelineState: MTLRenderPipelineState?
     private var clearPipelineState: MTLRenderPipelineState?
 
-    private var quadVertexBuffer: MTLBuffer?
+    /// Pipelines indexed by GDDrawPipeline for instanced draw lists
+    private(set) var drawPipelines: [MTLRenderPipelineState] = []
+
+    private(set) var quadVertexBuffer: MTLBuffer?
     private var quadIndexBuffer: MTLBuffer?
     private var objectUniformsBuffer: MTLBuffer?
     private var canvasUniformsBuffer: MTLBuffer?
 
     private var goboTextures: [Int: MTLTexture] = [:]
+    private var goboLoadsPending: Set<Int> = []
+    private let goboLock = NSLock()
     private(set) var samplerState: MTLSamplerState?
 
+    /// Per-frame uniform and instance data
+    let uniformRing: UniformRing
+    private var textureAllocations: Int = 0
+
+    /// Metal resources created by the render path so far (ring growth, gobo and text textures)
+    var resourceAllocations: Int {
+        goboLock.lock()
+        defer { goboLock.unlock() }
+        return uniformRing.allocations + textureAllocations
+    }
+
     private var library: MTLLibrary?
 
     let canvasWidth: Int
     let canvasHeight: Int
 
+    @MainActor
     init?(width: Int, height: Int) {
         guard let device = MTLCreateSystemDefaultDevice() else {
             print("Metal: Failed to create device")
@@ -1835,6 +1939,7 @@ final class MetalRenderer {
 
         self.device = device
         self.commandQueue = queue
+        self.uniformRing = UniformRing(device: device)
         self.canvasWidth = width
         self.canvasHeight = height
 
@@ -1947,6 +2052,8 @@ final class MetalRenderer {
             return false
         }
 
+        drawPipelines = [shapePipelineState!, goboPipelineState!, videoPipelineState!]
+
         print("Metal: Pipeline states created successfully")
         return true
     }
@@ -2017,6 +2124,7 @@ final class MetalRenderer {
             print("Metal: Failed to create texture for gobo \(id)")
             return
         }
+        noteTextureAllocation()
 
         // Copy image data to texture
         let bytesPerPixel = 4
@@ -2046,27 +2154,48 @@ final class MetalRenderer {
             bytesPerRow: bytesPerRow
         )
 
+        goboLock.lock()
         goboTextures[id] = texture
+        goboLock.unlock()
+    }
+
+    /// Count a texture the render path created outside the renderer
+    func noteTextureAllocation() {
+        goboLock.lock()
+        textureAllocations += 1
+        goboLock.unlock()
     }
 
-    /// Get or create gobo texture
+    /// Get a gobo texture (render thread). A miss asks the main thread to load it
+    /// from GoboLibrary; the fixture renders as a shape until the texture lands.
     func getGoboTexture(id: Int) -> MTLTexture? {
+        goboLock.lock()
         if let texture = goboTextures[id] {
+            goboLock.unlock()
             return texture
         }
+        let alreadyRequested = !goboLoadsPending.insert(id).inserted
+        goboLock.unlock()
 
-        // Try to load from GoboLibrary
-        if let cgImage = GoboLibrary.shared.getOrGenerateImage(for: id) {
-            loadGoboTexture(id: id, image: cgImage)
-            return goboTextures[id]
+        if !alreadyRequested {
+            DispatchQueue.main.async { [self] in
+                if let cgImage = GoboLibrary.shared.getOrGenerateImage(for: id) {
+                    loadGoboTexture(id: id, image: cgImage)
+                }
+                goboLock.lock()
+                goboLoadsPending.remove(id)
+                goboLock.unlock()
+            }
         }
-
         return nil
     }
 
     /// Invalidate and reload a gobo texture (called when file changes)
+    @MainActor
     func reloadGoboTexture(id: Int) {
+        goboLock.lock()
         goboTextures.removeValue(forKey: id)
+        goboLock.unlock()
         // Reload from disk
         if let cgImage = GoboLibrary.shared.reloadGobo(id: id) {
             loadGoboTexture(id: id, image: cgImage)
@@ -2075,9 +2204,12 @@ final class MetalRenderer {
     }
 
     /// Reload all gobo textures (called on manual refresh)
+    @MainActor
     func reloadGoboTextures() {
+        goboLock.lock()
         let ids = Array(goboTextures.keys)
         goboTextures.removeAll()
+        goboLock.unlock()
         print("MetalRenderer: Clearing \(ids.count) cached gobo textures")
 
         // Pre-load commonly used gobos
@@ -2123,17 +2255,67 @@ final class MetalRenderer {
 final class MetalRenderView: MTKView {
     private let controller: SceneController
     private let renderer: MetalRenderer
-    private var lastTimestamp: CFTimeInterval = CACurrentMediaTime()
+
+    // Frames run on the render thread (simulate, encode, present, push outputs).
+    // The main thread only publishes RenderInputs and applies what frames collected.
+    nonisolated(unsafe) private var renderThread: RenderThread?
+    nonisolated(unsafe) private var simulationClock = FixedStepClock(rate: MetalRenderView.simulationRate)
+    nonisolated(unsafe) private var metalLayer: CAMetalLayer?
+    private let renderInputs = SnapshotBox(RenderInputs())
+    private let collectedPlayback = SnapshotBox<[VideoPlaybackRequest]>([])
+    nonisolated(unsafe) private var framePlayback: [VideoPlaybackRequest] = []
+    private let inputsLock = NSLock()
+    nonisolated(unsafe) private var inputsRequested = false
+    nonisolated(unsafe) private(set) var lastSimulationSteps: Int = 0
+
+    /// Simulation steps per second for spin, prism rotation and prismatics,
+    /// independent of the display refresh rate
+    nonisolated static var simulationRate: Double {
+        let rate = UserDefaults.standard.double(forKey: "renderSimulationRate")
+        return rate > 0 ? rate : 120
+    }
 
     // MSAA and render targets
     private var msaaTexture: MTLTexture?
     private var resolveTexture: MTLTexture?
 
     // Offscreen canvas texture for full-resolution Syphon/NDI output
-    private var offscreenTexture: MTLTexture?
+    nonisolated(unsafe) private var offscreenTexture: MTLTexture?
     private var blitPipelineState: MTLRenderPipelineState?
 
-    // Test pattern text texture
+    // Per-frame instanced draw list (one draw per run of same pipeline/texture)
+    nonisolated(unsafe) private let drawList = GDDrawList(instanceStride: MemoryLayout<MetalObjectUniforms>.stride)
+    nonisolated(unsafe) private(set) var lastDrawCallCount: Int = 0
+    nonisolated(unsafe) private(set) var lastInstanceCount: Int = 0
+
+    // Quads culled before encoding and the share of full quad area still rasterized
+    nonisolated(unsafe) private(set) var lastCulledOffCanvas: Int = 0
+    nonisolated(unsafe) private(set) var lastCulledInvisible: Int = 0
+    nonisolated(unsafe) private(set) var lastQuadCoverage: Float = 1
+    nonisolated(unsafe) private var frameCulling = CullingStats()
+
+    // Metal resources created during the last frame (0 in steady state)
+    nonisolated(unsafe) private(set) var lastFrameAllocations: Int = 0
+    var totalAllocations: Int { renderer.resourceAllocations }
+    var uniformBytesLastFrame: Int { renderer.uniformRing.bytesUsedLastFrame }
+    var uniformRingCapacity: Int { renderer.uniformRing.capacity }
+
+    /// On-screen preview rate in Hz (0 = every frame). The canvas and outputs still
+    /// render every frame; a lower preview rate only skips presenting the view.
+    nonisolated static var previewRate: Double {
+        return max(0, UserDefaults.standard.double(forKey: "renderPreviewRate"))
+    }
+    nonisolated(unsafe) private var lastPreviewTime: CFTimeInterval = 0
+    nonisolated(unsafe) private(set) var previewFramesSkipped: Int = 0
+
+    /// Group fixture draws by pipeline/texture across the whole frame rather than
+    /// only merging neighbours. Fewer draws, but overlapping fixtures of different
+    /// kinds (shape/gobo/video) may change stacking order.
+    static var groupDrawsByState: Bool {
+        return UserDefaults.standard.bool(forKey: "renderGroupDrawsByState")
+    }
+
+    // Test pattern text texture (main thread; handed to frames through RenderInputs)
     private var testPatternTextTexture: MTLTexture?
     private var lastTestPatternText: String = ""
 
@@ -2167,13 +2349,13 @@ final class MetalRenderView: MTKView {
 
         super.init(frame: frame, device: renderer.device)
 
-        self.delegate = self
         self.colorPixelFormat = .bgra8Unorm
         self.clearColor = MTLClearColor(red: 0, green: 0, blue: 0, alpha: 1)
         self.sampleCount = 1  // Shader AA via fwidth()
-        self.isPaused = false
+        // MTKView's own draw loop stays off; the render thread pulls drawables from the layer
+        self.isPaused = true
         self.enableSetNeedsDisplay = false
-        self.preferredFramesPerSecond = 60
+        self.metalLayer = layer as? CAMetalLayer
 
         // Create offscreen texture at full canvas resolution for Syphon/NDI
         createOffscreenTexture()
@@ -2196,12 +2378,28 @@ final class MetalRenderView: MTKView {
         OutputManager.shared.setup(device: renderer.device)
 
         // NDI outputs are now handled by OutputManager (restored from saved config)
+
+        startRenderThread()
     }
 
     required init(coder: NSCoder) {
         fatalError("init(coder:) has not been implemented")
     }
 
+    deinit {
+        renderThread?.stop()
+    }
+
+    // Frames only run while the view is in a window
+    override func viewDidMoveToWindow() {
+        super.viewDidMoveToWindow()
+        if window != nil {
+            startRenderThread()
+        } else {
+            stopRenderThread()
+        }
+    }
+
     @objc private func handleGoboFileChanged(_ notification: Notification) {
         guard let goboId = notification.userInfo?["goboId"] as? Int else { return }
         print("MetalRenderView: Reloading gobo \(goboId) from file change")
@@ -2333,7 +2531,8 @@ final class MetalRenderView: MTKView {
     }
 
     /// Render scene to offscreen texture at full canvas resolution
-    private func renderToOffscreen(commandBuffer: MTLCommandBuffer, time: CFTimeInterval) {
+    nonisolated private func renderToOffscreen(commandBuffer: MTLCommandBuffer, time: CFTimeInterval,
+                                               objects: [VisualObject], inputs: RenderInputs) {
         guard let offscreen = offscreenTexture else { return }
 
         // Create render pass for offscreen texture
@@ -2356,30 +2555,23 @@ final class MetalRenderView: MTKView {
         renderEncoder.setVertexBytes(&canvasUniforms, length: MemoryLayout<MetalCanvasUniforms>.stride, index: 2)
 
         // If test pattern is active, ONLY draw test pattern (no fixtures)
-        if OutputSettingsWindowController.testPatternActive {
-            drawTestPattern(encoder: renderEncoder)
+        if inputs.testPattern {
+            drawTestPattern(encoder: renderEncoder, textTexture: inputs.testPatternText)
         } else {
             // Render each object (fixtures)
-            for obj in controller.objects {
-                if obj.prismType != .off && obj.prismFacets > 0 {
-                    renderPrismCopies(obj, encoder: renderEncoder)
-                } else {
-                    renderObject(obj, encoder: renderEncoder, positionOffset: .zero)
-                }
-            }
+            renderObjects(encoder: renderEncoder, objects: objects, inputs: inputs)
         }
 
         // Draw output borders when Show Borders is enabled
-        if OutputSettingsWindowController.showBordersActive {
-            drawOutputBorders(encoder: renderEncoder)
+        if inputs.showBorders {
+            drawOutputBorders(encoder: renderEncoder, outputs: inputs.outputs)
         }
 
         renderEncoder.endEncoding()
     }
 
     /// Draw colored output regions like the canvas preview
-    private func drawOutputBorders(encoder: MTLRenderCommandEncoder) {
-        let outputs = OutputManager.shared.getAllOutputs()
+    nonisolated private func drawOutputBorders(encoder: MTLRenderCommandEncoder, outputs: [ManagedOutput]) {
         let colors: [SIMD4<Float>] = [
             SIMD4<Float>(0, 0.6, 1, 1),     // Blue
             SIMD4<Float>(0.6, 0, 1, 1),     // Purple
@@ -2421,7 +2613,7 @@ final class MetalRenderView: MTKView {
     }
 
     /// Draw output label (index number) in center of output area
-    private func drawOutputLabel(encoder: MTLRenderCommandEncoder, x: CGFloat, y: CGFloat, w: CGFloat, h: CGFloat, index: Int, color: SIMD4<Float>) {
+    nonisolated private func drawOutputLabel(encoder: MTLRenderCommandEncoder, x: CGFloat, y: CGFloat, w: CGFloat, h: CGFloat, index: Int, color: SIMD4<Float>) {
         let centerX = x + w / 2
         let centerY = y + h / 2
         let digitHeight: CGFloat = min(80, h * 0.3)  // Scale to output size
@@ -2447,7 +2639,7 @@ final class MetalRenderView: MTKView {
     }
 
     /// Draw a single digit using 7-segment style rectangles
-    private func drawDigit(encoder: MTLRenderCommandEncoder, digit: Int, centerX: CGFloat, centerY: CGFloat,
+    nonisolated private func drawDigit(encoder: MTLRenderCommandEncoder, digit: Int, centerX: CGFloat, centerY: CGFloat,
                           width: CGFloat, height: CGFloat, stroke: CGFloat, color: SIMD4<Float>) {
         let halfW = width / 2
         let halfH = height / 2
@@ -2508,7 +2700,7 @@ final class MetalRenderView: MTKView {
     }
 
     /// Draw a solid colored rectangle at canvas pixel coordinates
-    private func drawSolidRect(encoder: MTLRenderCommandEncoder, x: CGFloat, y: CGFloat, w: CGFloat, h: CGFloat, color: SIMD4<Float>) {
+    nonisolated private func drawSolidRect(encoder: MTLRenderCommandEncoder, x: CGFloat, y: CGFloat, w: CGFloat, h: CGFloat, color: SIMD4<Float>) {
         var uniforms = MetalObjectUniforms()
         uniforms.position = SIMD2<Float>(Float(x + w/2), Float(y + h/2))
         uniforms.scale = SIMD2<Float>(Float(w/2), Float(h/2))
@@ -2531,19 +2723,7 @@ final class MetalRenderView: MTKView {
         uniforms.prismaticColorCount = 0
         uniforms.animationType = 0
 
-        let vertices: [SIMD2<Float>] = [
-            SIMD2<Float>(-1, 1), SIMD2<Float>(0, 0),
-            SIMD2<Float>(1, 1), SIMD2<Float>(1, 0),
-            SIMD2<Float>(-1, -1), SIMD2<Float>(0, 1),
-            SIMD2<Float>(1, -1), SIMD2<Float>(1, 1)
-        ]
-
-        encoder.setVertexBuffer(renderer.commandQueue.device.makeBuffer(
-            bytes: vertices,
-            length: MemoryLayout<SIMD2<Float>>.stride * 8,
-            options: .storageModeShared
-        ), offset: 0, index: 0)
-
+        encoder.setVertexBuffer(renderer.quadVertexBuffer, offset: 0, index: 0)
         encoder.setVertexBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
         encoder.setFragmentBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
 
@@ -2551,14 +2731,14 @@ final class MetalRenderView: MTKView {
     }
 
     /// Draw a colored quad at canvas pixel coordinates (legacy - kept for test pattern)
-    private func drawColoredQuad(encoder: MTLRenderCommandEncoder, x: CGFloat, y: CGFloat, w: CGFloat, h: CGFloat, color: SIMD4<Float>) {
+    nonisolated private func drawColoredQuad(encoder: MTLRenderCommandEncoder, x: CGFloat, y: CGFloat, w: CGFloat, h: CGFloat, color: SIMD4<Float>) {
         drawSolidRect(encoder: encoder, x: x, y: y, w: w, h: h, color: color)
     }
 
     // MARK: - Test Pattern Generator
 
     /// Draw calibration test pattern - red grid with white circles on black background
-    private func drawTestPattern(encoder: MTLRenderCommandEncoder) {
+    nonisolated private func drawTestPattern(encoder: MTLRenderCommandEncoder, textTexture: MTLTexture?) {
         encoder.setRenderPipelineState(renderer.shapePipelineState!)
 
         let canvasW = CGFloat(canvasSize.width)
@@ -2643,28 +2823,18 @@ final class MetalRenderView: MTKView {
         drawColoredQuad(encoder: encoder, x: 0, y: innerBorderOffset, w: canvasW, h: innerBorderWidth, color: green)
         drawColoredQuad(encoder: encoder, x: 0, y: canvasH - innerBorderOffset - innerBorderWidth, w: canvasW, h: innerBorderWidth, color: green)
 
-        // Draw custom text in center if set
-        let patternText = OutputSettingsWindowController.testPatternText
-        if !patternText.isEmpty {
-            // Update texture if text changed
-            if patternText != lastTestPatternText {
-                testPatternTextTexture = createTextTexture(text: patternText, fontSize: 150)
-                lastTestPatternText = patternText
-            }
-
-            // Draw text texture centered on canvas
-            if let textTexture = testPatternTextTexture {
-                let textW = CGFloat(textTexture.width)
-                let textH = CGFloat(textTexture.height)
-                let textX = (canvasW - textW) / 2
-                let textY = (canvasH - textH) / 2
-                drawTexturedQuad(encoder: encoder, texture: textTexture, x: textX, y: textY, w: textW, h: textH)
-            }
+        // Draw custom text in center if set (texture built on the main thread)
+        if let textTexture = textTexture {
+            let textW = CGFloat(textTexture.width)
+            let textH = CGFloat(textTexture.height)
+            let textX = (canvasW - textW) / 2
+            let textY = (canvasH - textH) / 2
+            drawTexturedQuad(encoder: encoder, texture: textTexture, x: textX, y: textY, w: textW, h: textH)
         }
     }
 
     /// Draw a smooth circle outline using small quads
-    private func drawCircleOutline(encoder: MTLRenderCommandEncoder, cx: CGFloat, cy: CGFloat, radius: CGFloat, thickness: CGFloat, color: SIMD4<Float>) {
+    nonisolated private func drawCircleOutline(encoder: MTLRenderCommandEncoder, cx: CGFloat, cy: CGFloat, radius: CGFloat, thickness: CGFloat, color: SIMD4<Float>) {
         let segments = 120
         for i in 0..<segments {
             let angle1 = CGFloat(i) * (2.0 * CGFloat.pi) / CGFloat(segments)
@@ -2739,6 +2909,7 @@ final class MetalRenderView: MTKView {
 
         guard let texture = device.makeTexture(descriptor: descriptor),
               let data = context.data else { return nil }
+        renderer.noteTextureAllocation()
 
         texture.replace(
             region: MTLRegion(origin: MTLOrigin(x: 0, y: 0, z: 0),
@@ -2752,7 +2923,7 @@ final class MetalRenderView: MTKView {
     }
 
     /// Draw a textured quad for test pattern text
-    private func drawTexturedQuad(encoder: MTLRenderCommandEncoder, texture: MTLTexture, x: CGFloat, y: CGFloat, w: CGFloat, h: CGFloat) {
+    nonisolated private func drawTexturedQuad(encoder: MTLRenderCommandEncoder, texture: MTLTexture, x: CGFloat, y: CGFloat, w: CGFloat, h: CGFloat) {
         guard let pipelineState = renderer.videoPipelineState else { return }
 
         var uniforms = MetalObjectUniforms()
@@ -2777,15 +2948,8 @@ final class MetalRenderView: MTKView {
         uniforms.prismaticColorCount = 0
         uniforms.animationType = 0
 
-        let vertices: [SIMD2<Float>] = [
-            SIMD2<Float>(-1, 1), SIMD2<Float>(0, 0),
-            SIMD2<Float>(1, 1), SIMD2<Float>(1, 0),
-            SIMD2<Float>(-1, -1), SIMD2<Float>(0, 1),
-            SIMD2<Float>(1, -1), SIMD2<Float>(1, 1)
-        ]
-
         encoder.setRenderPipelineState(pipelineState)
-        encoder.setVertexBytes(vertices, length: vertices.count * MemoryLayout<SIMD2<Float>>.stride, index: 0)
+        encoder.setVertexBuffer(renderer.quadVertexBuffer, offset: 0, index: 0)
         encoder.setVertexBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
         encoder.setFragmentBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
         encoder.setFragmentTexture(texture, index: 0)
@@ -2793,150 +2957,263 @@ final class MetalRenderView: MTKView {
         encoder.drawPrimitives(type: .triangleStrip, vertexStart: 0, vertexCount: 4)
     }
 
-    /// Blit offscreen texture to drawable with scaling
-    private func blitToDrawable(commandBuffer: MTLCommandBuffer, drawable: CAMetalDrawable) {
-        guard let offscreen = offscreenTexture else { return }
+    /// Draw the finished canvas texture into the view's drawable. The canvas
+    /// quad covers the whole canvas coordinate space, so the preview maps the
+    /// canvas onto the view exactly like drawing the fixtures there did, at the
+    /// cost of one textured quad instead of a second pass over every fixture.
+    nonisolated private func encodePreview(commandBuffer: MTLCommandBuffer, drawable: CAMetalDrawable, time: CFTimeInterval) {
+        let renderPassDescriptor = MTLRenderPassDescriptor()
+        renderPassDescriptor.colorAttachments[0].texture = drawable.texture
+        renderPassDescriptor.colorAttachments[0].loadAction = .clear
+        renderPassDescriptor.colorAttachments[0].storeAction = .store
+        renderPassDescriptor.colorAttachments[0].clearColor = MTLClearColor(red: 0, green: 0, blue: 0, alpha: 1)
 
-        let blitEncoder = commandBuffer.makeBlitCommandEncoder()!
+        guard let renderEncoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPassDescriptor) else {
+            return
+        }
 
-        // Calculate scaling - fit offscreen into drawable
-        let srcWidth = offscreen.width
-        let srcHeight = offscreen.height
-        let dstWidth = drawable.texture.width
-        let dstHeight = drawable.texture.height
+        var canvasUniforms = MetalCanvasUniforms(
+            canvasSize: SIMD2<Float>(Float(canvasSize.width), Float(canvasSize.height)),
+            time: Float(time),
+            padding: 0
+        )
+        renderEncoder.setVertexBytes(&canvasUniforms, length: MemoryLayout<MetalCanvasUniforms>.stride, index: 2)
 
-        // Scale to fit while maintaining aspect ratio
-        let srcAspect = Float(srcWidth) / Float(srcHeight)
-        let dstAspect = Float(dstWidth) / Float(dstHeight)
+        if let canvas = offscreenTexture {
+            drawTexturedQuad(encoder: renderEncoder, texture: canvas, x: 0, y: 0,
+                             w: CGFloat(canvasSize.width), h: CGFloat(canvasSize.height))
+        }
 
-        var copyWidth: Int
-        var copyHeight: Int
-        var dstX: Int = 0
-        var dstY: Int = 0
+        renderEncoder.endEncoding()
+    }
+}
 
-        if srcAspect > dstAspect {
-            // Source is wider - fit to width
-            copyWidth = dstWidth
-            copyHeight = Int(Float(dstWidth) / srcAspect)
-            dstY = (dstHeight - copyHeight) / 2
-        } else {
-            // Source is taller - fit to height
-            copyHeight = dstHeight
-            copyWidth = Int(Float(dstHeight) * srcAspect)
-            dstX = (dstWidth - copyWidth) / 2
-        }
-
-        // For blit, we need to copy at matching sizes, so we'll just copy what fits
-        // Use the minimum of source and destination dimensions
-        let actualCopyWidth = min(srcWidth, dstWidth)
-        let actualCopyHeight = min(srcHeight, dstHeight)
-
-        blitEncoder.copy(
-            from: offscreen,
-            sourceSlice: 0,
-            sourceLevel: 0,
-            sourceOrigin: MTLOrigin(x: 0, y: 0, z: 0),
-            sourceSize: MTLSize(width: actualCopyWidth, height: actualCopyHeight, depth: 1),
-            to: drawable.texture,
-            destinationSlice: 0,
-            destinationLevel: 0,
-            destinationOrigin: MTLOrigin(x: 0, y: 0, z: 0)
-        )
+/// Video playback state of one video fixture, collected by a frame for the main thread
+struct VideoPlaybackRequest {
+    var slot: Int
+    var state: VideoPlaybackState
+    var gotoPercent: Float?
+    var volume: Float
+}
 
-        blitEncoder.endEncoding()
-    }
+/// Everything a frame needs from main-thread services, published by the main thread
+struct RenderInputs {
+    var outputs: [ManagedOutput] = []
+    var testPattern = false
+    var showBorders = false
+    var testPatternText: MTLTexture?
+    var videoTextures: [Int: MTLTexture] = [:]
 }
 
-extension MetalRenderView: MTKViewDelegate {
-    nonisolated func mtkView(_ view: MTKView, drawableSizeWillChange size: CGSize) {
-        // Handle resize if needed
+extension MetalRenderView {
+    // MARK: - Render Inputs (main thread)
+
+    private func startRenderThread() {
+        guard metalLayer != nil else {
+            print("Metal: View has no CAMetalLayer, render thread not started")
+            return
+        }
+        publishRenderInputs()
+
+        if renderThread == nil {
+            renderThread = RenderThread(name: "com.geodraw.render") { [weak self] in
+                self?.renderFrame()
+            }
+        }
+        renderThread?.start()
+    }
+
+    /// Stop the display link and wait for the frame in progress to finish
+    private func stopRenderThread() {
+        renderThread?.stop()
     }
 
-    nonisolated func draw(in view: MTKView) {
-        // Dispatch to main actor for rendering
-        Task { @MainActor in
-            self.performDraw()
+    /// Ask the main thread for fresh inputs. At most one request is queued, so a
+    /// busy main thread only makes frames reuse older media frames and settings.
+    nonisolated private func requestRenderInputs() {
+        inputsLock.lock()
+        let alreadyRequested = inputsRequested
+        inputsRequested = true
+        inputsLock.unlock()
+        guard !alreadyRequested else { return }
+
+        DispatchQueue.main.async { [self] in
+            publishRenderInputs()
         }
     }
 
-    private func performDraw() {
-        let now = CACurrentMediaTime()
-        let delta = CGFloat(now - lastTimestamp)
-        lastTimestamp = now
+    /// Main-thread half of a frame: drive media slots and snapshot the
+    /// main-actor state the render thread reads
+    private func publishRenderInputs() {
+        inputsLock.lock()
+        inputsRequested = false
+        inputsLock.unlock()
 
-        // Reset per-frame video caches (texture created once, shared across fixtures)
-        VideoSlotManager.shared.beginFrame()
+        // DMX control universe switches recorded by the last tick
+        controller.applyControlFlags()
 
-        // Update scene - use actual canvas size, not view bounds
-        controller.tick(deltaTime: delta, canvasSize: canvasSize)
+        var inputs = RenderInputs()
+        inputs.outputs = OutputManager.shared.getAllOutputs()
+        inputs.testPattern = OutputSettingsWindowController.testPatternActive
+        inputs.showBorders = OutputSettingsWindowController.showBordersActive
 
-        guard let drawable = currentDrawable,
-              let commandBuffer = renderer.commandQueue.makeCommandBuffer() else {
-            return
+        let patternText = OutputSettingsWindowController.testPatternText
+        if patternText != lastTestPatternText {
+            testPatternTextTexture = createTextTexture(text: patternText, fontSize: 150)
+            lastTestPatternText = patternText
         }
+        inputs.testPatternText = testPatternTextTexture
 
-        // If OutputManager has enabled outputs, render to offscreen texture at full canvas resolution
-        let hasEnabledOutputs = !OutputManager.shared.getAllOutputs().filter { $0.config.enabled }.isEmpty
-        let needsOffscreen = hasEnabledOutputs && offscreenTexture != nil
-        if needsOffscreen {
-            renderToOffscreen(commandBuffer: commandBuffer, time: now)
+        // Apply the playback states the last frame collected, then fetch one
+        // texture per media slot that frame used
+        let videoSlots = VideoSlotManager.shared
+        videoSlots.beginFrame()
+        var usedSlots = Set<Int>()
+        for request in collectedPlayback.load() {
+            videoSlots.collectPlaybackState(forSlot: request.slot, state: request.state,
+                                            gotoPercent: request.gotoPercent, volume: request.volume)
+            usedSlots.insert(request.slot)
         }
-
-        // Render to view's drawable for display
-        guard let renderPassDescriptor = currentRenderPassDescriptor else {
-            return
+        videoSlots.applyCollectedStates()
+        for slot in usedSlots {
+            if let texture = videoSlots.getTexture(forSlot: slot) {
+                inputs.videoTextures[slot] = texture
+            }
         }
 
-        // Clear to black
-        renderPassDescriptor.colorAttachments[0].loadAction = .clear
-        renderPassDescriptor.colorAttachments[0].storeAction = .store
-        renderPassDescriptor.colorAttachments[0].clearColor = MTLClearColor(red: 0, green: 0, blue: 0, alpha: 1)
+        renderInputs.store(inputs)
+    }
 
-        guard let renderEncoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPassDescriptor) else {
-            return
-        }
+    // MARK: - Render Thread
 
-        // Set canvas uniforms for display (using full canvas coordinates)
-        var canvasUniforms = MetalCanvasUniforms(
-            canvasSize: SIMD2<Float>(Float(canvasSize.width), Float(canvasSize.height)),
-            time: Float(now),
-            padding: 0
-        )
-        renderEncoder.setVertexBytes(&canvasUniforms, length: MemoryLayout<MetalCanvasUniforms>.stride, index: 2)
+    /// One display-link frame: simulate, render canvas and view, push outputs, present
+    nonisolated private func renderFrame() {
+        let now = CACurrentMediaTime()
+        let inputs = renderInputs.load()
+        requestRenderInputs()
 
-        // Render each object to drawable for display
-        for obj in controller.objects {
-            if obj.prismType != .off && obj.prismFacets > 0 {
-                renderPrismCopies(obj, encoder: renderEncoder)
-            } else {
-                renderObject(obj, encoder: renderEncoder, positionOffset: .zero)
-            }
+        // DMX input once per frame, animation in whole fixed steps
+        let steps = simulationClock.steps(at: now)
+        lastSimulationSteps = steps
+        controller.simulate(steps: steps, step: CGFloat(simulationClock.step),
+                            canvasSize: canvasSize, outputs: inputs.outputs)
+        let objects = controller.objects
+
+        guard let commandBuffer = renderer.commandQueue.makeCommandBuffer() else {
+            return
         }
 
-        renderEncoder.endEncoding()
+        // Frame fence: wait for this frame's uniform buffer, count what the frame allocates
+        renderer.uniformRing.beginFrame(commandBuffer: commandBuffer)
+        let allocationsBefore = renderer.resourceAllocations
+        defer { lastFrameAllocations = renderer.resourceAllocations - allocationsBefore }
+        framePlayback.removeAll(keepingCapacity: true)
+
+        // The scene is drawn once, into the canvas texture; outputs, the live
+        // preview capture and the view all read that
+        renderToOffscreen(commandBuffer: commandBuffer, time: now, objects: objects, inputs: inputs)
 
-        // Apply all collected video playback states (after rendering collected them)
-        VideoSlotManager.shared.applyCollectedStates()
+        // Video playback states go to the main thread with the next input refresh
+        collectedPlayback.store(framePlayback)
 
         // Push frame to OutputManager (display outputs, NDI)
         // This is non-blocking - display uses GPU→GPU path, NDI uses async queue
-        if let offscreen = offscreenTexture {
+        if let offscreen = offscreenTexture, inputs.outputs.contains(where: { $0.config.enabled }) {
             // Use absolute time (Unix epoch) for NDI sync - all outputs get same timecode
             let timestamp = UInt64(Date().timeIntervalSince1970 * 1_000_000_000)
-            OutputManager.shared.pushFrame(texture: offscreen, timestamp: timestamp, frameRate: 60.0)
+            OutputManager.shared.pushFrame(texture: offscreen, timestamp: timestamp, frameRate: 60.0, to: inputs.outputs)
         }
 
-        // NOTE: Legacy NDI capture removed - OutputManager handles all NDI outputs now
-        // This eliminates the synchronous waitUntilCompleted() that was blocking the render loop
+        // View preview: a scaled sample of the canvas, optionally at a reduced rate.
+        // Skipped frames don't take a drawable at all.
+        let rate = MetalRenderView.previewRate
+        let previewDue = rate <= 0 || now - lastPreviewTime >= 1.0 / rate - 0.002  // Half a 240 Hz vsync of slack
+        if previewDue, let drawable = metalLayer?.nextDrawable() {
+            lastPreviewTime = now
+            encodePreview(commandBuffer: commandBuffer, drawable: drawable, time: now)
+            commandBuffer.present(drawable)
+        } else if !previewDue {
+            previewFramesSkipped += 1
+        }
 
-        commandBuffer.present(drawable)
         commandBuffer.commit()
     }
 
-    private func renderObject(_ obj: VisualObject, encoder: MTLRenderCommandEncoder, positionOffset: SIMD2<Float>) {
+    /// Queue every fixture into the draw list and encode the frame as instanced draws
+    nonisolated private func renderObjects(encoder: MTLRenderCommandEncoder, objects: [VisualObject], inputs: RenderInputs) {
+        drawList.reset()
+        frameCulling = CullingStats()
+        for obj in objects {
+            var instance = objectInstance(obj, inputs: inputs)
+            guard let bounds = FixtureBounds(instance.uniforms, pipeline: instance.pipeline) else {
+                frameCulling.invisible += 1
+                continue
+            }
+            instance.uniforms.localBounds = bounds.quad
+            instance.bounds = bounds
+
+            if obj.prismType != .off && obj.prismFacets > 0 {
+                queuePrismCopies(obj, instance: instance)
+            } else {
+                queue(instance, positionOffset: .zero)
+            }
+        }
+        drawList.build(withStateGrouping: MetalRenderView.groupDrawsByState)
+        lastDrawCallCount = Int(drawList.drawCallCount)
+        lastInstanceCount = Int(drawList.instanceCount)
+        lastCulledOffCanvas = frameCulling.offCanvas
+        lastCulledInvisible = frameCulling.invisible
+        lastQuadCoverage = frameCulling.fullArea > 0 ? frameCulling.drawnArea / frameCulling.fullArea : 1
+
+        guard drawList.instanceCount > 0,
+              let instanceData = drawList.instanceData,
+              let quadBuffer = renderer.quadVertexBuffer,
+              let instances = renderer.uniformRing.push(instanceData, length: Int(drawList.instanceBytes)) else {
+            return
+        }
+
+        encoder.setVertexBuffer(quadBuffer, offset: 0, index: 0)
+        drawList.encode(with: encoder, instanceBuffer: instances.buffer, offset: instances.offset,
+                        pipelines: renderer.drawPipelines, sampler: renderer.samplerState)
+    }
+
+    /// Uniforms, pipeline and texture for one fixture quad
+    private struct ObjectInstance {
+        var uniforms: MetalObjectUniforms
+        var pipeline: GDDrawPipeline
+        var texture: MTLTexture?
+        var bounds: FixtureBounds? = nil
+    }
+
+    /// Per-frame culling counters (areas in canvas pixels)
+    private struct CullingStats {
+        var offCanvas = 0
+        var invisible = 0
+        var drawnArea: Float = 0
+        var fullArea: Float = 0
+    }
+
+    nonisolated private func queue(_ instance: ObjectInstance, positionOffset: SIMD2<Float>) {
+        var uniforms = instance.uniforms
+        uniforms.position += positionOffset
+        if let bounds = instance.bounds {
+            guard bounds.intersectsCanvas(at: uniforms.position, width: Float(canvasSize.width), height: Float(canvasSize.height)) else {
+                frameCulling.offCanvas += 1
+                return
+            }
+            let fullArea = 4 * abs(uniforms.scale.x * uniforms.scale.y) * uniforms.baseRadius * uniforms.baseRadius
+            frameCulling.fullArea += fullArea
+            frameCulling.drawnArea += fullArea * bounds.coverage
+        }
+        withUnsafeBytes(of: &uniforms) { bytes in
+            drawList.addInstance(bytes.baseAddress!, pipeline: instance.pipeline, texture: instance.texture)
+        }
+    }
+
+    nonisolated private func objectInstance(_ obj: VisualObject, inputs: RenderInputs) -> ObjectInstance {
         // Set up object uniforms
         var uniforms = MetalObjectUniforms()
-        uniforms.position = SIMD2<Float>(Float(obj.position.x) + positionOffset.x, Float(obj.position.y) + positionOffset.y)
+        uniforms.position = SIMD2<Float>(Float(obj.position.x), Float(obj.position.y))
         uniforms.scale = SIMD2<Float>(Float(obj.scale.width), Float(obj.scale.height))
         // Videos render level by default - shapes and gobos use rotation
         uniforms.rotation = obj.isVideo ? 0.0 : Float(obj.totalRotation)
@@ -3001,33 +3278,21 @@ extension MetalRenderView: MTKViewDelegate {
             uniforms.animPrismaticFill = 0
         }
 
-        // Set vertex buffer
-        encoder.setVertexBuffer(renderer.commandQueue.device.makeBuffer(
-            bytes: [
-                SIMD2<Float>(-1, 1), SIMD2<Float>(0, 0),
-                SIMD2<Float>(1, 1), SIMD2<Float>(1, 0),
-                SIMD2<Float>(-1, -1), SIMD2<Float>(0, 1),
-                SIMD2<Float>(1, -1), SIMD2<Float>(1, 1)
-            ] as [SIMD2<Float>],
-            length: MemoryLayout<SIMD2<Float>>.stride * 8,
-            options: .storageModeShared
-        ), offset: 0, index: 0)
-
         // Choose pipeline based on object type
         if obj.isVideo, let slotIndex = obj.videoSlot {
-            // Collect video playback state - will be applied after all objects processed
-            VideoSlotManager.shared.collectPlaybackState(
-                forSlot: slotIndex,
+            // Collect video playback state - applied on the main thread with the next input refresh
+            framePlayback.append(VideoPlaybackRequest(
+                slot: slotIndex,
                 state: obj.videoPlaybackState,
                 gotoPercent: obj.videoGotoPercent,
                 volume: obj.videoVolume
-            )
+            ))
 
             // Pass mask blend value via goboIndex (shader reads it as blend factor)
             uniforms.goboIndex = Int32(obj.videoMaskBlend * 255.0)
 
             // Use video texture with crossfadable color/mask blend
-            if let videoTexture = VideoSlotManager.shared.getTexture(forSlot: slotIndex) {
+            if let videoTexture = inputs.videoTextures[slotIndex] {
                 // Calculate scale to render at native resolution
                 // baseRadius * 2 = 240 pixels at scale 1.0
                 // To get native pixels: nativeWidth / 240 = required scale
@@ -3039,45 +3304,25 @@ extension MetalRenderView: MTKViewDelegate {
                 uniforms.scale.x = nativeScaleX * Float(obj.scale.width)
                 uniforms.scale.y = nativeScaleY * Float(obj.scale.height)
 
-                // Set uniforms with native-resolution scale
-                encoder.setVertexBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
-                encoder.setFragmentBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
-
-                encoder.setRenderPipelineState(renderer.videoPipelineState!)
-                encoder.setFragmentTexture(videoTexture, index: 0)
-                encoder.setFragmentSamplerState(renderer.samplerState, index: 0)
-            } else {
-                // No video frame available - render as shape (placeholder)
-                encoder.setVertexBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
-                encoder.setFragmentBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
-                encoder.setRenderPipelineState(renderer.shapePipelineState!)
+                return ObjectInstance(uniforms: uniforms, pipeline: .video, texture: videoTexture)
             }
+            // No video frame available - render as shape (placeholder)
+            return ObjectInstance(uniforms: uniforms, pipeline: .shape, texture: nil)
         } else if obj.isGobo, let goboId = obj.goboId {
             // Gobos use 1:1 aspect ratio (square)
-            encoder.setVertexBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
-            encoder.setFragmentBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
-            // Use gobo pipeline
             if let goboTexture = renderer.getGoboTexture(id: goboId) {
-                encoder.setRenderPipelineState(renderer.goboPipelineState!)
-                encoder.setFragmentTexture(goboTexture, index: 0)
-                encoder.setFragmentSamplerState(renderer.samplerState, index: 0)
-            } else {
-                // Fallback to shape rendering
-                encoder.setRenderPipelineState(renderer.shapePipelineState!)
+                return ObjectInstance(uniforms: uniforms, pipeline: .gobo, texture: goboTexture)
             }
-        } else {
-            // Use shape pipeline (shapes use 1:1 aspect)
-            encoder.setVertexBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
-            encoder.setFragmentBytes(&uniforms, length: MemoryLayout<MetalObjectUniforms>.stride, index: 1)
-            encoder.setRenderPipelineState(renderer.shapePipelineState!)
+            // Fallback to shape rendering
+            return ObjectInstance(uniforms: uniforms, pipeline: .shape, texture: nil)
         }
 
-        // Draw quad
-        encoder.drawPrimitives(type: .triangleStrip, vertexStart: 0, vertexCount: 4)
+        // Use shape pipeline (shapes use 1:1 aspect)
+        return ObjectInstance(uniforms: uniforms, pipeline: .shape, texture: nil)
     }
 
-    /// Renders an object multiple times at offset positions to simulate prism beam multiplication
-    private func renderPrismCopies(_ obj: VisualObject, encoder: MTLRenderCommandEncoder) {
+    /// Queues an object multiple times at offset positions to simulate prism beam multiplication
+    nonisolated private func queuePrismCopies(_ obj: VisualObject, instance: ObjectInstance) {
         // Calculate current prism angle
         let prismAngle: Float
         if obj.prismRotationMode == .index {
@@ -3091,13 +3336,13 @@ extension MetalRenderView: MTKViewDelegate {
         if obj.prismType.isAnimation {
             // Animation wheels overlay a texture, just render once for now
             // TODO: Add animation wheel texture overlays
-            renderObject(obj, encoder: encoder, positionOffset: .zero)
+            queue(instance, positionOffset: .zero)
             return
         }
 
         let facetCount = obj.prismFacets
         guard facetCount > 0 else {
-            renderObject(obj, encoder: encoder, positionOffset: .zero)
+            queue(instance, positionOffset: .zero)
             return
         }
 
@@ -3116,7 +3361,7 @@ extension MetalRenderView: MTKViewDelegate {
                 let angle = Float(i) * angleStep + prismAngleRad
                 let offsetX = cos(angle) * spreadRadius
                 let offsetY = sin(angle) * spreadRadius
-                renderObject(obj, encoder: encoder, positionOffset: SIMD2<Float>(offsetX, offsetY))
+                queue(instance, positionOffset: SIMD2<Float>(offsetX, offsetY))
             }
         } else if obj.prismType.isLinear {
             // Linear prism: arrange copies in a row
@@ -3137,11 +3382,11 @@ extension MetalRenderView: MTKViewDelegate {
                 let offsetX = localX * cosA - localY * sinA
                 let offsetY = localX * sinA + localY * cosA
 
-                renderObject(obj, encoder: encoder, positionOffset: SIMD2<Float>(offsetX, offsetY))
+                queue(instance, positionOffset: SIMD2<Float>(offsetX, offsetY))
             }
         } else {
             // Unknown prism type - render once
-            renderObject(obj, encoder: encoder, positionOffset: .zero)
+            queue(instance, positionOffset: .zero)
         }
     }
 }
@@ -3536,47 +3781,77 @@ struct NetworkInterface: Hashable {
 // MARK: - DMX / Art-Net / sACN
 
 final class DMXState: @unchecked Sendable {
-    private let queue = DispatchQueue(label: "dmx.state.queue", qos: .userInteractive)
-    private var universes: [Int: UniverseData] = [:]
-    private(set) var lastPacketTime: Date = .distantPast
-    private(set) var packetCount: Int = 0
+    /// C++ ingest engine - sockets, parsing and preallocated universe buffers
+    let engine = GDDMXEngine()
 
-    struct UniverseData {
-        var values: [UInt8] = Array(repeating: 0, count: maxDMXChannels)
-        var lastUpdated: Date = .distantPast
+    /// Take this frame's copy of every universe - call once per frame before frameValues(for:)
+    func beginFrame() {
+        engine.captureFrame()
     }
 
-    func values(for universe: Int) -> [UInt8] {
-        queue.sync {
-            universes[universe]?.values ?? Array(repeating: 0, count: maxDMXChannels)
-        }
+    /// Borrowed view of a universe in the current frame (zeros if never received).
+    /// No copy or lock; valid until the next beginFrame(), on the thread that called it.
+    func frameValues(for universe: Int) -> UnsafeBufferPointer<UInt8> {
+        UnsafeBufferPointer(start: engine.frameUniverse(universe), count: maxDMXChannels)
     }
 
-    func update(universe: Int, dmx: [UInt8]) {
-        queue.async {
-            var data = self.universes[universe] ?? UniverseData()
-            let count = min(maxDMXChannels, dmx.count)
-            if count > 0 {
-                data.values.replaceSubrange(0..<count, with: dmx[0..<count])
-            }
-            data.lastUpdated = Date()
-            self.universes[universe] = data
-            self.lastPacketTime = Date()
-            self.packetCount += 1
+    /// Whether the universe had received data when the current frame was taken
+    func frameHasData(for universe: Int) -> Bool {
+        engine.frameHasUniverse(universe)
+    }
+
+    /// Whether any of count channels from start (0-based) changed since the previous beginFrame()
+    func frameChanged(for universe: Int, from start: Int, count: Int) -> Bool {
+        engine.frameUniverse(universe, changedFrom: start, count: count)
+    }
+
+    /// Hand the fixture patch to the engine's decode worker; slot i of every decoded frame is entry i
+    @discardableResult
+    func setFixturePatch(modes: [UInt8], universes: [UInt16], addresses: [UInt16]) -> UInt64 {
+        engine.setFixturePatch(withModes: modes, universes: universes, addresses: addresses, count: modes.count)
+    }
+
+    /// Latest decoded fixture frame - borrowed, valid until the next call, on the thread that called it
+    func fixtureFrame() -> GDFixtureFrame {
+        engine.acquireFixtureFrame()
+    }
+
+    func values(for universe: Int) -> [UInt8] {
+        var values = [UInt8](repeating: 0, count: maxDMXChannels)
+        values.withUnsafeMutableBufferPointer { buffer in
+            _ = engine.copyUniverse(universe, into: buffer.baseAddress!)
         }
+        return values
     }
 
     func getStats() -> (lastPacket: Date, count: Int) {
-        queue.sync {
-            (lastPacketTime, packetCount)
-        }
+        (engine.lastPacketTime, Int(engine.packetCount))
     }
 
     /// Check if a universe has received any data
     func hasReceivedData(for universe: Int) -> Bool {
-        queue.sync {
-            universes[universe] != nil
-        }
+        engine.hasReceivedData(forUniverse: universe)
+    }
+
+    // MARK: - Capture / Replay
+
+    /// Record every received Art-Net / sACN datagram to a capture file
+    func startCapture(to url: URL) -> Bool {
+        try? FileManager.default.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true)
+        return engine.startCapture(toPath: url.path)
+    }
+
+    func stopCapture() {
+        engine.stopCapture()
+    }
+
+    /// Feed a capture file through ingest (speed 0 = as fast as possible). Live input pauses until stopReplay().
+    func startReplay(from url: URL, speed: Double, loop: Bool) -> Bool {
+        engine.startReplay(fromPath: url.path, speed: speed, loop: loop)
+    }
+
+    func stopReplay() {
+        engine.stopReplay()
     }
 }
 
@@ -3586,8 +3861,27 @@ final class DMXReceiver {
     private(set) var universeCount: Int
     private(set) var protocolType: DMXProtocol
     private(set) var networkInterface: NetworkInterface
-    private var sources: [DispatchSourceRead] = []
-    private let queue = DispatchQueue(label: "dmx.receiver.queue", qos: .userInteractive)
+
+    /// Universe = Art-Net port-address + offset. 1 (default) numbers Art-Net from 1 like sACN and the patch.
+    static var artNetUniverseOffset: Int {
+        UserDefaults.standard.object(forKey: "artNetUniverseOffset") as? Int ?? 1
+    }
+
+    /// Universe = sACN universe + offset (default 0)
+    static var sacnUniverseOffset: Int {
+        UserDefaults.standard.object(forKey: "sacnUniverseOffset") as? Int ?? 0
+    }
+
+    /// Extra interfaces (by IP) listened on alongside the selected one, e.g. a backup lighting network
+    static var backupInterfaceIPs: [String] {
+        UserDefaults.standard.stringArray(forKey: "dmxBackupInterfaceIPs") ?? []
+    }
+
+    /// Receive threads; sACN multicast groups are split between them. Default: one per 64 universes, up to 4
+    static func receiveThreads(universeCount: Int) -> Int {
+        let configured = UserDefaults.standard.integer(forKey: "dmxReceiveThreads")
+        return configured > 0 ? configured : min(4, max(1, (universeCount + 63) / 64))
+    }
 
     init(state: DMXState, startUniverse: Int, universeCount: Int = 1, protocolType: DMXProtocol = .both, networkInterface: NetworkInterface? = nil) {
         self.state = state
@@ -3599,20 +3893,41 @@ final class DMXReceiver {
     }
 
     func start() {
+        let protocols: GDDMXProtocols
         switch protocolType {
         case .artNet:
-            setupArtNet()
+            protocols = .artNet
         case .sACN:
-            setupSACN()
+            protocols = .SACN
         case .both:
-            setupArtNet()
-            setupSACN()
+            protocols = [.artNet, .SACN]
+        }
+
+        state.engine.artNetUniverseOffset = DMXReceiver.artNetUniverseOffset
+        state.engine.sacnUniverseOffset = DMXReceiver.sacnUniverseOffset
+
+        // Packets are drained in batches on the engine's receive thread and
+        // written straight into universe buffers
+        let backups = networkInterface.isLoopback ? [] : DMXReceiver.backupInterfaceIPs.filter { $0 != networkInterface.ip }
+        let threads = DMXReceiver.receiveThreads(universeCount: universeCount)
+        let started = state.engine.start(
+            with: protocols,
+            interfaceIPs: [networkInterface.ip] + backups,
+            loopback: networkInterface.isLoopback,
+            startUniverse: max(1, startUniverse),
+            universeCount: universeCount,
+            receiveThreads: threads
+        )
+        if started {
+            let extra = backups.isEmpty ? "" : " + \(backups.joined(separator: ", "))"
+            print("DMX listening (\(protocolType.displayName)) for U\(startUniverse)-\(startUniverse + universeCount - 1), interface: \(networkInterface.displayName)\(extra), \(threads) receive thread(s)")
+        } else {
+            print("Failed to start DMX receiver on \(networkInterface.displayName)")
         }
     }
 
     func stop() {
-        sources.forEach { $0.cancel() }
-        sources.removeAll()
+        state.engine.stop()
     }
 
     func restart(startUniverse: Int, universeCount: Int, protocolType: DMXProtocol, networkInterface: NetworkInterface) {
@@ -3623,198 +3938,6 @@ final class DMXReceiver {
         self.networkInterface = networkInterface
         start()
     }
-
-    private func setupArtNet() {
-        guard let fd = bindUDP(port: 6454, joinMulticast: nil) else {
-            print("Failed to bind Art-Net port 6454")
-            return
-        }
-        print("Art-Net listening on port 6454, interface: \(networkInterface.displayName)")
-        listen(fd: fd) { [weak self] data in
-            self?.handleArtNet(data: data)
-        }
-    }
-
-    private func setupSACN() {
-        // sACN uses per-universe multicast groups
-        // For multi-universe, we need to join all relevant multicast groups
-
-        // Calculate first multicast group for binding
-        let firstUniverse = max(1, startUniverse)
-        let hi = UInt8((firstUniverse >> 8) & 0xFF)
-        let lo = UInt8(firstUniverse & 0xFF)
-        let firstMulticast = "239.255.\(hi).\(lo)"
-
-        // For loopback, skip multicast join (unicast only)
-        let joinGroup: String? = networkInterface.isLoopback ? nil : firstMulticast
-
-        guard let fd = bindUDP(port: 5568, joinMulticast: joinGroup) else {
-            print("Failed to bind sACN port 5568")
-            return
-        }
-
-        // Join additional multicast groups for remaining universes
-        if !networkInterface.isLoopback && universeCount > 1 {
-            for offset in 1..<universeCount {
-                let universe = startUniverse + offset
-                let uhi = UInt8((universe >> 8) & 0xFF)
-                let ulo = UInt8(universe & 0xFF)
-                let multicast = "239.255.\(uhi).\(ulo)"
-                joinMulticastGroup(fd: fd, group: multicast)
-            }
-            print("sACN listening on port 5568, multicast groups for U\(startUniverse)-\(startUniverse + universeCount - 1), interface: \(networkInterface.displayName)")
-        } else if networkInterface.isLoopback {
-            print("sACN listening on port 5568 (unicast mode for loopback), interface: \(networkInterface.displayName)")
-        } else {
-            print("sACN listening on port 5568, multicast: \(firstMulticast), interface: \(networkInterface.displayName)")
-        }
-
-        listen(fd: fd) { [weak self] data in
-            self?.handleSACN(data: data)
-        }
-    }
-
-    private func joinMulticastGroup(fd: Int32, group: String) {
-        var mreq = ip_mreq()
-        mreq.imr_multiaddr.s_addr = inet_addr(group)
-
-        // Use specific interface if not loopback
-        if networkInterface.ip != "0.0.0.0" {
-            mreq.imr_interface.s_addr = inet_addr(networkInterface.ip)
-        } else {
-            mreq.imr_interface.s_addr = INADDR_ANY
-        }
-
-        let result = setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, socklen_t(MemoryLayout<ip_mreq>.size))
-        if result < 0 {
-            print("Failed to join multicast group \(group): \(errno)")
-        } else {
-            print("Joined multicast group \(group)")
-        }
-    }
-
-    private func handleArtNet(data: Data) {
-        // Spec: https://art-net.org.uk/
-        guard data.count >= 18 else { return }
-        let magic = "Art-Net\u{0}".utf8.map { $0 }
-        for (idx, byte) in magic.enumerated() where data[idx] != byte { return }
-
-        let opcode = UInt16(data[8]) | (UInt16(data[9]) << 8)
-        let opDmx: UInt16 = 0x5000
-        guard opcode == opDmx else { return }
-
-        let length = Int(data[17]) | (Int(data[16]) << 8)
-        guard length > 0, data.count >= 18 + length else { return }
-        // Universe is little-endian, zero-based in Art-Net. Store also as 1-based for convenience.
-        let artUniverseRaw = Int(UInt16(data[14]) | (UInt16(data[15]) << 8))
-        let artUniverse = artUniverseRaw + 1
-        let payload = Array(data[18..<(18 + length)])
-        state.update(universe: artUniverse, dmx: payload)
-        state.update(universe: artUniverseRaw, dmx: payload) // also store raw
-    }
-
-    private func handleSACN(data: Data) {
-        // Minimal E1.31 DMX data packet parsing
-        guard data.count >= 126 else { return }
-        // ACN Packet Identifier "ASC-E1.17\0\0\0"
-        let acnPID: [UInt8] = [0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00]
-        for i in 0..<acnPID.count where data[i + 4] != acnPID[i] { return }
-
-        // Universe lives in framing layer at bytes 113-114 (0-based)
-        let universeOffset = 113
-        let universe = Int(UInt16(data[universeOffset]) << 8 | UInt16(data[universeOffset + 1]))
-        guard universe > 0 else { return }
-
-        // DMX data starts after DMP header; property value count is at bytes 123-124
-        let propertyCount = Int(UInt16(data[123]) << 8 | UInt16(data[124]))
-        let dmxStart = 125
-        guard propertyCount > 0, dmxStart < data.count else { return }
-        let available = min(propertyCount, data.count - dmxStart)
-        guard available > 1 else { return } // includes start code
-        let payload = Array(data[(dmxStart + 1)..<(dmxStart + available)]) // skip start code
-        state.update(universe: universe, dmx: payload)
-    }
-
-    private func bindUDP(port: UInt16, joinMulticast: String?) -> Int32? {
-        let fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)
-        guard fd >= 0 else {
-            print("Failed to create socket: \(errno)")
-            return nil
-        }
-
-        var yes: Int32 = 1
-        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, socklen_t(MemoryLayout.size(ofValue: yes)))
-        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &yes, socklen_t(MemoryLayout.size(ofValue: yes)))
-
-        // Enable broadcast for Art-Net
-        setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &yes, socklen_t(MemoryLayout.size(ofValue: yes)))
-
-        var addr = sockaddr_in()
-        addr.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
-        addr.sin_family = sa_family_t(AF_INET)
-        addr.sin_port = in_port_t(port).bigEndian
-
-        // For multicast (sACN), always bind to INADDR_ANY - interface is selected via IP_ADD_MEMBERSHIP
-        // For unicast (Art-Net), can bind to specific interface
-        if joinMulticast != nil {
-            // Multicast requires binding to INADDR_ANY
-            addr.sin_addr = in_addr(s_addr: INADDR_ANY.bigEndian)
-        } else if networkInterface.ip == "0.0.0.0" {
-            addr.sin_addr = in_addr(s_addr: INADDR_ANY.bigEndian)
-        } else {
-            addr.sin_addr.s_addr = inet_addr(networkInterface.ip)
-        }
-
-        let bindResult = withUnsafePointer(to: &addr) {
-            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
-                Darwin.bind(fd, $0, socklen_t(MemoryLayout<sockaddr_in>.size))
-            }
-        }
-        if bindResult != 0 {
-            print("Bind failed on port \(port): \(errno) - \(String(cString: strerror(errno)))")
-            close(fd)
-            return nil
-        }
-
-        if let group = joinMulticast {
-            var mreq = ip_mreq()
-            mreq.imr_multiaddr.s_addr = inet_addr(group)
-            // For multicast, bind interface specifically
-            if networkInterface.ip == "0.0.0.0" {
-                mreq.imr_interface.s_addr = INADDR_ANY
-            } else {
-                mreq.imr_interface.s_addr = inet_addr(networkInterface.ip)
-            }
-            let mcastResult = setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, socklen_t(MemoryLayout<ip_mreq>.size))
-            if mcastResult != 0 {
-                print("Multicast join failed for \(group): \(errno) - \(String(cString: strerror(errno)))")
-                // Not fatal; continue without multicast
-            } else {
-                print("Joined multicast group \(group)")
-            }
-        }
-
-        let flags = fcntl(fd, F_GETFL, 0)
-        _ = fcntl(fd, F_SETFL, flags | O_NONBLOCK)
-        return fd
-    }
-
-    private func listen(fd: Int32, handler: @escaping (Data) -> Void) {
-        let source = DispatchSource.makeReadSource(fileDescriptor: fd, queue: queue)
-        source.setEventHandler { [weak self] in
-            guard let _ = self else { return }
-            var buffer = [UInt8](repeating: 0, count: 2048)
-            let len = recv(fd, &buffer, buffer.count, 0)
-            if len > 0 {
-                handler(Data(buffer[0..<len]))
-            }
-        }
-        source.setCancelHandler {
-            close(fd)
-        }
-        sources.append(source)
-        source.resume()
-    }
 }
 
 // MARK: - Rendering models
@@ -5318,6 +5441,7 @@ struct VisualObject {
     var mode: DMXMode = .full  // Per-fixture mode (33ch/23ch/10ch)
     var universe: Int = 1      // Fixed universe for this fixture
     var address: Int = 1       // Fixed start address for this fixture
+    var patchSlot: Int = -1    // Index into the engine's decoded fixture frame (-1 = not patched yet)
     var shapeIndex: Int = 1  // Raw DMX value (0-255)
     var shape: ShapeType = .circle
     var goboId: Int? = nil   // If 51-200, this is a gobo
@@ -5410,14 +5534,32 @@ struct VisualObject {
     }
 }
 
-final class SceneController {
+final class SceneController: @unchecked Sendable {
     private let state: DMXState
     private(set) var startUniverse: Int
     private(set) var universeCount: Int
     private(set) var startAddress: Int
     private(set) var startFixtureId: Int
     var defaultMode: DMXMode  // Default mode for new fixtures
-    private(set) var objects: [VisualObject]
+    private var _objects: [VisualObject]
+
+    // The render thread ticks while the UI edits fixtures, so every entry point
+    // takes the lock. Recursive because the mutators call each other
+    // (addFixture -> getNextAvailableAddress, updateConfig -> updateAddressing).
+    private let lock = NSRecursiveLock()
+
+    // Copy of the fixtures as of the last tick or edit. Readers (UI, web server,
+    // the renderer's encode pass) never wait for a tick in progress.
+    private let published = SnapshotBox<[VisualObject]>([])
+
+    var objects: [VisualObject] {
+        return published.load()
+    }
+
+    // Patch last handed to the engine's fixture decoder, indexed by VisualObject.patchSlot
+    private var decodePatchModes: [UInt8] = []
+    private var decodePatchUniverses: [UInt16] = []
+    private var decodePatchAddresses: [UInt16] = []
 
     // Master DMX Control - Universe 0
     // ═══════════════════════════════════════════════════════════════
@@ -5455,7 +5597,9 @@ final class SceneController {
     // ═══════════════════════════════════════════════════════════════
     // Master Control universe/address are now configurable via UserDefaults
     static var controlUniverse: Int {
-        return UserDefaults.standard.integer(forKey: "masterControlUniverse")
+        // 0 is Art-Net port-address 0, which the receiver stores at the Art-Net offset
+        let universe = UserDefaults.standard.integer(forKey: "masterControlUniverse")
+        return universe == 0 ? DMXReceiver.artNetUniverseOffset : universe
     }
     static var controlAddress: Int {
         let addr = UserDefaults.standard.integer(forKey: "masterControlAddress")
@@ -5508,6 +5652,17 @@ final class SceneController {
 
     private(set) var masterIntensity: CGFloat = 1.0
     private(set) var controlUniverseActive = false
+    private(set) var controlTestPattern = false
+    private(set) var controlShowBorders = false
+
+    // Dirty tracking: fixtures and output patches are only re-applied when their channels changed
+    private var lastAppliedFixtureSequence: UInt64 = 0
+    private var lastAppliedMasterIntensity: CGFloat = 1.0
+    private var lastAppliedCanvasSize: CGSize = .zero
+    private var fixturesNeedFullApply = true
+    private var outputPatchApplied: [UUID: (universe: Int, address: Int)] = [:]
+    private(set) var fixturesAppliedLastTick = 0
+    private(set) var outputPatchesAppliedLastTick = 0
 
     // For backwards compatibility
     var mode: DMXMode { defaultMode }
@@ -5520,7 +5675,7 @@ final class SceneController {
         self.startFixtureId = startFixtureId
         self.universeCount = 1  // Placeholder, will be recalculated
         // Create fixtures with the default mode
-        self.objects = (0..<fixtureCount).map { _ in
+        self._objects = (0..<fixtureCount).map { _ in
             var obj = VisualObject()
             obj.mode = mode
             return obj
@@ -5529,37 +5684,52 @@ final class SceneController {
         updateAddressing(startUniverse: startUniverse, startAddress: startAddress, startFixtureId: startFixtureId)
     }
 
+    /// Publish the fixtures for readers and release the lock (mutators end with this)
+    private func publishAndUnlock() {
+        published.store(_objects)
+        lock.unlock()
+    }
+
     /// Calculate total universes needed based on per-fixture universes
     private func calculateUniverseCount() -> Int {
-        guard !objects.isEmpty else { return 1 }
+        guard !_objects.isEmpty else { return 1 }
         // Find the highest universe used by any fixture
-        let maxUniverse = objects.map { $0.universe }.max() ?? startUniverse
-        let minUniverse = objects.map { $0.universe }.min() ?? startUniverse
+        let maxUniverse = _objects.map { $0.universe }.max() ?? startUniverse
+        let minUniverse = _objects.map { $0.universe }.min() ?? startUniverse
         return maxUniverse - minUniverse + 1
     }
 
     /// Get the universe and address for a specific fixture (0-indexed)
     /// Now just returns the fixture's stored values
     func getFixtureAddress(index: Int) -> (universe: Int, address: Int) {
-        guard index >= 0 && index < objects.count else {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard index >= 0 && index < _objects.count else {
             return (startUniverse, startAddress)
         }
-        return (objects[index].universe, objects[index].address)
+        return (_objects[index].universe, _objects[index].address)
     }
 
     /// Set the mode for a specific fixture
     func setFixtureMode(index: Int, mode: DMXMode) {
-        guard index >= 0 && index < objects.count else { return }
-        objects[index].mode = mode
+        lock.lock()
+        defer { publishAndUnlock() }
+
+        guard index >= 0 && index < _objects.count else { return }
+        _objects[index].mode = mode
         universeCount = calculateUniverseCount()
     }
 
     /// Remove fixtures at specific indices
     func removeFixtures(at indices: IndexSet) {
+        lock.lock()
+        defer { publishAndUnlock() }
+
         // Remove in reverse order to preserve indices
         for index in indices.reversed() {
-            guard index >= 0 && index < objects.count else { continue }
-            objects.remove(at: index)
+            guard index >= 0 && index < _objects.count else { continue }
+            _objects.remove(at: index)
         }
         universeCount = calculateUniverseCount()
     }
@@ -5567,6 +5737,9 @@ final class SceneController {
     /// Add a new fixture at the next available address
     /// Uses universe auto-spanning: if fixture doesn't fit in remaining space, moves to next universe
     func addFixture(mode: DMXMode? = nil, universe: Int? = nil, address: Int? = nil) {
+        lock.lock()
+        defer { publishAndUnlock() }
+
         var obj = VisualObject()
         let fixtureMode = mode ?? defaultMode
         obj.mode = fixtureMode
@@ -5582,7 +5755,7 @@ final class SceneController {
             obj.address = nextAddr
         }
 
-        objects.append(obj)
+        _objects.append(obj)
         universeCount = calculateUniverseCount()
     }
 
@@ -5590,10 +5763,13 @@ final class SceneController {
     /// If forMode is provided, checks if that fixture would fit in the remaining space
     /// Uses universe auto-spanning: if fixture doesn't fit, moves to next universe
     func getNextAvailableAddress(forMode: DMXMode? = nil) -> (universe: Int, address: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+
         var nextUniv: Int
         var nextAddr: Int
 
-        if let lastObj = objects.last {
+        if let lastObj = _objects.last {
             // Calculate address after last fixture
             nextAddr = lastObj.address + lastObj.mode.channelsPerFixture
             nextUniv = lastObj.universe
@@ -5624,6 +5800,9 @@ final class SceneController {
 
     /// Repatch all fixtures sequentially starting from the given universe/address
     func updateAddressing(startUniverse: Int, startAddress: Int, startFixtureId: Int) {
+        lock.lock()
+        defer { publishAndUnlock() }
+
         self.startUniverse = startUniverse
         self.startAddress = startAddress
         self.startFixtureId = startFixtureId
@@ -5632,8 +5811,8 @@ final class SceneController {
         var currentUniverse = startUniverse
         var currentAddress = startAddress
 
-        for i in 0..<objects.count {
-            let channelsNeeded = objects[i].mode.channelsPerFixture
+        for i in 0..<_objects.count {
+            let channelsNeeded = _objects[i].mode.channelsPerFixture
 
             // Check if fixture fits in current universe
             if currentAddress + channelsNeeded - 1 > 512 {
@@ -5642,8 +5821,8 @@ final class SceneController {
                 currentAddress = 1
             }
 
-            objects[i].universe = currentUniverse
-            objects[i].address = currentAddress
+            _objects[i].universe = currentUniverse
+            _objects[i].address = currentAddress
 
             // Move to next address
             currentAddress += channelsNeeded
@@ -5654,53 +5833,71 @@ final class SceneController {
 
     /// Set universe and address for a specific fixture
     func setFixtureAddress(index: Int, universe: Int, address: Int) {
-        guard index >= 0 && index < objects.count else { return }
-        objects[index].universe = universe
-        objects[index].address = address
+        lock.lock()
+        defer { publishAndUnlock() }
+
+        guard index >= 0 && index < _objects.count else { return }
+        _objects[index].universe = universe
+        _objects[index].address = address
         universeCount = calculateUniverseCount()
     }
 
     /// Set position for a specific fixture (for layout editor)
     func setFixturePosition(index: Int, position: CGPoint) {
-        guard index >= 0 && index < objects.count else { return }
-        objects[index].position = position
+        lock.lock()
+        defer { publishAndUnlock() }
+
+        guard index >= 0 && index < _objects.count else { return }
+        _objects[index].position = position
+        fixturesNeedFullApply = true
     }
 
     /// Set scale for a specific fixture (for layout editor)
     func setFixtureScale(index: Int, scale: CGSize) {
-        guard index >= 0 && index < objects.count else { return }
-        objects[index].scale = scale
+        lock.lock()
+        defer { publishAndUnlock() }
+
+        guard index >= 0 && index < _objects.count else { return }
+        _objects[index].scale = scale
+        fixturesNeedFullApply = true
     }
 
     /// Apply positions to all fixtures (for layout editor)
     func applyLayoutPositions(_ positions: [(x: Float, y: Float)]) {
+        lock.lock()
+        defer { publishAndUnlock() }
+
         for (i, pos) in positions.enumerated() {
-            if i < objects.count {
-                objects[i].position = CGPoint(x: CGFloat(pos.x), y: CGFloat(pos.y))
+            if i < _objects.count {
+                _objects[i].position = CGPoint(x: CGFloat(pos.x), y: CGFloat(pos.y))
             }
         }
+        fixturesNeedFullApply = true
     }
 
     func updateConfig(fixtureCount: Int, startUniverse: Int, startAddress: Int, startFixtureId: Int = 1, mode: DMXMode? = nil) {
+        lock.lock()
+        defer { publishAndUnlock() }
+
         if let newMode = mode {
             self.defaultMode = newMode
             // Update all existing fixtures to the new mode
-            for i in 0..<objects.count {
-                objects[i].mode = newMode
+            for i in 0..<_objects.count {
+                _objects[i].mode = newMode
             }
         }
 
-        if fixtureCount != objects.count {
-            if fixtureCount > objects.count {
+        if fixtureCount != _objects.count {
+            if fixtureCount > _objects.count {
                 // Add new fixtures
-                while objects.count < fixtureCount {
+                while _objects.count < fixtureCount {
                     var obj = VisualObject()
                     obj.mode = defaultMode
-                    objects.append(obj)
+                    _objects.append(obj)
                 }
             } else {
                 // Remove fixtures from end
-                objects = Array(objects.prefix(fixtureCount))
+                _objects = Array(_objects.prefix(fixtureCount))
             }
         }
 
@@ -5708,29 +5905,89 @@ final class SceneController {
         updateAddressing(startUniverse: startUniverse, startAddress: startAddress, startFixtureId: startFixtureId)
     }
 
+    /// Variable-step tick (CPU fallback view): apply input, advance by the frame time
     func tick(deltaTime: CGFloat, canvasSize: CGSize) {
+        lock.lock()
+        defer { publishAndUnlock() }
+
+        applyInput(canvasSize: canvasSize, outputs: OutputManager.shared.getAllOutputs())
+        advanceObjects(by: deltaTime)
+        sortObjects()
+    }
+
+    /// Fixed-step tick (render thread): DMX input is applied once per frame, then
+    /// animation advances by `steps` steps of `step` seconds. `outputs` is the
+    /// output list the main thread last published; changes to them are applied
+    /// back on the main thread.
+    func simulate(steps: Int, step: CGFloat, canvasSize: CGSize, outputs: [ManagedOutput]) {
+        lock.lock()
+        defer { publishAndUnlock() }
+
+        applyInput(canvasSize: canvasSize, outputs: outputs)
+        for _ in 0..<steps {
+            advanceObjects(by: step)
+        }
+        sortObjects()
+    }
+
+    /// Copy the control universe's test pattern / borders switches to the output
+    /// settings (main thread; the tick only records them)
+    @MainActor
+    func applyControlFlags() {
+        guard controlUniverseActive else { return }
+        OutputSettingsWindowController.testPatternActive = controlTestPattern
+        OutputSettingsWindowController.showBordersActive = controlShowBorders
+    }
+
+    /// Output patch changes are applied where OutputManager's tables live
+    private func onMain(_ body: @escaping @Sendable () -> Void) {
+        if Thread.isMainThread {
+            body()
+        } else {
+            DispatchQueue.main.async(execute: body)
+        }
+    }
+
+    private func applyInput(canvasSize: CGSize, outputs allOutputs: [ManagedOutput]) {
+        // One consistent copy of all universes for this frame; every read below borrows from it
+        state.beginFrame()
+
         // Process Master Control fixture (3ch) if enabled
         let masterEnabled = SceneController.masterControlEnabled
-        controlUniverseActive = masterEnabled && state.hasReceivedData(for: SceneController.controlUniverse)
+        controlUniverseActive = masterEnabled && state.frameHasData(for: SceneController.controlUniverse)
 
         if controlUniverseActive {
-            let ctrl = state.values(for: SceneController.controlUniverse)
+            let ctrl = state.frameValues(for: SceneController.controlUniverse)
             let addr = SceneController.controlAddress  // Base address offset (0-based)
 
             // Ch 1: Master Intensity
             masterIntensity = CGFloat(ctrl[addr + SceneController.chMasterIntensity]) / 255.0
 
             // Ch 2: Test Pattern (128+ = on)
-            OutputSettingsWindowController.testPatternActive = ctrl[addr + SceneController.chTestPattern] >= 128
+            controlTestPattern = ctrl[addr + SceneController.chTestPattern] >= 128
 
             // Ch 3: Show Borders (128+ = on)
-            OutputSettingsWindowController.showBordersActive = ctrl[addr + SceneController.chShowBorders] >= 128
+            controlShowBorders = ctrl[addr + SceneController.chShowBorders] >= 128
         } else {
             masterIntensity = 1.0  // Full brightness when no master control data
         }
 
         // Process each output's individual DMX patch (27ch per output)
-        let allOutputs = OutputManager.shared.getAllOutputs()
+        // Outputs whose patch channels changed (or that were repatched) this frame
+        func outputPatchChanged(_ output: ManagedOutput) -> Bool {
+            let universe = output.config.dmxUniverse
+            let base = output.config.dmxAddress - 1
+            guard universe > 0, state.frameHasData(for: universe),
+                  base >= 0, base + SceneController.outputChannelCount <= maxDMXChannels else { return false }
+            if let applied = outputPatchApplied[output.id],
+               applied.universe == universe, applied.address == output.config.dmxAddress {
+                return state.frameChanged(for: universe, from: base, count: SceneController.outputChannelCount)
+            }
+            return true
+        }
+        let changedOutputs = Set(allOutputs.filter(outputPatchChanged).map(\.id))
+        outputPatchesAppliedLastTick = 0
+
         for output in allOutputs {
             // Skip outputs without DMX patch (universe 0 = disabled)
             guard output.config.dmxUniverse > 0 else {
@@ -5738,17 +5995,27 @@ final class SceneController {
             }
 
             let universe = output.config.dmxUniverse
-            guard state.hasReceivedData(for: universe) else { continue }
+            guard state.frameHasData(for: universe) else { continue }
 
-            let dmx = state.values(for: universe)
+            let dmx = state.frameValues(for: universe)
             let base = output.config.dmxAddress - 1  // Convert 1-based to 0-based
 
             // Ensure we have enough channels
             guard base >= 0, base + SceneController.outputChannelCount <= dmx.count else { continue }
 
+            // Unchanged patch: nothing to do, unless auto blend has to follow another output that moved
+            if !changedOutputs.contains(output.id) {
+                guard !changedOutputs.isEmpty, dmx[base + SceneController.chOutAutoBlend] >= 128 else { continue }
+            }
+            outputPatchApplied[output.id] = (universe, output.config.dmxAddress)
+            outputPatchesAppliedLastTick += 1
+
             // Ch 1: Output Intensity (default 255 = full)
+            let outputId = output.id
             let outputIntensity = Float(dmx[base + SceneController.chOutIntensity]) / 255.0
-            OutputManager.shared.updateOutputIntensity(id: output.id, intensity: outputIntensity)
+            onMain {
+                OutputManager.shared.updateOutputIntensity(id: outputId, intensity: outputIntensity)
+            }
 
             // Ch 2: Auto Blend Enable (128+ = on) - auto-calculate edge blend from position overlaps
             let autoBlendValue = dmx[base + SceneController.chOutAutoBlend]
@@ -5808,13 +6075,11 @@ final class SceneController {
             if posChanged {
                 NSLog("OUTPUT DMX: %@ pos changed from (%d,%d) to (%d,%d) [raw X=%d Y=%d]",
                       output.name, currentPosX, currentPosY, posX, posY, posXRaw, posYRaw)
-                OutputManager.shared.updatePosition(
-                    id: output.id,
-                    x: posX,
-                    y: posY,
-                    w: currentConfig.positionW ?? 1920,
-                    h: currentConfig.positionH ?? 1080
-                )
+                let w = currentConfig.positionW ?? 1920
+                let h = currentConfig.positionH ?? 1080
+                onMain {
+                    OutputManager.shared.updatePosition(id: outputId, x: posX, y: posY, w: w, h: h)
+                }
             }
 
             // Auto-calculate edge blend when enabled (uses current positions)
@@ -5835,80 +6100,105 @@ final class SceneController {
                     posW: currentW,
                     posH: currentH
                 )
-                OutputManager.shared.updateEdgeBlend(
-                    id: output.id,
-                    left: autoL, right: autoR,
-                    top: autoT, bottom: autoB,
-                    gamma: currentConfig.edgeBlendGamma,
-                    power: currentConfig.edgeBlendPower,
-                    blackLevel: currentConfig.edgeBlendBlackLevel
-                )
+                let gamma = currentConfig.edgeBlendGamma
+                let power = currentConfig.edgeBlendPower
+                let blackLevel = currentConfig.edgeBlendBlackLevel
+                onMain {
+                    OutputManager.shared.updateEdgeBlend(
+                        id: outputId,
+                        left: autoL, right: autoR,
+                        top: autoT, bottom: autoB,
+                        gamma: gamma,
+                        power: power,
+                        blackLevel: blackLevel
+                    )
+                }
             }
 
             // Update edge blend and warp if changed (manual DMX control, only when auto blend is off)
             if !autoBlendEnabled && (edgeChanged || warpChanged) {
-                output.config.warpTopLeftX = warpTLX
-                output.config.warpTopLeftY = warpTLY
-                output.config.warpTopRightX = warpTRX
-                output.config.warpTopRightY = warpTRY
-                output.config.warpBottomLeftX = warpBLX
-                output.config.warpBottomLeftY = warpBLY
-                output.config.warpBottomRightX = warpBRX
-                output.config.warpBottomRightY = warpBRY
-                output.config.warpCurvature = curvature
-
-                OutputManager.shared.updateEdgeBlend(
-                    id: output.id,
-                    left: edgeLeft, right: edgeRight,
-                    top: edgeTop, bottom: edgeBottom,
-                    gamma: currentConfig.edgeBlendGamma,
-                    power: currentConfig.edgeBlendPower,
-                    blackLevel: currentConfig.edgeBlendBlackLevel
-                )
+                let gamma = currentConfig.edgeBlendGamma
+                let power = currentConfig.edgeBlendPower
+                let blackLevel = currentConfig.edgeBlendBlackLevel
+                onMain {
+                    guard let target = OutputManager.shared.getOutput(id: outputId) else { return }
+                    target.config.warpTopLeftX = warpTLX
+                    target.config.warpTopLeftY = warpTLY
+                    target.config.warpTopRightX = warpTRX
+                    target.config.warpTopRightY = warpTRY
+                    target.config.warpBottomLeftX = warpBLX
+                    target.config.warpBottomLeftY = warpBLY
+                    target.config.warpBottomRightX = warpBRX
+                    target.config.warpBottomRightY = warpBRY
+                    target.config.warpCurvature = curvature
+
+                    OutputManager.shared.updateEdgeBlend(
+                        id: outputId,
+                        left: edgeLeft, right: edgeRight,
+                        top: edgeTop, bottom: edgeBottom,
+                        gamma: gamma,
+                        power: power,
+                        blackLevel: blackLevel
+                    )
+                }
             }
         }
 
-        // Cache universe data
-        var universeCache: [Int: [UInt8]] = [:]
+        // Fixtures are decoded by the engine ahead of the tick; repatch when any
+        // fixture was added, removed, readdressed or changed mode
+        if fixturePatchChanged() {
+            repatchFixtures()
+            fixturesNeedFullApply = true
+        }
+        let frame = state.fixtureFrame()
 
-        // Process each fixture with its individual mode and address
-        for i in 0..<objects.count {
-            var obj = objects[i]
-            let (universe, address) = getFixtureAddress(index: i)
-            let base = address - 1  // Convert 1-based to 0-based
+        // Only fixtures decoded since the last applied frame, unless something
+        // every fixture depends on changed
+        if masterIntensity != lastAppliedMasterIntensity || canvasSize != lastAppliedCanvasSize {
+            fixturesNeedFullApply = true
+        }
+        let fullApply = fixturesNeedFullApply
+        let appliedSequence = lastAppliedFixtureSequence
+        fixturesAppliedLastTick = 0
 
-            // Get or cache universe data
-            if universeCache[universe] == nil {
-                universeCache[universe] = state.values(for: universe)
-            }
-            guard let dmx = universeCache[universe] else { continue }
-
-            let chCount = obj.mode.channelsPerFixture
-            guard base >= 0, base + chCount <= dmx.count else { continue }
-
-            // Parse based on fixture's own mode
-            switch obj.mode {
-            case .compact:
-                parseCompactMode(dmx: dmx, base: base, obj: &obj, canvasSize: canvasSize)
-            case .standard:
-                parseStandardMode(dmx: dmx, base: base, obj: &obj, canvasSize: canvasSize)
-            case .full:
-                parseFullMode(dmx: dmx, base: base, obj: &obj, canvasSize: canvasSize)
-            }
+        for i in 0..<_objects.count {
+            var obj = _objects[i]
+            let slot = obj.patchSlot
+
+            // Fixtures that run past the end of their universe keep their last state
+            guard slot >= 0, slot < frame.count,
+                  frame.bytes[GDFixtureByte.valid.rawValue * frame.stride + slot] != 0 else { continue }
 
-            // Apply master intensity to fixture color
-            if masterIntensity < 1.0 {
-                let r = obj.color.redComponent * masterIntensity
-                let g = obj.color.greenComponent * masterIntensity
-                let b = obj.color.blueComponent * masterIntensity
-                obj.color = NSColor(calibratedRed: r, green: g, blue: b, alpha: obj.color.alphaComponent)
+            if fullApply || frame.stamps[slot] > appliedSequence {
+                applyDecodedFixture(frame, slot: slot, obj: &obj, canvasSize: canvasSize)
+
+                // Apply master intensity to fixture color
+                if masterIntensity < 1.0 {
+                    let r = obj.color.redComponent * masterIntensity
+                    let g = obj.color.greenComponent * masterIntensity
+                    let b = obj.color.blueComponent * masterIntensity
+                    obj.color = NSColor(calibratedRed: r, green: g, blue: b, alpha: obj.color.alphaComponent)
+                }
+                fixturesAppliedLastTick += 1
+                _objects[i] = obj
             }
+        }
 
-            obj.advance(deltaTime: deltaTime)
-            objects[i] = obj
+        lastAppliedFixtureSequence = frame.sequence
+        lastAppliedMasterIntensity = masterIntensity
+        lastAppliedCanvasSize = canvasSize
+        fixturesNeedFullApply = false
+    }
+
+    /// Advance spin / prism / prismatic animation of every fixture
+    private func advanceObjects(by deltaTime: CGFloat) {
+        for i in 0..<_objects.count {
+            _objects[i].advance(deltaTime: deltaTime)
         }
+    }
 
-        objects.sort { lhs, rhs in
+    private func sortObjects() {
+        _objects.sort { lhs, rhs in
             if lhs.zIndex == rhs.zIndex {
                 return lhs.position.y < rhs.position.y
             }
@@ -5993,170 +6283,63 @@ final class SceneController {
         return (featherL, featherR, featherT, featherB)
     }
 
-    // MARK: - Mode-Specific Parsing
-
-    /// Compact Mode (10ch): Content, X, Y, Scale, Opacity, R, G, B, Softness, Spin
-    private func parseCompactMode(dmx: [UInt8], base: Int, obj: inout VisualObject, canvasSize: CGSize) {
-        let shapeIndex = Int(dmx[base])     // CH1: Content
-        let xValue = Int(dmx[base + 1])     // CH2: X (8-bit)
-        let yValue = Int(dmx[base + 2])     // CH3: Y (8-bit)
-        let scaleValue = Int(dmx[base + 3]) // CH4: Scale
-        let opacityValue = Int(dmx[base + 4]) // CH5: Opacity
-        let r = CGFloat(dmx[base + 5]) / 255.0  // CH6: Red
-        let g = CGFloat(dmx[base + 6]) / 255.0  // CH7: Green
-        let b = CGFloat(dmx[base + 7]) / 255.0  // CH8: Blue
-        let softnessValue = Int(dmx[base + 8])  // CH9: Softness
-        let spinValue = Int(dmx[base + 9])      // CH10: Spin
+    // MARK: - Fixture Patch
 
-        // Parse shape/gobo/video
-        let (shape, goboId, videoSlot) = parseContentChannel(shapeIndex)
-
-        obj.shapeIndex = shapeIndex
-        obj.shape = shape
-        obj.goboId = goboId
-        obj.videoSlot = videoSlot
-        obj.videoPlaybackState = videoSlot != nil ? .playLoop : .stop
-        obj.videoGotoPercent = nil
-        obj.videoMaskBlend = 0.0
-        obj.videoVolume = 1.0
-
-        // 8-bit position mapping
-        obj.position = CGPoint(
-            x: mapPosition8(value: xValue, max: canvasSize.width),
-            y: mapPosition8(value: yValue, max: canvasSize.height)
-        )
-        obj.zIndex = 0
-
-        // Single 8-bit scale
-        let uniformScale = map8(value: scaleValue, max: 6.0)
-        obj.scale = CGSize(width: uniformScale, height: uniformScale)
-
-        obj.softness = map8(value: softnessValue, max: 40.0)
-        obj.opacity = map8(value: opacityValue, max: 1.0)
-        obj.intensity = 1.0
-        obj.color = NSColor(calibratedRed: r, green: g, blue: b, alpha: 1.0)
-        obj.baseRotation = 0
-        obj.spinSpeed = spinDegreesPerSecond(from: spinValue) * (.pi / 180.0)
+    private func fixturePatchChanged() -> Bool {
+        guard decodePatchModes.count == _objects.count else { return true }
+        for obj in _objects {
+            let slot = obj.patchSlot
+            guard slot >= 0, slot < decodePatchModes.count,
+                  decodePatchModes[slot] == UInt8(obj.mode.rawValue),
+                  decodePatchUniverses[slot] == UInt16(clamping: obj.universe),
+                  decodePatchAddresses[slot] == UInt16(clamping: obj.address) else { return true }
+        }
+        return false
+    }
 
-        // No iris/shutters in compact mode
-        obj.iris = 1.0
-        obj.shutterTopInsertion = 0
-        obj.shutterBottomInsertion = 0
-        obj.shutterLeftInsertion = 0
-        obj.shutterRightInsertion = 0
+    /// Give every fixture a slot in the decoded frame (its current index) and send the patch to the engine
+    private func repatchFixtures() {
+        decodePatchModes = _objects.map { UInt8($0.mode.rawValue) }
+        decodePatchUniverses = _objects.map { UInt16(clamping: $0.universe) }
+        decodePatchAddresses = _objects.map { UInt16(clamping: $0.address) }
+        for i in 0..<_objects.count {
+            _objects[i].patchSlot = i
+        }
+        state.setFixturePatch(modes: decodePatchModes, universes: decodePatchUniverses, addresses: decodePatchAddresses)
     }
 
-    /// Standard Mode (23ch): Full control except iris/shutters
-    private func parseStandardMode(dmx: [UInt8], base: Int, obj: inout VisualObject, canvasSize: CGSize) {
-        let shapeIndex = Int(dmx[base])
+    // MARK: - Mode-Specific Parsing
 
-        // Parse shape/gobo/video
-        let (shape, goboId, videoSlot) = parseContentChannel(shapeIndex)
+    /// Apply one fixture from the engine's decoded frame. Levels, positions and
+    /// angles arrive already mapped (see fixture_decoder.h); channels that pick a
+    /// behaviour (content, playback, prism) are parsed here per mode:
+    /// Compact 10ch, Standard 23ch, Full 37ch (adds iris, shutters and prism).
+    private func applyDecodedFixture(_ frame: GDFixtureFrame, slot: Int, obj: inout VisualObject, canvasSize: CGSize) {
+        let stride = frame.stride
+        func value(_ field: GDFixtureField) -> Float {
+            frame.fields[field.rawValue * stride + slot]
+        }
+        func byte(_ row: GDFixtureByte) -> Int {
+            Int(frame.bytes[row.rawValue * stride + slot])
+        }
 
-        // Video playback state
-        var videoPlaybackState: VideoPlaybackState = .stop
-        var videoGotoPercent: Float? = nil
-        if videoSlot != nil {
-            let playbackValue = dmx[base + 20]
-            let parsed = VideoPlaybackState.from(dmxValue: playbackValue)
-            videoPlaybackState = parsed.state
-            videoGotoPercent = parsed.gotoPercent
-        }
-
-        let xValue = Int(dmx[base + 1]) << 8 | Int(dmx[base + 2])
-        let yValue = Int(dmx[base + 3]) << 8 | Int(dmx[base + 4])
-        let z = Int(dmx[base + 5])
-        let scaleValue = Int(dmx[base + 6]) << 8 | Int(dmx[base + 7])
-        let hScaleValue = Int(dmx[base + 8]) << 8 | Int(dmx[base + 9])
-        let vScaleValue = Int(dmx[base + 10]) << 8 | Int(dmx[base + 11])
-        let softnessValue = Int(dmx[base + 12])
-        let opacityValue = Int(dmx[base + 13])
-        let intensityValue = Int(dmx[base + 14])
-        let r = CGFloat(dmx[base + 15]) / 255.0
-        let g = CGFloat(dmx[base + 16]) / 255.0
-        let b = CGFloat(dmx[base + 17]) / 255.0
-        let rotationValue = Int(dmx[base + 18])
-        let spinValue = Int(dmx[base + 19])
-        let videoModeValue = Int(dmx[base + 21])
-        let volumeValue = Int(dmx[base + 22])
-
-        obj.shapeIndex = shapeIndex
-        obj.shape = shape
-        obj.goboId = goboId
-        obj.videoSlot = videoSlot
-        obj.videoPlaybackState = videoPlaybackState
-        obj.videoGotoPercent = videoGotoPercent
-        obj.videoMaskBlend = Float(videoModeValue) / 255.0
-        obj.videoVolume = Float(volumeValue) / 255.0
-        obj.position = CGPoint(x: mapPosition16(value: xValue, max: canvasSize.width), y: mapPosition16(value: yValue, max: canvasSize.height))
-        obj.zIndex = z
-
-        let uniformScale = map16(value: scaleValue, max: 6.0)
-        let hScale = max(0.1, map16(value: hScaleValue, max: 2.0))
-        let vScale = max(0.1, map16(value: vScaleValue, max: 2.0))
-        obj.scale = CGSize(width: uniformScale * hScale, height: uniformScale * vScale)
-
-        obj.softness = map8(value: softnessValue, max: 40.0)
-        obj.opacity = map8(value: opacityValue, max: 1.0)
-        obj.intensity = map8(value: intensityValue, max: 1.0)
-        let intensity = obj.intensity
-        obj.color = NSColor(calibratedRed: r * intensity, green: g * intensity, blue: b * intensity, alpha: 1.0)
-        obj.baseRotation = (CGFloat(rotationValue) / 255.0) * 2.0 * .pi
-        obj.spinSpeed = spinDegreesPerSecond(from: spinValue) * (.pi / 180.0)
-
-        // No iris/shutters in standard mode
-        obj.iris = 1.0
-        obj.shutterTopInsertion = 0
-        obj.shutterBottomInsertion = 0
-        obj.shutterLeftInsertion = 0
-        obj.shutterRightInsertion = 0
-    }
-
-    /// Full Mode (33ch): All features including iris and shutters
-    private func parseFullMode(dmx: [UInt8], base: Int, obj: inout VisualObject, canvasSize: CGSize) {
-        let shapeIndex = Int(dmx[base])
+        let shapeIndex = byte(.content)
 
         // Parse shape/gobo/video
         let (shape, goboId, videoSlot) = parseContentChannel(shapeIndex)
 
-        // Video playback state
+        // Video playback state (compact has no playback channel - media loops)
         var videoPlaybackState: VideoPlaybackState = .stop
         var videoGotoPercent: Float? = nil
         if videoSlot != nil {
-            let playbackValue = dmx[base + 20]
-            let parsed = VideoPlaybackState.from(dmxValue: playbackValue)
-            videoPlaybackState = parsed.state
-            videoGotoPercent = parsed.gotoPercent
-        }
-
-        let xValue = Int(dmx[base + 1]) << 8 | Int(dmx[base + 2])
-        let yValue = Int(dmx[base + 3]) << 8 | Int(dmx[base + 4])
-        let z = Int(dmx[base + 5])
-        let scaleValue = Int(dmx[base + 6]) << 8 | Int(dmx[base + 7])
-        let hScaleValue = Int(dmx[base + 8]) << 8 | Int(dmx[base + 9])
-        let vScaleValue = Int(dmx[base + 10]) << 8 | Int(dmx[base + 11])
-        let softnessValue = Int(dmx[base + 12])
-        let opacityValue = Int(dmx[base + 13])
-        let intensityValue = Int(dmx[base + 14])
-        let r = CGFloat(dmx[base + 15]) / 255.0
-        let g = CGFloat(dmx[base + 16]) / 255.0
-        let b = CGFloat(dmx[base + 17]) / 255.0
-        let rotationValue = Int(dmx[base + 18])
-        let spinValue = Int(dmx[base + 19])
-        let videoModeValue = Int(dmx[base + 21])
-        let volumeValue = Int(dmx[base + 22])
-
-        // Iris and Framing Shutter channels (CH24-33)
-        let irisValue = Int(dmx[base + 23])
-        let blade1InsValue = Int(dmx[base + 24])
-        let blade1AngValue = Int(dmx[base + 25])
-        let blade2InsValue = Int(dmx[base + 26])
-        let blade2AngValue = Int(dmx[base + 27])
-        let blade3InsValue = Int(dmx[base + 28])
-        let blade3AngValue = Int(dmx[base + 29])
-        let blade4InsValue = Int(dmx[base + 30])
-        let blade4AngValue = Int(dmx[base + 31])
-        let assemblyRotValue = Int(dmx[base + 32])
+            if obj.mode == .compact {
+                videoPlaybackState = .playLoop
+            } else {
+                let parsed = VideoPlaybackState.from(dmxValue: UInt8(byte(.playback)))
+                videoPlaybackState = parsed.state
+                videoGotoPercent = parsed.gotoPercent
+            }
+        }
 
         obj.shapeIndex = shapeIndex
         obj.shape = shape
@@ -6164,54 +6347,45 @@ final class SceneController {
         obj.videoSlot = videoSlot
         obj.videoPlaybackState = videoPlaybackState
         obj.videoGotoPercent = videoGotoPercent
-        obj.videoMaskBlend = Float(videoModeValue) / 255.0
-        obj.videoVolume = Float(volumeValue) / 255.0
-        obj.position = CGPoint(x: mapPosition16(value: xValue, max: canvasSize.width), y: mapPosition16(value: yValue, max: canvasSize.height))
-        obj.zIndex = z
-
-
-        let uniformScale = map16(value: scaleValue, max: 6.0)
-        let hScale = max(0.1, map16(value: hScaleValue, max: 2.0))
-        let vScale = max(0.1, map16(value: vScaleValue, max: 2.0))
-        obj.scale = CGSize(width: uniformScale * hScale, height: uniformScale * vScale)
-
-        obj.softness = map8(value: softnessValue, max: 40.0)
-        obj.opacity = map8(value: opacityValue, max: 1.0)
-        obj.intensity = map8(value: intensityValue, max: 1.0)
-        let intensity = obj.intensity
-        obj.color = NSColor(calibratedRed: r * intensity, green: g * intensity, blue: b * intensity, alpha: 1.0)
-
-        obj.baseRotation = (CGFloat(rotationValue) / 255.0) * 2.0 * .pi
-        obj.spinSpeed = spinDegreesPerSecond(from: spinValue) * (.pi / 180.0)
-
-        // Iris and Framing Shutters
-        obj.iris = Float(irisValue) / 255.0
-        obj.shutterTopInsertion = Float(blade1InsValue) / 255.0
-        obj.shutterTopAngle = ((Float(blade1AngValue) - 128.0) / 127.0) * (Float.pi / 4.0)
-        obj.shutterBottomInsertion = Float(blade2InsValue) / 255.0
-        obj.shutterBottomAngle = ((Float(blade2AngValue) - 128.0) / 127.0) * (Float.pi / 4.0)
-        obj.shutterLeftInsertion = Float(blade3InsValue) / 255.0
-        obj.shutterLeftAngle = ((Float(blade3AngValue) - 128.0) / 127.0) * (Float.pi / 4.0)
-        obj.shutterRightInsertion = Float(blade4InsValue) / 255.0
-        obj.shutterRightAngle = ((Float(blade4AngValue) - 128.0) / 127.0) * (Float.pi / 4.0)
-        obj.shutterRotation = ((Float(assemblyRotValue) - 128.0) / 127.0) * (Float.pi / 4.0)
+        obj.videoMaskBlend = value(.videoMaskBlend)
+        obj.videoVolume = value(.videoVolume)
+        obj.position = CGPoint(x: CGFloat(value(.positionX)) * canvasSize.width, y: CGFloat(value(.positionY)) * canvasSize.height)
+        obj.zIndex = byte(.z)
+        obj.scale = CGSize(width: CGFloat(value(.scaleX)), height: CGFloat(value(.scaleY)))
+
+        obj.softness = CGFloat(value(.softness))
+        obj.opacity = CGFloat(value(.opacity))
+        obj.intensity = CGFloat(value(.intensity))
+        obj.color = NSColor(calibratedRed: CGFloat(value(.red)), green: CGFloat(value(.green)), blue: CGFloat(value(.blue)), alpha: 1.0)
+        obj.baseRotation = CGFloat(value(.rotation))
+        obj.spinSpeed = CGFloat(value(.spin))
+
+        // Iris and shutter insertions (open / retracted outside full mode)
+        obj.iris = value(.iris)
+        obj.shutterTopInsertion = value(.shutterTopInsertion)
+        obj.shutterBottomInsertion = value(.shutterBottomInsertion)
+        obj.shutterLeftInsertion = value(.shutterLeftInsertion)
+        obj.shutterRightInsertion = value(.shutterRightInsertion)
+
+        guard obj.mode == .full else { return }
+
+        obj.shutterTopAngle = value(.shutterTopAngle)
+        obj.shutterBottomAngle = value(.shutterBottomAngle)
+        obj.shutterLeftAngle = value(.shutterLeftAngle)
+        obj.shutterRightAngle = value(.shutterRightAngle)
+        obj.shutterRotation = value(.shutterRotation)
 
         // CH34: Prism Pattern (facet beam multiplication only)
-        let prismPatternValue = Int(dmx[base + 33])
-        parsePrismPattern(prismPatternValue, obj: &obj)
+        parsePrismPattern(byte(.prism), obj: &obj)
 
         // CH35: Animation Wheel
-        let animationValue = Int(dmx[base + 34])
-        parseAnimationWheel(animationValue, obj: &obj)
-
+        parseAnimationWheel(byte(.animation), obj: &obj)
 
         // CH36: Prismatics (dichroic color sets) - also controls fill mode for animations
-        let prismaticsValue = Int(dmx[base + 35])
-        parsePrismatics(prismaticsValue, obj: &obj)
+        parsePrismatics(byte(.prismatics), obj: &obj)
 
         // CH37: Prism/Animation Rotation (0-127=index, 128-191=CCW, 192=stop, 193-255=CW)
-        let prismRotValue = Int(dmx[base + 36])
-        parsePrismRotation(prismRotValue, obj: &obj)
+        parsePrismRotation(byte(.prismRotation), obj: &obj)
     }
 
     /// Parse content channel (CH1) to determine shape, gobo, or video
@@ -6231,35 +6405,6 @@ final class SceneController {
         }
     }
 
-    private func map16(value: Int, max: CGFloat) -> CGFloat {
-        let t = CGFloat(value) / 65535.0
-        return t * max
-    }
-
-    private func map8(value: Int, max: CGFloat) -> CGFloat {
-        let t = CGFloat(value) / 255.0
-        return t * max
-    }
-
-    // Position mapping with 20% overflow on all edges
-    private func mapPosition16(value: Int, max: CGFloat) -> CGFloat {
-        let t = CGFloat(value) / 65535.0
-        return max * (t * 1.4 - 0.2)
-    }
-
-    private func mapPosition8(value: Int, max: CGFloat) -> CGFloat {
-        let t = CGFloat(value) / 255.0
-        return max * (t * 1.4 - 0.2)
-    }
-
-    private func spinDegreesPerSecond(from value: Int) -> CGFloat {
-        if value <= 127 {
-            return -CGFloat(value) / 127.0 * 180.0 // CCW
-        } else {
-            return CGFloat(value - 128) / 127.0 * 180.0 // CW
-        }
-    }
-
     /// Parse CH34: Prism Pattern (beam multiplication)
     /// Ordered by facet count: higher DMX = wider spread
     /// Within each prism range, spread goes from tight (0.2) to wide (2.5)
@@ -6522,6 +6667,7 @@ final class RenderView: NSView {
         let delta = CGFloat(now - lastTimestamp)
         lastTimestamp = now
         controller.tick(deltaTime: delta, canvasSize: canvasSize)
+        controller.applyControlFlags()
         needsDisplay = true
     }
 
@@ -9016,6 +9162,7 @@ final class AppDelegate: NSObject, NSApplicationDelegate, NSMenuItemValidation {
     init(fixtureCount: Int, startUniverse: Int, startAddress: Int = 1, protocolType: DMXProtocol = .both, networkInterface: NetworkInterface? = nil) {
         self.maxObjects = 200  // Max fixtures supported
         self.state = DMXState()
+        sharedDMXState = state
         self.controller = SceneController(fixtureCount: fixtureCount, state: state, startUniverse: startUniverse, startAddress: startAddress)
         let iface = networkInterface ?? NetworkInterface.all().first!
         let universeCount = controller.universeCount
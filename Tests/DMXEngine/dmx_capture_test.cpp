@@ -0,0 +1,203 @@
+// dmx_capture_test.cpp - DMXCaptureWriter / DMXReplayer round trip
+// A looped replay must ingest every pass in full: each pass restarts the
+// senders' sequence numbers 1 ms after the previous pass ended.
+
+#include "dmx_capture.h"
+#include "dmx_packets.h"
+#include "test_support.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+using namespace RocKontrol;
+
+namespace {
+
+constexpr uint64_t kMs = 1000000ull;
+constexpr uint32_t kFrames = 12;          // Short enough that a restart looks late to the merger
+
+std::string tempPath(const char* name) {
+    const char* dir = getenv("TMPDIR");
+    return std::string(dir && *dir ? dir : "/tmp") + "/" + name + "-" + std::to_string(getpid()) + ".rkcap";
+}
+
+// Art-Net universe 0 and sACN universes 1-2 (two sources), ~40 fps
+void writeCapture(const std::string& path) {
+    DMXCaptureWriter writer;
+    CHECK(writer.open(path));
+    DMXPackets::SACNSource a = DMXPackets::SACNSource::withId(1);
+    DMXPackets::SACNSource b = DMXPackets::SACNSource::withId(2, 90);
+    uint8_t slots[kDMXSlots];
+    uint64_t now = 1000 * kMs;
+    for (uint32_t f = 0; f < kFrames; f++, now += 25 * kMs) {
+        for (uint32_t i = 0; i < kDMXSlots; i++) slots[i] = (uint8_t)(f + i);
+        uint8_t seq = (uint8_t)(f + 1);
+        auto art = DMXPackets::artDmx(0, seq, slots, kDMXSlots);
+        writer.record(DMXWire::ArtNet, art.data(), art.size(), now);
+        for (uint16_t u = 1; u <= 2; u++) {
+            auto pa = DMXPackets::sacnData(a, u, seq, slots, kDMXSlots);
+            auto pb = DMXPackets::sacnData(b, u, seq, slots, kDMXSlots);
+            writer.record(DMXWire::SACN, pa.data(), pa.size(), now + kMs);
+            writer.record(DMXWire::SACN, pb.data(), pb.size(), now + kMs);
+        }
+    }
+    CHECK_EQ(writer.packets(), kFrames * 5u);
+    writer.close();
+    CHECK_EQ(writer.writeErrors(), 0u);
+}
+
+void testReplayOnce() {
+    std::string path = tempPath("dmx_capture_once");
+    writeCapture(path);
+
+    UniverseStore store;
+    DMXIngest ingest(store);
+    DMXReplayer replayer(ingest);
+    CHECK(replayer.open(path));
+    CHECK_EQ(replayer.recordCount(), kFrames * 5u);
+    CHECK_EQ(replayer.durationNs(), (kFrames - 1) * 25 * kMs + kMs);
+
+    CHECK(replayer.start(0, false));
+    while (replayer.isRunning()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    CHECK_EQ(replayer.packetsReplayed(), kFrames * 5u);
+    CHECK_EQ(ingest.dmxPackets(), kFrames * 5u);
+
+    uint8_t out[kDMXSlots];
+    store.read(1, out);             // Art-Net 0 + offset 1 and sACN 1 share store universe 1
+    CHECK_EQ(out[0], kFrames - 1);
+    store.read(2, out);
+    CHECK_EQ(out[10], (uint8_t)(kFrames - 1 + 10));
+    replayer.close();
+    unlink(path.c_str());
+}
+
+void testLoopedReplayKeepsEveryPass() {
+    std::string path = tempPath("dmx_capture_loop");
+    writeCapture(path);
+
+    UniverseStore store;
+    DMXIngest ingest(store);
+    DMXReplayer replayer(ingest);
+    CHECK(replayer.open(path));
+    CHECK(replayer.start(0, true));
+    while (replayer.loops() < 5) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    replayer.stop();
+
+    // Nothing dropped as late or duplicate at the pass boundaries
+    CHECK_EQ(ingest.dmxPackets(), replayer.packetsReplayed());
+    CHECK_EQ(ingest.duplicatePackets(), 0u);
+    CHECK_EQ(ingest.sacnMerger().sequenceErrors(), 0u);
+    for (const auto& info : ingest.stats().universes()) CHECK_EQ(info.sequence_gaps, 0u);
+    replayer.close();
+    unlink(path.c_str());
+}
+
+// Two consoles on one Art-Net universe with the same sequence numbers: the
+// capture keeps each datagram's sender, so the replay drops neither
+void testReplayKeepsSenders() {
+    std::string path = tempPath("dmx_capture_senders");
+    {
+        DMXCaptureWriter writer;
+        CHECK(writer.open(path));
+        uint8_t slots[kDMXSlots] = {};
+        for (uint32_t f = 0; f < kFrames; f++) {
+            auto art = DMXPackets::artDmx(0, (uint8_t)(f + 1), slots, kDMXSlots);
+            writer.record(DMXWire::ArtNet, art.data(), art.size(), (f + 1) * 25 * kMs, 0x0A000001);
+            writer.record(DMXWire::ArtNet, art.data(), art.size(), (f + 1) * 25 * kMs, 0x0A000002);
+        }
+        writer.close();
+    }
+
+    UniverseStore store;
+    DMXIngest ingest(store);
+    DMXReplayer replayer(ingest);
+    CHECK(replayer.open(path));
+    CHECK(replayer.start(0, false));
+    while (replayer.isRunning()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    CHECK_EQ(ingest.dmxPackets(), kFrames * 2u);
+    CHECK_EQ(ingest.duplicatePackets(), 0u);
+    replayer.close();
+    unlink(path.c_str());
+}
+
+// A replay as fast as possible stamps packets up to the capture's length
+// ahead of the clock. After resetSenders() live packets must apply at once:
+// no replayed source still winning, no sync domain still holding writes.
+void testLiveAfterFastReplay() {
+    std::string path = tempPath("dmx_capture_fast");
+    {
+        DMXCaptureWriter writer;
+        CHECK(writer.open(path));
+        DMXPackets::SACNSource console = DMXPackets::SACNSource::withId(1, 200);
+        console.sync_address = 9;
+        uint8_t slots[kDMXSlots];
+        for (uint32_t f = 0; f < 400; f++) {        // 10 s at 40 fps
+            uint64_t now = (uint64_t)f * 25 * kMs + 1;
+            memset(slots, 200, sizeof(slots));
+            auto data = DMXPackets::sacnData(console, 1, (uint8_t)(f + 1), slots, kDMXSlots);
+            auto sync = DMXPackets::sacnSync(console, 9, (uint8_t)(f + 1));
+            auto art = DMXPackets::artDmx(1, (uint8_t)(f % 255 + 1), slots, kDMXSlots);
+            auto artSync = DMXPackets::artSync();
+            writer.record(DMXWire::SACN, data.data(), data.size(), now);
+            writer.record(DMXWire::SACN, sync.data(), sync.size(), now);
+            writer.record(DMXWire::ArtNet, art.data(), art.size(), now);
+            writer.record(DMXWire::ArtNet, artSync.data(), artSync.size(), now);
+        }
+    }
+
+    UniverseStore store;
+    DMXIngest ingest(store);
+    DMXReplayer replayer(ingest);
+    CHECK(replayer.open(path));
+    CHECK(replayer.start(0, false));
+    while (replayer.isRunning()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    replayer.close();
+    ingest.resetSenders();
+
+    // Live: a priority 100 sACN console without sync, and Art-Net without ArtSync
+    uint8_t live[kDMXSlots];
+    memset(live, 7, sizeof(live));
+    DMXPackets::SACNSource desk = DMXPackets::SACNSource::withId(2, 100);
+    auto data = DMXPackets::sacnData(desk, 1, 1, live, kDMXSlots);
+    ingest.ingest(DMXWire::SACN, data.data(), data.size(), dmxClockNs());
+    auto art = DMXPackets::artDmx(1, 1, live, kDMXSlots);
+    ingest.ingest(DMXWire::ArtNet, art.data(), art.size(), dmxClockNs());
+
+    uint8_t out[kDMXSlots];
+    store.read(1, out);                         // sACN 1
+    CHECK_EQ(out[0], 7);
+    store.read(2, out);                         // Art-Net 1 + offset 1
+    CHECK_EQ(out[0], 7);
+    CHECK_EQ(ingest.sacnMerger().activeSources(), 1u);
+    unlink(path.c_str());
+}
+
+// A full disk shows up as write errors rather than a short capture file
+void testWriteErrorsCounted() {
+    if (access("/dev/full", W_OK) != 0) {
+        printf("  skipped - no /dev/full\n");
+        return;
+    }
+    DMXCaptureWriter writer;
+    CHECK(writer.open("/dev/full"));        // The header only reaches the buffer
+    uint8_t slots[kDMXSlots] = {};
+    auto art = DMXPackets::artDmx(0, 1, slots, kDMXSlots);
+    for (int i = 0; i < 4000; i++) writer.record(DMXWire::ArtNet, art.data(), art.size(), (uint64_t)(i + 1) * kMs);
+    writer.close();
+    CHECK(writer.writeErrors() > 0u);
+    CHECK(writer.packets() < 4000u);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testReplayOnce);
+    RUN_TEST(testLoopedReplayKeepsEveryPass);
+    RUN_TEST(testReplayKeepsSenders);
+    RUN_TEST(testLiveAfterFastReplay);
+    RUN_TEST(testWriteErrorsCounted);
+    return testResult();
+}
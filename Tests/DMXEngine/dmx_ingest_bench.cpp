@@ -0,0 +1,185 @@
+// dmx_ingest_bench.cpp - DMX packet rate: parse + apply, and the UDP receive loop
+// "ingest" feeds prebuilt datagrams straight into DMXIngest::ingest(). "udp"
+// starts the receive loop on loopback and blasts the same datagrams at it from
+// a generator thread, at batch size 1 (one recv per datagram) and 32
+// (recvmmsg on Linux). The generator keeps at most a socket buffer's worth in
+// flight, so the rate is what the receive loop sustains rather than loss.
+// "shards" runs 1-8 threads calling ingest() on disjoint universe ranges, as
+// the receive shards do, and reports the combined rate: how far the merger,
+// latch and store locks let ingest scale with cores.
+
+#include "dmx_ingest.h"
+#include "bench_support.h"
+#include "dmx_packets.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <cstdio>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace RocKontrol;
+using namespace BenchSupport;
+
+namespace {
+
+constexpr uint16_t kUniverses = 64;             // A grandMA3 worth of output
+constexpr uint64_t kInFlight = 256;             // Datagrams the generator may run ahead
+constexpr size_t kArtNetSequenceOffset = 12;    // ArtDmx Sequence
+constexpr size_t kSACNSequenceOffset = 111;     // E1.31 framing layer Sequence Number
+
+std::vector<std::vector<uint8_t>> buildFrame(DMXWire wire, uint8_t sequence) {
+    std::vector<std::vector<uint8_t>> frame;
+    uint8_t slots[kDMXSlots];
+    DMXPackets::SACNSource source = DMXPackets::SACNSource::withId(1);
+    for (uint16_t u = 0; u < kUniverses; u++) {
+        for (uint32_t i = 0; i < kDMXSlots; i++) slots[i] = (uint8_t)(i + u + sequence);
+        frame.push_back(wire == DMXWire::ArtNet ? DMXPackets::artDmx(u, sequence, slots, kDMXSlots)
+                                                : DMXPackets::sacnData(source, u + 1, sequence, slots, kDMXSlots));
+    }
+    return frame;
+}
+
+// Sequence numbers 1..255 in turn, so neither the Art-Net duplicate check nor
+// the sACN merger drops anything
+std::vector<std::vector<std::vector<uint8_t>>> buildFrames(DMXWire wire) {
+    std::vector<std::vector<std::vector<uint8_t>>> frames;
+    for (int s = 1; s <= 255; s++) frames.push_back(buildFrame(wire, (uint8_t)s));
+    return frames;
+}
+
+void benchIngest(DMXWire wire, uint64_t packets) {
+    UniverseStore store;
+    DMXIngest ingest(store);
+    auto frames = buildFrames(wire);
+
+    uint64_t start = nowNs();
+    uint64_t clock = 1;
+    for (uint64_t n = 0; n < packets; n++) {
+        const auto& p = frames[(n / kUniverses) % frames.size()][n % kUniverses];
+        ingest.ingest(wire, p.data(), p.size(), clock += 1000);
+    }
+    uint64_t elapsed = nowNs() - start;
+    printf("ingest %-7s %8llu packets  %10.0f packets/s  %6.1f ns/packet\n",
+           wire == DMXWire::ArtNet ? "Art-Net" : "sACN", (unsigned long long)ingest.dmxPackets(),
+           packets * 1e9 / elapsed, (double)elapsed / packets);
+}
+
+bool benchUDP(DMXWire wire, uint32_t batchSize, uint64_t packets) {
+    UniverseStore store;
+    DMXIngest ingest(store);
+    DMXIngestConfig config;
+    config.art_net = wire == DMXWire::ArtNet;
+    config.sacn = wire == DMXWire::SACN;
+    config.loopback = true;
+    config.universe_count = kUniverses;
+    config.batch_size = batchSize;
+    ingest.configure(config);
+    if (!ingest.start()) {
+        printf("udp    skipped - cannot bind the %s port\n", wire == DMXWire::ArtNet ? "Art-Net" : "sACN");
+        return false;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sockaddr_in to = {};
+    to.sin_family = AF_INET;
+    to.sin_port = htons(wire == DMXWire::ArtNet ? kArtNetPort : kSACNPort);
+    to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    auto frames = buildFrames(wire);
+
+    uint64_t start = nowNs();
+    uint64_t sent = 0;
+    while (sent < packets) {
+        if (sent >= kInFlight + ingest.packetsReceived()) {
+            std::this_thread::yield();
+            continue;
+        }
+        const auto& p = frames[(sent / kUniverses) % frames.size()][sent % kUniverses];
+        if (sendto(fd, p.data(), p.size(), 0, (const sockaddr*)&to, sizeof(to)) == (ssize_t)p.size()) sent++;
+    }
+
+    // Whatever is still queued, with a deadline in case the kernel dropped some
+    uint64_t deadline = nowNs() + 500000000ull;
+    while (ingest.packetsReceived() < sent && nowNs() < deadline) std::this_thread::yield();
+    uint64_t elapsed = nowNs() - start;
+    uint64_t received = ingest.packetsReceived();
+    uint64_t batches = ingest.receiveBatches();
+    ingest.stop();
+    close(fd);
+
+    printf("udp    %-7s batch=%2u  %8llu packets  %10.0f packets/s  %5.1f per batch  lost %llu\n",
+           wire == DMXWire::ArtNet ? "Art-Net" : "sACN", batchSize, (unsigned long long)received,
+           received * 1e9 / elapsed, batches ? (double)received / batches : 0.0,
+           (unsigned long long)(sent - received));
+    return true;
+}
+
+// Each thread owns kUniverses universes and rewrites the sequence number in
+// place every round, so nothing is dropped as a duplicate
+void benchShards(DMXWire wire, uint32_t threads, uint64_t packets) {
+    UniverseStore store;
+    DMXIngest ingest(store);
+    const size_t sequenceOffset = wire == DMXWire::ArtNet ? kArtNetSequenceOffset : kSACNSequenceOffset;
+    const uint64_t perThread = packets / threads;
+
+    std::vector<std::vector<std::vector<uint8_t>>> shards(threads);
+    uint8_t slots[kDMXSlots] = {};
+    DMXPackets::SACNSource source = DMXPackets::SACNSource::withId(1);
+    for (uint32_t t = 0; t < threads; t++) {
+        for (uint16_t u = 0; u < kUniverses; u++) {
+            uint16_t universe = (uint16_t)(t * kUniverses + u);
+            shards[t].push_back(wire == DMXWire::ArtNet
+                                    ? DMXPackets::artDmx(universe, 1, slots, kDMXSlots)
+                                    : DMXPackets::sacnData(source, universe + 1, 1, slots, kDMXSlots));
+        }
+    }
+
+    std::atomic<uint32_t> ready{0};
+    std::atomic<bool> go{false};
+    auto shard = [&](uint32_t t) {
+        auto& frame = shards[t];
+        ready.fetch_add(1);
+        while (!go.load()) std::this_thread::yield();
+        uint64_t clock = 1;
+        for (uint64_t n = 0; n < perThread; n++) {
+            auto& p = frame[n % kUniverses];
+            p[sequenceOffset] = (uint8_t)(1 + (n / kUniverses) % 255);
+            ingest.ingest(wire, p.data(), p.size(), clock += 1000);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < threads; t++) workers.emplace_back(shard, t);
+    while (ready.load() < threads) std::this_thread::yield();
+    uint64_t start = nowNs();
+    go.store(true);
+    for (auto& worker : workers) worker.join();
+    uint64_t elapsed = nowNs() - start;
+
+    printf("shards %-7s threads=%u  %8llu packets  %10.0f packets/s\n",
+           wire == DMXWire::ArtNet ? "Art-Net" : "sACN", threads, (unsigned long long)ingest.dmxPackets(),
+           perThread * threads * 1e9 / elapsed);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = quickMode(argc, argv);
+    const uint64_t packets = quick ? 20000 : 2000000;
+
+    for (DMXWire wire : {DMXWire::ArtNet, DMXWire::SACN}) {
+        benchIngest(wire, packets);
+    }
+    printf("shards on %u hardware threads\n", std::thread::hardware_concurrency());
+    for (DMXWire wire : {DMXWire::ArtNet, DMXWire::SACN}) {
+        for (uint32_t threads : {1u, 2u, 4u, 8u}) benchShards(wire, threads, packets);
+    }
+    for (DMXWire wire : {DMXWire::ArtNet, DMXWire::SACN}) {
+        for (uint32_t batch : {1u, 32u}) {
+            if (!benchUDP(wire, batch, packets / 4)) break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+// dmx_stats_test.cpp - DMXStats packet and frame accounting
+// Art-Net and sACN feeding the same store universe come in on different
+// receive shards; each wire has its own entry, so the counts stay exact with
+// both threads recording at once.
+
+#include "dmx_stats.h"
+#include "test_support.h"
+#include <thread>
+#include <vector>
+
+using namespace RocKontrol;
+
+namespace {
+
+constexpr uint64_t kMs = 1000000ull;
+
+const DMXUniverseStats* find(const std::vector<DMXUniverseStats>& all, uint16_t universe, DMXWire wire) {
+    for (const auto& info : all) {
+        if (info.universe == universe && info.wire == wire) return &info;
+    }
+    return nullptr;
+}
+
+void testArtNetSequence() {
+    DMXStats stats;
+    CHECK(stats.recordPacket(DMXWire::ArtNet, 1, 254, 1 * kMs));
+    CHECK(!stats.recordPacket(DMXWire::ArtNet, 1, 254, 2 * kMs));   // Read again on a second interface
+    CHECK(stats.recordPacket(DMXWire::ArtNet, 1, 255, 3 * kMs));
+    CHECK(stats.recordPacket(DMXWire::ArtNet, 1, 1, 4 * kMs));      // Wraps to 1
+    CHECK(stats.recordPacket(DMXWire::ArtNet, 1, 3, 5 * kMs));      // Lost 2
+    CHECK(stats.recordPacket(DMXWire::ArtNet, 1, 0, 6 * kMs));      // Sequencing off
+    CHECK(stats.recordPacket(DMXWire::ArtNet, 1, 0, 7 * kMs));
+
+    auto all = stats.universes();
+    const DMXUniverseStats* info = find(all, 1, DMXWire::ArtNet);
+    CHECK(info != nullptr);
+    if (!info) return;
+    CHECK_EQ(info->packets, 6u);
+    CHECK_EQ(info->sequence_gaps, 1u);
+    CHECK(info->interval_ns >= kMs && info->interval_ns < 2 * kMs);     // Duplicate not timed
+    CHECK_EQ(info->last_packet_ns, 7 * kMs);
+}
+
+// Two consoles feeding one Art-Net universe, sequence numbers in step
+void testArtNetSendersKeptApart() {
+    const uint32_t consoleA = 0x0A000001, consoleB = 0x0A000002;
+    DMXStats stats;
+    uint64_t now = 0;
+    for (uint8_t seq = 1; seq <= 10; seq++) {
+        CHECK(stats.recordPacket(DMXWire::ArtNet, 1, seq, now += kMs, consoleA));
+        CHECK(stats.recordPacket(DMXWire::ArtNet, 1, seq, now += kMs, consoleB));
+    }
+    CHECK(!stats.recordPacket(DMXWire::ArtNet, 1, 10, now += kMs, consoleB));
+
+    // More senders than are followed: the oldest is forgotten, not blamed for gaps
+    for (uint32_t console = 3; console <= DMXStats::kMaxSenders + 2; console++) {
+        CHECK(stats.recordPacket(DMXWire::ArtNet, 1, 50, now += kMs, 0x0A000000 + console));
+    }
+    CHECK(stats.recordPacket(DMXWire::ArtNet, 1, 11, now += kMs, consoleA));
+
+    auto all = stats.universes();
+    CHECK_EQ(all.size(), 1u);
+    CHECK_EQ(all[0].packets, 20u + DMXStats::kMaxSenders + 1);
+    CHECK_EQ(all[0].sequence_gaps, 0u);
+}
+
+void testWiresKeptApart() {
+    DMXStats stats;
+    for (uint64_t i = 1; i <= 10; i++) {
+        stats.recordPacket(DMXWire::ArtNet, 5, (uint8_t)i, i * 25 * kMs);
+        stats.recordPacket(DMXWire::SACN, 5, (uint8_t)i, i * 23 * kMs + kMs);
+    }
+    CHECK_EQ(stats.universeCount(), 2u);
+    auto all = stats.universes();
+    const DMXUniverseStats* art = find(all, 5, DMXWire::ArtNet);
+    const DMXUniverseStats* sacn = find(all, 5, DMXWire::SACN);
+    CHECK(art && sacn);
+    if (!art || !sacn) return;
+    CHECK_EQ(art->packets, 10u);
+    CHECK_EQ(sacn->packets, 10u);
+    CHECK_EQ(art->interval_ns, 25 * kMs);       // Steady streams - no cross-talk in the timing
+    CHECK_EQ(sacn->interval_ns, 23 * kMs);
+    CHECK_EQ(art->jitter_ns, 0u);
+    CHECK_EQ(sacn->jitter_ns, 0u);
+
+    stats.reset();
+    CHECK_EQ(stats.universeCount(), 0u);
+    stats.recordPacket(DMXWire::SACN, 5, 1, kMs);
+    all = stats.universes();
+    CHECK_EQ(all.size(), 1u);
+    CHECK(find(all, 5, DMXWire::SACN) != nullptr);
+    CHECK_EQ(all[0].packets, 1u);
+}
+
+// Two shards, one per wire, hammering the same universes
+void testConcurrentWires() {
+    DMXStats stats;
+    const uint32_t packets = 200000;
+    auto shard = [&](DMXWire wire) {
+        uint64_t now = 1;
+        for (uint32_t i = 0; i < packets; i++) {
+            stats.recordPacket(wire, (uint16_t)(1 + i % 4), (uint8_t)(1 + (i / 4) % 255), now += 1000);
+        }
+    };
+    std::thread art(shard, DMXWire::ArtNet);
+    std::thread sacn(shard, DMXWire::SACN);
+    art.join();
+    sacn.join();
+
+    auto all = stats.universes();
+    CHECK_EQ(all.size(), 8u);
+    for (const auto& info : all) {
+        CHECK_EQ(info.packets, packets / 4);
+        CHECK_EQ(info.sequence_gaps, 0u);
+    }
+}
+
+// Unicast sACN for one universe spread over two SO_REUSEPORT shards
+void testConcurrentShardsOneUniverse() {
+    DMXStats stats;
+    const uint32_t packets = 200000;
+    auto shard = [&](uint64_t start) {
+        uint64_t now = start;
+        for (uint32_t i = 0; i < packets; i++) stats.recordPacket(DMXWire::SACN, 7, (uint8_t)i, now += 2000);
+    };
+    std::thread a(shard, 1);
+    std::thread b(shard, 1001);
+    a.join();
+    b.join();
+
+    auto all = stats.universes();
+    CHECK_EQ(all.size(), 1u);
+    CHECK_EQ(all[0].packets, 2 * packets);
+    CHECK(all[0].interval_ns > 0 && all[0].interval_ns <= 2000);
+}
+
+void testFrameLatencyPerWire() {
+    UniverseStore store;
+    UniverseSnapshot snapshot;
+    DMXStats stats;
+    uint8_t slots[kDMXSlots] = {};
+
+    stats.recordPacket(DMXWire::ArtNet, 2, 1, dmxClockNs());
+    stats.recordPacket(DMXWire::SACN, 2, 1, dmxClockNs());
+    store.write(2, slots, kDMXSlots, dmxClockNs());
+    store.snapshot(snapshot);
+    stats.recordFrame(snapshot);                // First snapshot is a full refresh
+
+    slots[0] = 1;
+    store.write(2, slots, kDMXSlots, dmxClockNs());
+    store.snapshot(snapshot);
+    stats.recordFrame(snapshot);
+
+    auto all = stats.universes();
+    CHECK_EQ(all.size(), 2u);
+    for (const auto& info : all) CHECK_EQ(info.frames, 1u);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testArtNetSequence);
+    RUN_TEST(testArtNetSendersKeptApart);
+    RUN_TEST(testWiresKeptApart);
+    RUN_TEST(testConcurrentWires);
+    RUN_TEST(testConcurrentShardsOneUniverse);
+    RUN_TEST(testFrameLatencyPerWire);
+    return testResult();
+}
@@ -0,0 +1,95 @@
+// fixture_decode_bench.cpp - FixtureDecoder::decode for 2,000 fixtures
+// Fixtures cycle through Full / Standard / Compact and are packed into
+// universes back to back. Each frame rewrites the universes, takes a snapshot
+// and decodes; "all" changes every fixture, "10%" every tenth one, "idle"
+// nothing (neighbours sharing a dirty block with a changed fixture are
+// decoded too, so "10%" decodes more than 200). Median and p99 of the decode
+// alone are checked against the 0.5 ms budget; the snapshot is reported
+// beside it.
+
+#include "fixture_decoder.h"
+#include "bench_support.h"
+#include <cstdio>
+#include <vector>
+
+using namespace RocKontrol;
+using namespace BenchSupport;
+
+namespace {
+
+constexpr uint32_t kFixtures = 2000;
+constexpr uint64_t kBudgetNs = 500000;
+
+std::vector<FixturePatch> buildPatch() {
+    std::vector<FixturePatch> patch(kFixtures);
+    uint16_t universe = 1;
+    uint32_t address = 1;
+    for (uint32_t i = 0; i < kFixtures; i++) {
+        FixtureMode mode = (FixtureMode)(i % 3);
+        uint32_t channels = fixtureChannelCount(mode);
+        if (address + channels - 1 > kDMXSlots) {
+            universe++;
+            address = 1;
+        }
+        patch[i] = {mode, universe, (uint16_t)address};
+        address += channels;
+    }
+    return patch;
+}
+
+// stride 0 = leave every fixture as it is
+void writeFrame(UniverseStore& store, std::vector<std::vector<uint8_t>>& universes,
+                const std::vector<FixturePatch>& patch, uint32_t stride, uint32_t frame, uint64_t now) {
+    if (stride == 0) return;
+    for (uint32_t i = 0; i < kFixtures; i += stride) {
+        const FixturePatch& p = patch[i];
+        uint8_t* slots = universes[p.universe].data() + p.address - 1;
+        for (uint32_t c = 0; c < fixtureChannelCount(p.mode); c++) slots[c] = (uint8_t)(c * 7 + i + frame);
+    }
+    for (size_t u = 1; u < universes.size(); u++) store.write((uint16_t)u, universes[u].data(), kDMXSlots, now);
+}
+
+void bench(const char* name, uint32_t stride, int frames) {
+    std::vector<FixturePatch> patch = buildPatch();
+    uint16_t lastUniverse = patch.back().universe;
+    UniverseStore store;
+    std::vector<std::vector<uint8_t>> universes(lastUniverse + 1, std::vector<uint8_t>(kDMXSlots, 0));
+
+    FixtureDecoder decoder;
+    decoder.setPatch(patch.data(), kFixtures);
+    UniverseSnapshot snapshot;
+    writeFrame(store, universes, patch, 1, 0, 1);
+    store.snapshot(snapshot);
+    decoder.decode(snapshot);                   // First pass decodes everything
+
+    std::vector<uint64_t> decodeNs, snapshotNs;
+    uint64_t decoded = 0;
+    for (int f = 1; f <= frames; f++) {
+        writeFrame(store, universes, patch, stride, (uint32_t)f, (uint64_t)f * 1000);
+        uint64_t start = nowNs();
+        store.snapshot(snapshot);
+        uint64_t mid = nowNs();
+        decoded += decoder.decode(snapshot);
+        uint64_t end = nowNs();
+        snapshotNs.push_back(mid - start);
+        decodeNs.push_back(end - mid);
+        doNotOptimize(decoder.frame().fields.data());
+    }
+
+    uint64_t p50 = percentile(decodeNs, 0.5);
+    uint64_t p99 = percentile(decodeNs, 0.99);
+    printf("%-5s %u fixtures in %u universes  %5.0f decoded/frame  decode p50 %6.1f us  p99 %6.1f us  "
+           "snapshot p50 %6.1f us  %s\n",
+           name, kFixtures, (unsigned)lastUniverse, (double)decoded / frames, p50 / 1e3, p99 / 1e3,
+           percentile(snapshotNs, 0.5) / 1e3, p99 <= kBudgetNs ? "within 0.5 ms" : "OVER 0.5 ms");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int frames = quickMode(argc, argv) ? 20 : 2000;
+    bench("all", 1, frames);
+    bench("10%", 10, frames);
+    bench("idle", 0, frames);
+    return 0;
+}
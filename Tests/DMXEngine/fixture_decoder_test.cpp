@@ -0,0 +1,280 @@
+// fixture_decoder_test.cpp - FixtureDecoder against the Swift parsers it replaced
+// swiftDecode() is parseFullMode / parseStandardMode / parseCompactMode from
+// SceneController (before the C++ decoder) in double precision, with positions
+// in canvas units. Every mode is checked field by field on random DMX, then a
+// decoder that only re-decodes dirty fixtures is run against a fresh full
+// decode of the same snapshot over random change sets.
+
+#include "fixture_decoder.h"
+#include "test_support.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace RocKontrol;
+
+namespace {
+
+constexpr double kPi = 3.14159265358979;
+
+struct Expected {
+    double fields[(uint32_t)FixtureField::Count];
+    uint8_t bytes[(uint32_t)FixtureByte::Count];
+};
+
+double map8(int value, double max) { return value / 255.0 * max; }
+double map16(int value, double max) { return value / 65535.0 * max; }
+double mapPosition8(int value) { return value / 255.0 * 1.4 - 0.2; }
+double mapPosition16(int value) { return value / 65535.0 * 1.4 - 0.2; }
+
+double spinRadians(int value) {
+    double degrees = value <= 127 ? -value / 127.0 * 180.0 : (value - 128) / 127.0 * 180.0;
+    return degrees * (kPi / 180.0);
+}
+
+double shutterAngle(int value) { return (value - 128.0) / 127.0 * (kPi / 4.0); }
+
+Expected swiftDecode(FixtureMode mode, const uint8_t* dmx) {
+    Expected e = {};
+    auto set = [&](FixtureField f, double v) { e.fields[(uint32_t)f] = v; };
+    auto byte = [&](FixtureByte b, uint8_t v) { e.bytes[(uint32_t)b] = v; };
+    byte(FixtureByte::Valid, 1);
+    byte(FixtureByte::Content, dmx[0]);
+
+    // No iris / shutters below Full
+    set(FixtureField::Iris, 1.0);
+
+    if (mode == FixtureMode::Compact) {
+        set(FixtureField::PositionX, mapPosition8(dmx[1]));
+        set(FixtureField::PositionY, mapPosition8(dmx[2]));
+        double uniform = map8(dmx[3], 6.0);
+        set(FixtureField::ScaleX, uniform);
+        set(FixtureField::ScaleY, uniform);
+        set(FixtureField::Opacity, map8(dmx[4], 1.0));
+        set(FixtureField::Intensity, 1.0);
+        set(FixtureField::Red, dmx[5] / 255.0);
+        set(FixtureField::Green, dmx[6] / 255.0);
+        set(FixtureField::Blue, dmx[7] / 255.0);
+        set(FixtureField::Softness, map8(dmx[8], 40.0));
+        set(FixtureField::Spin, spinRadians(dmx[9]));
+        set(FixtureField::VideoVolume, 1.0);
+        return e;
+    }
+
+    set(FixtureField::PositionX, mapPosition16(dmx[1] << 8 | dmx[2]));
+    set(FixtureField::PositionY, mapPosition16(dmx[3] << 8 | dmx[4]));
+    byte(FixtureByte::Z, dmx[5]);
+    double uniform = map16(dmx[6] << 8 | dmx[7], 6.0);
+    set(FixtureField::ScaleX, uniform * std::max(0.1, map16(dmx[8] << 8 | dmx[9], 2.0)));
+    set(FixtureField::ScaleY, uniform * std::max(0.1, map16(dmx[10] << 8 | dmx[11], 2.0)));
+    set(FixtureField::Softness, map8(dmx[12], 40.0));
+    set(FixtureField::Opacity, map8(dmx[13], 1.0));
+    double intensity = map8(dmx[14], 1.0);
+    set(FixtureField::Intensity, intensity);
+    set(FixtureField::Red, dmx[15] / 255.0 * intensity);
+    set(FixtureField::Green, dmx[16] / 255.0 * intensity);
+    set(FixtureField::Blue, dmx[17] / 255.0 * intensity);
+    set(FixtureField::Rotation, dmx[18] / 255.0 * 2.0 * kPi);
+    set(FixtureField::Spin, spinRadians(dmx[19]));
+    byte(FixtureByte::Playback, dmx[20]);
+    set(FixtureField::VideoMaskBlend, dmx[21] / 255.0);
+    set(FixtureField::VideoVolume, dmx[22] / 255.0);
+    if (mode == FixtureMode::Standard) return e;
+
+    set(FixtureField::Iris, dmx[23] / 255.0);
+    set(FixtureField::ShutterTopInsertion, dmx[24] / 255.0);
+    set(FixtureField::ShutterTopAngle, shutterAngle(dmx[25]));
+    set(FixtureField::ShutterBottomInsertion, dmx[26] / 255.0);
+    set(FixtureField::ShutterBottomAngle, shutterAngle(dmx[27]));
+    set(FixtureField::ShutterLeftInsertion, dmx[28] / 255.0);
+    set(FixtureField::ShutterLeftAngle, shutterAngle(dmx[29]));
+    set(FixtureField::ShutterRightInsertion, dmx[30] / 255.0);
+    set(FixtureField::ShutterRightAngle, shutterAngle(dmx[31]));
+    set(FixtureField::ShutterRotation, shutterAngle(dmx[32]));
+    byte(FixtureByte::Prism, dmx[33]);
+    byte(FixtureByte::Animation, dmx[34]);
+    byte(FixtureByte::Prismatics, dmx[35]);
+    byte(FixtureByte::PrismRotation, dmx[36]);
+    return e;
+}
+
+// Shutter angles below Full were left untouched by Swift; the decoder reports 0
+bool swiftSetsField(FixtureMode mode, FixtureField f) {
+    if (mode == FixtureMode::Full) return true;
+    switch (f) {
+    case FixtureField::ShutterTopAngle:
+    case FixtureField::ShutterBottomAngle:
+    case FixtureField::ShutterLeftAngle:
+    case FixtureField::ShutterRightAngle:
+    case FixtureField::ShutterRotation:
+        return false;
+    default:
+        return true;
+    }
+}
+
+void checkFixture(const FixtureFrame& frame, uint32_t slot, FixtureMode mode, const uint8_t* dmx) {
+    Expected e = swiftDecode(mode, dmx);
+    for (uint32_t f = 0; f < (uint32_t)FixtureField::Count; f++) {
+        if (!swiftSetsField(mode, (FixtureField)f)) {
+            CHECK_NEAR(frame.field((FixtureField)f)[slot], 0.0, 1e-6);
+            continue;
+        }
+        CHECK_NEAR(frame.field((FixtureField)f)[slot], e.fields[f], 1e-5);
+    }
+    for (uint32_t b = 0; b < (uint32_t)FixtureByte::Count; b++) {
+        CHECK_EQ(frame.byteRow((FixtureByte)b)[slot], e.bytes[b]);
+    }
+}
+
+void testChannelCounts() {
+    CHECK_EQ(fixtureChannelCount(FixtureMode::Full), 37u);
+    CHECK_EQ(fixtureChannelCount(FixtureMode::Standard), 23u);
+    CHECK_EQ(fixtureChannelCount(FixtureMode::Compact), 10u);
+}
+
+// Every mode, fixtures spread across the universe, against random DMX
+void testModesMatchSwift() {
+    std::mt19937 rng(15);
+    const FixtureMode modes[] = {FixtureMode::Full, FixtureMode::Standard, FixtureMode::Compact};
+
+    std::vector<FixturePatch> patch;
+    uint16_t address = 1;
+    for (int i = 0; i < 12; i++) {
+        FixtureMode mode = modes[i % 3];
+        patch.push_back({mode, 7, address});
+        address += (uint16_t)(fixtureChannelCount(mode) + i % 4);
+    }
+
+    FixtureDecoder decoder;
+    decoder.setPatch(patch.data(), (uint32_t)patch.size());
+    UniverseStore store;
+    UniverseSnapshot snapshot;
+    std::vector<uint8_t> dmx(kDMXSlots);
+
+    for (int round = 0; round < 50; round++) {
+        for (auto& v : dmx) v = (uint8_t)rng();
+        // Edges of every range
+        if (round == 0) std::fill(dmx.begin(), dmx.end(), 0);
+        if (round == 1) std::fill(dmx.begin(), dmx.end(), 255);
+        if (round == 2) std::fill(dmx.begin(), dmx.end(), 128);
+
+        store.write(7, dmx.data(), kDMXSlots, (uint64_t)round + 1);
+        store.snapshot(snapshot);
+        decoder.decode(snapshot);
+
+        const FixtureFrame& frame = decoder.frame();
+        CHECK_EQ(frame.count, (uint32_t)patch.size());
+        for (uint32_t i = 0; i < patch.size(); i++) {
+            checkFixture(frame, i, patch[i].mode, dmx.data() + patch[i].address - 1);
+        }
+    }
+}
+
+// A fixture running past slot 512 is flagged, its neighbours still decode
+void testFixturePastUniverseEnd() {
+    FixturePatch patch[] = {
+        {FixtureMode::Full, 1, 470},        // 470 + 37 - 1 = 506: fits
+        {FixtureMode::Standard, 1, 500},    // Ends at 522
+        {FixtureMode::Compact, 1, 503},     // Ends at 512 exactly
+    };
+    FixtureDecoder decoder;
+    decoder.setPatch(patch, 3);
+    UniverseStore store;
+    UniverseSnapshot snapshot;
+    std::vector<uint8_t> dmx(kDMXSlots, 200);
+    store.write(1, dmx.data(), kDMXSlots, 1);
+    store.snapshot(snapshot);
+    CHECK_EQ(decoder.decode(snapshot), 3u);
+
+    const FixtureFrame& frame = decoder.frame();
+    CHECK_EQ(frame.byteRow(FixtureByte::Valid)[0], 1);
+    CHECK_EQ(frame.byteRow(FixtureByte::Valid)[1], 0);
+    CHECK_EQ(frame.byteRow(FixtureByte::Valid)[2], 1);
+    checkFixture(frame, 0, FixtureMode::Full, dmx.data() + 469);
+    checkFixture(frame, 2, FixtureMode::Compact, dmx.data() + 502);
+}
+
+// Partial decode after random changes == decoding everything from scratch
+void testPartialMatchesFullDecode() {
+    std::mt19937 rng(16);
+    const uint16_t kUniverses = 6;
+
+    // Mixed modes packed back to back, a few gaps, some fixtures sharing channels
+    std::vector<FixturePatch> patch;
+    for (uint16_t u = 1; u <= kUniverses; u++) {
+        uint32_t address = 1;
+        for (uint32_t i = 0;; i++) {
+            FixtureMode mode = (FixtureMode)(rng() % 3);
+            uint32_t channels = fixtureChannelCount(mode);
+            if (address + channels - 1 > kDMXSlots) break;
+            patch.push_back({mode, u, (uint16_t)address});
+            address += (i % 5 == 4) ? channels / 2 : channels + rng() % 3;
+        }
+    }
+    const uint32_t n = (uint32_t)patch.size();
+
+    UniverseStore store;
+    std::vector<std::vector<uint8_t>> universes(kUniverses + 1, std::vector<uint8_t>(kDMXSlots));
+    for (uint16_t u = 1; u <= kUniverses; u++) {
+        for (auto& v : universes[u]) v = (uint8_t)rng();
+        store.write(u, universes[u].data(), kDMXSlots, 1);
+    }
+
+    FixtureDecoder partial;
+    partial.setPatch(patch.data(), n);
+    UniverseSnapshot snapshot;
+    store.snapshot(snapshot);
+    CHECK_EQ(partial.decode(snapshot), n);
+
+    for (int round = 0; round < 200; round++) {
+        // Change a random set of fixtures (none, a few, or most of them)
+        uint32_t changes = round % 10 == 0 ? 0 : rng() % (round % 7 == 0 ? n : 8);
+        std::vector<uint64_t> before(partial.frame().stamps.begin(), partial.frame().stamps.begin() + n);
+        std::vector<bool> touched(kUniverses + 1, false);
+        for (uint32_t c = 0; c < changes; c++) {
+            const FixturePatch& p = patch[rng() % n];
+            uint32_t channel = rng() % fixtureChannelCount(p.mode);
+            universes[p.universe][p.address - 1 + channel] = (uint8_t)rng();
+            touched[p.universe] = true;
+        }
+        for (uint16_t u = 1; u <= kUniverses; u++) {
+            if (touched[u]) store.write(u, universes[u].data(), kDMXSlots, (uint64_t)round + 2);
+        }
+
+        store.snapshot(snapshot);
+        uint32_t decoded = partial.decode(snapshot);
+        if (changes == 0) CHECK_EQ(decoded, 0u);
+
+        FixtureDecoder full;
+        full.setPatch(patch.data(), n);
+        CHECK_EQ(full.decode(snapshot), n);
+
+        const FixtureFrame& a = partial.frame();
+        const FixtureFrame& b = full.frame();
+        uint32_t restamped = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            for (uint32_t f = 0; f < (uint32_t)FixtureField::Count; f++) {
+                CHECK_NEAR(a.field((FixtureField)f)[i], b.field((FixtureField)f)[i], 1e-6);
+            }
+            for (uint32_t k = 0; k < (uint32_t)FixtureByte::Count; k++) {
+                CHECK_EQ(a.byteRow((FixtureByte)k)[i], b.byteRow((FixtureByte)k)[i]);
+            }
+            if (a.stamps[i] != before[i]) {
+                CHECK_EQ(a.stamps[i], a.sequence);
+                restamped++;
+            }
+        }
+        CHECK_EQ(restamped, decoded);
+    }
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testChannelCounts);
+    RUN_TEST(testModesMatchSwift);
+    RUN_TEST(testFixturePastUniverseEnd);
+    RUN_TEST(testPartialMatchesFullDecode);
+    return testResult();
+}
@@ -0,0 +1,158 @@
+// sync_latch_test.cpp - SyncLatch staging, timeouts and domain isolation
+
+#include "sync_latch.h"
+#include "test_support.h"
+#include <vector>
+
+using namespace RocKontrol;
+
+namespace {
+
+constexpr uint64_t kMs = 1000000;
+constexpr uint32_t kSACNDomain = 9;
+
+std::vector<uint8_t> fill(uint8_t value) {
+    return std::vector<uint8_t>(kDMXSlots, value);
+}
+
+uint8_t level(const UniverseStore& store, uint16_t universe) {
+    uint8_t slots[kDMXSlots];
+    store.read(universe, slots);
+    return slots[0];
+}
+
+void testArtSyncLatches() {
+    UniverseStore store;
+    SyncLatch latch(store);
+
+    // No ArtSync seen yet: immediate
+    CHECK(latch.write(1, fill(1).data(), kDMXSlots, 1 * kMs, SyncLatch::kArtSyncDomain));
+    CHECK_EQ(level(store, 1), 1);
+    CHECK(!latch.isSynchronizing(SyncLatch::kArtSyncDomain, 1 * kMs));
+
+    latch.sync(SyncLatch::kArtSyncDomain, 2 * kMs);
+    CHECK(latch.isSynchronizing(SyncLatch::kArtSyncDomain, 3 * kMs));
+    latch.write(1, fill(5).data(), kDMXSlots, 3 * kMs, SyncLatch::kArtSyncDomain);
+    latch.write(2, fill(6).data(), kDMXSlots, 4 * kMs, SyncLatch::kArtSyncDomain);
+    latch.write(1, fill(7).data(), kDMXSlots, 5 * kMs, SyncLatch::kArtSyncDomain);   // Replaces the staged 5
+    CHECK_EQ(level(store, 1), 1);
+    CHECK(!store.hasData(2));
+
+    latch.sync(SyncLatch::kArtSyncDomain, 6 * kMs);
+    CHECK_EQ(level(store, 1), 7);
+    CHECK_EQ(level(store, 2), 6);
+    CHECK_EQ(latch.latchedFrames(), 1u);
+    CHECK_EQ(latch.latchedUniverses(), 2u);
+    CHECK_EQ(latch.unsyncedWrites(), 1u);
+
+    // A sync with nothing staged publishes nothing
+    latch.sync(SyncLatch::kArtSyncDomain, 7 * kMs);
+    CHECK_EQ(latch.latchedFrames(), 1u);
+}
+
+void testFallbackAfterTimeout() {
+    UniverseStore store;
+    SyncLatch latch(store);
+    const uint64_t synced = 10 * kMs;
+    const uint64_t lost = synced + SyncLatch::kArtSyncTimeoutNs + 1;
+
+    latch.sync(SyncLatch::kArtSyncDomain, synced);
+    latch.write(1, fill(3).data(), kDMXSlots, synced + kMs, SyncLatch::kArtSyncDomain);
+    CHECK(!store.hasData(1));
+
+    // Writes past the timeout go straight through, even before expire() runs
+    CHECK(!latch.isSynchronizing(SyncLatch::kArtSyncDomain, lost));
+    latch.write(2, fill(4).data(), kDMXSlots, lost, SyncLatch::kArtSyncDomain);
+    CHECK_EQ(level(store, 2), 4);
+
+    // expire() shows what was still staged and drops the domain
+    latch.expire(synced + SyncLatch::kArtSyncTimeoutNs);
+    CHECK_EQ(latch.syncTimeouts(), 0u);
+    CHECK(!store.hasData(1));
+    latch.expire(lost);
+    CHECK_EQ(latch.syncTimeouts(), 1u);
+    CHECK_EQ(level(store, 1), 3);
+    CHECK_EQ(latch.latchedFrames(), 1u);
+
+    latch.write(1, fill(8).data(), kDMXSlots, lost + kMs, SyncLatch::kArtSyncDomain);
+    CHECK_EQ(level(store, 1), 8);
+    CHECK_EQ(latch.unsyncedWrites(), 2u);
+}
+
+void testDomainsIsolated() {
+    UniverseStore store;
+    SyncLatch latch(store);
+
+    latch.sync(SyncLatch::kArtSyncDomain, 1 * kMs);
+    latch.sync(kSACNDomain, 1 * kMs);
+    latch.write(1, fill(1).data(), kDMXSlots, 2 * kMs, SyncLatch::kArtSyncDomain);
+    latch.write(2, fill(2).data(), kDMXSlots, 2 * kMs, kSACNDomain);
+    latch.write(3, fill(3).data(), kDMXSlots, 2 * kMs, SyncLatch::kNoSync);
+    latch.write(4, fill(4).data(), kDMXSlots, 2 * kMs, kSACNDomain + 1);     // Never synced
+    CHECK(!store.hasData(1));
+    CHECK(!store.hasData(2));
+    CHECK_EQ(level(store, 3), 3);
+    CHECK_EQ(level(store, 4), 4);
+
+    latch.sync(kSACNDomain, 3 * kMs);
+    CHECK(!store.hasData(1));
+    CHECK_EQ(level(store, 2), 2);
+
+    latch.sync(SyncLatch::kArtSyncDomain, 3 * kMs);
+    CHECK_EQ(level(store, 1), 1);
+    CHECK_EQ(latch.latchedFrames(), 2u);
+    CHECK_EQ(latch.latchedUniverses(), 2u);
+    CHECK_EQ(latch.unsyncedWrites(), 2u);
+
+    // A universe leaving its domain drops what was staged for it
+    latch.write(2, fill(5).data(), kDMXSlots, 4 * kMs, kSACNDomain);
+    latch.write(2, fill(6).data(), kDMXSlots, 5 * kMs, SyncLatch::kNoSync);
+    latch.sync(kSACNDomain, 6 * kMs);
+    CHECK_EQ(level(store, 2), 6);
+    CHECK_EQ(latch.latchedFrames(), 2u);
+}
+
+// reset() publishes what was staged and puts every domain back to immediate mode
+void testReset() {
+    UniverseStore store;
+    SyncLatch latch(store);
+
+    latch.sync(kSACNDomain, 1 * kMs);
+    latch.write(1, fill(9).data(), kDMXSlots, 2 * kMs, kSACNDomain);
+    latch.reset();
+    CHECK_EQ(level(store, 1), 9);
+    CHECK(!latch.isSynchronizing(kSACNDomain, 2 * kMs));
+    CHECK_EQ(latch.syncTimeouts(), 0u);
+
+    latch.write(1, fill(10).data(), kDMXSlots, 3 * kMs, kSACNDomain);
+    CHECK_EQ(level(store, 1), 10);
+}
+
+void testStoreFull() {
+    UniverseStore store;
+    SyncLatch latch(store);
+    std::vector<uint8_t> slots = fill(1);
+
+    for (uint32_t u = 0; u < UniverseStore::kMaxUniverses; u++) {
+        CHECK(latch.write((uint16_t)u, slots.data(), kDMXSlots, 1, SyncLatch::kNoSync));
+    }
+    CHECK(!latch.write(60000, slots.data(), kDMXSlots, 1, SyncLatch::kNoSync));
+    CHECK_EQ(latch.storeFull(), 1u);
+
+    // Staged universes that no longer fit are counted when their sync publishes them
+    latch.sync(kSACNDomain, 1 * kMs);
+    CHECK(latch.write(60001, slots.data(), kDMXSlots, 2 * kMs, kSACNDomain));
+    latch.sync(kSACNDomain, 3 * kMs);
+    CHECK_EQ(latch.storeFull(), 2u);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testArtSyncLatches);
+    RUN_TEST(testFallbackAfterTimeout);
+    RUN_TEST(testDomainsIsolated);
+    RUN_TEST(testReset);
+    RUN_TEST(testStoreFull);
+    return testResult();
+}
@@ -0,0 +1,130 @@
+// universe_store_test.cpp - UniverseStore / UniverseSnapshot lookups and change tracking
+
+#include "universe_store.h"
+#include "test_support.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace RocKontrol;
+
+namespace {
+
+std::vector<uint8_t> fill(uint8_t value) {
+    return std::vector<uint8_t>(kDMXSlots, value);
+}
+
+void testSnapshotCopiesUniverses() {
+    UniverseStore store;
+    UniverseSnapshot snapshot;
+    store.write(10, fill(1).data(), kDMXSlots, 100);
+    store.write(3, fill(2).data(), 8, 200);
+    store.snapshot(snapshot);
+
+    CHECK(snapshot.fullRefresh());
+    CHECK(snapshot.hasData(10));
+    CHECK(snapshot.hasData(3));
+    CHECK(!snapshot.hasData(4));
+    CHECK_EQ(snapshot.universe(10)[511], 1);
+    CHECK_EQ(snapshot.universe(3)[7], 2);
+    CHECK_EQ(snapshot.universe(4)[0], 0);
+    CHECK_EQ(snapshot.updatedNs(3), 200u);
+
+    // Claimed after the snapshot: not part of this frame
+    store.write(4, fill(3).data(), kDMXSlots, 300);
+    CHECK(!snapshot.hasData(4));
+    CHECK_EQ(snapshot.universe(4)[0], 0);
+}
+
+void testChangedBlocks() {
+    UniverseStore store;
+    UniverseSnapshot snapshot;
+    std::vector<uint8_t> slots = fill(0);
+    store.write(1, slots.data(), kDMXSlots, 1);
+    store.snapshot(snapshot);
+    CHECK(snapshot.changed(1, 0, 1));           // Full refresh
+
+    slots[100] = 9;
+    store.write(1, slots.data(), kDMXSlots, 2);
+    store.snapshot(snapshot);
+    CHECK(!snapshot.fullRefresh());
+    CHECK(snapshot.changed(1, 96, 8));
+    CHECK(snapshot.changed(1, 0, 512));
+    CHECK(!snapshot.changed(1, 0, 96));
+    CHECK(!snapshot.changed(1, 104, 400));
+    CHECK_EQ(snapshot.changedUniverses(), 1u);
+
+    store.snapshot(snapshot);
+    CHECK(!snapshot.changed(1, 0, 512));
+    CHECK_EQ(snapshot.changedUniverses(), 0u);
+}
+
+// clear() hands slots to whichever universes arrive next; a snapshot taken
+// before it must keep answering for the universes it copied
+void testSnapshotSurvivesClear() {
+    UniverseStore store;
+    UniverseSnapshot before;
+    store.write(1, fill(11).data(), kDMXSlots, 1);
+    store.write(2, fill(22).data(), kDMXSlots, 1);
+    store.snapshot(before);
+
+    store.clear();
+    store.write(2, fill(33).data(), kDMXSlots, 2);     // Reuses slot 1 (universe 1's)
+    store.write(7, fill(77).data(), kDMXSlots, 2);     // Reuses slot 2 (universe 2's)
+
+    CHECK_EQ(before.universe(1)[0], 11);
+    CHECK_EQ(before.universe(2)[0], 22);
+    CHECK(!before.hasData(7));
+    CHECK_EQ(before.universe(7)[0], 0);
+
+    // The next snapshot into the same object starts over
+    store.snapshot(before);
+    CHECK(before.fullRefresh());
+    CHECK(!before.hasData(1));
+    CHECK_EQ(before.universe(1)[0], 0);
+    CHECK_EQ(before.universe(2)[0], 33);
+    CHECK_EQ(before.universe(7)[0], 77);
+    CHECK_EQ(before.slotCount(), 2u);
+    CHECK_EQ(before.slotUniverse(0), 2);
+    CHECK_EQ(before.slotUniverse(1), 7);
+}
+
+// Two receive shards seeing the first packet of the same universes at once
+// (Art-Net and sACN mapped to one store universe) must share one slot each
+void testConcurrentClaims() {
+    const uint16_t universes = 1000;
+    for (int round = 0; round < 50; round++) {
+        UniverseStore store;
+        std::atomic<int> ready{0};
+        auto shard = [&](uint8_t value) {
+            std::vector<uint8_t> slots = fill(value);
+            ready.fetch_add(1);
+            while (ready.load() < 2) {}
+            for (uint16_t u = 1; u <= universes; u++) store.write(u, slots.data(), kDMXSlots, 1);
+        };
+        std::thread a(shard, 1);
+        std::thread b(shard, 2);
+        a.join();
+        b.join();
+
+        CHECK_EQ(store.universeCount(), (uint32_t)universes);
+        UniverseSnapshot snapshot;
+        store.snapshot(snapshot);
+        CHECK_EQ(snapshot.slotCount(), (uint32_t)universes);
+        uint8_t out[kDMXSlots];
+        for (uint16_t u = 1; u <= universes; u++) {
+            store.read(u, out);
+            CHECK_EQ(snapshot.universe(u)[0], out[0]);     // The slot the store reads, not an orphan
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testSnapshotCopiesUniverses);
+    RUN_TEST(testChangedBlocks);
+    RUN_TEST(testSnapshotSurvivesClear);
+    RUN_TEST(testConcurrentClaims);
+    return testResult();
+}
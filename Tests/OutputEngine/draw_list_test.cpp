@@ -0,0 +1,189 @@
+// draw_list_test.cpp - DrawList batching and instance packing
+// Each instance block carries its queue index, so the packed buffer shows
+// exactly which quad landed where.
+
+#include "draw_list.h"
+#include "test_support.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace RocKontrol;
+
+namespace {
+
+struct Instance {
+    uint32_t index;
+    float payload[7];
+};
+
+struct Quad {
+    uint32_t pipeline;
+    uint32_t texture;
+};
+
+void queue(DrawList& list, const std::vector<Quad>& quads) {
+    for (uint32_t i = 0; i < quads.size(); i++) {
+        Instance inst = {};
+        inst.index = i;
+        inst.payload[0] = (float)i * 0.5f;
+        list.add(quads[i].pipeline, quads[i].texture, &inst);
+    }
+}
+
+// Queue index of the n-th packed instance
+uint32_t packedIndex(const DrawList& list, uint32_t n) {
+    Instance inst;
+    memcpy(&inst, list.instanceData() + (size_t)n * list.instanceStride(), sizeof(inst));
+    CHECK_EQ(inst.payload[0], (float)inst.index * 0.5f);
+    return inst.index;
+}
+
+// Batches cover [0, count) back to back and each matches its instances' state
+void checkBatches(const DrawList& list, const std::vector<Quad>& quads) {
+    uint32_t next = 0;
+    for (const DrawBatch& b : list.batches()) {
+        CHECK_EQ(b.first_instance, next);
+        CHECK(b.instance_count > 0);
+        for (uint32_t i = b.first_instance; i < b.first_instance + b.instance_count; i++) {
+            const Quad& q = quads[packedIndex(list, i)];
+            CHECK_EQ(q.pipeline, b.pipeline);
+            CHECK_EQ(q.texture, b.texture);
+        }
+        next += b.instance_count;
+    }
+    CHECK_EQ(next, list.instanceCount());
+    CHECK_EQ(list.instanceBytes(), (size_t)list.instanceCount() * sizeof(Instance));
+}
+
+void testSubmissionMergesNeighbours() {
+    std::vector<Quad> quads = {{1, 0}, {1, 0}, {1, 5}, {2, 5}, {2, 5}, {1, 0}};
+    DrawList list(sizeof(Instance));
+    queue(list, quads);
+    list.build(DrawOrder::Submission);
+
+    const auto& b = list.batches();
+    CHECK_EQ(b.size(), 4u);
+    CHECK_EQ(b[0].instance_count, 2u);
+    CHECK_EQ(b[2].pipeline, 2u);
+    CHECK_EQ(b[2].instance_count, 2u);
+    CHECK_EQ(b[3].first_instance, 5u);
+    for (uint32_t i = 0; i < quads.size(); i++) CHECK_EQ(packedIndex(list, i), i);
+    checkBatches(list, quads);
+
+    // First batch counts its pipeline; texture 0 is not a bind
+    CHECK_EQ(list.pipelineChanges(), 3u);
+    CHECK_EQ(list.textureChanges(), 2u);
+}
+
+void testByStateSortsStably() {
+    std::vector<Quad> quads = {{2, 1}, {1, 3}, {2, 1}, {1, 0}, {1, 3}, {2, 0}};
+    DrawList list(sizeof(Instance));
+    queue(list, quads);
+    list.build(DrawOrder::ByState);
+
+    const auto& b = list.batches();
+    CHECK_EQ(b.size(), 4u);     // (1,0) (1,3) (2,0) (2,1)
+    const uint32_t expected[] = {3, 1, 4, 5, 0, 2};
+    for (uint32_t i = 0; i < 6; i++) CHECK_EQ(packedIndex(list, i), expected[i]);
+    checkBatches(list, quads);
+    CHECK_EQ(list.pipelineChanges(), 2u);
+    CHECK_EQ(list.textureChanges(), 3u);
+
+    // Building again in queue order uses the staged blocks
+    list.build(DrawOrder::Submission);
+    for (uint32_t i = 0; i < 6; i++) CHECK_EQ(packedIndex(list, i), i);
+    CHECK_EQ(list.batches().size(), 6u);
+}
+
+void testAddReturnsPatchableBlock() {
+    DrawList list(sizeof(Instance));
+    Instance inst = {};
+    uint8_t* block = list.add(1, 0, &inst);
+    Instance patched = {};
+    patched.index = 0;
+    patched.payload[0] = 0.0f;
+    patched.payload[6] = 42.0f;
+    memcpy(block, &patched, sizeof(patched));
+    list.build(DrawOrder::ByState);
+
+    Instance out;
+    memcpy(&out, list.instanceData(), sizeof(out));
+    CHECK_EQ(out.payload[6], 42.0f);
+}
+
+void testEmptyAndReset() {
+    DrawList list(sizeof(Instance));
+    list.build(DrawOrder::ByState);
+    CHECK(list.batches().empty());
+    CHECK_EQ(list.instanceCount(), 0u);
+    CHECK_EQ(list.pipelineChanges(), 0u);
+
+    std::vector<Quad> quads(64, Quad{1, 1});
+    queue(list, quads);
+    list.build(DrawOrder::Submission);
+    CHECK_EQ(list.batches().size(), 1u);
+    const uint8_t* data = list.instanceData();
+
+    // Same size next frame: no reallocation, nothing left over
+    list.reset();
+    CHECK_EQ(list.instanceCount(), 0u);
+    CHECK(list.batches().empty());
+    queue(list, quads);
+    list.build(DrawOrder::Submission);
+    CHECK(list.instanceData() == data);
+    CHECK_EQ(list.batches()[0].instance_count, 64u);
+}
+
+// Random frames: Submission keeps queue order with maximal merging, ByState
+// equals a stable sort of the queue with one batch per distinct state
+void testRandomFrames() {
+    std::mt19937 rng(11);
+    DrawList list(sizeof(Instance));
+    for (int frame = 0; frame < 50; frame++) {
+        std::vector<Quad> quads(rng() % 400);
+        for (auto& q : quads) {
+            q.pipeline = rng() % 3;
+            q.texture = rng() % 4 ? rng() % 6 : 0;
+        }
+
+        list.reset();
+        queue(list, quads);
+        list.build(DrawOrder::Submission);
+        checkBatches(list, quads);
+        size_t runs = 0;
+        for (size_t i = 0; i < quads.size(); i++) {
+            if (i == 0 || quads[i].pipeline != quads[i - 1].pipeline || quads[i].texture != quads[i - 1].texture) runs++;
+        }
+        CHECK_EQ(list.batches().size(), runs);
+
+        list.build(DrawOrder::ByState);
+        checkBatches(list, quads);
+        std::vector<uint32_t> order(quads.size());
+        for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            return quads[a].pipeline != quads[b].pipeline ? quads[a].pipeline < quads[b].pipeline
+                                                          : quads[a].texture < quads[b].texture;
+        });
+        for (uint32_t i = 0; i < order.size(); i++) CHECK_EQ(packedIndex(list, i), order[i]);
+        size_t states = 0;
+        for (size_t i = 0; i < order.size(); i++) {
+            const Quad& q = quads[order[i]];
+            if (i == 0 || q.pipeline != quads[order[i - 1]].pipeline || q.texture != quads[order[i - 1]].texture) states++;
+        }
+        CHECK_EQ(list.batches().size(), states);
+        CHECK(list.pipelineChanges() <= 3u);
+    }
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testSubmissionMergesNeighbours);
+    RUN_TEST(testByStateSortsStably);
+    RUN_TEST(testAddReturnsPatchableBlock);
+    RUN_TEST(testEmptyAndReset);
+    RUN_TEST(testRandomFrames);
+    return testResult();
+}
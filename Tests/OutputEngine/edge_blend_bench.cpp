@@ -0,0 +1,66 @@
+// edge_blend_bench.cpp - Software edge blend renderer cost and 1 -> N core scaling
+// A 1920x1080 source is rendered to a 1920x1080 output with feathers only, and
+// with keystone + dome curvature + lens. "first" includes building the warp map
+// and sample taps; "steady" is the cached per-frame cost the NDI path pays.
+
+#include "band_worker_pool.h"
+#include "edge_blend_cpu.h"
+#include "bench_support.h"
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace RocKontrol;
+using namespace BenchSupport;
+
+int main(int argc, char** argv) {
+    const bool quick = quickMode(argc, argv);
+    const int runs = quick ? 2 : 20;
+    const uint32_t width = quick ? 480 : 1920;
+    const uint32_t height = quick ? 270 : 1080;
+    size_t maxWorkers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    if (quick) maxWorkers = std::min<size_t>(maxWorkers, 1);
+
+    std::vector<uint8_t> src((size_t)width * height * 4);
+    for (size_t i = 0; i < src.size(); i++) src[i] = (uint8_t)(i * 2654435761u >> 24);
+    std::vector<uint8_t> dst(src.size());
+
+    EdgeBlendSettings feather;
+    feather.featherLeft = 0.15f;
+    feather.featherRight = 0.15f;
+
+    EdgeBlendSettings warped = feather;
+    warped.geometry.warp[WarpGeometry::TopLeft][0] = 0.08f;
+    warped.geometry.warp[WarpGeometry::TopRight][0] = -0.08f;
+    warped.geometry.curvature = 0.4f;
+    warped.geometry.lensK1 = 0.15f;
+
+    struct Case { const char* name; const EdgeBlendSettings* settings; };
+    for (const Case& c : {Case{"feather", &feather}, Case{"warped", &warped}}) {
+        uint64_t inlineNs = 0;
+        for (size_t workers = 0; workers <= maxWorkers; workers++) {
+            BandWorkerPool pool(workers);
+            uint64_t firstNs = UINT64_MAX;
+            for (int i = 0; i < (quick ? 1 : 5); i++) {
+                EdgeBlendRenderer fresh(pool);
+                uint64_t start = nowNs();
+                fresh.render(*c.settings, src.data(), width, height, (size_t)width * 4,
+                             dst.data(), width, height, (size_t)width * 4);
+                firstNs = std::min(firstNs, nowNs() - start);
+            }
+
+            EdgeBlendRenderer renderer(pool);
+            renderer.render(*c.settings, src.data(), width, height, (size_t)width * 4,
+                            dst.data(), width, height, (size_t)width * 4);
+            uint64_t ns = bestOf(runs, [&] {
+                renderer.render(*c.settings, src.data(), width, height, (size_t)width * 4,
+                                dst.data(), width, height, (size_t)width * 4);
+            });
+            doNotOptimize(dst[dst.size() / 2]);
+            if (workers == 0) inlineNs = ns;
+            printf("%-7s %ux%u threads=%2zu  first %8.3f ms  steady %8.3f ms  speedup %.2fx\n", c.name,
+                   width, height, workers + 1, firstNs / 1e6, ns / 1e6, (double)inlineNs / (double)ns);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,350 @@
+// edge_blend_golden_test.cpp - Golden-image regression suite for the edge blend / display paths
+// Each scene renders a fixed test pattern three ways and compares with the
+// checked-in image in Tests/golden/edge_blend:
+//   - EdgeBlendRenderer, the CPU reference (must match to one code value)
+//   - edgeBlendFragment from output_ndi.mm, compiled as C++ (see msl_cpu.h)
+//   - display_fragment from output_display.mm, for the crop-only scenes
+//
+//   edge_blend_golden_test --update   rewrite the goldens from the CPU reference
+
+#include "edge_blend_cpu.h"
+#include "band_worker_pool.h"
+#include "msl_cpu.h"
+#include "test_support.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace metal { namespace edge_blend {
+#include "edgeBlendShaderSource.metal"
+} }
+
+namespace metal { namespace display {
+#include "kDisplayShaderSource.metal"
+} }
+
+using namespace RocKontrol;
+using metal::float2;
+using metal::float4;
+
+namespace {
+
+const uint32_t kSrcWidth = 192, kSrcHeight = 108;
+const uint32_t kDstWidth = 128, kDstHeight = 72;
+
+struct Scene {
+    const char* name;
+    EdgeBlendSettings settings;
+    bool cropOnly;          // Also rendered through the display shader
+};
+
+// Colour bars over a diagonal gradient with a checker inset - smooth enough
+// that bilinear rounding stays within a code value, busy enough to show warps
+std::vector<uint8_t> testPattern() {
+    static const uint8_t kBars[8][3] = {
+        {255, 255, 255}, {0, 255, 255}, {255, 255, 0}, {0, 255, 0},
+        {255, 0, 255}, {0, 0, 255}, {255, 0, 0}, {0, 0, 0}
+    };
+    std::vector<uint8_t> src((size_t)kSrcWidth * kSrcHeight * 4);
+    for (uint32_t y = 0; y < kSrcHeight; y++) {
+        for (uint32_t x = 0; x < kSrcWidth; x++) {
+            uint8_t* p = &src[((size_t)y * kSrcWidth + x) * 4];
+            if (y < kSrcHeight / 3) {
+                const uint8_t* bar = kBars[x * 8 / kSrcWidth];
+                p[0] = bar[0]; p[1] = bar[1]; p[2] = bar[2];
+            } else if (x > kSrcWidth / 3 && x < kSrcWidth * 2 / 3 && y > kSrcHeight / 2) {
+                uint8_t v = ((x / 8 + y / 8) & 1) ? 220 : 35;
+                p[0] = v; p[1] = v; p[2] = v;
+            } else {
+                p[0] = (uint8_t)(x * 255 / (kSrcWidth - 1));
+                p[1] = (uint8_t)(y * 255 / (kSrcHeight - 1));
+                p[2] = (uint8_t)((x + y) * 255 / (kSrcWidth + kSrcHeight - 2));
+            }
+            p[3] = 255;
+        }
+    }
+    return src;
+}
+
+std::vector<Scene> scenes() {
+    std::vector<Scene> list;
+    auto add = [&](const char* name, bool cropOnly) -> EdgeBlendSettings& {
+        list.push_back({name, EdgeBlendSettings(), cropOnly});
+        return list.back().settings;
+    };
+
+    add("passthrough", true);
+
+    EdgeBlendSettings& crop = add("crop", true);
+    crop.geometry.cropOriginX = 0.25f;
+    crop.geometry.cropOriginY = 0.2f;
+    crop.geometry.cropSizeX = 0.5f;
+    crop.geometry.cropSizeY = 0.6f;
+
+    EdgeBlendSettings& feather = add("feather_left_right", false);
+    feather.featherLeft = 0.2f;
+    feather.featherRight = 0.3f;
+
+    EdgeBlendSettings& shaped = add("feather_all_power_gamma_black", false);
+    shaped.featherLeft = 0.15f;
+    shaped.featherRight = 0.15f;
+    shaped.featherTop = 0.2f;
+    shaped.featherBottom = 0.1f;
+    shaped.power = 2.0f;
+    shaped.gamma = 1.8f;
+    shaped.blackLevel = 0.04f;
+
+    EdgeBlendSettings& dimmed = add("intensity", false);
+    dimmed.intensity = 0.45f;
+
+    EdgeBlendSettings& keystone = add("keystone", false);
+    keystone.geometry.warp[WarpGeometry::TopLeft][0] = 0.1f;
+    keystone.geometry.warp[WarpGeometry::TopRight][0] = -0.1f;
+    keystone.geometry.warp[WarpGeometry::BottomLeft][1] = -0.05f;
+
+    EdgeBlendSettings& eight = add("eight_point", false);
+    eight.geometry.warp[WarpGeometry::TopMiddle][1] = 0.06f;
+    eight.geometry.warp[WarpGeometry::MiddleLeft][0] = 0.05f;
+    eight.geometry.warp[WarpGeometry::MiddleRight][0] = -0.03f;
+    eight.geometry.warp[WarpGeometry::BottomMiddle][1] = -0.04f;
+
+    EdgeBlendSettings& convex = add("dome_convex", false);
+    convex.geometry.curvature = 0.5f;
+
+    EdgeBlendSettings& concave = add("dome_concave", false);
+    concave.geometry.curvature = -0.35f;
+
+    EdgeBlendSettings& lens = add("lens", false);
+    lens.geometry.lensK1 = 0.2f;
+    lens.geometry.lensK2 = 0.05f;
+    lens.geometry.lensCenterX = 0.55f;
+
+    EdgeBlendSettings& overlay = add("corner_overlay", false);
+    overlay.activeCorner = 2;
+    overlay.geometry.warp[WarpGeometry::TopRight][0] = -0.08f;
+    overlay.geometry.warp[WarpGeometry::TopRight][1] = 0.05f;
+
+    EdgeBlendSettings& all = add("combined", false);
+    all.featherLeft = 0.1f;
+    all.featherBottom = 0.12f;
+    all.gamma = 2.4f;
+    all.blackLevel = 0.02f;
+    all.intensity = 0.8f;
+    all.activeCorner = 3;
+    all.geometry.warp[WarpGeometry::BottomLeft][0] = 0.04f;
+    all.geometry.warp[WarpGeometry::TopRight][1] = 0.03f;
+    all.geometry.curvature = 0.2f;
+    all.geometry.lensK1 = -0.1f;
+    all.geometry.cropOriginX = 0.1f;
+    all.geometry.cropSizeX = 0.8f;
+    return list;
+}
+
+std::string goldenPath(const Scene& scene) {
+    return std::string(GOLDEN_DIR) + "/edge_blend/" + scene.name + ".ppm";
+}
+
+// Binary PPM (RGB) from / to BGRA
+bool writePPM(const std::string& path, const std::vector<uint8_t>& bgra, uint32_t width, uint32_t height) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    fprintf(f, "P6\n%u %u\n255\n", width, height);
+    for (size_t i = 0; i < (size_t)width * height; i++) {
+        uint8_t rgb[3] = {bgra[i * 4 + 2], bgra[i * 4 + 1], bgra[i * 4]};
+        fwrite(rgb, 1, 3, f);
+    }
+    return fclose(f) == 0;
+}
+
+bool readPPM(const std::string& path, std::vector<uint8_t>& rgb, uint32_t& width, uint32_t& height) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    int maxValue = 0;
+    bool ok = fscanf(f, "P6 %u %u %d", &width, &height, &maxValue) == 3 && maxValue == 255 && fgetc(f) != EOF;
+    if (ok) {
+        rgb.resize((size_t)width * height * 3);
+        ok = fread(rgb.data(), 1, rgb.size(), f) == rgb.size();
+    }
+    fclose(f);
+    return ok;
+}
+
+// Largest per-channel difference, and how many pixels exceed `tolerance`
+struct Diff {
+    int maxDelta = 0;
+    int overTolerance = 0;
+};
+
+Diff compare(const std::vector<uint8_t>& bgra, const std::vector<uint8_t>& rgb, int tolerance) {
+    Diff diff;
+    for (size_t i = 0; i < rgb.size() / 3; i++) {
+        int worst = 0;
+        for (int c = 0; c < 3; c++) {
+            worst = std::max(worst, std::abs((int)bgra[i * 4 + 2 - c] - (int)rgb[i * 3 + c]));
+        }
+        diff.maxDelta = std::max(diff.maxDelta, worst);
+        if (worst > tolerance) diff.overTolerance++;
+    }
+    return diff;
+}
+
+std::vector<uint8_t> renderReference(const Scene& scene, const std::vector<uint8_t>& src, BandWorkerPool& pool) {
+    std::vector<uint8_t> dst((size_t)kDstWidth * kDstHeight * 4);
+    EdgeBlendRenderer renderer(pool);
+    renderer.render(scene.settings, src.data(), kSrcWidth, kSrcHeight, kSrcWidth * 4,
+                    dst.data(), kDstWidth, kDstHeight, kDstWidth * 4);
+    return dst;
+}
+
+metal::edge_blend::EdgeBlendParams edgeBlendParams(const EdgeBlendSettings& s) {
+    metal::edge_blend::EdgeBlendParams p = {};
+    const WarpGeometry& g = s.geometry;
+    p.featherLeft = s.featherLeft;
+    p.featherRight = s.featherRight;
+    p.featherTop = s.featherTop;
+    p.featherBottom = s.featherBottom;
+    p.gamma = s.gamma;
+    p.power = s.power;
+    p.blackLevel = s.blackLevel;
+    p.activeCorner = (float)s.activeCorner;
+    p.cropOrigin = float2(g.cropOriginX, g.cropOriginY);
+    p.cropSize = float2(g.cropSizeX, g.cropSizeY);
+    float2* warp[WarpGeometry::PointCount] = {
+        &p.warpTopLeft, &p.warpTopMiddle, &p.warpTopRight, &p.warpMiddleLeft,
+        &p.warpMiddleRight, &p.warpBottomLeft, &p.warpBottomMiddle, &p.warpBottomRight
+    };
+    for (int i = 0; i < WarpGeometry::PointCount; i++) *warp[i] = float2(g.warp[i][0], g.warp[i][1]);
+    p.lensK1 = g.lensK1;
+    p.lensK2 = g.lensK2;
+    p.lensCenter = float2(g.lensCenterX, g.lensCenterY);
+    p.warpCurvature = g.curvature;
+    p.intensity = s.intensity;
+    return p;
+}
+
+std::vector<uint8_t> renderEdgeBlendShader(const Scene& scene, const std::vector<uint8_t>& src) {
+    namespace shader = metal::edge_blend;
+    std::vector<float4> texels = MSLCPU::loadBGRA8(src.data(), kSrcWidth, kSrcHeight, kSrcWidth * 4);
+    auto tex = MSLCPU::texture(texels, kSrcWidth, kSrcHeight);
+    shader::EdgeBlendParams params = edgeBlendParams(scene.settings);
+    std::vector<uint8_t> dst((size_t)kDstWidth * kDstHeight * 4);
+    MSLCPU::drawTriangle(shader::edgeBlendVertex, kDstWidth, kDstHeight,
+                         [&](shader::VertexOut in, uint32_t x, uint32_t y) {
+        MSLCPU::storeBGRA8(shader::edgeBlendFragment(in, tex, metal::sampler(), params),
+                           &dst[((size_t)y * kDstWidth + x) * 4]);
+    });
+    return dst;
+}
+
+std::vector<uint8_t> renderDisplayShader(const Scene& scene, const std::vector<uint8_t>& src) {
+    namespace shader = metal::display;
+    std::vector<float4> texels = MSLCPU::loadBGRA8(src.data(), kSrcWidth, kSrcHeight, kSrcWidth * 4);
+    auto tex = MSLCPU::texture(texels, kSrcWidth, kSrcHeight);
+    shader::DisplayParams params = {};
+    params.cropX = scene.settings.geometry.cropOriginX;
+    params.cropY = scene.settings.geometry.cropOriginY;
+    params.cropW = scene.settings.geometry.cropSizeX;
+    params.cropH = scene.settings.geometry.cropSizeY;
+    params.outputWidth = (float)kDstWidth;
+    params.outputHeight = (float)kDstHeight;
+    std::vector<uint8_t> dst((size_t)kDstWidth * kDstHeight * 4);
+    MSLCPU::drawTriangle(shader::display_vertex, kDstWidth, kDstHeight,
+                         [&](shader::VertexOut in, uint32_t x, uint32_t y) {
+        MSLCPU::storeBGRA8(shader::display_fragment(in, tex, metal::sampler(), params),
+                           &dst[((size_t)y * kDstWidth + x) * 4]);
+    });
+    return dst;
+}
+
+bool updateGoldens() {
+    std::vector<uint8_t> src = testPattern();
+    BandWorkerPool pool(0);
+    bool ok = true;
+    for (const Scene& scene : scenes()) {
+        std::string path = goldenPath(scene);
+        if (!writePPM(path, renderReference(scene, src, pool), kDstWidth, kDstHeight)) {
+            fprintf(stderr, "Could not write %s\n", path.c_str());
+            ok = false;
+        } else {
+            fprintf(stderr, "Wrote %s\n", path.c_str());
+        }
+    }
+    return ok;
+}
+
+// CPU reference matches the goldens with any worker count
+void testReferenceMatchesGoldens() {
+    std::vector<uint8_t> src = testPattern();
+    for (size_t workers : {0u, 3u}) {
+        BandWorkerPool pool(workers);
+        for (const Scene& scene : scenes()) {
+            std::vector<uint8_t> rgb;
+            uint32_t width = 0, height = 0;
+            bool loaded = readPPM(goldenPath(scene), rgb, width, height);
+            CHECK(loaded);
+            if (!loaded) continue;
+            CHECK_EQ(width, kDstWidth);
+            CHECK_EQ(height, kDstHeight);
+
+            std::vector<uint8_t> out = renderReference(scene, src, pool);
+            Diff diff = compare(out, rgb, 1);
+            if (diff.overTolerance) fprintf(stderr, "  %s: max delta %d\n", scene.name, diff.maxDelta);
+            CHECK_EQ(diff.overTolerance, 0);
+
+            bool opaque = true;
+            for (size_t i = 3; i < out.size(); i += 4) opaque = opaque && out[i] == 255;
+            CHECK(opaque);
+        }
+    }
+}
+
+// The NDI shader itself reproduces the goldens. The reference filters with
+// 8-bit weights like the GPU, the CPU-compiled shader with float weights.
+void testEdgeBlendShaderMatchesGoldens() {
+    std::vector<uint8_t> src = testPattern();
+    for (const Scene& scene : scenes()) {
+        std::vector<uint8_t> rgb;
+        uint32_t width = 0, height = 0;
+        if (!readPPM(goldenPath(scene), rgb, width, height)) {
+            CHECK(false);
+            continue;
+        }
+        Diff diff = compare(renderEdgeBlendShader(scene, src), rgb, 2);
+        if (diff.overTolerance) fprintf(stderr, "  %s: max delta %d (%d px)\n", scene.name, diff.maxDelta, diff.overTolerance);
+        CHECK_EQ(diff.overTolerance, 0);
+    }
+}
+
+// The display path (crop only) agrees with the NDI path's goldens
+void testDisplayShaderMatchesGoldens() {
+    std::vector<uint8_t> src = testPattern();
+    int cropScenes = 0;
+    for (const Scene& scene : scenes()) {
+        if (!scene.cropOnly) continue;
+        cropScenes++;
+        std::vector<uint8_t> rgb;
+        uint32_t width = 0, height = 0;
+        if (!readPPM(goldenPath(scene), rgb, width, height)) {
+            CHECK(false);
+            continue;
+        }
+        Diff diff = compare(renderDisplayShader(scene, src), rgb, 2);
+        if (diff.overTolerance) fprintf(stderr, "  %s: max delta %d (%d px)\n", scene.name, diff.maxDelta, diff.overTolerance);
+        CHECK_EQ(diff.overTolerance, 0);
+    }
+    CHECK(cropScenes >= 2);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "--update") == 0) {
+        return updateGoldens() ? 0 : 1;
+    }
+    RUN_TEST(testReferenceMatchesGoldens);
+    RUN_TEST(testEdgeBlendShaderMatchesGoldens);
+    RUN_TEST(testDisplayShaderMatchesGoldens);
+    return testResult();
+}
@@ -0,0 +1,118 @@
+// frame_ring_bench.cpp - FrameRing vs the previous mutex ring under reader contention
+// One producer pushes frames carrying a retained handle (like an id<MTLTexture>)
+// while 1, 4 or 16 consumers call peekLatest() in a loop. Reports producer push
+// latency and total consumer reads per second.
+
+#include "frame_ring.h"
+#include "bench_support.h"
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace BenchSupport;
+
+namespace {
+
+struct BenchFrame {
+    std::shared_ptr<int> texture;
+    uint64_t timestamp_ns = 0;
+    uint64_t frame_number = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    void reset() { *this = BenchFrame(); }
+};
+
+// FrameRingBuffer as it was before the lock-free rewrite
+class MutexFrameRing {
+public:
+    explicit MutexFrameRing(size_t capacity) : capacity_(capacity), frames_(capacity) {}
+
+    bool push(const BenchFrame& frame) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        frames_[write_idx_] = frame;
+        write_idx_ = (write_idx_ + 1) % capacity_;
+        if (count_ < capacity_) count_++;
+        else read_idx_ = (read_idx_ + 1) % capacity_;
+        return true;
+    }
+
+    bool peekLatest(BenchFrame& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (count_ == 0) return false;
+        out = frames_[(write_idx_ + capacity_ - 1) % capacity_];
+        return true;
+    }
+
+    uint64_t dropped() const { return 0; }
+
+private:
+    size_t capacity_;
+    std::vector<BenchFrame> frames_;
+    size_t write_idx_ = 0;
+    size_t read_idx_ = 0;
+    size_t count_ = 0;
+    std::mutex mutex_;
+};
+
+template <typename Ring>
+void run(const char* label, int consumers, uint64_t durationNs) {
+    Ring ring(5);
+    auto texture = std::make_shared<int>(0);
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> reads{0};
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&] {
+            BenchFrame out;
+            uint64_t local = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                if (ring.peekLatest(out)) local++;
+            }
+            reads.fetch_add(local);
+        });
+    }
+
+    std::vector<uint64_t> pushNs;
+    pushNs.reserve(1 << 20);
+    BenchFrame frame;
+    frame.texture = texture;
+    frame.width = 1920;
+    frame.height = 1080;
+
+    uint64_t start = nowNs();
+    uint64_t end = start + durationNs;
+    uint64_t pushes = 0;
+    while (nowNs() < end) {
+        frame.frame_number = ++pushes;
+        uint64_t t0 = nowNs();
+        ring.push(frame);
+        if (pushNs.size() < pushNs.capacity()) pushNs.push_back(nowNs() - t0);
+    }
+    uint64_t elapsed = nowNs() - start;
+    done.store(true);
+    for (auto& t : threads) t.join();
+
+    double seconds = (double)elapsed / 1e9;
+    uint64_t p50 = percentile(pushNs, 0.50);
+    uint64_t p99 = percentile(pushNs, 0.99);
+    uint64_t worst = pushNs.empty() ? 0 : pushNs.back();
+    printf("%-8s consumers=%2d  push p50=%5llu ns p99=%6llu ns max=%8llu ns  pushes/s=%10.0f  reads/s=%12.0f  dropped=%llu\n",
+           label, consumers, (unsigned long long)p50, (unsigned long long)p99, (unsigned long long)worst,
+           (double)pushes / seconds, (double)reads.load() / seconds, (unsigned long long)ring.dropped());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint64_t durationNs = quickMode(argc, argv) ? 20000000ull : 1000000000ull;
+    for (int consumers : {1, 4, 16}) {
+        run<MutexFrameRing>("mutex", consumers, durationNs);
+        run<RocKontrol::FrameRing<BenchFrame>>("lockfree", consumers, durationNs);
+    }
+    return 0;
+}
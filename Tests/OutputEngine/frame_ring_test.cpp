@@ -0,0 +1,176 @@
+// frame_ring_test.cpp - FrameRing ordering, drop-oldest and concurrent readers
+
+#include "frame_ring.h"
+#include "test_support.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using RocKontrol::FrameRing;
+
+namespace {
+
+// Stands in for SwitcherFrame: check must always match seq (torn copies don't),
+// token plays the role of the retained texture.
+struct TestFrame {
+    uint64_t seq = 0;
+    uint64_t check = 0;
+    std::shared_ptr<int> token;
+
+    void reset() { *this = TestFrame(); }
+};
+
+TestFrame makeFrame(uint64_t seq, std::shared_ptr<int> token = nullptr) {
+    TestFrame frame;
+    frame.seq = seq;
+    frame.check = seq * 0x9E3779B97F4A7C15ull;
+    frame.token = std::move(token);
+    return frame;
+}
+
+void testEmpty() {
+    FrameRing<TestFrame> ring(4);
+    TestFrame out;
+    CHECK(ring.empty());
+    CHECK(!ring.peekLatest(out));
+    CHECK(!ring.pop(out));
+}
+
+void testOrder() {
+    FrameRing<TestFrame> ring(5);
+    for (uint64_t i = 1; i <= 3; i++) CHECK(ring.push(makeFrame(i)));
+    CHECK_EQ(ring.size(), 3u);
+
+    TestFrame out;
+    CHECK(ring.peekLatest(out));
+    CHECK_EQ(out.seq, 3u);
+    for (uint64_t i = 1; i <= 3; i++) {
+        CHECK(ring.pop(out));
+        CHECK_EQ(out.seq, i);
+    }
+    CHECK(!ring.pop(out));
+    CHECK(!ring.peekLatest(out));
+}
+
+void testDropOldest() {
+    FrameRing<TestFrame> ring(5);
+    for (uint64_t i = 1; i <= 12; i++) CHECK(ring.push(makeFrame(i)));
+    CHECK_EQ(ring.size(), 5u);
+
+    TestFrame out;
+    for (uint64_t i = 8; i <= 12; i++) {
+        CHECK(ring.pop(out));
+        CHECK_EQ(out.seq, i);
+    }
+    CHECK(ring.empty());
+    CHECK_EQ(ring.dropped(), 0u);
+}
+
+void testClear() {
+    FrameRing<TestFrame> ring(3);
+    for (uint64_t i = 1; i <= 4; i++) ring.push(makeFrame(i));
+    ring.clear();
+
+    TestFrame out;
+    CHECK(ring.empty());
+    CHECK(!ring.peekLatest(out));
+    CHECK(!ring.pop(out));
+
+    ring.push(makeFrame(5));
+    CHECK(ring.peekLatest(out));
+    CHECK_EQ(out.seq, 5u);
+    CHECK_EQ(ring.size(), 1u);
+}
+
+void testResizeReleasesFrames() {
+    auto token = std::make_shared<int>(1);
+    FrameRing<TestFrame> ring(3);
+    for (uint64_t i = 1; i <= 6; i++) ring.push(makeFrame(i, token));
+    CHECK(token.use_count() > 1);
+
+    ring.resize(8);
+    CHECK_EQ(token.use_count(), 1);
+    CHECK(ring.empty());
+
+    for (uint64_t i = 1; i <= 8; i++) ring.push(makeFrame(i));
+    CHECK_EQ(ring.size(), 8u);
+}
+
+// Slots are recycled, so a retained frame is released once its slot is reused
+void testRecycledSlotsReleaseFrames() {
+    auto token = std::make_shared<int>(1);
+    FrameRing<TestFrame> ring(2);
+    ring.push(makeFrame(1, token));
+    for (uint64_t i = 2; i <= 10; i++) ring.push(makeFrame(i));
+    CHECK_EQ(token.use_count(), 1);
+}
+
+void testConcurrentReaders() {
+    const uint64_t kFrames = 200000;
+    FrameRing<TestFrame> ring(4);
+    auto token = std::make_shared<int>(1);
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::atomic<int> backwards{0};
+    std::vector<std::vector<uint64_t>> popped(2);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&] {
+            uint64_t last = 0;
+            TestFrame out;
+            while (!done.load(std::memory_order_acquire)) {
+                if (!ring.peekLatest(out)) continue;
+                if (out.check != out.seq * 0x9E3779B97F4A7C15ull) torn++;
+                if (out.seq < last) backwards++;
+                last = out.seq;
+            }
+        });
+    }
+    for (int p = 0; p < 2; p++) {
+        readers.emplace_back([&, p] {
+            TestFrame out;
+            while (!done.load(std::memory_order_acquire)) {
+                if (!ring.pop(out)) continue;
+                if (out.check != out.seq * 0x9E3779B97F4A7C15ull) torn++;
+                popped[p].push_back(out.seq);
+            }
+        });
+    }
+
+    for (uint64_t i = 1; i <= kFrames; i++) ring.push(makeFrame(i, token));
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) t.join();
+
+    CHECK_EQ(torn.load(), 0);
+    CHECK_EQ(backwards.load(), 0);
+
+    // Each consumer pops in order, and no frame is popped twice
+    std::vector<uint64_t> all;
+    for (auto& list : popped) {
+        CHECK(std::is_sorted(list.begin(), list.end()));
+        all.insert(all.end(), list.begin(), list.end());
+    }
+    std::sort(all.begin(), all.end());
+    CHECK(std::adjacent_find(all.begin(), all.end()) == all.end());
+
+    // Only frames still held by ring slots keep the token alive
+    CHECK(token.use_count() <= 1 + 4 + 2);
+    ring.resize(4);
+    CHECK_EQ(token.use_count(), 1);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testEmpty);
+    RUN_TEST(testOrder);
+    RUN_TEST(testDropOldest);
+    RUN_TEST(testClear);
+    RUN_TEST(testResizeReleasesFrames);
+    RUN_TEST(testRecycledSlotsReleaseFrames);
+    RUN_TEST(testConcurrentReaders);
+    return testResult();
+}
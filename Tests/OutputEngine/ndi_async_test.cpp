@@ -0,0 +1,334 @@
+// ndi_async_test.cpp - Async send buffer ownership against a stand-in NDIlib_v5
+// The stand-in table plays the SDK: it owns each async frame until the next
+// send, flush or destroy, is told by the frame pool when a block is released,
+// and checks at retire that an owned (still leased) buffer was not rewritten.
+// NDIFrameSender is tested directly (it is the send stage of both NDIOutput and
+// SoftwareNDIOutput), then end to end through SoftwareNDIOutput.
+
+#include "ndi_backend.h"
+#include "ndi_send.h"
+#include "pixel_buffer_pool.h"
+#include "software_ndi_output.h"
+#include "test_support.h"
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace RocKontrol;
+
+namespace {
+
+uint64_t fnv1a(const uint8_t* data, size_t size) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+struct StandInSDK : PixelBufferObserver {
+    std::mutex mutex;
+
+    // Async frame the SDK owns
+    const uint8_t* owned = nullptr;
+    size_t owned_size = 0;
+    uint64_t owned_hash = 0;
+    bool owned_released = false;
+
+    int creates = 0;
+    int destroys = 0;
+    int sync_sends = 0;
+    int async_sends = 0;
+    int flushes = 0;
+    int releases = 0;                // Blocks back in the pool
+    int released_while_owned = 0;    // Block went back to the pool during ownership
+    int rewritten_while_owned = 0;   // Block still leased but its bytes changed
+    bool owned_at_destroy = false;
+
+    void blockReleased(const uint8_t* data) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        releases++;
+        if (owned && data == owned && !owned_released) {
+            owned_released = true;
+            released_while_owned++;
+        }
+    }
+
+    // Caller holds mutex. Only reads the buffer when the pool says it is still leased.
+    void retire() {
+        if (!owned) return;
+        if (!owned_released && fnv1a(owned, owned_size) != owned_hash) rewritten_while_owned++;
+        owned = nullptr;
+        owned_released = false;
+    }
+};
+
+std::shared_ptr<StandInSDK> g_sdk;
+int g_handle;
+
+NDIlib_send_instance_t standInCreate(const NDIlib_send_create_t*) {
+    std::lock_guard<std::mutex> lock(g_sdk->mutex);
+    g_sdk->creates++;
+    return reinterpret_cast<NDIlib_send_instance_t>(&g_handle);
+}
+
+void standInDestroy(NDIlib_send_instance_t) {
+    std::lock_guard<std::mutex> lock(g_sdk->mutex);
+    g_sdk->owned_at_destroy = g_sdk->owned != nullptr;
+    g_sdk->retire();
+    g_sdk->destroys++;
+}
+
+void standInSend(NDIlib_send_instance_t, const NDIlib_video_frame_v2_t*) {
+    std::lock_guard<std::mutex> lock(g_sdk->mutex);
+    g_sdk->retire();
+    g_sdk->sync_sends++;
+}
+
+void standInSendAsync(NDIlib_send_instance_t, const NDIlib_video_frame_v2_t* frame) {
+    std::lock_guard<std::mutex> lock(g_sdk->mutex);
+    g_sdk->retire();
+    if (!frame) {
+        g_sdk->flushes++;
+        return;
+    }
+    g_sdk->async_sends++;
+    g_sdk->owned = frame->p_data;
+    g_sdk->owned_size = ndiFrameDataSize(*frame);
+    g_sdk->owned_hash = fnv1a(g_sdk->owned, g_sdk->owned_size);
+}
+
+int standInConnections(NDIlib_send_instance_t, uint32_t) {
+    return 2;
+}
+
+NDIlib_v5 makeTable() {
+    NDIlib_v5 table = {};
+    table.send_create = standInCreate;
+    table.send_destroy = standInDestroy;
+    table.send_send_video_v2 = standInSend;
+    table.send_send_video_async_v2 = standInSendAsync;
+    table.send_get_no_connections = standInConnections;
+    return table;
+}
+
+NDIlib_video_frame_v2_t makeFrame(uint8_t* data, int width, int height) {
+    NDIlib_video_frame_v2_t frame;
+    frame.xres = width;
+    frame.yres = height;
+    frame.FourCC = NDIlib_FourCC_type_BGRA;
+    frame.line_stride_in_bytes = width * 4;
+    frame.p_data = data;
+    return frame;
+}
+
+void pushFrames(SoftwareNDIOutput& output, int count) {
+    const uint32_t width = 96, height = 54;
+    std::vector<uint8_t> pixels((size_t)width * height * 4);
+    for (int i = 0; i < count; i++) {
+        memset(pixels.data(), i * 7, pixels.size());
+        output.pushPixelData(pixels.data(), width, height, 0, (uint64_t)(i + 1) * 16683333, 59.94f);
+        if (i % 3 == 0) std::this_thread::sleep_for(std::chrono::microseconds(300));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+// The stand-in itself flags both ways of breaking the rule
+void testStandInDetectsViolations() {
+    g_sdk = std::make_shared<StandInSDK>();
+    NDIlib_v5 table = makeTable();
+    NDILibBackend backend(&table);
+    CHECK(backend.load());
+    PixelBufferPool pool(4);
+    pool.setObserver(g_sdk);
+
+    NDIlib_send_create_t settings;
+    auto sender = backend.createSender(settings);
+    CHECK(sender != nullptr);
+
+    // Released before the next send
+    PixelBuffer a = pool.acquire(32 * 32 * 4);
+    memset(a.data(), 1, a.size());
+    auto frame = makeFrame(a.data(), 32, 32);
+    backend.sendVideoAsync(sender, &frame);
+    a.reset();
+    CHECK_EQ(g_sdk->released_while_owned, 1);
+
+    // Rewritten in place while still leased
+    PixelBuffer b = pool.acquire(32 * 32 * 4);
+    memset(b.data(), 2, b.size());
+    frame = makeFrame(b.data(), 32, 32);
+    backend.sendVideoAsync(sender, &frame);
+    memset(b.data(), 3, b.size());
+    backend.sendVideoAsync(sender, nullptr);
+    CHECK_EQ(g_sdk->rewritten_while_owned, 1);
+    CHECK_EQ(backend.connectionCount(sender, 0), 2);
+
+    backend.destroySender(sender);
+    CHECK_EQ(g_sdk->destroys, 1);
+}
+
+// Each async lease stays pinned across its send and is released right after the next one
+void testFrameSenderPinsUntilNextSend() {
+    g_sdk = std::make_shared<StandInSDK>();
+    NDIlib_v5 table = makeTable();
+    NDILibBackend backend(&table);
+    CHECK(backend.load());
+    PixelBufferPool pool(4);
+    pool.setObserver(g_sdk);
+    NDIlib_send_create_t settings;
+    auto sender = backend.createSender(settings);
+
+    NDIFrameSender ndiSender;
+    CHECK(!ndiSender.hasPinned());
+    for (int i = 0; i < 10; i++) {
+        PixelBuffer lease = pool.acquire(32 * 32 * 4);
+        memset(lease.data(), i, lease.size());
+        auto frame = makeFrame(lease.data(), 32, 32);
+        ndiSender.send(backend, sender, frame, std::move(lease), true);
+        CHECK(ndiSender.hasPinned());
+        // Only the previously pinned block went back
+        CHECK_EQ(g_sdk->releases, i);
+        CHECK_EQ(g_sdk->released_while_owned, 0);
+    }
+    CHECK_EQ(g_sdk->async_sends, 10);
+    CHECK_EQ(g_sdk->rewritten_while_owned, 0);
+
+    ndiSender.flush(backend, sender);
+    CHECK(!ndiSender.hasPinned());
+    CHECK_EQ(g_sdk->flushes, 1);
+    CHECK_EQ(g_sdk->releases, 10);
+    CHECK_EQ(g_sdk->released_while_owned, 0);
+
+    // Nothing pinned: a second flush does not reach the SDK
+    ndiSender.flush(backend, sender);
+    CHECK_EQ(g_sdk->flushes, 1);
+
+    backend.destroySender(sender);
+    CHECK(!g_sdk->owned_at_destroy);
+}
+
+// A sync send releases its own lease and retires the pinned async frame
+void testFrameSenderSyncRetiresPin() {
+    g_sdk = std::make_shared<StandInSDK>();
+    NDIlib_v5 table = makeTable();
+    NDILibBackend backend(&table);
+    CHECK(backend.load());
+    PixelBufferPool pool(4);
+    pool.setObserver(g_sdk);
+    NDIlib_send_create_t settings;
+    auto sender = backend.createSender(settings);
+
+    NDIFrameSender ndiSender;
+    PixelBuffer asyncLease = pool.acquire(32 * 32 * 4);
+    auto frame = makeFrame(asyncLease.data(), 32, 32);
+    ndiSender.send(backend, sender, frame, std::move(asyncLease), true);
+    CHECK(ndiSender.hasPinned());
+
+    PixelBuffer syncLease = pool.acquire(32 * 32 * 4);
+    frame = makeFrame(syncLease.data(), 32, 32);
+    ndiSender.send(backend, sender, frame, std::move(syncLease), false);
+    CHECK(!ndiSender.hasPinned());
+    CHECK(!syncLease);
+    CHECK_EQ(g_sdk->sync_sends, 1);
+    CHECK_EQ(g_sdk->released_while_owned, 0);
+    CHECK_EQ(g_sdk->releases, 2);
+
+    // Nothing left to flush
+    ndiSender.flush(backend, sender);
+    CHECK_EQ(g_sdk->flushes, 0);
+    backend.destroySender(sender);
+}
+
+void testAsyncSendKeepsBuffersUntilNextSend() {
+    for (NDIPixelFormat format : {NDIPixelFormat::BGRA, NDIPixelFormat::UYVY, NDIPixelFormat::UYVA}) {
+        g_sdk = std::make_shared<StandInSDK>();
+        NDIlib_v5 table = makeTable();
+
+        SoftwareNDIOutput output(std::make_shared<NDILibBackend>(&table));
+        SoftwareNDIOutputConfig config;
+        config.clock_video = false;
+        config.async_send = true;
+        config.pixel_format = format;
+        CHECK(output.configure(config));
+        output.setBufferObserver(g_sdk);
+        CHECK(output.start());
+        CHECK_EQ(output.connectionCount(), 2);
+
+        pushFrames(output, 45);
+        output.stop();
+
+        CHECK(output.framesSent() > 0);
+        CHECK_EQ((uint64_t)g_sdk->async_sends, output.framesSent());
+        CHECK_EQ(g_sdk->sync_sends, 0);
+        CHECK_EQ(g_sdk->released_while_owned, 0);
+        CHECK_EQ(g_sdk->rewritten_while_owned, 0);
+        // Stop flushes once, and before the sender is destroyed
+        CHECK_EQ(g_sdk->flushes, 1);
+        CHECK(!g_sdk->owned_at_destroy);
+        CHECK_EQ(g_sdk->creates, 1);
+        CHECK_EQ(g_sdk->destroys, 1);
+    }
+}
+
+void testSyncSendNeverHoldsBuffers() {
+    g_sdk = std::make_shared<StandInSDK>();
+    NDIlib_v5 table = makeTable();
+
+    SoftwareNDIOutput output(std::make_shared<NDILibBackend>(&table));
+    SoftwareNDIOutputConfig config;
+    config.clock_video = false;
+    config.async_send = false;
+    CHECK(output.configure(config));
+    output.setBufferObserver(g_sdk);
+    CHECK(output.start());
+    pushFrames(output, 30);
+    output.stop();
+
+    CHECK(output.framesSent() > 0);
+    CHECK_EQ((uint64_t)g_sdk->sync_sends, output.framesSent());
+    CHECK_EQ(g_sdk->async_sends, 0);
+    CHECK_EQ(g_sdk->flushes, 0);
+    CHECK_EQ(g_sdk->released_while_owned, 0);
+}
+
+// Switching async -> sync mid-stream: the sync send retires the last async frame
+void testToggleAsyncWhileRunning() {
+    g_sdk = std::make_shared<StandInSDK>();
+    NDIlib_v5 table = makeTable();
+
+    SoftwareNDIOutput output(std::make_shared<NDILibBackend>(&table));
+    SoftwareNDIOutputConfig config;
+    config.clock_video = false;
+    CHECK(output.configure(config));
+    output.setBufferObserver(g_sdk);
+    CHECK(output.start());
+    pushFrames(output, 20);
+    output.setAsyncSend(false);
+    pushFrames(output, 20);
+    output.setAsyncSend(true);
+    pushFrames(output, 20);
+    output.stop();
+
+    CHECK(g_sdk->async_sends > 0);
+    CHECK(g_sdk->sync_sends > 0);
+    CHECK_EQ(g_sdk->released_while_owned, 0);
+    CHECK_EQ(g_sdk->rewritten_while_owned, 0);
+    CHECK(!g_sdk->owned_at_destroy);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testStandInDetectsViolations);
+    RUN_TEST(testFrameSenderPinsUntilNextSend);
+    RUN_TEST(testFrameSenderSyncRetiresPin);
+    RUN_TEST(testAsyncSendKeepsBuffersUntilNextSend);
+    RUN_TEST(testSyncSendNeverHoldsBuffers);
+    RUN_TEST(testToggleAsyncWhileRunning);
+    return testResult();
+}
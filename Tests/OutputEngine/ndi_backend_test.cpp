@@ -0,0 +1,247 @@
+// ndi_backend_test.cpp - FakeNDIBackend recording, pacing and async ownership checks
+
+#include "ndi_backend.h"
+#include "pixel_buffer_pool.h"
+#include "software_ndi_output.h"
+#include "test_support.h"
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace RocKontrol;
+
+namespace {
+
+NDIlib_video_frame_v2_t makeFrame(uint8_t* data, int width, int height) {
+    NDIlib_video_frame_v2_t frame;
+    frame.xres = width;
+    frame.yres = height;
+    frame.FourCC = NDIlib_FourCC_type_BGRA;
+    frame.frame_rate_N = 60000;
+    frame.frame_rate_D = 1001;
+    frame.line_stride_in_bytes = width * 4;
+    frame.p_data = data;
+    return frame;
+}
+
+NDIlib_send_create_t makeSettings(bool clockVideo) {
+    NDIlib_send_create_t settings;
+    settings.p_ndi_name = "test";
+    settings.p_groups = nullptr;
+    settings.clock_video = clockVideo;
+    settings.clock_audio = false;
+    return settings;
+}
+
+void testRecordsFrames() {
+    FakeNDIBackend::Options options;
+    options.simulate_clock = false;
+    options.checksum_frames = true;
+    FakeNDIBackend fake(options);
+
+    auto a = fake.createSender(makeSettings(false));
+    auto b = fake.createSender(makeSettings(false));
+    CHECK_EQ(fake.sendersAlive(), 2u);
+
+    std::vector<uint8_t> pixels(16 * 8 * 4, 0x40);
+    auto frame = makeFrame(pixels.data(), 16, 8);
+    frame.timecode = 1234;
+    fake.sendVideo(a, frame);
+    fake.sendVideo(b, frame);
+    pixels[0] = 0x41;
+    fake.sendVideoAsync(a, &frame);
+    fake.sendVideoAsync(a, nullptr);
+
+    auto records = fake.records();
+    CHECK_EQ(records.size(), 3u);
+    CHECK_EQ(fake.framesSent(), 3u);
+    CHECK_EQ(fake.asyncFlushes(), 1u);
+    CHECK(records[0].sender_id != records[1].sender_id);
+    CHECK_EQ(records[0].xres, 16);
+    CHECK_EQ(records[0].yres, 8);
+    CHECK_EQ(records[0].line_stride, 64);
+    CHECK_EQ(records[0].timecode, 1234);
+    CHECK(!records[0].async);
+    CHECK(records[2].async);
+    CHECK_EQ(records[0].checksum, records[1].checksum);
+    CHECK(records[0].checksum != records[2].checksum);
+
+    fake.destroySender(a);
+    fake.destroySender(b);
+    CHECK_EQ(fake.sendersAlive(), 0u);
+    CHECK_EQ(fake.ownershipViolations(), 0u);
+}
+
+// Release buffer N only after async send N+1 (or the flush) has returned
+void testAsyncProtocolHasNoViolations() {
+    FakeNDIBackend::Options options;
+    options.simulate_clock = false;
+    FakeNDIBackend fake(options);
+    PixelBufferPool pool(4);
+    pool.setObserver(fake.ownershipObserver());
+
+    auto sender = fake.createSender(makeSettings(false));
+    PixelBuffer inFlight;
+    for (int i = 0; i < 20; i++) {
+        PixelBuffer next = pool.acquire(32 * 32 * 4);
+        memset(next.data(), i, next.size());
+        auto frame = makeFrame(next.data(), 32, 32);
+        fake.sendVideoAsync(sender, &frame);
+        inFlight = std::move(next);   // Releases the previous buffer
+    }
+    fake.sendVideoAsync(sender, nullptr);
+    inFlight.reset();
+
+    CHECK_EQ(fake.ownershipViolations(), 0u);
+    CHECK_EQ(fake.asyncFlushes(), 1u);
+    CHECK(pool.reuses() > 0);
+    fake.destroySender(sender);
+}
+
+// Releasing the buffer the SDK still owns is caught even when the recycled
+// block is refilled with exactly the same bytes
+void testEarlyReleaseIsAViolation() {
+    FakeNDIBackend::Options options;
+    options.simulate_clock = false;
+    FakeNDIBackend fake(options);
+    PixelBufferPool pool(4);
+    pool.setObserver(fake.ownershipObserver());
+    auto sender = fake.createSender(makeSettings(false));
+
+    PixelBuffer first = pool.acquire(32 * 32 * 4);
+    memset(first.data(), 0x55, first.size());
+    const uint8_t* block = first.data();
+    auto frame = makeFrame(first.data(), 32, 32);
+    fake.sendVideoAsync(sender, &frame);
+
+    first.reset();
+    CHECK_EQ(fake.ownershipViolations(), 1u);
+
+    PixelBuffer second = pool.acquire(32 * 32 * 4);
+    CHECK(second.data() == block);
+    memset(second.data(), 0x55, second.size());
+    frame = makeFrame(second.data(), 32, 32);
+    fake.sendVideoAsync(sender, &frame);
+    fake.sendVideoAsync(sender, nullptr);
+    second.reset();
+    CHECK_EQ(fake.ownershipViolations(), 1u);
+
+    fake.destroySender(sender);
+}
+
+// A synchronous send and destroying the sender both end async ownership
+void testSyncSendAndDestroyRetireAsync() {
+    FakeNDIBackend::Options options;
+    options.simulate_clock = false;
+    FakeNDIBackend fake(options);
+    PixelBufferPool pool(4);
+    pool.setObserver(fake.ownershipObserver());
+    auto sender = fake.createSender(makeSettings(false));
+
+    PixelBuffer a = pool.acquire(16 * 16 * 4);
+    auto frame = makeFrame(a.data(), 16, 16);
+    fake.sendVideoAsync(sender, &frame);
+    std::vector<uint8_t> sync(16 * 16 * 4);
+    frame = makeFrame(sync.data(), 16, 16);
+    fake.sendVideo(sender, frame);
+    a.reset();
+    CHECK_EQ(fake.ownershipViolations(), 0u);
+
+    PixelBuffer b = pool.acquire(16 * 16 * 4);
+    frame = makeFrame(b.data(), 16, 16);
+    fake.sendVideoAsync(sender, &frame);
+    fake.destroySender(sender);
+    b.reset();
+    CHECK_EQ(fake.ownershipViolations(), 0u);
+}
+
+// The pool keeps the observer alive after the backend is gone
+void testObserverOutlivesBackend() {
+    PixelBufferPool pool(4);
+    PixelBuffer lease = pool.acquire(1024);
+    {
+        FakeNDIBackend fake;
+        pool.setObserver(fake.ownershipObserver());
+    }
+    lease.reset();
+    pool.setObserver(nullptr);
+    CHECK(pool.acquire(1024));
+}
+
+// clock_video holds each send to the frame rate
+void testClockVideoPacing() {
+    FakeNDIBackend fake;
+    auto sender = fake.createSender(makeSettings(true));
+    std::vector<uint8_t> pixels(8 * 8 * 4);
+    auto frame = makeFrame(pixels.data(), 8, 8);
+    frame.frame_rate_N = 200;
+    frame.frame_rate_D = 1;
+
+    const int frames = 11;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) fake.sendVideo(sender, frame);
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    CHECK(elapsedMs >= (frames - 1) * 5.0 - 0.5);
+
+    auto records = fake.records();
+    CHECK_EQ(records.size(), (size_t)frames);
+    // Against the schedule rather than frame to frame: an oversleep on one
+    // frame is absorbed by the next, like the SDK's clock
+    for (size_t i = 1; i < records.size(); i++) {
+        CHECK(records[i].send_time_ns - records[0].send_time_ns >= i * 5000000u - 500000u);
+    }
+    fake.destroySender(sender);
+}
+
+// SoftwareNDIOutput keeps every async buffer alive until the next send and
+// flushes once on stop
+void testSoftwareOutputOwnership() {
+    for (NDIPixelFormat format : {NDIPixelFormat::BGRA, NDIPixelFormat::UYVA}) {
+        FakeNDIBackend::Options options;
+        options.simulate_clock = false;
+        auto fake = std::make_shared<FakeNDIBackend>(options);
+
+        SoftwareNDIOutput output(fake);
+        SoftwareNDIOutputConfig config;
+        config.clock_video = false;
+        config.pixel_format = format;
+        CHECK(output.configure(config));
+        output.setBufferObserver(fake->ownershipObserver());
+        CHECK(output.start());
+
+        const uint32_t width = 64, height = 36;
+        std::vector<uint8_t> pixels((size_t)width * height * 4);
+        for (int i = 0; i < 60; i++) {
+            memset(pixels.data(), i, pixels.size());
+            output.pushPixelData(pixels.data(), width, height, 0, (uint64_t)(i + 1) * 16666667, 60.0f);
+            if (i % 4 == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        output.stop();
+
+        CHECK(output.framesSent() > 0);
+        CHECK_EQ(fake->framesSent(), output.framesSent());
+        CHECK_EQ(fake->asyncFlushes(), 1u);
+        CHECK_EQ(fake->ownershipViolations(), 0u);
+        CHECK_EQ(fake->sendersAlive(), 0u);
+
+        auto records = fake->records();
+        CHECK(!records.empty());
+        CHECK_EQ(records[0].xres, (int)width);
+        CHECK_EQ(records[0].fourcc, format == NDIPixelFormat::BGRA ? NDIlib_FourCC_type_BGRA : NDIlib_FourCC_type_UYVA);
+    }
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testRecordsFrames);
+    RUN_TEST(testAsyncProtocolHasNoViolations);
+    RUN_TEST(testEarlyReleaseIsAViolation);
+    RUN_TEST(testSyncSendAndDestroyRetireAsync);
+    RUN_TEST(testObserverOutlivesBackend);
+    RUN_TEST(testClockVideoPacing);
+    RUN_TEST(testSoftwareOutputOwnership);
+    return testResult();
+}
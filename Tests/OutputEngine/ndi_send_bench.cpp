@@ -0,0 +1,103 @@
+// ndi_send_bench.cpp - NDI send path throughput, drop rate and pacing on FakeNDIBackend
+// SoftwareNDIOutput runs the same crop / prep / async send stages as NDIOutput
+// minus Metal, so this measures the whole CPU send path headless.
+//
+//   throughput: unclocked sender, producer pushes as fast as it can
+//   pacing:     clock_video sender at 59.94, producer pushes on its own 59.94 timer
+
+#include "ndi_backend.h"
+#include "software_ndi_output.h"
+#include "bench_support.h"
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace RocKontrol;
+using namespace BenchSupport;
+
+namespace {
+
+struct Run {
+    uint64_t pushed = 0;
+    uint64_t sent = 0;
+    uint64_t dropped = 0;
+    uint64_t violations = 0;
+    double seconds = 0;
+    std::vector<NDISentFrame> records;
+};
+
+Run runSender(uint32_t width, uint32_t height, NDIPixelFormat format, bool clocked, int frames) {
+    FakeNDIBackend::Options options;
+    options.simulate_clock = clocked;
+    auto fake = std::make_shared<FakeNDIBackend>(options);
+
+    SoftwareNDIOutput output(fake);
+    SoftwareNDIOutputConfig config;
+    config.clock_video = clocked;
+    config.pixel_format = format;
+    output.configure(config);
+    output.setBufferObserver(fake->ownershipObserver());
+    output.start();
+
+    std::vector<uint8_t> pixels((size_t)width * height * 4);
+    for (size_t i = 0; i < pixels.size(); i++) pixels[i] = (uint8_t)(i * 2654435761u >> 24);
+
+    const uint64_t interval = 1000000000ULL * 1001 / 60000;
+    Run run;
+    uint64_t start = nowNs();
+    for (int i = 0; i < frames; i++) {
+        if (clocked) {
+            uint64_t due = start + (uint64_t)i * interval;
+            uint64_t now = nowNs();
+            if (due > now) std::this_thread::sleep_for(std::chrono::nanoseconds(due - now));
+        }
+        if (output.pushPixelData(pixels.data(), width, height, 0, nowNs(), 59.94f)) run.pushed++;
+    }
+    // Let the send thread drain what is queued
+    uint64_t drainUntil = nowNs() + (clocked ? 4 * interval : 20000000ULL);
+    while (nowNs() < drainUntil && output.framesSent() + output.framesDropped() < run.pushed) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    run.seconds = (nowNs() - start) / 1e9;
+    output.stop();
+
+    run.sent = output.framesSent();
+    run.dropped = output.framesDropped();
+    run.violations = fake->ownershipViolations();
+    run.records = fake->records();
+    return run;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = quickMode(argc, argv);
+    const int throughputFrames = quick ? 20 : 600;
+    const int pacingFrames = quick ? 10 : 600;
+
+    struct Size { uint32_t w, h; };
+    std::vector<Size> sizes = {{1920, 1080}};
+    if (!quick) sizes.push_back({3840, 2160});
+
+    for (Size size : sizes) {
+        for (NDIPixelFormat format : {NDIPixelFormat::BGRA, NDIPixelFormat::UYVY, NDIPixelFormat::UYVA}) {
+            Run run = runSender(size.w, size.h, format, false, throughputFrames);
+            printf("throughput %-4s %ux%u  %7.1f fps sent  drop %5.1f%%  violations %llu\n",
+                   ndiPixelFormatToString(format), size.w, size.h, run.sent / run.seconds,
+                   run.pushed ? 100.0 * run.dropped / run.pushed : 0.0, (unsigned long long)run.violations);
+        }
+    }
+
+    Run run = runSender(1920, 1080, NDIPixelFormat::UYVY, true, pacingFrames);
+    std::vector<uint64_t> intervals;
+    for (size_t i = 1; i < run.records.size(); i++) {
+        intervals.push_back(run.records[i].send_time_ns - run.records[i - 1].send_time_ns);
+    }
+    uint64_t p50 = percentile(intervals, 0.50);
+    uint64_t p99 = percentile(intervals, 0.99);
+    uint64_t worst = intervals.empty() ? 0 : intervals.back();
+    printf("pacing     UYVY 1920x1080  interval p50 %.3f ms  p99 %.3f ms  max %.3f ms  drop %llu of %llu\n",
+           p50 / 1e6, p99 / 1e6, worst / 1e6,
+           (unsigned long long)run.dropped, (unsigned long long)run.pushed);
+    return 0;
+}
@@ -0,0 +1,238 @@
+// ndi_send_test.cpp - NDI output stages shared by NDIOutput and SoftwareNDIOutput
+// Crop resolution, edge blend normalization and NDI frame setup by hand, then
+// SoftwareNDIOutput end to end against the same stages run directly: what it
+// sends must match EdgeBlendRenderer (the CPU twin of the NDIOutput shader,
+// see edge_blend_golden_test) for the same crop, blend and intensity.
+
+#include "edge_blend_cpu.h"
+#include "ndi_backend.h"
+#include "ndi_send.h"
+#include "software_ndi_output.h"
+#include "test_support.h"
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace RocKontrol;
+
+namespace {
+
+constexpr uint32_t kSrcWidth = 320;
+constexpr uint32_t kSrcHeight = 180;
+
+uint64_t fnv1a(const uint8_t* data, size_t size) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::vector<uint8_t> makeSource() {
+    std::vector<uint8_t> pixels((size_t)kSrcWidth * kSrcHeight * 4);
+    for (uint32_t y = 0; y < kSrcHeight; y++) {
+        for (uint32_t x = 0; x < kSrcWidth; x++) {
+            uint8_t* p = &pixels[((size_t)y * kSrcWidth + x) * 4];
+            p[0] = (uint8_t)(x * 3 + y);
+            p[1] = (uint8_t)(y * 5);
+            p[2] = (uint8_t)(x ^ y);
+            p[3] = 255;
+        }
+    }
+    return pixels;
+}
+
+// Push one frame through a sync sender and return what went on the wire
+NDISentFrame sendOne(SoftwareNDIOutput& output, FakeNDIBackend& backend, const std::vector<uint8_t>& pixels) {
+    uint64_t before = backend.framesSent();
+    CHECK(output.pushPixelData(pixels.data(), kSrcWidth, kSrcHeight, 0, 16683333, 59.94f));
+    for (int i = 0; i < 2000 && backend.framesSent() == before; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::vector<NDISentFrame> records = backend.records();
+    CHECK(!records.empty());
+    return records.empty() ? NDISentFrame() : records.back();
+}
+
+void testFrameRateTable() {
+    const struct { float fps; int n; int d; } cases[] = {
+        {59.94f, 60000, 1001}, {60.0f, 60000, 1001}, {29.97f, 30000, 1001}, {30.0f, 30000, 1001},
+        {23.976f, 24000, 1001}, {24.0f, 24000, 1001}, {25.0f, 25000, 1000}, {50.0f, 50000, 1000},
+    };
+    for (const auto& c : cases) {
+        NDIlib_video_frame_v2_t frame;
+        setNDIFrameRate(frame, c.fps);
+        CHECK_EQ(frame.frame_rate_N, c.n);
+        CHECK_EQ(frame.frame_rate_D, c.d);
+    }
+}
+
+void testVideoFrame() {
+    PixelBufferPool pool;
+    NDIPixelFrame frame;
+    frame.data = pool.acquire(64 * 36 * 4);
+    frame.width = 64;
+    frame.height = 36;
+    frame.line_stride = 64 * 4;
+    frame.timestamp_ns = 1000000;
+
+    NDIlib_video_frame_v2_t ndi = ndiVideoFrame(frame, 25.0f);
+    CHECK_EQ(ndi.xres, 64);
+    CHECK_EQ(ndi.yres, 36);
+    CHECK_EQ(ndi.line_stride_in_bytes, 256);
+    CHECK(ndi.p_data == frame.data.data());
+    CHECK_EQ(ndi.frame_rate_N, 25000);
+    CHECK_EQ(ndi.timecode, (int64_t)10000);
+    CHECK_NEAR(ndi.picture_aspect_ratio, 64.0f / 36.0f, 1e-6);
+
+    // No rate = 59.94, no timestamp = synthesized
+    frame.timestamp_ns = 0;
+    ndi = ndiVideoFrame(frame, 0.0f);
+    CHECK_EQ(ndi.frame_rate_N, 60000);
+    CHECK_EQ(ndi.frame_rate_D, 1001);
+    CHECK_EQ(ndi.timecode, (int64_t)NDIlib_send_timecode_synthesize);
+}
+
+void testCropPixels() {
+    SoftwareNDIOutput output(std::make_shared<FakeNDIBackend>());
+    PixelCrop crop = output.cropPixels(400, 200);
+    CHECK_EQ(crop.x, 0u);
+    CHECK_EQ(crop.w, 400u);
+    CHECK_EQ(crop.h, 200u);
+
+    output.setCrop(0.25f, 0.5f, 0.5f, 0.25f);
+    crop = output.cropPixels(400, 200);
+    CHECK_EQ(crop.x, 100u);
+    CHECK_EQ(crop.y, 100u);
+    CHECK_EQ(crop.w, 200u);
+    CHECK_EQ(crop.h, 50u);
+
+    // Overhanging and empty sizes run to the edge, an origin past it falls back to 0
+    output.setCrop(0.75f, 1.5f, 0.5f, 0.0f);
+    crop = output.cropPixels(400, 200);
+    CHECK_EQ(crop.x, 300u);
+    CHECK_EQ(crop.w, 100u);
+    CHECK_EQ(crop.y, 0u);
+    CHECK_EQ(crop.h, 200u);
+}
+
+void testBlendNormalization() {
+    SoftwareNDIOutput output(std::make_shared<FakeNDIBackend>());
+    output.setEdgeBlend(20, 40, 10, 5, 1.8f, 1.5f, 0.05f, 1, 1, 1,
+                        8, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -16, 10,
+                        0.3f, 0.1f, -0.05f, 0.45f, 0.55f, 2);
+    PixelCrop crop = {100, 50, 200, 100};
+    EdgeBlendSettings s = edgeBlendSettingsFor(output.currentEdgeBlend(), crop, 400, 200, 0.75f);
+
+    CHECK_NEAR(s.featherLeft, 0.1f, 1e-6);
+    CHECK_NEAR(s.featherRight, 0.2f, 1e-6);
+    CHECK_NEAR(s.featherTop, 0.1f, 1e-6);
+    CHECK_NEAR(s.featherBottom, 0.05f, 1e-6);
+    CHECK_NEAR(s.gamma, 1.8f, 1e-6);
+    CHECK_NEAR(s.power, 1.5f, 1e-6);
+    CHECK_NEAR(s.blackLevel, 0.05f, 1e-6);
+    CHECK_EQ(s.activeCorner, 2);
+    CHECK_NEAR(s.intensity, 0.75f, 1e-6);
+
+    const WarpGeometry& g = s.geometry;
+    CHECK_NEAR(g.warp[0][0], 0.04f, 1e-6);      // Top left
+    CHECK_NEAR(g.warp[0][1], 0.04f, 1e-6);
+    CHECK_NEAR(g.warp[7][0], -0.08f, 1e-6);     // Bottom right
+    CHECK_NEAR(g.warp[7][1], 0.1f, 1e-6);
+    CHECK_NEAR(g.curvature, 0.3f, 1e-6);
+    CHECK_NEAR(g.lensK1, 0.1f, 1e-6);
+    CHECK_NEAR(g.lensK2, -0.05f, 1e-6);
+    CHECK_NEAR(g.lensCenterX, 0.45f, 1e-6);
+    CHECK_NEAR(g.lensCenterY, 0.55f, 1e-6);
+    CHECK_NEAR(g.cropOriginX, 0.25f, 1e-6);
+    CHECK_NEAR(g.cropOriginY, 0.25f, 1e-6);
+    CHECK_NEAR(g.cropSizeX, 0.5f, 1e-6);
+    CHECK_NEAR(g.cropSizeY, 0.5f, 1e-6);
+}
+
+// Blend path: the sink's bytes are EdgeBlendRenderer's for the same settings
+void testSinkMatchesRenderer() {
+    FakeNDIBackend::Options options;
+    options.simulate_clock = false;
+    options.checksum_frames = true;
+    auto backend = std::make_shared<FakeNDIBackend>(options);
+
+    SoftwareNDIOutput output(backend);
+    SoftwareNDIOutputConfig config;
+    config.async_send = false;
+    CHECK(output.configure(config));
+    output.setCrop(0.125f, 0.1f, 0.5f, 0.75f);
+    output.setEdgeBlend(24, 12, 0, 16, 2.2f, 1.3f, 0.02f, 1, 1, 1,
+                        6, -3, 0, 2, -4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                        0.2f, 0.05f, 0.0f, 0.5f, 0.5f, 0);
+    output.setIntensity(0.6f);
+    CHECK(output.start());
+
+    std::vector<uint8_t> pixels = makeSource();
+    NDISentFrame sent = sendOne(output, *backend, pixels);
+    output.stop();
+
+    PixelCrop crop = output.cropPixels(kSrcWidth, kSrcHeight);
+    EdgeBlendSettings settings = edgeBlendSettingsFor(output.currentEdgeBlend(), crop,
+                                                      kSrcWidth, kSrcHeight, output.intensity());
+    std::vector<uint8_t> expected((size_t)crop.w * crop.h * 4);
+    EdgeBlendRenderer renderer;
+    CHECK(renderer.render(settings, pixels.data(), kSrcWidth, kSrcHeight, (size_t)kSrcWidth * 4,
+                          expected.data(), crop.w, crop.h, (size_t)crop.w * 4));
+
+    CHECK_EQ(sent.xres, (int)crop.w);
+    CHECK_EQ(sent.yres, (int)crop.h);
+    CHECK_EQ(sent.checksum, fnv1a(expected.data(), expected.size()));
+}
+
+// No blend: a straight crop with the intensity LUT of pixel prep
+void testSinkCropAndIntensity() {
+    FakeNDIBackend::Options options;
+    options.simulate_clock = false;
+    options.checksum_frames = true;
+    auto backend = std::make_shared<FakeNDIBackend>(options);
+
+    SoftwareNDIOutput output(backend);
+    SoftwareNDIOutputConfig config;
+    config.async_send = false;
+    CHECK(output.configure(config));
+    output.setCrop(0.5f, 0.25f, 0.25f, 0.5f);
+    output.setIntensity(0.5f);
+    CHECK(output.start());
+
+    std::vector<uint8_t> pixels = makeSource();
+    NDISentFrame sent = sendOne(output, *backend, pixels);
+    output.stop();
+
+    const uint32_t cropX = 160, cropY = 45, cropW = 80, cropH = 90;
+    const int scale = 128;   // lround(0.5 * 256)
+    std::vector<uint8_t> expected((size_t)cropW * cropH * 4);
+    for (uint32_t y = 0; y < cropH; y++) {
+        for (uint32_t x = 0; x < cropW; x++) {
+            const uint8_t* s = &pixels[((size_t)(cropY + y) * kSrcWidth + cropX + x) * 4];
+            uint8_t* d = &expected[((size_t)y * cropW + x) * 4];
+            for (int c = 0; c < 3; c++) d[c] = (uint8_t)((s[c] * scale + 128) >> 8);
+            d[3] = s[3];
+        }
+    }
+
+    CHECK_EQ(sent.xres, (int)cropW);
+    CHECK_EQ(sent.yres, (int)cropH);
+    CHECK_EQ(sent.frame_rate_N, 60000);
+    CHECK_EQ(sent.frame_rate_D, 1001);
+    CHECK_EQ(sent.checksum, fnv1a(expected.data(), expected.size()));
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testFrameRateTable);
+    RUN_TEST(testVideoFrame);
+    RUN_TEST(testCropPixels);
+    RUN_TEST(testBlendNormalization);
+    RUN_TEST(testSinkMatchesRenderer);
+    RUN_TEST(testSinkCropAndIntensity);
+    return testResult();
+}
@@ -0,0 +1,40 @@
+// pixel_convert_bench.cpp - BGRA -> UYVY throughput per kernel path
+
+#include "pixel_convert.h"
+#include "bench_support.h"
+#include <cstdio>
+#include <vector>
+
+using namespace RocKontrol;
+using namespace BenchSupport;
+
+int main(int argc, char** argv) {
+    const int runs = quickMode(argc, argv) ? 2 : 30;
+    const struct { uint32_t width, height; } sizes[] = {{1920, 1080}, {3840, 2160}};
+    const ConvertPath paths[] = {ConvertPath::Scalar, ConvertPath::SSE2, ConvertPath::AVX2, ConvertPath::NEON};
+
+    for (auto size : sizes) {
+        std::vector<uint8_t> src((size_t)size.width * size.height * 4);
+        for (size_t i = 0; i < src.size(); i++) src[i] = (uint8_t)(i * 2654435761u >> 24);
+        std::vector<uint8_t> dst(convertedFrameSize(NDIPixelFormat::UYVA, size.width, size.height));
+        size_t uyvyStride = uyvyLineStride(size.width);
+
+        for (ConvertPath path : paths) {
+            if (!convertPathAvailable(path)) continue;
+            uint64_t ns = bestOf(runs, [&] {
+                convertBGRAToUYVY(src.data(), size.width * 4, dst.data(), uyvyStride,
+                                  size.width, size.height, ColorMatrix::BT709, path);
+            });
+            double mpix = (double)size.width * size.height / ((double)ns / 1e3);
+            printf("UYVY %4ux%-4u %-6s %8.3f ms  %8.1f Mpix/s\n", size.width, size.height,
+                   convertPathName(path), ns / 1e6, mpix);
+        }
+
+        uint64_t ns = bestOf(runs, [&] {
+            extractAlphaPlane(src.data(), size.width * 4, dst.data() + uyvyStride * size.height, size.width,
+                              size.width, size.height);
+        });
+        printf("alpha %4ux%-4u        %8.3f ms\n", size.width, size.height, ns / 1e6);
+    }
+    return 0;
+}
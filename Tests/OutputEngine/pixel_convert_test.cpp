@@ -0,0 +1,158 @@
+// pixel_convert_test.cpp - SIMD BGRA -> UYVY kernels against the scalar reference
+
+#include "pixel_convert.h"
+#include "test_support.h"
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace RocKontrol;
+
+namespace {
+
+const ConvertPath kSimdPaths[] = {ConvertPath::SSE2, ConvertPath::AVX2, ConvertPath::NEON};
+const ColorMatrix kMatrices[] = {ColorMatrix::BT709, ColorMatrix::BT601};
+
+std::vector<uint8_t> randomImage(uint32_t rows, size_t stride, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> image(stride * rows);
+    for (auto& byte : image) byte = (uint8_t)rng();
+    return image;
+}
+
+std::vector<uint8_t> convert(const std::vector<uint8_t>& src, size_t srcStride, uint32_t width, uint32_t rows,
+                             ColorMatrix matrix, ConvertPath path) {
+    // Padding after each row must survive untouched
+    size_t dstStride = uyvyLineStride(width) + 8;
+    std::vector<uint8_t> dst(dstStride * rows, 0xA5);
+    convertBGRAToUYVY(src.data(), srcStride, dst.data(), dstStride, width, rows, matrix, path);
+    return dst;
+}
+
+// Every available SIMD path is byte-identical to Scalar, for every width
+// remainder the vector loops hand to the scalar tail and for padded strides
+void testSimdMatchesScalar() {
+    for (ConvertPath path : kSimdPaths) {
+        if (!convertPathAvailable(path)) {
+            fprintf(stderr, "  %s not available on this CPU - skipped\n", convertPathName(path));
+            continue;
+        }
+        for (ColorMatrix matrix : kMatrices) {
+            for (uint32_t width = 1; width <= 70; width++) {
+                uint32_t rows = 3;
+                size_t stride = (size_t)width * 4 + (width % 3) * 4;
+                auto src = randomImage(rows, stride, width * 31 + (uint32_t)matrix);
+                auto expected = convert(src, stride, width, rows, matrix, ConvertPath::Scalar);
+                auto actual = convert(src, stride, width, rows, matrix, path);
+                CHECK(expected == actual);
+            }
+            auto src = randomImage(4, 1920 * 4, 7);
+            CHECK(convert(src, 1920 * 4, 1920, 4, matrix, ConvertPath::Scalar) ==
+                  convert(src, 1920 * 4, 1920, 4, matrix, path));
+        }
+    }
+}
+
+// Saturated extremes (all 0 and all 255 in every channel combination)
+void testSimdMatchesScalarAtExtremes() {
+    std::vector<uint8_t> src;
+    for (int i = 0; i < 64; i++) {
+        src.push_back((i & 1) ? 255 : 0);
+        src.push_back((i & 2) ? 255 : 0);
+        src.push_back((i & 4) ? 255 : 0);
+        src.push_back((i & 8) ? 255 : 0);
+    }
+    for (ConvertPath path : kSimdPaths) {
+        if (!convertPathAvailable(path)) continue;
+        for (ColorMatrix matrix : kMatrices) {
+            CHECK(convert(src, 64 * 4, 64, 1, matrix, ConvertPath::Scalar) == convert(src, 64 * 4, 64, 1, matrix, path));
+        }
+    }
+}
+
+// The fixed-point formula stays within one code value of the exact
+// limited-range transform
+void testScalarMatchesReferenceFormula() {
+    const double matrices[2][2] = {{0.2126, 0.0722}, {0.299, 0.114}};
+    for (int m = 0; m < 2; m++) {
+        double kr = matrices[m][0], kb = matrices[m][1], kg = 1.0 - kr - kb;
+        auto src = randomImage(8, 64 * 4, 99 + m);
+        auto dst = convert(src, 64 * 4, 64, 8, kMatrices[m], ConvertPath::Scalar);
+        size_t dstStride = uyvyLineStride(64) + 8;
+
+        for (uint32_t row = 0; row < 8; row++) {
+            for (uint32_t x = 0; x < 64; x += 2) {
+                const uint8_t* p0 = &src[row * 64 * 4 + x * 4];
+                const uint8_t* p1 = p0 + 4;
+                const uint8_t* out = &dst[row * dstStride + x * 2];
+
+                auto luma = [&](const uint8_t* p) {
+                    return 16.0 + 219.0 * (kr * p[2] + kg * p[1] + kb * p[0]) / 255.0;
+                };
+                double r = (p0[2] + p1[2]) / 2.0, g = (p0[1] + p1[1]) / 2.0, b = (p0[0] + p1[0]) / 2.0;
+                double y = kr * r + kg * g + kb * b;
+                double u = 128.0 + 224.0 * ((b - y) / (2.0 * (1.0 - kb))) / 255.0;
+                double v = 128.0 + 224.0 * ((r - y) / (2.0 * (1.0 - kr))) / 255.0;
+
+                CHECK_NEAR(out[1], luma(p0), 1.0);
+                CHECK_NEAR(out[3], luma(p1), 1.0);
+                CHECK_NEAR(out[0], u, 1.0);
+                CHECK_NEAR(out[2], v, 1.0);
+            }
+        }
+    }
+}
+
+void testBlackAndWhite() {
+    const uint8_t pixels[] = {0, 0, 0, 255, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255};
+    uint8_t out[8];
+    for (ColorMatrix matrix : kMatrices) {
+        convertBGRAToUYVY(pixels, sizeof(pixels), out, sizeof(out), 4, 1, matrix, ConvertPath::Auto);
+        const uint8_t expected[] = {128, 16, 128, 16, 128, 235, 128, 235};
+        CHECK(memcmp(out, expected, sizeof(out)) == 0);
+    }
+}
+
+// Odd widths repeat the last pixel into the final pair
+void testOddWidthPadsLastPair() {
+    const uint8_t pixels[] = {10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120};
+    const uint8_t doubled[] = {10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110, 120, 90, 100, 110, 120};
+    uint8_t odd[8], even[8];
+    convertBGRAToUYVY(pixels, sizeof(pixels), odd, sizeof(odd), 3, 1, ColorMatrix::BT709, ConvertPath::Scalar);
+    convertBGRAToUYVY(doubled, sizeof(doubled), even, sizeof(even), 4, 1, ColorMatrix::BT709, ConvertPath::Scalar);
+    CHECK(memcmp(odd, even, sizeof(odd)) == 0);
+}
+
+void testAlphaPlane() {
+    auto src = randomImage(5, 13 * 4 + 4, 5);
+    std::vector<uint8_t> plane(16 * 5, 0);
+    extractAlphaPlane(src.data(), 13 * 4 + 4, plane.data(), 16, 13, 5);
+    for (uint32_t row = 0; row < 5; row++) {
+        for (uint32_t x = 0; x < 13; x++) {
+            CHECK_EQ(plane[row * 16 + x], src[row * (13 * 4 + 4) + x * 4 + 3]);
+        }
+        CHECK_EQ(plane[row * 16 + 13], 0);
+    }
+}
+
+void testFrameSizes() {
+    CHECK_EQ(uyvyLineStride(1919), 3840u);
+    CHECK_EQ(convertedFrameSize(NDIPixelFormat::BGRA, 1920, 1080), 1920u * 1080 * 4);
+    CHECK_EQ(convertedFrameSize(NDIPixelFormat::UYVY, 1920, 1080), 1920u * 1080 * 2);
+    CHECK_EQ(convertedFrameSize(NDIPixelFormat::UYVA, 1920, 1080), 1920u * 1080 * 3);
+    CHECK(convertPathAvailable(ConvertPath::Scalar));
+    CHECK(resolveConvertPath(ConvertPath::Auto) != ConvertPath::Auto);
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testSimdMatchesScalar);
+    RUN_TEST(testSimdMatchesScalarAtExtremes);
+    RUN_TEST(testScalarMatchesReferenceFormula);
+    RUN_TEST(testBlackAndWhite);
+    RUN_TEST(testOddWidthPadsLastPair);
+    RUN_TEST(testAlphaPlane);
+    RUN_TEST(testFrameSizes);
+    return testResult();
+}
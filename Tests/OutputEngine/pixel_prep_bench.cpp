@@ -0,0 +1,103 @@
+// pixel_prep_bench.cpp - 1 -> N core scaling of the NDI pixel prep stage
+// A 7680x1080 panoramic canvas is cropped, intensity scaled and converted with
+// 0..N pool workers (plus the calling thread); speedup is relative to inline.
+// Then 1..8 outputs each prep their own 1080p UYVY feed on one shared pool,
+// concurrently and - as before concurrent dispatch - one parallelFor at a time.
+
+#include "band_worker_pool.h"
+#include "pixel_prep.h"
+#include "bench_support.h"
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace RocKontrol;
+using namespace BenchSupport;
+
+namespace {
+
+// Frames per second across all outputs, each on its own thread
+double multiOutputFps(BandWorkerPool& pool, uint32_t outputs, int frames, bool serialize,
+                      const std::vector<uint8_t>& src, uint32_t width, uint32_t height) {
+    std::mutex serialMutex;
+    std::vector<std::vector<uint8_t>> dst(outputs, std::vector<uint8_t>(uyvyLineStride(width) * height));
+    std::vector<std::thread> threads;
+    uint64_t start = nowNs();
+    for (uint32_t o = 0; o < outputs; o++) {
+        threads.emplace_back([&, o] {
+            PixelPrep stage(pool);
+            PixelPrepJob job;
+            job.src = src.data();
+            job.srcStride = (size_t)width * 4;
+            job.width = width;
+            job.height = height;
+            job.intensity = 0.8f;
+            job.format = NDIPixelFormat::UYVY;
+            job.dst = dst[o].data();
+            job.dstStride = uyvyLineStride(width);
+            for (int f = 0; f < frames; f++) {
+                if (serialize) {
+                    std::lock_guard<std::mutex> lock(serialMutex);
+                    stage.run(job);
+                } else {
+                    stage.run(job);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    return (double)outputs * frames * 1e9 / (double)(nowNs() - start);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = quickMode(argc, argv);
+    const int runs = quick ? 2 : 20;
+    const uint32_t width = 7680, height = 1080;
+    size_t maxWorkers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    if (quick) maxWorkers = std::min<size_t>(maxWorkers, 1);
+
+    std::vector<uint8_t> src((size_t)width * height * 4);
+    for (size_t i = 0; i < src.size(); i++) src[i] = (uint8_t)(i * 2654435761u >> 24);
+    std::vector<uint8_t> dst(convertedFrameSize(NDIPixelFormat::BGRA, width, height));   // Largest format
+
+    for (NDIPixelFormat format : {NDIPixelFormat::BGRA, NDIPixelFormat::UYVY, NDIPixelFormat::UYVA}) {
+        uint64_t inlineNs = 0;
+        for (size_t workers = 0; workers <= maxWorkers; workers++) {
+            BandWorkerPool pool(workers);
+            PixelPrep stage(pool);
+
+            PixelPrepJob job;
+            job.src = src.data();
+            job.srcStride = (size_t)width * 4;
+            job.width = width;
+            job.height = height;
+            job.intensity = 0.8f;
+            job.format = format;
+            job.dst = dst.data();
+            job.dstStride = format == NDIPixelFormat::BGRA ? (size_t)width * 4 : uyvyLineStride(width);
+            job.dstAlpha = dst.data() + uyvyLineStride(width) * height;
+            job.dstAlphaStride = width;
+
+            uint64_t ns = bestOf(runs, [&] { stage.run(job); });
+            if (workers == 0) inlineNs = ns;
+            printf("%-4s %ux%u threads=%2zu  %8.3f ms  speedup %.2fx\n", ndiPixelFormatToString(format),
+                   width, height, workers + 1, ns / 1e6, (double)inlineNs / (double)ns);
+        }
+    }
+
+    // Multi-output: a 1080p feed per output on the shared pool
+    const uint32_t feedWidth = 1920, feedHeight = 1080;
+    const int frames = quick ? 4 : 200;
+    BandWorkerPool shared(std::max<size_t>(maxWorkers, 1));
+    printf("hardware threads %u, pool workers %zu\n", std::thread::hardware_concurrency(), shared.workerCount());
+    for (uint32_t outputs : {1u, 2u, 4u, 8u}) {
+        double serial = multiOutputFps(shared, outputs, frames, true, src, feedWidth, feedHeight);
+        double concurrent = multiOutputFps(shared, outputs, frames, false, src, feedWidth, feedHeight);
+        printf("outputs=%u  1080p UYVY  serialized %7.1f fps  concurrent %7.1f fps  %.2fx\n",
+               outputs, serial, concurrent, concurrent / serial);
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+// pixel_prep_test.cpp - BandWorkerPool coverage and band-count independent PixelPrep output
+
+#include "band_worker_pool.h"
+#include "pixel_prep.h"
+#include "test_support.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace RocKontrol;
+
+namespace {
+
+void testParallelForCoversEveryIndexOnce() {
+    for (size_t workers : {0u, 1u, 3u, 7u}) {
+        BandWorkerPool pool(workers);
+        CHECK_EQ(pool.workerCount(), workers);
+        for (uint32_t count : {0u, 1u, 2u, 5u, 64u, 1000u}) {
+            std::vector<std::atomic<int>> hits(count);
+            pool.parallelFor(count, [&](uint32_t i) { hits[i].fetch_add(1); });
+            bool once = true;
+            for (auto& h : hits) once = once && h.load() == 1;
+            CHECK(once);
+        }
+    }
+}
+
+// parallelFor from several threads at once: every job still covers each of
+// its indices exactly once, whether it got a slot or ran inline
+void testConcurrentCallersCoverTheirJobs() {
+    BandWorkerPool pool(3);
+    const int kCallers = BandWorkerPool::kMaxJobs + 2;
+    std::atomic<int> wrong{0};
+
+    std::vector<std::thread> callers;
+    for (int c = 0; c < kCallers; c++) {
+        callers.emplace_back([&, c] {
+            std::vector<std::atomic<int>> hits(64);
+            for (int round = 0; round < 100; round++) {
+                uint32_t count = 1 + (uint32_t)(round * 7 + c) % 64;
+                for (auto& h : hits) h.store(0);
+                pool.parallelFor(count, [&](uint32_t i) { hits[i].fetch_add(1); });
+                for (uint32_t i = 0; i < 64; i++) {
+                    if (hits[i].load() != (i < count ? 1 : 0)) wrong++;
+                }
+            }
+        });
+    }
+    for (auto& t : callers) t.join();
+    CHECK_EQ(wrong.load(), 0);
+}
+
+// Two callers are not serialized: each job's bands wait until the other job
+// has started, which would time out if one parallelFor blocked the other
+void testConcurrentCallersRunTogether() {
+    BandWorkerPool pool(2);
+    std::atomic<bool> started[2] = {{false}, {false}};
+    std::atomic<int> timedOut{0};
+
+    auto caller = [&](int self) {
+        pool.parallelFor(4, [&](uint32_t) {
+            started[self].store(true);
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (!started[1 - self].load()) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    timedOut++;
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        });
+    };
+    std::thread a(caller, 0);
+    std::thread b(caller, 1);
+    a.join();
+    b.join();
+    CHECK_EQ(timedOut.load(), 0);
+}
+
+struct Frame {
+    uint32_t width, height;
+    std::vector<uint8_t> pixels;
+    size_t stride;
+};
+
+Frame makeFrame(uint32_t width, uint32_t height) {
+    Frame frame{width, height, {}, (size_t)width * 4 + 12};
+    frame.pixels.resize(frame.stride * height);
+    std::mt19937 rng(width ^ (height << 8));
+    for (auto& byte : frame.pixels) byte = (uint8_t)rng();
+    return frame;
+}
+
+void readFromFrame(void* context, uint32_t x, uint32_t y, uint32_t width, uint32_t rows,
+                   uint8_t* dst, size_t dstStride) {
+    const Frame* frame = static_cast<const Frame*>(context);
+    for (uint32_t r = 0; r < rows; r++) {
+        memcpy(dst + r * dstStride, frame->pixels.data() + (size_t)(y + r) * frame->stride + (size_t)x * 4,
+               (size_t)width * 4);
+    }
+}
+
+std::vector<uint8_t> prep(PixelPrep& prep, const Frame& frame, NDIPixelFormat format, float intensity,
+                          uint32_t bands, bool useReader) {
+    PixelPrepJob job;
+    if (useReader) {
+        job.readRows = readFromFrame;
+        job.readContext = const_cast<Frame*>(&frame);
+    } else {
+        job.src = frame.pixels.data();
+        job.srcStride = frame.stride;
+    }
+    job.cropX = 5;
+    job.cropY = 3;
+    job.width = frame.width - 11;
+    job.height = frame.height - 7;
+    job.intensity = intensity;
+    job.format = format;
+
+    std::vector<uint8_t> out(convertedFrameSize(format, job.width, job.height));
+    job.dst = out.data();
+    if (format == NDIPixelFormat::BGRA) {
+        job.dstStride = (size_t)job.width * 4;
+    } else {
+        job.dstStride = uyvyLineStride(job.width);
+        job.dstAlpha = out.data() + job.dstStride * job.height;
+        job.dstAlphaStride = job.width;
+    }
+
+    prep.setBandCount(bands);
+    CHECK(prep.run(job));
+    return out;
+}
+
+// Output is byte-identical for any band count, pool size and source kind
+void testOutputIndependentOfBands() {
+    Frame frame = makeFrame(333, 517);
+    BandWorkerPool inlinePool(0);
+    BandWorkerPool pool(5);
+    PixelPrep reference(inlinePool);
+    PixelPrep banded(pool);
+
+    for (NDIPixelFormat format : {NDIPixelFormat::BGRA, NDIPixelFormat::UYVY, NDIPixelFormat::UYVA}) {
+        for (float intensity : {1.0f, 0.5f, 0.0f}) {
+            auto expected = prep(reference, frame, format, intensity, 1, false);
+            for (uint32_t bands : {0u, 2u, 3u, 7u, 16u, 64u}) {
+                CHECK(prep(banded, frame, format, intensity, bands, false) == expected);
+                CHECK(prep(banded, frame, format, intensity, bands, true) == expected);
+            }
+        }
+    }
+}
+
+// BGRA prep is a crop plus intensity on RGB only
+void testBGRACropAndIntensity() {
+    Frame frame = makeFrame(64, 40);
+    BandWorkerPool pool(2);
+    PixelPrep stage(pool);
+    auto out = prep(stage, frame, NDIPixelFormat::BGRA, 0.5f, 0, false);
+
+    uint32_t width = 64 - 11;
+    for (uint32_t y = 0; y < 40 - 7; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            const uint8_t* s = &frame.pixels[(y + 3) * frame.stride + (x + 5) * 4];
+            const uint8_t* d = &out[(y * width + x) * 4];
+            for (int c = 0; c < 3; c++) CHECK_EQ(d[c], (uint8_t)((s[c] * 128 + 128) >> 8));
+            CHECK_EQ(d[3], s[3]);
+        }
+    }
+}
+
+void testRejectsInvalidJobs() {
+    BandWorkerPool pool(0);
+    PixelPrep stage(pool);
+    uint8_t pixel[4] = {};
+
+    PixelPrepJob job;
+    CHECK(!stage.run(job));
+    job.width = 1;
+    job.height = 1;
+    job.dst = pixel;
+    CHECK(!stage.run(job));                // No source
+    job.src = pixel;
+    job.format = NDIPixelFormat::UYVA;
+    CHECK(!stage.run(job));                // No alpha plane
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testParallelForCoversEveryIndexOnce);
+    RUN_TEST(testConcurrentCallersCoverTheirJobs);
+    RUN_TEST(testConcurrentCallersRunTogether);
+    RUN_TEST(testOutputIndependentOfBands);
+    RUN_TEST(testBGRACropAndIntensity);
+    RUN_TEST(testRejectsInvalidJobs);
+    return testResult();
+}
@@ -0,0 +1,256 @@
+// warp_map_test.cpp - WarpMap / warpSourceUV against the edge blend shader's own math
+// edgeBlendShaderSource is compiled as C++ (see msl_cpu.h), so warpSourceCoord,
+// warpMapFragment and edgeBlendMappedFragment here are the shader text itself.
+
+#include "warp_map.h"
+#include "band_worker_pool.h"
+#include "msl_cpu.h"
+#include "test_support.h"
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace metal { namespace edge_blend {
+#include "edgeBlendShaderSource.metal"
+} }
+
+using namespace RocKontrol;
+using metal::float2;
+using metal::float4;
+namespace shader = metal::edge_blend;
+
+namespace {
+
+shader::EdgeBlendParams shaderParams(const WarpGeometry& g) {
+    shader::EdgeBlendParams p = {};
+    p.gamma = 1.0f;
+    p.power = 1.0f;
+    p.intensity = 1.0f;
+    p.cropOrigin = float2(g.cropOriginX, g.cropOriginY);
+    p.cropSize = float2(g.cropSizeX, g.cropSizeY);
+    float2* warp[WarpGeometry::PointCount] = {
+        &p.warpTopLeft, &p.warpTopMiddle, &p.warpTopRight, &p.warpMiddleLeft,
+        &p.warpMiddleRight, &p.warpBottomLeft, &p.warpBottomMiddle, &p.warpBottomRight
+    };
+    for (int i = 0; i < WarpGeometry::PointCount; i++) *warp[i] = float2(g.warp[i][0], g.warp[i][1]);
+    p.lensK1 = g.lensK1;
+    p.lensK2 = g.lensK2;
+    p.lensCenter = float2(g.lensCenterX, g.lensCenterY);
+    p.warpCurvature = g.curvature;
+    return p;
+}
+
+// Keystone, bowed edges, dome curvature, lens and crop - alone and combined
+std::vector<WarpGeometry> geometries() {
+    std::vector<WarpGeometry> list;
+    list.push_back(WarpGeometry());
+
+    WarpGeometry keystone;
+    keystone.warp[WarpGeometry::TopLeft][0] = 0.12f;
+    keystone.warp[WarpGeometry::TopRight][0] = -0.12f;
+    list.push_back(keystone);
+
+    WarpGeometry bowed;
+    bowed.warp[WarpGeometry::TopMiddle][1] = 0.08f;
+    bowed.warp[WarpGeometry::BottomMiddle][1] = -0.05f;
+    bowed.warp[WarpGeometry::MiddleLeft][0] = 0.04f;
+    list.push_back(bowed);
+
+    for (float curvature : {0.6f, -0.4f}) {
+        WarpGeometry dome;
+        dome.curvature = curvature;
+        list.push_back(dome);
+    }
+
+    WarpGeometry lens;
+    lens.lensK1 = 0.25f;
+    lens.lensK2 = -0.1f;
+    lens.lensCenterX = 0.45f;
+    list.push_back(lens);
+
+    WarpGeometry cropped;
+    cropped.cropOriginX = 0.25f;
+    cropped.cropOriginY = 0.1f;
+    cropped.cropSizeX = 0.5f;
+    cropped.cropSizeY = 0.8f;
+    list.push_back(cropped);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> offset(-0.15f, 0.15f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (int i = 0; i < 12; i++) {
+        WarpGeometry g;
+        for (auto& point : g.warp) {
+            point[0] = offset(rng);
+            point[1] = offset(rng);
+        }
+        g.curvature = i % 3 == 0 ? 0.0f : unit(rng) * 0.5f;
+        g.lensK1 = i % 2 ? unit(rng) * 0.3f : 0.0f;
+        g.lensK2 = i % 4 == 1 ? unit(rng) * 0.1f : 0.0f;
+        g.cropOriginX = 0.1f;
+        g.cropSizeX = 0.8f;
+        list.push_back(g);
+    }
+    return list;
+}
+
+// warpSourceUV == shader warpSourceCoord at the same UV, inside and outside
+void testSourceUVMatchesShader() {
+    int compared = 0;
+    int outside = 0;
+    for (const WarpGeometry& g : geometries()) {
+        shader::EdgeBlendParams params = shaderParams(g);
+        for (int j = 0; j <= 96; j++) {
+            for (int i = 0; i <= 96; i++) {
+                float u = i / 96.0f;
+                float v = j / 96.0f;
+                float su = 0.0f, sv = 0.0f;
+                bool inside = warpSourceUV(g, u, v, su, sv);
+                float2 expected = shader::warpSourceCoord(float2(u, v), params);
+
+                CHECK_EQ(inside, expected.x >= 0.0f);
+                if (inside) {
+                    CHECK_NEAR(su, expected.x, 1e-6);
+                    CHECK_NEAR(sv, expected.y, 1e-6);
+                } else {
+                    outside++;
+                }
+                compared++;
+            }
+        }
+    }
+    CHECK(compared > 0);
+    CHECK(outside > 0);   // Keystones and curvature do leave black borders
+}
+
+// WarpMap::build == warpMapFragment rasterized through edgeBlendVertex
+void testMapMatchesWarpMapPass() {
+    const uint32_t width = 160, height = 90;
+    BandWorkerPool pool(3);
+    for (const WarpGeometry& g : geometries()) {
+        shader::EdgeBlendParams params = shaderParams(g);
+        WarpMap map;
+        map.build(g, width, height, pool);
+
+        int mismatches = 0;
+        MSLCPU::drawTriangle(shader::edgeBlendVertex, width, height,
+                             [&](shader::VertexOut in, uint32_t x, uint32_t y) {
+            // Pixel-centre texCoord convention of the vertex shader
+            CHECK_NEAR(in.texCoord.x, (x + 0.5f) / width, 1e-6);
+            CHECK_NEAR(in.texCoord.y, (y + 0.5f) / height, 1e-6);
+
+            float4 expected = shader::warpMapFragment(in, params);
+            const float* uv = map.row(y) + x * 2;
+            bool inside = uv[0] != WarpMap::kOutside;
+            if (inside != (expected.x >= 0.0f)) {
+                mismatches++;   // Only possible right on the warp boundary
+                return;
+            }
+            if (inside) {
+                CHECK_NEAR(uv[0], expected.x, 1e-5);
+                CHECK_NEAR(uv[1], expected.y, 1e-5);
+            }
+        });
+        CHECK(mismatches <= 2);
+    }
+}
+
+// Same map for every band count
+void testBuildIsBandIndependent() {
+    WarpGeometry g = geometries()[8];
+    BandWorkerPool inlinePool(0);
+    WarpMap reference;
+    reference.build(g, 333, 187, inlinePool);
+    for (size_t workers : {1u, 2u, 5u}) {
+        BandWorkerPool pool(workers);
+        WarpMap map;
+        map.build(g, 333, 187, pool);
+        CHECK(memcmp(map.data(), reference.data(), reference.rowBytes() * 187) == 0);
+    }
+}
+
+void testUpdateRebuildsOnlyOnChange() {
+    BandWorkerPool pool(1);
+    WarpMap map;
+    WarpGeometry g;
+    CHECK(map.update(g, 64, 32, pool));
+    CHECK(!map.update(g, 64, 32, pool));
+    CHECK_EQ(map.builds(), 1u);
+
+    g.warp[WarpGeometry::BottomRight][1] = 0.01f;
+    CHECK(map.update(g, 64, 32, pool));
+    CHECK(!map.update(g, 64, 32, pool));
+    CHECK(map.update(g, 64, 33, pool));
+    g.cropSizeX = 0.5f;
+    CHECK(map.update(g, 64, 33, pool));
+    CHECK_EQ(map.builds(), 4u);
+    CHECK(map.matches(g, 64, 33));
+}
+
+// No warp: the map is the cropped pixel centre grid
+void testIdentityMapIsCroppedGrid() {
+    BandWorkerPool pool(0);
+    WarpGeometry g;
+    g.cropOriginX = 0.5f;
+    g.cropSizeX = 0.5f;
+    WarpMap map;
+    map.build(g, 8, 4, pool);
+    for (uint32_t y = 0; y < 4; y++) {
+        for (uint32_t x = 0; x < 8; x++) {
+            CHECK_NEAR(map.row(y)[x * 2], 0.5f + (x + 0.5f) / 8.0f * 0.5f, 1e-6);
+            CHECK_NEAR(map.row(y)[x * 2 + 1], (y + 0.5f) / 4.0f, 1e-6);
+        }
+    }
+    CHECK(!g.warpActive());
+    CHECK(!g.curvatureActive());
+}
+
+// The baked-map fragment renders what the per-pixel fragment renders, within
+// one code value (the map holds exact pixel centres, the rasterized texCoord
+// can differ from them in the last bit)
+void testMappedFragmentMatchesDirect() {
+    const uint32_t width = 96, height = 54;
+    const uint32_t srcWidth = 128, srcHeight = 72;
+    std::vector<uint8_t> src((size_t)srcWidth * srcHeight * 4);
+    for (size_t i = 0; i < src.size(); i++) src[i] = (uint8_t)(i * 2654435761u >> 24);
+    std::vector<float4> texels = MSLCPU::loadBGRA8(src.data(), srcWidth, srcHeight, srcWidth * 4);
+    auto tex = MSLCPU::texture(texels, srcWidth, srcHeight);
+    metal::sampler smp;
+
+    BandWorkerPool pool(0);
+    for (const WarpGeometry& g : geometries()) {
+        shader::EdgeBlendParams params = shaderParams(g);
+        WarpMap map;
+        map.build(g, width, height, pool);
+        std::vector<float4> mapTexels((size_t)width * height);
+        for (size_t i = 0; i < mapTexels.size(); i++) {
+            mapTexels[i] = float4(map.data()[i * 2], map.data()[i * 2 + 1], 0.0f, 0.0f);
+        }
+        auto mapTex = MSLCPU::texture(mapTexels, width, height);
+
+        int differing = 0;
+        MSLCPU::drawTriangle(shader::edgeBlendVertex, width, height,
+                             [&](shader::VertexOut in, uint32_t, uint32_t) {
+            uint8_t direct[4], mapped[4];
+            MSLCPU::storeBGRA8(shader::edgeBlendFragment(in, tex, smp, params), direct);
+            MSLCPU::storeBGRA8(shader::edgeBlendMappedFragment(in, tex, mapTex, smp, params), mapped);
+            for (int c = 0; c < 4; c++) {
+                if (std::abs(direct[c] - mapped[c]) > 1) { differing++; break; }
+            }
+        });
+        CHECK_EQ(differing, 0);
+    }
+}
+
+} // namespace
+
+int main() {
+    RUN_TEST(testSourceUVMatchesShader);
+    RUN_TEST(testMapMatchesWarpMapPass);
+    RUN_TEST(testBuildIsBandIndependent);
+    RUN_TEST(testUpdateRebuildsOnlyOnChange);
+    RUN_TEST(testIdentityMapIsCroppedGrid);
+    RUN_TEST(testMappedFragmentMatchesDirect);
+    return testResult();
+}
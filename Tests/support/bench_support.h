@@ -0,0 +1,53 @@
+// bench_support.h - Timing helpers for the portable C++ benchmarks
+// Benchmarks print one line per case. --quick shrinks the run length so ctest
+// can smoke-run them; real numbers come from running the executable directly.
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace BenchSupport {
+
+inline uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline bool quickMode(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quick") == 0) return true;
+    }
+    return false;
+}
+
+// Percentile of a sample set (sorts in place)
+inline uint64_t percentile(std::vector<uint64_t>& samples, double p) {
+    if (samples.empty()) return 0;
+    std::sort(samples.begin(), samples.end());
+    size_t idx = std::min(samples.size() - 1, (size_t)(p * (double)(samples.size() - 1) + 0.5));
+    return samples[idx];
+}
+
+// Best-of-N wall time for fn(), in nanoseconds
+template <typename Fn>
+uint64_t bestOf(int runs, Fn&& fn) {
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < runs; i++) {
+        uint64_t start = nowNs();
+        fn();
+        best = std::min(best, nowNs() - start);
+    }
+    return best;
+}
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace BenchSupport
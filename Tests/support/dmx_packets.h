@@ -0,0 +1,119 @@
+// dmx_packets.h - Build Art-Net / sACN datagrams for the DMXEngine tests
+// Layouts follow Art-Net 4 (ArtDmx, ArtSync) and ANSI E1.31-2018, the same
+// offsets dmx_protocol.cpp parses.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace DMXPackets {
+
+constexpr size_t kSACNDataHeader = 125;     // Up to (not including) the start code
+
+inline void writeBE16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)(v >> 8);
+    p[1] = (uint8_t)v;
+}
+
+inline void writeBE32(uint8_t* p, uint32_t v) {
+    writeBE16(p, (uint16_t)(v >> 16));
+    writeBE16(p + 2, (uint16_t)v);
+}
+
+// ACN flags (0x7) + PDU length from offset to the end of the packet
+inline void writePDULength(uint8_t* p, size_t length) {
+    writeBE16(p, (uint16_t)(0x7000 | (length & 0x0FFF)));
+}
+
+// ArtDmx for a 15-bit port-address (0-based)
+inline std::vector<uint8_t> artDmx(uint16_t universe, uint8_t sequence, const uint8_t* slots, uint16_t count) {
+    std::vector<uint8_t> p(18 + count);
+    memcpy(p.data(), "Art-Net", 8);
+    p[8] = 0x00;            // OpDmx 0x5000, little-endian
+    p[9] = 0x50;
+    p[11] = 14;             // Protocol version
+    p[12] = sequence;
+    p[14] = (uint8_t)(universe & 0xFF);
+    p[15] = (uint8_t)((universe >> 8) & 0x7F);
+    writeBE16(p.data() + 16, count);
+    if (count) memcpy(p.data() + 18, slots, count);
+    return p;
+}
+
+inline std::vector<uint8_t> artSync() {
+    std::vector<uint8_t> p(14);
+    memcpy(p.data(), "Art-Net", 8);
+    p[8] = 0x00;            // OpSync 0x5200
+    p[9] = 0x52;
+    p[11] = 14;
+    return p;
+}
+
+struct SACNSource {
+    uint8_t cid[16] = {};
+    std::string name = "Test";
+    uint8_t priority = 100;
+    uint16_t sync_address = 0;
+    uint8_t options = 0;
+
+    // CID filled with one byte, enough to tell test sources apart
+    static SACNSource withId(uint8_t id, uint8_t priority = 100) {
+        SACNSource source;
+        memset(source.cid, id, sizeof(source.cid));
+        source.name = "Source " + std::to_string(id);
+        source.priority = priority;
+        return source;
+    }
+};
+
+// E1.31 data packet (start code 0)
+inline std::vector<uint8_t> sacnData(const SACNSource& source, uint16_t universe, uint8_t sequence,
+                                     const uint8_t* slots, uint16_t count, uint8_t startCode = 0) {
+    std::vector<uint8_t> p(kSACNDataHeader + 1 + count);
+    writeBE16(p.data(), 0x0010);                        // Preamble size
+    static const uint8_t acnId[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+    memcpy(p.data() + 4, acnId, sizeof(acnId));
+    writePDULength(p.data() + 16, p.size() - 16);
+    writeBE32(p.data() + 18, 0x00000004);               // VECTOR_ROOT_E131_DATA
+    memcpy(p.data() + 22, source.cid, 16);
+
+    writePDULength(p.data() + 38, p.size() - 38);
+    writeBE32(p.data() + 40, 0x00000002);               // VECTOR_E131_DATA_PACKET
+    strncpy((char*)p.data() + 44, source.name.c_str(), 63);
+    p[108] = source.priority;
+    writeBE16(p.data() + 109, source.sync_address);
+    p[111] = sequence;
+    p[112] = source.options;
+    writeBE16(p.data() + 113, universe);
+
+    writePDULength(p.data() + 115, p.size() - 115);
+    p[117] = 0x02;                                      // VECTOR_DMP_SET_PROPERTY
+    p[118] = 0xA1;                                      // Address & data type
+    writeBE16(p.data() + 121, 1);                       // Address increment
+    writeBE16(p.data() + 123, (uint16_t)(count + 1));   // Property count (start code + slots)
+    p[kSACNDataHeader] = startCode;
+    if (count) memcpy(p.data() + kSACNDataHeader + 1, slots, count);
+    return p;
+}
+
+// E1.31 synchronization packet
+inline std::vector<uint8_t> sacnSync(const SACNSource& source, uint16_t syncAddress, uint8_t sequence) {
+    std::vector<uint8_t> p(49);
+    writeBE16(p.data(), 0x0010);
+    static const uint8_t acnId[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+    memcpy(p.data() + 4, acnId, sizeof(acnId));
+    writePDULength(p.data() + 16, p.size() - 16);
+    writeBE32(p.data() + 18, 0x00000008);               // VECTOR_ROOT_E131_EXTENDED
+    memcpy(p.data() + 22, source.cid, 16);
+    writePDULength(p.data() + 38, p.size() - 38);
+    writeBE32(p.data() + 40, 0x00000001);               // VECTOR_E131_EXTENDED_SYNCHRONIZATION
+    p[44] = sequence;
+    writeBE16(p.data() + 45, syncAddress);
+    return p;
+}
+
+} // namespace DMXPackets
@@ -0,0 +1,87 @@
+// msl_cpu.h - Run the app's Metal shaders on the CPU for tests
+// The shader text is extracted from the .mm sources at configure time
+// (extract_msl in Tests/CMakeLists.txt) and compiled against support/msl/metal_stdlib.
+// This header adds the fixed-function parts: BGRA8 textures, BGRA8Unorm stores
+// and rasterizing a fullscreen-triangle pass at pixel centres.
+
+#pragma once
+
+#include <metal_stdlib>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MSLCPU {
+
+using metal::float2;
+using metal::float4;
+
+// Texels of a BGRA8Unorm texture as the shader reads them (RGBA, 0-1)
+inline std::vector<float4> loadBGRA8(const uint8_t* src, uint32_t width, uint32_t height, size_t stride) {
+    std::vector<float4> texels((size_t)width * height);
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t* row = src + (size_t)y * stride;
+        for (uint32_t x = 0; x < width; x++, row += 4) {
+            texels[(size_t)y * width + x] = float4(row[2] / 255.0f, row[1] / 255.0f, row[0] / 255.0f, row[3] / 255.0f);
+        }
+    }
+    return texels;
+}
+
+inline metal::texture2d<float> texture(const std::vector<float4>& texels, uint32_t width, uint32_t height) {
+    metal::texture2d<float> tex;
+    tex.texels = texels.data();
+    tex.width = width;
+    tex.height = height;
+    return tex;
+}
+
+// Fragment colour to a BGRA8Unorm render target (clamp, round to nearest)
+inline void storeBGRA8(float4 color, uint8_t* out) {
+    auto unorm8 = [](float v) { return (uint8_t)(metal::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    out[0] = unorm8(color.b);
+    out[1] = unorm8(color.g);
+    out[2] = unorm8(color.r);
+    out[3] = unorm8(color.a);
+}
+
+// Draw vertices 0-2 of vertexShader as one triangle into a width x height
+// target. Each covered pixel centre gets the vertex outputs' texCoord
+// interpolated (affine - every vertex has w = 1) and position in window
+// coordinates, then fragmentShader(in, x, y) is called.
+template <typename VertexShader, typename FragmentShader>
+void drawTriangle(VertexShader vertexShader, uint32_t width, uint32_t height, FragmentShader fragmentShader) {
+    auto v0 = vertexShader(0u);
+    auto v1 = vertexShader(1u);
+    auto v2 = vertexShader(2u);
+    decltype(v0) verts[3] = {v0, v1, v2};
+
+    // Clip space (y up) to window coordinates (y down)
+    float2 win[3];
+    for (int i = 0; i < 3; i++) {
+        win[i] = float2((verts[i].position.x * 0.5f + 0.5f) * (float)width,
+                        (0.5f - verts[i].position.y * 0.5f) * (float)height);
+    }
+    auto edge = [](float2 a, float2 b, float2 p) {
+        return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+    };
+    float area = edge(win[0], win[1], win[2]);
+    if (area == 0.0f) return;
+
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            float2 p((float)x + 0.5f, (float)y + 0.5f);
+            float l0 = edge(win[1], win[2], p) / area;
+            float l1 = edge(win[2], win[0], p) / area;
+            float l2 = 1.0f - l0 - l1;
+            if (l0 < 0.0f || l1 < 0.0f || l2 < 0.0f) continue;
+
+            auto in = v0;
+            in.position = float4(p, 0.0f, 1.0f);
+            in.texCoord = verts[0].texCoord * l0 + verts[1].texCoord * l1 + verts[2].texCoord * l2;
+            fragmentShader(in, x, y);
+        }
+    }
+}
+
+} // namespace MSLCPU
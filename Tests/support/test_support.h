@@ -0,0 +1,42 @@
+// test_support.h - Minimal assertion helpers for the portable C++ tests
+// Each test executable calls its test functions from main() and returns
+// testResult(); a failed CHECK prints its location and the test keeps going.
+
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+namespace TestSupport {
+
+inline int& failureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void fail(const char* file, int line, const char* expr) {
+    fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expr);
+    failureCount()++;
+}
+
+} // namespace TestSupport
+
+#define CHECK(cond) \
+    do { if (!(cond)) TestSupport::fail(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_EQ(a, b) \
+    do { if (!((a) == (b))) TestSupport::fail(__FILE__, __LINE__, #a " == " #b); } while (0)
+
+#define CHECK_NEAR(a, b, tolerance) \
+    do { if (!(std::fabs((double)(a) - (double)(b)) <= (double)(tolerance))) \
+        TestSupport::fail(__FILE__, __LINE__, #a " ~= " #b); } while (0)
+
+#define RUN_TEST(fn) \
+    do { fprintf(stderr, "[ RUN ] %s\n", #fn); fn(); } while (0)
+
+inline int testResult() {
+    int failures = TestSupport::failureCount();
+    if (failures) fprintf(stderr, "%d check(s) failed\n", failures);
+    else fprintf(stderr, "All checks passed\n");
+    return failures ? 1 : 0;
+}